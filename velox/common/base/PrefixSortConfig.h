@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace facebook::velox::common {
+
+/// Specifies the config for prefix sort.
+struct PrefixSortConfig {
+  PrefixSortConfig() = default;
+
+  PrefixSortConfig(uint32_t _maxNormalizedKeyBytes, uint32_t _minNumRows)
+      : maxNormalizedKeyBytes(_maxNormalizedKeyBytes),
+        minNumRows(_minNumRows) {}
+
+  /// Max number of bytes of the normalized keys encoded in front of each row
+  /// pointer. The sort keys that do not fit are compared through the
+  /// RowContainer on ties. Prefix sort is disabled if it is zero.
+  uint32_t maxNormalizedKeyBytes{128};
+
+  /// Min number of rows to use prefix sort. Fewer rows are sorted with
+  /// std::sort as the encoding overhead outweighs the faster compares.
+  uint32_t minNumRows{130};
+};
+} // namespace facebook::velox::common
@@ -35,7 +35,10 @@ SpillConfig::SpillConfig(
     uint64_t _writerFlushThresholdSize,
     int32_t _testSpillPct,
     const std::string& _compressionKind,
-    const std::string& _fileCreateConfig)
+    const std::string& _fileCreateConfig,
+    uint32_t _numReadAheadBuffers,
+    const std::string& _orderBySpillFormat,
+    std::optional<PrefixSortConfig> _prefixSortConfig)
     : getSpillDirPathCb(std::move(_getSpillDirPathCb)),
       updateAndCheckSpillLimitCb(std::move(_updateAndCheckSpillLimitCb)),
       fileNamePrefix(std::move(_fileNamePrefix)),
@@ -54,13 +57,37 @@ SpillConfig::SpillConfig(
       writerFlushThresholdSize(_writerFlushThresholdSize),
       testSpillPct(_testSpillPct),
       compressionKind(common::stringToCompressionKind(_compressionKind)),
-      fileCreateConfig(_fileCreateConfig) {
+      fileCreateConfig(_fileCreateConfig),
+      numReadAheadBuffers(_numReadAheadBuffers),
+      orderBySpillFormat(stringToSpillFormat(_orderBySpillFormat)),
+      prefixSortConfig(std::move(_prefixSortConfig)) {
   VELOX_USER_CHECK_GE(
       spillableReservationGrowthPct,
       minSpillableReservationPct,
       "Spillable memory reservation growth pct should not be lower than minimum available pct");
 }
 
+std::string spillFormatName(SpillFormat format) {
+  switch (format) {
+    case SpillFormat::kColumnar:
+      return "columnar";
+    case SpillFormat::kRowContainer:
+      return "row_container";
+    default:
+      VELOX_UNREACHABLE("Unknown spill format {}", static_cast<int>(format));
+  }
+}
+
+SpillFormat stringToSpillFormat(const std::string& format) {
+  if (format == "columnar") {
+    return SpillFormat::kColumnar;
+  }
+  if (format == "row_container") {
+    return SpillFormat::kRowContainer;
+  }
+  VELOX_USER_FAIL("Unsupported spill format: {}", format);
+}
+
 int32_t SpillConfig::joinSpillLevel(uint8_t startBitOffset) const {
   const auto numPartitionBits = joinPartitionBits;
   VELOX_CHECK_LE(
@@ -18,8 +18,10 @@
 
 #include <stdint.h>
 #include <string.h>
+#include <optional>
 
 #include <folly/executors/CPUThreadPoolExecutor.h>
+#include "velox/common/base/PrefixSortConfig.h"
 #include "velox/common/compression/Compression.h"
 
 namespace facebook::velox::common {
@@ -42,6 +44,20 @@ using GetSpillDirectoryPathCB = std::function<const std::string&()>;
 /// bytes exceed the set limit.
 using UpdateAndCheckSpillLimitCB = std::function<void(uint64_t)>;
 
+/// Specifies the format of the rows spilled from a RowContainer.
+enum class SpillFormat {
+  /// Extracts the rows into columns which are serialized by PrestoVectorSerde.
+  kColumnar,
+  /// Copies the rows as-is with their fixed-width parts and variable-length
+  /// blobs. Only the sort keys are extracted into columns to merge the sorted
+  /// spill runs. The restored rows are copied back into a RowContainer.
+  kRowContainer,
+};
+
+std::string spillFormatName(SpillFormat format);
+
+SpillFormat stringToSpillFormat(const std::string& format);
+
 /// Specifies the config for spilling.
 struct SpillConfig {
   SpillConfig() = default;
@@ -62,7 +78,10 @@ struct SpillConfig {
       uint64_t _writerFlushThresholdSize,
       int32_t _testSpillPct,
       const std::string& _compressionKind,
-      const std::string& _fileCreateConfig = {});
+      const std::string& _fileCreateConfig = {},
+      uint32_t _numReadAheadBuffers = 0,
+      const std::string& _orderBySpillFormat = "columnar",
+      std::optional<PrefixSortConfig> _prefixSortConfig = std::nullopt);
 
   /// Returns the hash join spilling level with given 'startBitOffset'.
   ///
@@ -146,5 +165,18 @@ struct SpillConfig {
 
   /// Custom options passed to velox::FileSystem to create spill WriteFile.
   std::string fileCreateConfig;
+
+  /// The number of buffers per spill file to read ahead on 'executor' while
+  /// the restored data is consumed. If it is zero or 'executor' is not set,
+  /// spill files are read synchronously on the Driver's thread.
+  uint32_t numReadAheadBuffers;
+
+  /// The format of the rows spilled by order by. The other operators always
+  /// spill in the columnar format.
+  SpillFormat orderBySpillFormat;
+
+  /// The prefix sort config used to sort the rows before spilling them. If
+  /// not set, the rows are sorted with timsort.
+  std::optional<PrefixSortConfig> prefixSortConfig;
 };
 } // namespace facebook::velox::common
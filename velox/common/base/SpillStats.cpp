@@ -20,6 +20,8 @@
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/base/SuccinctPrinter.h"
 
+#include <folly/String.h>
+
 namespace facebook::velox::common {
 namespace {
 std::vector<folly::Synchronized<SpillStats>>& allSpillStats() {
@@ -77,6 +79,12 @@ SpillStats& SpillStats::operator+=(const SpillStats& other) {
   spillFlushTimeUs += other.spillFlushTimeUs;
   spillWriteTimeUs += other.spillWriteTimeUs;
   spillMaxLevelExceededCount += other.spillMaxLevelExceededCount;
+  spillSkewFallbackCount += other.spillSkewFallbackCount;
+  spillReadBytes += other.spillReadBytes;
+  spillReadWaitTimeUs += other.spillReadWaitTimeUs;
+  for (auto i = 0; i < kNumSpillLevels; ++i) {
+    spilledPartitionBytesByLevel[i] += other.spilledPartitionBytesByLevel[i];
+  }
   return *this;
 }
 
@@ -97,6 +105,15 @@ SpillStats SpillStats::operator-(const SpillStats& other) const {
   result.spillWriteTimeUs = spillWriteTimeUs - other.spillWriteTimeUs;
   result.spillMaxLevelExceededCount =
       spillMaxLevelExceededCount - other.spillMaxLevelExceededCount;
+  result.spillSkewFallbackCount =
+      spillSkewFallbackCount - other.spillSkewFallbackCount;
+  result.spillReadBytes = spillReadBytes - other.spillReadBytes;
+  result.spillReadWaitTimeUs =
+      spillReadWaitTimeUs - other.spillReadWaitTimeUs;
+  for (auto i = 0; i < kNumSpillLevels; ++i) {
+    result.spilledPartitionBytesByLevel[i] = spilledPartitionBytesByLevel[i] -
+        other.spilledPartitionBytesByLevel[i];
+  }
   return result;
 }
 
@@ -128,6 +145,12 @@ bool SpillStats::operator<(const SpillStats& other) const {
   UPDATE_COUNTER(spillFlushTimeUs);
   UPDATE_COUNTER(spillWriteTimeUs);
   UPDATE_COUNTER(spillMaxLevelExceededCount);
+  UPDATE_COUNTER(spillSkewFallbackCount);
+  UPDATE_COUNTER(spillReadBytes);
+  UPDATE_COUNTER(spillReadWaitTimeUs);
+  for (auto i = 0; i < kNumSpillLevels; ++i) {
+    UPDATE_COUNTER(spilledPartitionBytesByLevel[i]);
+  }
 #undef UPDATE_COUNTER
   VELOX_CHECK(
       !((gtCount > 0) && (ltCount > 0)),
@@ -163,7 +186,11 @@ bool SpillStats::operator==(const SpillStats& other) const {
              spillDiskWrites,
              spillFlushTimeUs,
              spillWriteTimeUs,
-             spillMaxLevelExceededCount) ==
+             spillMaxLevelExceededCount,
+             spillSkewFallbackCount,
+             spillReadBytes,
+             spillReadWaitTimeUs,
+             spilledPartitionBytesByLevel) ==
       std::tie(
              other.spillRuns,
              other.spilledInputBytes,
@@ -177,7 +204,11 @@ bool SpillStats::operator==(const SpillStats& other) const {
              other.spillDiskWrites,
              other.spillFlushTimeUs,
              other.spillWriteTimeUs,
-             spillMaxLevelExceededCount);
+             spillMaxLevelExceededCount,
+             other.spillSkewFallbackCount,
+             other.spillReadBytes,
+             other.spillReadWaitTimeUs,
+             other.spilledPartitionBytesByLevel);
 }
 
 void SpillStats::reset() {
@@ -194,10 +225,14 @@ void SpillStats::reset() {
   spillFlushTimeUs = 0;
   spillWriteTimeUs = 0;
   spillMaxLevelExceededCount = 0;
+  spillSkewFallbackCount = 0;
+  spillReadBytes = 0;
+  spillReadWaitTimeUs = 0;
+  spilledPartitionBytesByLevel.fill(0);
 }
 
 std::string SpillStats::toString() const {
-  return fmt::format(
+  auto result = fmt::format(
       "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] spilledRows[{}] spilledPartitions[{}] spilledFiles[{}] spillFillTimeUs[{}] spillSortTime[{}] spillSerializationTime[{}] spillDiskWrites[{}] spillFlushTime[{}] spillWriteTime[{}] maxSpillExceededLimitCount[{}]",
       spillRuns,
       succinctBytes(spilledInputBytes),
@@ -212,6 +247,32 @@ std::string SpillStats::toString() const {
       succinctMicros(spillFlushTimeUs),
       succinctMicros(spillWriteTimeUs),
       spillMaxLevelExceededCount);
+  // The skew fallback stats are only reported by hash joins which restore
+  // spilled partitions.
+  if (spillSkewFallbackCount != 0) {
+    result +=
+        fmt::format(" spillSkewFallbackCount[{}]", spillSkewFallbackCount);
+  }
+  // The read stats are only reported once spilled data is restored.
+  if (spillReadBytes != 0) {
+    result += fmt::format(
+        " spillReadBytes[{}] spillReadWaitTime[{}]",
+        succinctBytes(spillReadBytes),
+        succinctMicros(spillReadWaitTimeUs));
+  }
+  int32_t numLevels = kNumSpillLevels;
+  while (numLevels > 0 && spilledPartitionBytesByLevel[numLevels - 1] == 0) {
+    --numLevels;
+  }
+  if (numLevels > 0) {
+    std::vector<std::string> levelBytes;
+    for (auto i = 0; i < numLevels; ++i) {
+      levelBytes.push_back(succinctBytes(spilledPartitionBytesByLevel[i]));
+    }
+    result += fmt::format(
+        " spilledPartitionBytesByLevel[{}]", folly::join(",", levelBytes));
+  }
+  return result;
 }
 
 void updateGlobalSpillRunStats(uint64_t numRuns) {
@@ -276,6 +337,16 @@ void updateGlobalMaxSpillLevelExceededCount(
       maxSpillLevelExceededCount;
 }
 
+void updateGlobalSpillSkewFallbackCount(uint64_t spillSkewFallbackCount) {
+  localSpillStats().wlock()->spillSkewFallbackCount += spillSkewFallbackCount;
+}
+
+void updateGlobalSpillReadStats(uint64_t readBytes, uint64_t readWaitTimeUs) {
+  auto statsLocked = localSpillStats().wlock();
+  statsLocked->spillReadBytes += readBytes;
+  statsLocked->spillReadWaitTimeUs += readWaitTimeUs;
+}
+
 SpillStats globalSpillStats() {
   SpillStats gSpillStats;
   for (auto& spillStats : allSpillStats()) {
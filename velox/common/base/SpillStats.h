@@ -16,6 +16,7 @@
 #pragma once
 #include <stdint.h>
 #include <string.h>
+#include <array>
 
 #include <folly/executors/CPUThreadPoolExecutor.h>
 #include "velox/common/compression/Compression.h"
@@ -54,6 +55,23 @@ struct SpillStats {
   /// The number of times that an hash build operator exceeds the max spill
   /// limit.
   uint64_t spillMaxLevelExceededCount{0};
+  /// The number of times that a hash build operator restores a spilled
+  /// partition through the skew fallback which builds the partition in
+  /// memory-bounded chunks instead of repartitioning it.
+  uint64_t spillSkewFallbackCount{0};
+  /// The number of bytes read from spill files to restore spilled data.
+  uint64_t spillReadBytes{0};
+  /// The time spent by the driver threads on waiting for spill file reads,
+  /// including the reads which are not covered by read-ahead.
+  uint64_t spillReadWaitTimeUs{0};
+
+  /// The number of spill levels for which 'spilledPartitionBytesByLevel' is
+  /// tracked. The bytes of deeper levels are added to the last entry.
+  static constexpr int32_t kNumSpillLevels = 8;
+  /// The spilled bytes of the partitions at each spill level. Level 0 is the
+  /// spill of the original input. Level n is the spill of the data restored
+  /// from level n - 1.
+  std::array<uint64_t, kNumSpillLevels> spilledPartitionBytesByLevel{};
 
   SpillStats(
       uint64_t _spillRuns,
@@ -135,6 +153,14 @@ void incrementGlobalSpilledFiles();
 void updateGlobalMaxSpillLevelExceededCount(
     uint64_t maxSpillLevelExceededCount);
 
+/// Increments the number of spilled partitions restored through the skew
+/// fallback.
+void updateGlobalSpillSkewFallbackCount(uint64_t spillSkewFallbackCount);
+
+/// Updates the stats of spill file reads including the read bytes and the
+/// time that the reader waits for the read.
+void updateGlobalSpillReadStats(uint64_t readBytes, uint64_t readWaitTimeUs);
+
 /// Gets the cumulative global spill stats.
 SpillStats globalSpillStats();
 } // namespace facebook::velox::common
@@ -105,4 +105,27 @@ TEST(SpillTest, spillStats) {
   ASSERT_EQ(
       stats2.toString(),
       "spillRuns[100] spilledInputBytes[2.00KB] spilledBytes[1.00KB] spilledRows[1031] spilledPartitions[1025] spilledFiles[1026] spillFillTimeUs[1.03ms] spillSortTime[1.03ms] spillSerializationTime[1.03ms] spillDiskWrites[1028] spillFlushTime[1.03ms] spillWriteTime[1.03ms] maxSpillExceededLimitCount[4]");
+
+  stats2.spillSkewFallbackCount = 2;
+  stats2.spilledPartitionBytesByLevel[0] = 2048;
+  stats2.spilledPartitionBytesByLevel[2] = 1024;
+  stats2.spillReadBytes = 4096;
+  stats2.spillReadWaitTimeUs = 1032;
+  stats1 = stats2;
+  stats1 += stats2;
+  ASSERT_EQ(stats1.spillSkewFallbackCount, 4);
+  ASSERT_EQ(stats1.spilledPartitionBytesByLevel[0], 4096);
+  ASSERT_EQ(stats1.spilledPartitionBytesByLevel[1], 0);
+  ASSERT_EQ(stats1.spilledPartitionBytesByLevel[2], 2048);
+  ASSERT_EQ(stats1.spillReadBytes, 8192);
+  ASSERT_EQ(stats1.spillReadWaitTimeUs, 2064);
+  ASSERT_TRUE(stats1 > stats2);
+  delta = stats1 - stats2;
+  ASSERT_EQ(delta.spillSkewFallbackCount, 2);
+  ASSERT_EQ(delta.spilledPartitionBytesByLevel[2], 1024);
+  ASSERT_EQ(delta.spillReadBytes, 4096);
+  ASSERT_EQ(delta.spillReadWaitTimeUs, 1032);
+  ASSERT_EQ(
+      stats2.toString(),
+      "spillRuns[100] spilledInputBytes[2.00KB] spilledBytes[1.00KB] spilledRows[1031] spilledPartitions[1025] spilledFiles[1026] spillFillTimeUs[1.03ms] spillSortTime[1.03ms] spillSerializationTime[1.03ms] spillDiskWrites[1028] spillFlushTime[1.03ms] spillWriteTime[1.03ms] maxSpillExceededLimitCount[4] spillSkewFallbackCount[2] spillReadBytes[4.00KB] spillReadWaitTime[1.03ms] spilledPartitionBytesByLevel[2.00KB,0B,1.00KB]");
 }
@@ -18,11 +18,21 @@
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
 
+#include <folly/hash/Hash.h>
+#include <folly/synchronization/Rcu.h>
+#include <thread>
+
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
 
+DEFINE_int32(
+    velox_cache_admission_frequency,
+    0,
+    "If > 0, new cache entries whose keys have been accessed fewer times are "
+    "admitted on probation and are not written to SSD. 0 disables admission");
+
 namespace facebook::velox::cache {
 
 using memory::MachinePageCount;
@@ -33,7 +43,11 @@ AsyncDataCacheEntry::AsyncDataCacheEntry(CacheShard* shard) : shard_(shard) {
 }
 
 AsyncDataCacheEntry::~AsyncDataCacheEntry() {
-  shard_->cache()->allocator()->freeNonContiguous(data_);
+  // Entries trimmed from the free list are deleted after an RCU grace period
+  // and may outlive 'shard_'. These hold no data.
+  if (!data_.empty()) {
+    shard_->cache()->allocator()->freeNonContiguous(data_);
+  }
 }
 
 void AsyncDataCacheEntry::setExclusiveToShared() {
@@ -61,8 +75,12 @@ void AsyncDataCacheEntry::setExclusiveToShared() {
     auto* ssdCache = shard_->cache()->ssdCache();
     assert(ssdCache); // for lint only.
     if (ssdCache->groupStats().shouldSaveToSsd(groupId_, trackingId_)) {
-      ssdSaveable_ = true;
-      shard_->cache()->possibleSsdSave(size_);
+      if (!shard_->cache()->shouldAdmit(key_.fileNum.id(), key_.offset)) {
+        shard_->incrementSsdAdmissionRejects();
+      } else {
+        ssdSaveable_ = true;
+        shard_->cache()->possibleSsdSave(size_);
+      }
     }
   }
 }
@@ -138,6 +156,118 @@ std::string AsyncDataCacheEntry::toString() const {
       numPins_);
 }
 
+CacheShard::CacheShard(AsyncDataCache* cache)
+    : cache_(cache), hitIndex_(new HitIndex(kInitialHitIndexSize)) {}
+
+CacheShard::~CacheShard() {
+  delete hitIndex_.load();
+}
+
+CacheShard::HitSlot& CacheShard::HitIndex::slot(RawFileCacheKey key) const {
+  // The low bits of the hash select the shard. Mix so that all bits count.
+  return slots
+      [folly::hash::twang_mix64(std::hash<RawFileCacheKey>()(key)) & mask];
+}
+
+CachePin CacheShard::findLockFree(RawFileCacheKey key, uint64_t size) {
+  AsyncDataCacheEntry* entry;
+  HitSlot* slot;
+  uint64_t version;
+  {
+    // Entries dropped from the free list are deleted after the readers inside
+    // an RCU read section at the time are done.
+    folly::rcu_reader guard;
+    slot = &hitIndex_.load(std::memory_order_acquire)->slot(key);
+    version = slot->version.load(std::memory_order_acquire);
+    if (version & 1) {
+      return CachePin();
+    }
+    entry = slot->entry.load(std::memory_order_relaxed);
+    const auto fileNum = slot->fileNum.load(std::memory_order_relaxed);
+    const auto offset = slot->offset.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot->version.load(std::memory_order_relaxed) != version ||
+        entry == nullptr || fileNum != key.fileNum || offset != key.offset) {
+      return CachePin();
+    }
+    auto numPins = entry->numPins_.load();
+    do {
+      if (numPins < 0) {
+        // Exclusive, i.e. loading or being removed.
+        return CachePin();
+      }
+    } while (!entry->numPins_.compare_exchange_weak(numPins, numPins + 1));
+  }
+  // The entry is pinned and cannot be evicted or reused. If the slot did not
+  // change, the entry still belonged to 'key' after it got pinned. The index
+  // may have been replaced in the meantime but the entries stay valid.
+  if (slot->version.load() != version || entry->size() < size ||
+      entry->isPrefetch()) {
+    entry->release();
+    return CachePin();
+  }
+  entry->touch();
+  ++numHit_;
+  hitBytes_ += entry->size();
+  CachePin pin;
+  pin.setEntry(entry);
+  return pin;
+}
+
+void CacheShard::addToHitIndexLocked(
+    RawFileCacheKey key,
+    AsyncDataCacheEntry* entry) {
+  auto* index = hitIndex_.load();
+  if (entryMap_.size() > index->mask + 1) {
+    auto* newIndex = new HitIndex((index->mask + 1) * 2);
+    for (const auto& [mapKey, mapEntry] : entryMap_) {
+      auto& slot = newIndex->slot(mapKey);
+      slot.fileNum = mapKey.fileNum;
+      slot.offset = mapKey.offset;
+      slot.entry = mapEntry;
+    }
+    hitIndex_.store(newIndex);
+    // Readers may still be probing the old index.
+    folly::rcu_retire(index);
+    return;
+  }
+  auto& slot = index->slot(key);
+  if (slot.entry.load(std::memory_order_relaxed) == entry &&
+      slot.fileNum.load(std::memory_order_relaxed) == key.fileNum &&
+      slot.offset.load(std::memory_order_relaxed) == key.offset) {
+    return;
+  }
+  const auto version = slot.version.load(std::memory_order_relaxed);
+  slot.version.store(version + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.fileNum.store(key.fileNum, std::memory_order_relaxed);
+  slot.offset.store(key.offset, std::memory_order_relaxed);
+  slot.entry.store(entry, std::memory_order_relaxed);
+  slot.version.store(version + 2, std::memory_order_release);
+}
+
+void CacheShard::removeFromHitIndexLocked(
+    RawFileCacheKey key,
+    AsyncDataCacheEntry* entry) {
+  auto& slot = hitIndex_.load()->slot(key);
+  if (slot.entry.load(std::memory_order_relaxed) != entry) {
+    return;
+  }
+  // Sequentially consistent so that a reader that pinned 'entry' before it
+  // was claimed for removal sees the version change.
+  const auto version = slot.version.load();
+  slot.version.store(version + 1);
+  slot.entry.store(nullptr);
+  slot.version.store(version + 2);
+}
+
+// static
+bool CacheShard::tryClaimLocked(AsyncDataCacheEntry* entry) {
+  int32_t expected = 0;
+  return entry->numPins_.compare_exchange_strong(
+      expected, AsyncDataCacheEntry::kExclusive);
+}
+
 std::unique_ptr<AsyncDataCacheEntry> CacheShard::getFreeEntry() {
   std::unique_ptr<AsyncDataCacheEntry> newEntry;
   if (freeEntries_.empty()) {
@@ -153,6 +283,10 @@ CachePin CacheShard::findOrCreate(
     RawFileCacheKey key,
     uint64_t size,
     folly::SemiFuture<bool>* wait) {
+  auto pin = findLockFree(key, size);
+  if (!pin.empty()) {
+    return pin;
+  }
   AsyncDataCacheEntry* entryToInit = nullptr;
   {
     std::lock_guard<std::mutex> l(mutex_);
@@ -169,7 +303,11 @@ CachePin CacheShard::findOrCreate(
         return CachePin();
       }
       if (found->size() >= size) {
-        found->touch();
+        // The first use of a prefetched entry is the access it was loaded
+        // for. This does not take an entry off admission probation.
+        if (!(found->isPrefetch() && found->isEvictable())) {
+          found->touch();
+        }
         // The entry is in a readable state. Add a pin.
         if (found->isPrefetch()) {
           found->isFirstUse_ = true;
@@ -179,7 +317,8 @@ CachePin CacheShard::findOrCreate(
           hitBytes_ += found->size();
         }
         ++found->numPins_;
-        CachePin pin;
+        // The slot may have been taken by a colliding key.
+        addToHitIndexLocked(key, found);
         pin.setEntry(found);
         return pin;
       }
@@ -202,6 +341,7 @@ CachePin CacheShard::findOrCreate(
     newEntry->promise_ = nullptr;
     entryToInit = newEntry.get();
     entryMap_[key] = newEntry.get();
+    addToHitIndexLocked(key, newEntry.get());
     if (emptySlots_.empty()) {
       entries_.push_back(std::move(newEntry));
     } else {
@@ -238,6 +378,11 @@ CachePin CacheShard::initEntry(
   // can be set outside of 'mutex_'.
   entry->initialize(
       FileCacheKey{StringIdLease(fileIds(), key.fileNum), key.offset});
+  if (!cache_->shouldAdmit(key.fileNum, key.offset)) {
+    // Data not accessed often enough is the first to go unless it gets hit.
+    entry->makeEvictable();
+    ++numProbation_;
+  }
   cache_->incrementNew(entry->size());
   CachePin pin;
   pin.setEntry(entry);
@@ -312,10 +457,11 @@ void CacheShard::removeEntryLocked(AsyncDataCacheEntry* entry) {
   if (!entry->key_.fileNum.hasValue()) {
     return;
   }
-  const auto it = entryMap_.find(
-      RawFileCacheKey{entry->key_.fileNum.id(), entry->key_.offset});
+  const RawFileCacheKey key{entry->key_.fileNum.id(), entry->key_.offset};
+  const auto it = entryMap_.find(key);
   VELOX_CHECK(it != entryMap_.end());
   entryMap_.erase(it);
+  removeFromHitIndexLocked(key, entry);
   entry->key_.fileNum.clear();
   entry->setSsdFile(nullptr, 0);
   if (entry->isPrefetch()) {
@@ -390,6 +536,9 @@ uint64_t CacheShard::evict(
           ++evictSaveableSkipped;
           continue;
         }
+        if (!tryClaimLocked(candidate)) {
+          continue;
+        }
         largeEvicted += candidate->data_.byteSize();
         if (pagesToAcquire > 0) {
           const auto candidatePages = candidate->data().numPages();
@@ -443,7 +592,12 @@ uint64_t CacheShard::evict(
 void CacheShard::tryAddFreeEntry(std::unique_ptr<AsyncDataCacheEntry>&& entry) {
   freeEntries_.push_back(std::move(entry));
   // If we have too many free entries, we free up half of them to save space.
+  // A lock-free hit may still be looking at a dropped entry, so the entry is
+  // deleted after an RCU grace period.
   if (freeEntries_.size() >= kMaxFreeEntries) {
+    for (auto i = kMaxFreeEntries >> 1; i < freeEntries_.size(); ++i) {
+      folly::rcu_retire(freeEntries_[i].release());
+    }
     freeEntries_.resize(kMaxFreeEntries >> 1);
   }
 }
@@ -512,6 +666,8 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.numEvictChecks += numEvictChecks_;
   stats.numWaitExclusive += numWaitExclusive_;
   stats.numAgedOut += numAgedOut_;
+  stats.numProbation += numProbation_;
+  stats.numSsdAdmissionRejects += numSsdAdmissionRejects_;
   stats.sumEvictScore += sumEvictScore_;
   stats.allocClocks += allocClocks_;
 }
@@ -561,7 +717,8 @@ bool CacheShard::removeFileEntries(
       if (filesToRemove.count(cacheEntry->key_.fileNum.id()) == 0) {
         continue;
       }
-      if (cacheEntry->isExclusive() || cacheEntry->isShared()) {
+      if (cacheEntry->isExclusive() || cacheEntry->isShared() ||
+          !tryClaimLocked(cacheEntry.get())) {
         filesRetained.insert(cacheEntry->key_.fileNum.id());
         continue;
       }
@@ -589,11 +746,34 @@ bool CacheShard::removeFileEntries(
 
 AsyncDataCache::AsyncDataCache(
     memory::MemoryAllocator* allocator,
-    std::unique_ptr<SsdCache> ssdCache)
+    std::unique_ptr<SsdCache> ssdCache,
+    int32_t numShards)
     : allocator_(allocator), ssdCache_(std::move(ssdCache)), cachedPages_(0) {
-  for (auto i = 0; i < kNumShards; ++i) {
+  if (numShards == 0) {
+    numShards = defaultNumShards();
+  }
+  VELOX_CHECK_GT(numShards, 0);
+  VELOX_CHECK_EQ(
+      numShards & (numShards - 1), 0, "Number of shards must be a power of 2");
+  VELOX_CHECK_LE(
+      FLAGS_velox_cache_admission_frequency, FrequencySketch::kMaxFrequency);
+  if (FLAGS_velox_cache_admission_frequency > 0) {
+    // Sized for entries of 64KB on average.
+    admissionSketch_ = std::make_shared<FrequencySketch>(
+        std::max<uint64_t>(4096, allocator_->capacity() >> 16));
+  }
+  for (auto i = 0; i < numShards; ++i) {
     shards_.push_back(std::make_unique<CacheShard>(this));
   }
+  shardMask_ = numShards - 1;
+}
+
+// static
+int32_t AsyncDataCache::defaultNumShards() {
+  const int32_t numThreads = std::thread::hardware_concurrency();
+  return std::min<int32_t>(
+      kMaxShards,
+      bits::nextPowerOfTwo(std::max<int32_t>(kMinShards, numThreads / 4)));
 }
 
 AsyncDataCache::~AsyncDataCache() {}
@@ -601,8 +781,10 @@ AsyncDataCache::~AsyncDataCache() {}
 // static
 std::shared_ptr<AsyncDataCache> AsyncDataCache::create(
     memory::MemoryAllocator* allocator,
-    std::unique_ptr<SsdCache> ssdCache) {
-  auto cache = std::make_shared<AsyncDataCache>(allocator, std::move(ssdCache));
+    std::unique_ptr<SsdCache> ssdCache,
+    int32_t numShards) {
+  auto cache = std::make_shared<AsyncDataCache>(
+      allocator, std::move(ssdCache), numShards);
   allocator->registerCache(cache);
   return cache;
 }
@@ -638,12 +820,12 @@ CachePin AsyncDataCache::findOrCreate(
     RawFileCacheKey key,
     uint64_t size,
     folly::SemiFuture<bool>* wait) {
-  const int shard = std::hash<RawFileCacheKey>()(key) & (kShardMask);
+  const int shard = std::hash<RawFileCacheKey>()(key) & shardMask_;
   return shards_[shard]->findOrCreate(key, size, wait);
 }
 
 bool AsyncDataCache::exists(RawFileCacheKey key) const {
-  int shard = std::hash<RawFileCacheKey>()(key) & (kShardMask);
+  int shard = std::hash<RawFileCacheKey>()(key) & shardMask_;
   return shards_[shard]->exists(key);
 }
 
@@ -662,7 +844,10 @@ bool AsyncDataCache::makeSpace(
   // serialize with a mutex because memory arbitration must not be
   // called from inside a global mutex.
 
-  constexpr int32_t kMaxAttempts = kNumShards * 4;
+  // One round over the shards, then a round of evicting all unpinned
+  // entries, with at least 16 attempts in total.
+  const int32_t numShards = shards_.size();
+  const int32_t maxAttempts = std::max<int32_t>(16, numShards * 2);
   // Evict at least 1MB even for small allocations to avoid constantly hitting
   // the mutex protected evict loop.
   constexpr int32_t kMinEvictPages = 256;
@@ -693,7 +878,7 @@ bool AsyncDataCache::makeSpace(
     rank = ++numThreadsInAllocate_;
     isCounted = true;
   }
-  for (auto nthAttempt = 0; nthAttempt < kMaxAttempts; ++nthAttempt) {
+  for (auto nthAttempt = 0; nthAttempt < maxAttempts; ++nthAttempt) {
     if (canTryAllocate(numPages, acquired)) {
       if (allocate(acquired)) {
         return true;
@@ -705,7 +890,7 @@ bool AsyncDataCache::makeSpace(
           << "Pause 0.5s after failed eviction waiting for SSD cache write to unpin memory";
       std::this_thread::sleep_for(std::chrono::milliseconds(500)); // NOLINT
     }
-    if (nthAttempt > kMaxAttempts / 2) {
+    if (nthAttempt > maxAttempts / 2) {
       if (!isCounted) {
         rank = ++numThreadsInAllocate_;
         isCounted = true;
@@ -726,10 +911,10 @@ bool AsyncDataCache::makeSpace(
     // Evict from next shard. If we have gone through all shards once
     // and still have not made the allocation, we go to desperate mode
     // with 'evictAllUnpinned' set to true.
-    shards_[shardCounter_ & (kShardMask)]->evict(
+    shards_[shardCounter_ & shardMask_]->evict(
         memory::AllocationTraits::pageBytes(
             std::max<uint64_t>(kMinEvictPages, numPages) * sizeMultiplier),
-        nthAttempt >= kNumShards,
+        nthAttempt >= numShards,
         numPagesToAcquire,
         acquired);
     if (numPages < kSmallSizePages && sizeMultiplier < 4) {
@@ -755,7 +940,7 @@ uint64_t AsyncDataCache::shrink(uint64_t targetBytes) {
     MicrosecondTimer timer(&shrinkTimeUs);
     for (int shard = 0; shard < shards_.size(); ++shard) {
       memory::Allocation unused;
-      evictedBytes += shards_[shardCounter_++ & (kShardMask)]->evict(
+      evictedBytes += shards_[shardCounter_++ & shardMask_]->evict(
           std::max<uint64_t>(minBytesToEvict, targetBytes - evictedBytes),
           // Cache shrink is triggered when server is under low memory pressure
           // so need to free up memory as soon as possible. So we always avoid
@@ -918,7 +1103,8 @@ std::string CacheStats::toString() const {
       << "Cache access miss: " << numNew << " hit: " << numHit
       << " hit bytes: " << succinctBytes(hitBytes) << " eviction: " << numEvict
       << " eviction checks: " << numEvictChecks << " aged out: " << numAgedOut
-      << "\n"
+      << " probation: " << numProbation
+      << " ssd admission rejects: " << numSsdAdmissionRejects << "\n"
       // Cache prefetch stats.
       << "Prefetch entries: " << numPrefetch
       << " bytes: " << succinctBytes(prefetchBytes)
@@ -22,18 +22,22 @@
 #include <folly/chrono/Hardware.h>
 #include <folly/container/F14Set.h>
 #include <folly/futures/SharedPromise.h>
+#include <gflags/gflags.h>
 #include "folly/GLog.h"
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/CoalesceIo.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SelectivityInfo.h"
 #include "velox/common/caching/FileGroupStats.h"
+#include "velox/common/caching/FrequencySketch.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
 #include "velox/common/file/File.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/common/memory/MemoryAllocator.h"
 
+DECLARE_int32(velox_cache_admission_frequency);
+
 namespace facebook::velox::cache {
 
 #define VELOX_CACHE_LOG_PREFIX "[CACHE] "
@@ -62,8 +66,10 @@ inline AccessTime accessTime() {
 }
 
 struct AccessStats {
-  AccessTime lastUse{0};
-  int32_t numUses{0};
+  // Updated by touch() without the shard mutex on a lock-free cache hit. The
+  // values are approximate and lost updates are acceptable.
+  tsan_atomic<AccessTime> lastUse{0};
+  tsan_atomic<int32_t> numUses{0};
 
   // Retention score. A higher number means less worth retaining. This
   // works well with a typical formula of time over use count going to
@@ -72,10 +78,11 @@ struct AccessStats {
   // expensive and many entries are checked one after the other. lastUse == 0
   // means explicitly evictable.
   int32_t score(AccessTime now, uint64_t /*size*/) const {
-    if (!lastUse) {
+    const AccessTime last = lastUse;
+    if (!last) {
       return std::numeric_limits<int32_t>::max();
     }
-    return (now - lastUse) / (1 + numUses);
+    return (now - last) / (1 + numUses);
   }
 
   // Resets the access tracking to not accessed. This is used after
@@ -254,6 +261,11 @@ class AsyncDataCacheEntry {
   /// Sets access stats so that this is immediately evictable.
   void makeEvictable();
 
+  /// True if 'this' has not been used since makeEvictable().
+  bool isEvictable() const {
+    return accessStats_.lastUse == 0;
+  }
+
   // Moves the promise out of 'this'. Used in order to handle the
   // promise within the lock of the cache shard, so not within private
   // methods of 'this'.
@@ -291,15 +303,18 @@ class AsyncDataCacheEntry {
   std::unique_ptr<folly::SharedPromise<bool>> promise_;
   int32_t size_{0};
 
-  // Setting this from 0 to 1 or to kExclusive requires owning shard_->mutex_.
+  // Setting this to kExclusive requires owning shard_->mutex_ and, if the
+  // entry may be in the hit index of 'shard_', a compare-and-swap from 0 since
+  // lock-free hits pin with a compare-and-swap from any non-negative value.
   std::atomic<int32_t> numPins_{0};
 
   AccessStats accessStats_;
 
   // True if 'this' is speculatively loaded. This is reset on first
   // hit. Allows catching a situation where prefetched entries get
-  // evicted before they are hit.
-  bool isPrefetch_{false};
+  // evicted before they are hit. Read without the shard mutex by lock-free
+  // hits.
+  tsan_atomic<bool> isPrefetch_{false};
 
   // Sets after first use of a prefetched entry. Cleared by
   // getAndClearFirstUseFlag(). Does not require synchronization since used for
@@ -511,6 +526,12 @@ struct CacheStats {
   int64_t numWaitExclusive{0};
   // Total number of entries that are aged out and beyond TTL.
   int64_t numAgedOut{};
+  // Number of new entries admitted on probation because their keys were not
+  // accessed often enough. See FLAGS_velox_cache_admission_frequency.
+  int64_t numProbation{0};
+  // Number of loaded entries not written to SSD because their keys were not
+  // accessed often enough.
+  int64_t numSsdAdmissionRejects{0};
   // Cumulative clocks spent in allocating or freeing memory for backing cache
   // entries.
   uint64_t allocClocks{0};
@@ -530,10 +551,13 @@ struct CacheStats {
 /// Collection of cache entries whose key hashes to the same shard of
 /// the hash number space.  The cache population is divided into shards
 /// to decrease contention on the mutex for the key to entry mapping
-/// and other housekeeping.
+/// and other housekeeping. Hits on readable entries are served from a
+/// lock-free hit index without taking the mutex.
 class CacheShard {
  public:
-  explicit CacheShard(AsyncDataCache* cache) : cache_(cache) {}
+  explicit CacheShard(AsyncDataCache* cache);
+
+  ~CacheShard();
 
   /// See AsyncDataCache::findOrCreate.
   CachePin findOrCreate(
@@ -597,9 +621,54 @@ class CacheShard {
     return allocClocks_;
   }
 
+  void incrementSsdAdmissionRejects() {
+    ++numSsdAdmissionRejects_;
+  }
+
  private:
   static constexpr uint32_t kMaxFreeEntries = 1 << 10;
   static constexpr int32_t kNoThreshold = std::numeric_limits<int32_t>::max();
+  static constexpr uint32_t kInitialHitIndexSize = 1 << 10;
+
+  // Slot of the hit index. Written under 'mutex_' as a seqlock: 'version' is
+  // odd while the other members change. Read without locks.
+  struct HitSlot {
+    std::atomic<uint64_t> version{0};
+    std::atomic<uint64_t> fileNum{0};
+    std::atomic<uint64_t> offset{0};
+    std::atomic<AsyncDataCacheEntry*> entry{nullptr};
+  };
+
+  // Direct mapped, lossy index from key to entry. A key that is not found
+  // falls back to 'entryMap_' under 'mutex_'. Replaced by a larger index as
+  // 'entryMap_' grows. The old index is freed after an RCU grace period.
+  struct HitIndex {
+    explicit HitIndex(uint32_t size)
+        : mask(size - 1), slots(std::make_unique<HitSlot[]>(size)) {}
+
+    HitSlot& slot(RawFileCacheKey key) const;
+
+    const uint64_t mask;
+    const std::unique_ptr<HitSlot[]> slots;
+  };
+
+  // Returns a shared pin on the entry for 'key' if the hit index has it with
+  // at least 'size' bytes and the entry is neither exclusive nor an unused
+  // prefetch. Returns an empty pin otherwise. Takes no mutex.
+  CachePin findLockFree(RawFileCacheKey key, uint64_t size);
+
+  // Points the hit index slot of 'key' to 'entry'. Grows the index if
+  // 'entryMap_' has outgrown it.
+  void addToHitIndexLocked(RawFileCacheKey key, AsyncDataCacheEntry* entry);
+
+  // Clears the hit index slot of 'key' if it points to 'entry'.
+  void removeFromHitIndexLocked(
+      RawFileCacheKey key,
+      AsyncDataCacheEntry* entry);
+
+  // Moves an unpinned 'entry' to exclusive mode so that it can be removed.
+  // Returns false if the entry got pinned, e.g. by a concurrent lock-free hit.
+  static bool tryClaimLocked(AsyncDataCacheEntry* entry);
 
   void calibrateThreshold();
 
@@ -621,6 +690,8 @@ class CacheShard {
 
   mutable std::mutex mutex_;
   folly::F14FastMap<RawFileCacheKey, AsyncDataCacheEntry*> entryMap_;
+  // Lock-free index over a subset of 'entryMap_'. Replaced under 'mutex_'.
+  std::atomic<HitIndex*> hitIndex_;
   // Entries associated to a key.
   std::deque<std::unique_ptr<AsyncDataCacheEntry>> entries_;
   // Unused indices in 'entries_'.
@@ -635,10 +706,10 @@ class CacheShard {
   uint32_t eventCounter_{0};
   // Maximum retainable entry score(). Anything above this is evictable.
   int32_t evictionThreshold_{kNoThreshold};
-  // Cumulative count of cache hits.
-  uint64_t numHit_{0};
+  // Cumulative count of cache hits. Updated also by lock-free hits.
+  std::atomic<uint64_t> numHit_{0};
   // Sum of bytes in cache hits.
-  uint64_t hitBytes_{0};
+  std::atomic<uint64_t> hitBytes_{0};
   // Cumulative count of hits on entries held in exclusive mode.
   uint64_t numWaitExclusive_{0};
   // Cumulative count of new entry creation.
@@ -656,19 +727,34 @@ class CacheShard {
   // Tracker of time spent in allocating/freeing MemoryAllocator space
   // for backing cached data.
   std::atomic<uint64_t> allocClocks_{0};
+  // Count of new entries admitted on probation. Updated outside 'mutex_'.
+  std::atomic<uint64_t> numProbation_{0};
+  // Count of entries not saved to SSD by admission.
+  std::atomic<uint64_t> numSsdAdmissionRejects_{0};
 };
 
 class AsyncDataCache : public memory::Cache {
  public:
+  /// 'numShards' must be a power of 2. 0 means defaultNumShards().
   AsyncDataCache(
       memory::MemoryAllocator* allocator,
-      std::unique_ptr<SsdCache> ssdCache = nullptr);
+      std::unique_ptr<SsdCache> ssdCache = nullptr,
+      int32_t numShards = 0);
 
   ~AsyncDataCache() override;
 
   static std::shared_ptr<AsyncDataCache> create(
       memory::MemoryAllocator* allocator,
-      std::unique_ptr<SsdCache> ssdCache = nullptr);
+      std::unique_ptr<SsdCache> ssdCache = nullptr,
+      int32_t numShards = 0);
+
+  /// Returns a shard count that scales with the number of cores: a power of 2
+  /// of at least a quarter of the hardware threads, between 4 and 256.
+  static int32_t defaultNumShards();
+
+  int32_t numShards() const {
+    return shards_.size();
+  }
 
   static AsyncDataCache* getInstance();
 
@@ -736,6 +822,25 @@ class AsyncDataCache : public memory::Cache {
     return ssdCache_.get();
   }
 
+  /// Returns the sketch of access frequencies that drives TinyLFU style
+  /// admission, nullptr if admission is off. Scans record the regions they
+  /// access in this through their ScanTracker.
+  const std::shared_ptr<FrequencySketch>& admissionSketch() const {
+    return admissionSketch_;
+  }
+
+  /// True if the data at 'offset' in 'fileNum' has been accessed often enough
+  /// to compete with the cached working set, i.e. to be retained in memory
+  /// and to be written to SSD. Data that is accessed once, e.g. by a large
+  /// scan, is admitted to memory on probation so that it is evicted before
+  /// any entry that has been hit. Always true if admission is off.
+  bool shouldAdmit(uint64_t fileNum, uint64_t offset) const {
+    return admissionSketch_ == nullptr ||
+        admissionSketch_->frequency(
+            FrequencySketch::hashKey(fileNum, offset)) >=
+        FLAGS_velox_cache_admission_frequency;
+  }
+
   /// Updates stats for creation of a new cache entry of 'size' bytes,
   /// i.e. a cache miss. Periodically updates SSD admission criteria,
   /// i.e. reconsider criteria every half cache capacity worth of misses.
@@ -795,8 +900,8 @@ class AsyncDataCache : public memory::Cache {
       folly::F14FastSet<uint64_t>& filesRetained);
 
  private:
-  static constexpr int32_t kNumShards = 4; // Must be power of 2.
-  static constexpr int32_t kShardMask = kNumShards - 1;
+  static constexpr int32_t kMinShards = 4;
+  static constexpr int32_t kMaxShards = 256;
 
   // True if 'acquired' has more pages than 'numPages' or allocator has space
   // for numPages - acquired pages of more allocation.
@@ -810,7 +915,11 @@ class AsyncDataCache : public memory::Cache {
 
   memory::MemoryAllocator* const allocator_;
   std::unique_ptr<SsdCache> ssdCache_;
+  // Set if FLAGS_velox_cache_admission_frequency > 0.
+  std::shared_ptr<FrequencySketch> admissionSketch_;
   std::vector<std::unique_ptr<CacheShard>> shards_;
+  // shards_.size() - 1.
+  int32_t shardMask_;
   std::atomic<int32_t> shardCounter_{0};
   std::atomic<memory::MachinePageCount> cachedPages_{0};
   // Number of pages that are allocated and not yet loaded or loaded
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FrequencySketch.h"
+
+#include <folly/hash/Hash.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::cache {
+namespace {
+// Seeds for deriving the positions of the 4 counters of a key.
+constexpr uint64_t kSeeds[] = {
+    0xc3a5c85c97cb3127ULL,
+    0xb492b66fbe98f273ULL,
+    0x9ae16a3b2f90404fULL,
+    0xcbf29ce484222325ULL};
+
+// Selects the counter in a word when all bits of the word are counters.
+constexpr uint64_t kOneBitPerCounter = 0x1111111111111111ULL;
+} // namespace
+
+FrequencySketch::FrequencySketch(uint64_t expectedEntries)
+    : mask_(bits::nextPowerOfTwo(std::max<uint64_t>(expectedEntries, 64)) - 1),
+      sampleSize_(10 * std::max<uint64_t>(expectedEntries, 64)),
+      table_(new std::atomic<uint64_t>[mask_ + 1]) {
+  clear();
+}
+
+// static
+uint64_t FrequencySketch::hashKey(uint64_t fileNum, uint64_t offset) {
+  return folly::hash::hash_128_to_64(fileNum, offset);
+}
+
+std::pair<uint64_t, int32_t> FrequencySketch::counterPosition(
+    uint64_t hash,
+    int32_t nth) const {
+  const auto mixed = folly::hash::twang_mix64(hash + kSeeds[nth]);
+  // The low bits pick the word and the high 4 bits the counter in the word.
+  return {mixed & mask_, static_cast<int32_t>(mixed >> 60) * 4};
+}
+
+void FrequencySketch::increment(uint64_t hash) {
+  bool added = false;
+  for (auto i = 0; i < kNumHashes; ++i) {
+    const auto [index, shift] = counterPosition(hash, i);
+    auto& word = table_[index];
+    auto value = word.load(std::memory_order_relaxed);
+    while (((value >> shift) & kMaxFrequency) != kMaxFrequency) {
+      if (word.compare_exchange_weak(
+              value, value + (1ULL << shift), std::memory_order_relaxed)) {
+        added = true;
+        break;
+      }
+    }
+  }
+  if (added && ++numIncrements_ >= sampleSize_) {
+    age();
+  }
+}
+
+int32_t FrequencySketch::frequency(uint64_t hash) const {
+  int32_t result = kMaxFrequency;
+  for (auto i = 0; i < kNumHashes; ++i) {
+    const auto [index, shift] = counterPosition(hash, i);
+    const auto value = table_[index].load(std::memory_order_relaxed);
+    result = std::min<int32_t>(result, (value >> shift) & kMaxFrequency);
+  }
+  return result;
+}
+
+void FrequencySketch::age() {
+  // Only the thread that resets the count does the halving.
+  auto count = numIncrements_.load();
+  do {
+    if (count < sampleSize_) {
+      return;
+    }
+  } while (!numIncrements_.compare_exchange_weak(count, count / 2));
+  for (uint64_t i = 0; i <= mask_; ++i) {
+    auto value = table_[i].load(std::memory_order_relaxed);
+    while (!table_[i].compare_exchange_weak(
+        value,
+        (value >> 1) & (kOneBitPerCounter * 7),
+        std::memory_order_relaxed)) {
+    }
+  }
+  ++numAgings_;
+}
+
+void FrequencySketch::clear() {
+  for (uint64_t i = 0; i <= mask_; ++i) {
+    table_[i].store(0, std::memory_order_relaxed);
+  }
+  numIncrements_ = 0;
+}
+
+} // namespace facebook::velox::cache
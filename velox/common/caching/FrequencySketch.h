@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace facebook::velox::cache {
+
+/// Approximate access frequency counter for TinyLFU style cache admission. A
+/// count-min sketch of 4 bit counters, 16 to a 64 bit word. Each key
+/// increments 4 counters in different words and its frequency is the minimum
+/// of these. After 10 increments per expected entry all counters are halved,
+/// so that the sketch follows changes in the working set instead of keeping
+/// the history of the whole run. Thread safe. Concurrent increments may be
+/// lost, which is harmless for an estimate.
+class FrequencySketch {
+ public:
+  static constexpr int32_t kMaxFrequency = 15;
+
+  /// 'expectedEntries' is the number of distinct keys the sketch should
+  /// tell apart, e.g. the number of entries that fit in the cache.
+  explicit FrequencySketch(uint64_t expectedEntries);
+
+  /// Returns a hash for the cache entry at 'offset' in file 'fileNum'.
+  static uint64_t hashKey(uint64_t fileNum, uint64_t offset);
+
+  /// Records an access to the key with 'hash'.
+  void increment(uint64_t hash);
+
+  /// Returns the estimated number of accesses to the key with 'hash' since
+  /// the last halving, at most kMaxFrequency.
+  int32_t frequency(uint64_t hash) const;
+
+  /// Resets all counters to 0.
+  void clear();
+
+  /// Number of times all counters have been halved.
+  uint64_t numAgings() const {
+    return numAgings_;
+  }
+
+  uint64_t numWords() const {
+    return mask_ + 1;
+  }
+
+ private:
+  static constexpr int32_t kNumHashes = 4;
+
+  // Returns the word of 'table_' and the bit offset in the word of the
+  // 'nth' counter for 'hash'.
+  std::pair<uint64_t, int32_t> counterPosition(uint64_t hash, int32_t nth)
+      const;
+
+  // Halves all counters.
+  void age();
+
+  const uint64_t mask_;
+  // Number of increments after which the counters are halved.
+  const uint64_t sampleSize_;
+  const std::unique_ptr<std::atomic<uint64_t>[]> table_;
+  // Increments since the last halving.
+  std::atomic<uint64_t> numIncrements_{0};
+  std::atomic<uint64_t> numAgings_{0};
+};
+
+} // namespace facebook::velox::cache
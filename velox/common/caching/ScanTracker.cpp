@@ -17,6 +17,7 @@
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/FileGroupStats.h"
 
+#include <algorithm>
 #include <sstream>
 
 namespace facebook::velox::cache {
@@ -36,6 +37,24 @@ void ScanTracker::recordReference(
   sum_.incrementReference(bytes, loadQuantum_);
 }
 
+void ScanTracker::recordAccess(
+    uint64_t fileId,
+    uint64_t offset,
+    uint64_t bytes) {
+  if (!admissionSketch_) {
+    return;
+  }
+  if (loadQuantum_ <= 0) {
+    admissionSketch_->increment(FrequencySketch::hashKey(fileId, offset));
+    return;
+  }
+  for (uint64_t quantum = 0; quantum < std::max<uint64_t>(bytes, 1);
+       quantum += loadQuantum_) {
+    admissionSketch_->increment(
+        FrequencySketch::hashKey(fileId, offset + quantum));
+  }
+}
+
 void ScanTracker::recordRead(
     const TrackingId id,
     uint64_t bytes,
@@ -22,6 +22,7 @@
 
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/caching/FrequencySketch.h"
 
 namespace facebook::velox::cache {
 
@@ -114,16 +115,19 @@ class ScanTracker {
   // shared_ptr and will be referenced from a map from id to weak_ptr
   // to 'this'. 'unregisterer' is supplied so that the destructor can
   // remove the weak_ptr from the map of pending trackers. 'loadQuantum' is the
-  // largest single IO size for read.
+  // largest single IO size for read. If 'admissionSketch' is set, the regions
+  // the scan references are counted in it for cache admission.
   ScanTracker(
       std::string_view id,
       std::function<void(ScanTracker* FOLLY_NONNULL)> unregisterer,
       int32_t loadQuantum,
-      FileGroupStats* FOLLY_NULLABLE fileGroupStats = nullptr)
+      FileGroupStats* FOLLY_NULLABLE fileGroupStats = nullptr,
+      std::shared_ptr<FrequencySketch> admissionSketch = nullptr)
       : id_(id),
         unregisterer_(unregisterer),
         loadQuantum_(loadQuantum),
-        fileGroupStats_(fileGroupStats) {}
+        fileGroupStats_(fileGroupStats),
+        admissionSketch_(std::move(admissionSketch)) {}
 
   ~ScanTracker() {
     if (unregisterer_) {
@@ -139,6 +143,12 @@ class ScanTracker {
       uint64_t fileId,
       uint64_t groupId);
 
+  // Records in the cache admission sketch that the scan accesses 'bytes' bytes
+  // at 'offset' in 'fileId'. The region counts once for each load quantum, at
+  // the offsets of the cache entries the region is loaded into. No-op if there
+  // is no admission sketch.
+  void recordAccess(uint64_t fileId, uint64_t offset, uint64_t bytes);
+
   // Records that 'bytes' bytes have actually been read from the stream
   // given by 'id'.
   void recordRead(
@@ -191,6 +201,7 @@ class ScanTracker {
   // size is unlimited.
   const int32_t loadQuantum_;
   FileGroupStats* FOLLY_NULLABLE fileGroupStats_;
+  const std::shared_ptr<FrequencySketch> admissionSketch_;
 };
 
 } // namespace facebook::velox::cache
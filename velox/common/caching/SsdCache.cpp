@@ -16,6 +16,7 @@
 #include "velox/common/caching/SsdCache.h"
 #include <folly/Executor.h>
 #include <folly/portability/SysUio.h>
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/testutil/TestValue.h"
@@ -53,13 +54,33 @@ SsdCache::SsdCache(
   // size.
   uint64_t sizeQuantum = numShards_ * SsdFile::kRegionSize;
   int32_t fileMaxRegions = bits::roundUp(maxBytes, sizeQuantum) / sizeQuantum;
+  // Opening a shard reads its checkpoint, if any. The shards are opened in
+  // parallel on 'executor_' so that a restart with a large cache recovers in
+  // the time of the largest shard.
+  std::vector<std::shared_ptr<AsyncSource<SsdFile>>> openFiles;
+  openFiles.reserve(numShards_);
   for (auto i = 0; i < numShards_; ++i) {
-    files_.push_back(std::make_unique<SsdFile>(
-        fmt::format("{}{}", filePrefix_, i),
-        i,
-        fileMaxRegions,
-        checkpointIntervalBytes / numShards,
-        disableFileCow));
+    // Captures no 'this', the source may outlive a failed constructor.
+    openFiles.push_back(std::make_shared<AsyncSource<SsdFile>>(
+        [prefix = filePrefix_,
+         i,
+         fileMaxRegions,
+         checkpointIntervalBytes,
+         numShards,
+         disableFileCow]() {
+          return std::make_unique<SsdFile>(
+              fmt::format("{}{}", prefix, i),
+              i,
+              fileMaxRegions,
+              checkpointIntervalBytes / numShards,
+              disableFileCow);
+        }));
+    if (executor_ != nullptr) {
+      executor_->add([source = openFiles.back()]() { source->prepare(); });
+    }
+  }
+  for (auto& openFile : openFiles) {
+    files_.push_back(openFile->move());
   }
 }
 
@@ -16,11 +16,13 @@
 
 #include "velox/common/caching/SsdFile.h"
 #include <folly/Executor.h>
+#include <folly/hash/Checksum.h>
 #include <folly/portability/SysUio.h>
 #include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
+#include "velox/common/file/IoUring.h"
 
 #include <fcntl.h>
 #ifdef linux
@@ -79,6 +81,18 @@ void addEntryToIovecs(AsyncDataCacheEntry& entry, std::vector<iovec>& iovecs) {
     };
   }
 }
+
+// Returns the CRC32C of the data of 'entry'.
+uint32_t checksumEntry(AsyncDataCacheEntry& entry) {
+  std::vector<iovec> iovecs;
+  addEntryToIovecs(entry, iovecs);
+  uint32_t checksum = ~0U;
+  for (const auto& iov : iovecs) {
+    checksum = folly::crc32c(
+        reinterpret_cast<const uint8_t*>(iov.iov_base), iov.iov_len, checksum);
+  }
+  return checksum;
+}
 } // namespace
 
 SsdPin::SsdPin(SsdFile& file, SsdRun run) : file_(&file), run_(run) {
@@ -127,6 +141,7 @@ SsdFile::SsdFile(
       maxRegions_(maxRegions),
       shardId_(shardId),
       checkpointIntervalBytes_(checkpointIntervalBytes),
+      checksumEnabled_(checkpointIntervalBytes > 0),
       executor_(executor) {
   int32_t oDirect = 0;
 #ifdef linux
@@ -240,7 +255,9 @@ CoalesceIoStats SsdFile::load(
 
   // Do coalesced IO for the pins. For short payloads, the break-even between
   // discrete pread calls and a single preadv that discards gaps is ~25K per
-  // gap. For longer payloads this is ~50-100K.
+  // gap. For longer payloads this is ~50-100K. If the file reads
+  // asynchronously, all coalesced reads are issued before waiting for any.
+  std::vector<folly::SemiFuture<uint64_t>> pendingReads;
   auto stats = readPins(
       pins,
       payloadTotal / pins.size() < 10000 ? 25000 : 50000,
@@ -254,8 +271,24 @@ CoalesceIoStats SsdFile::load(
           int32_t /*end*/,
           uint64_t offset,
           const std::vector<folly::Range<char*>>& buffers) {
-        read(offset, buffers);
+        if (readFile_->hasPreadvAsync()) {
+          pendingReads.push_back(readFile_->preadvAsync(offset, buffers));
+        } else {
+          read(offset, buffers);
+        }
       });
+  if (!pendingReads.empty()) {
+    // Wait for all reads before failing, the pins must outlive the IO.
+    auto results = folly::collectAll(std::move(pendingReads)).get();
+    for (auto& result : results) {
+      if (result.hasException()) {
+        ++stats_.readSsdErrors;
+        result.throwUnlessValue();
+      }
+    }
+  }
+
+  verifyRecovered(ssdPins, pins);
 
   for (auto i = 0; i < ssdPins.size(); ++i) {
     pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
@@ -263,6 +296,82 @@ CoalesceIoStats SsdFile::load(
   return stats;
 }
 
+void SsdFile::verifyRecovered(
+    const std::vector<SsdPin>& ssdPins,
+    const std::vector<CachePin>& pins) {
+  std::vector<int32_t> verified;
+  std::vector<int32_t> corrupt;
+  for (auto i = 0; i < ssdPins.size(); ++i) {
+    const auto run = ssdPins[i].run();
+    if (!run.needsVerify()) {
+      continue;
+    }
+    if (checksumRun(*pins[i].checkedEntry(), run) == run.checksum()) {
+      verified.push_back(i);
+    } else {
+      corrupt.push_back(i);
+    }
+  }
+  if (verified.empty() && corrupt.empty()) {
+    return;
+  }
+  {
+    std::lock_guard<std::shared_mutex> l(mutex_);
+    // The entry may have been erased or rewritten since it was pinned.
+    const auto findRun = [&](int32_t index) {
+      auto it = entries_.find(pins[index].checkedEntry()->key());
+      if (it != entries_.end() &&
+          it->second.bits() != ssdPins[index].run().bits()) {
+        return entries_.end();
+      }
+      return it;
+    };
+    for (auto index : verified) {
+      auto it = findRun(index);
+      if (it != entries_.end()) {
+        it->second.setVerified();
+      }
+    }
+    for (auto index : corrupt) {
+      auto it = findRun(index);
+      if (it != entries_.end()) {
+        entries_.erase(it);
+      }
+    }
+  }
+  if (!corrupt.empty()) {
+    stats_.readSsdCorruptions += corrupt.size();
+    ++stats_.readSsdErrors;
+    const auto run = ssdPins[corrupt[0]].run();
+    VELOX_FAIL(
+        "IOERR: Checksum mismatch for {} recovered SSD cache entries, first at "
+        "offset {} size {} in {}",
+        corrupt.size(),
+        run.offset(),
+        run.size(),
+        fileName_);
+  }
+}
+
+uint32_t SsdFile::checksumRun(AsyncDataCacheEntry& entry, SsdRun run) {
+  auto checksum = checksumEntry(entry);
+  // The checksum covers the whole run. If 'entry' is a prefix of the run, the
+  // rest is read from the file so that the run is verified on first access.
+  constexpr uint64_t kMaxReadSize = 1 << 20;
+  uint64_t offset = run.offset() + entry.size();
+  const uint64_t end = run.offset() + run.size();
+  std::string buffer;
+  while (offset < end) {
+    const auto readSize = std::min(kMaxReadSize, end - offset);
+    buffer.resize(readSize);
+    const auto data = readFile_->pread(offset, readSize, buffer.data());
+    checksum = folly::crc32c(
+        reinterpret_cast<const uint8_t*>(data.data()), data.size(), checksum);
+    offset += readSize;
+  }
+  return checksum;
+}
+
 void SsdFile::read(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers) {
@@ -382,19 +491,26 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     int32_t numWritten = 0;
     int32_t bytes = 0;
     std::vector<iovec> iovecs;
+    std::vector<uint32_t> checksums;
     for (auto i = storeIndex; i < pins.size(); ++i) {
       auto* entry = pins[i].checkedEntry();
       const auto entrySize = entry->size();
       if (bytes + entrySize > available) {
         break;
       }
+      if (checksumEnabled_) {
+        checksums.push_back(checksumEntry(*entry));
+      }
       addEntryToIovecs(*entry, iovecs);
       bytes += entrySize;
       ++numWritten;
     }
     VELOX_CHECK_GE(fileSize_, offset + bytes);
 
-    const auto rc = folly::pwritev(fd_, iovecs.data(), iovecs.size(), offset);
+    auto* ioUring = IoUring::instance();
+    const auto rc = ioUring != nullptr
+        ? ioUring->pwritev(fd_, iovecs.data(), iovecs.size(), offset)
+        : folly::pwritev(fd_, iovecs.data(), iovecs.size(), offset);
     if (rc != bytes) {
       VELOX_SSD_CACHE_LOG(ERROR)
           << "Failed to write to SSD, file name: " << fileName_
@@ -415,7 +531,8 @@ void SsdFile::write(std::vector<CachePin>& pins) {
         const auto size = entry->size();
         FileCacheKey key = {
             entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
-        entries_[std::move(key)] = SsdRun(offset, size);
+        entries_[std::move(key)] = SsdRun(
+            offset, size, checksumEnabled_ ? checksums[i - storeIndex] : 0);
         if (FLAGS_ssd_verify_write) {
           verifyWrite(*entry, SsdRun(offset, size));
         }
@@ -691,14 +808,17 @@ void SsdFile::checkpoint(bool force) {
     // int32_t The 4 bytes of kCheckpointMagic,
     // int32_t maxRegions,
     // int32_t numRegions,
+    // int32_t 1 if entries have checksums, else 0,
     // regionScores from the 'tracker_',
     // {fileId, fileName} pairs,
     // kMapMarker,
-    // {fileId, offset, SSdRun} triples,
+    // {fileId, offset, SSdRun bits[, checksum]} tuples,
     // kEndMarker.
     state.write(kCheckpointMagic, sizeof(int32_t));
     state.write(asChar(&maxRegions_), sizeof(maxRegions_));
     state.write(asChar(&numRegions_), sizeof(numRegions_));
+    const int32_t hasChecksums = checksumEnabled_;
+    state.write(asChar(&hasChecksums), sizeof(hasChecksums));
 
     // Copy the region scores before writing out for tsan.
     const auto scoresCopy = tracker_.copyScores();
@@ -723,6 +843,10 @@ void SsdFile::checkpoint(bool force) {
       state.write(asChar(&pair.first.offset), sizeof(pair.first.offset));
       auto offsetAndSize = pair.second.bits();
       state.write(asChar(&offsetAndSize), sizeof(offsetAndSize));
+      if (hasChecksums) {
+        const auto checksum = pair.second.checksum();
+        state.write(asChar(&checksum), sizeof(checksum));
+      }
     }
 
     // NOTE: we need to ensure cache file data sync update completes before
@@ -839,9 +963,13 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
       maxRegions_,
       "Trying to start from checkpoint with a different capacity");
   numRegions_ = readNumber<int32_t>(state);
+  const bool hasChecksums = readNumber<int32_t>(state) != 0;
   std::vector<int64_t> scores(maxRegions);
   state.read(asChar(scores.data()), maxRegions_ * sizeof(uint64_t));
   std::unordered_map<uint64_t, StringIdLease> idMap;
+  // Files that could not get their checkpointed id back. SsdCache selects the
+  // shard by file id, so entries of these may be in the wrong shard.
+  std::unordered_set<uint64_t> movedIds;
   for (;;) {
     auto id = readNumber<uint64_t>(state);
     if (id == kCheckpointMapMarker) {
@@ -850,7 +978,13 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
     std::string name;
     name.resize(readNumber<int32_t>(state));
     state.read(name.data(), name.size());
-    auto lease = StringIdLease(fileIds(), name);
+    // Give the file its id from before the restart so that the entries stay
+    // reachable under the same keys and shards.
+    auto lease = StringIdLease(fileIds(), id, name);
+    if (lease.id() != id) {
+      movedIds.insert(id);
+      continue;
+    }
     idMap[id] = std::move(lease);
   }
 
@@ -868,16 +1002,22 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
       break;
     }
     const uint64_t offset = readNumber<uint64_t>(state);
-    const auto run = SsdRun(readNumber<uint64_t>(state));
+    const auto bits = readNumber<uint64_t>(state);
+    const auto run = hasChecksums
+        ? SsdRun::recovered(bits, readNumber<uint32_t>(state))
+        : SsdRun(bits);
     // Check that the recovered entry does not fall in an evicted region.
     if (evictedMap.find(regionIndex(run.offset())) == evictedMap.end()) {
-      // The file may have a different id on restore.
       auto it = idMap.find(fileNum);
-      VELOX_CHECK(it != idMap.end());
+      if (it == idMap.end()) {
+        VELOX_CHECK(movedIds.count(fileNum), "Unknown file id {}", fileNum);
+        continue;
+      }
       FileCacheKey key{it->second, offset};
       entries_[std::move(key)] = run;
     }
   }
+  stats_.entriesRecovered += entries_.size();
   // The state is successfully read. Install the access frequency scores and
   // evicted regions.
   VELOX_CHECK_EQ(scores.size(), tracker_.regionScores().size());
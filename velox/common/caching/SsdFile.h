@@ -29,15 +29,16 @@ namespace facebook::velox::cache {
 
 // A 64 bit word describing a SSD cache entry in an SsdFile. The low
 // 23 bits are the size, for a maximum entry size of 8MB. The high
-// bits are the offset.
+// bits are the offset. If the file keeps checksums, the run also has the
+// CRC32C of the entry's data.
 class SsdRun {
  public:
   static constexpr int32_t kSizeBits = 23;
 
   SsdRun() : bits_(0) {}
 
-  SsdRun(uint64_t offset, uint32_t size)
-      : bits_((offset << kSizeBits) | ((size - 1))) {
+  SsdRun(uint64_t offset, uint32_t size, uint32_t checksum = 0)
+      : bits_((offset << kSizeBits) | ((size - 1))), checksum_(checksum) {
     VELOX_CHECK_LT(offset, 1L << (64 - kSizeBits));
     VELOX_CHECK_LT(size - 1, 1 << kSizeBits);
   }
@@ -49,9 +50,22 @@ class SsdRun {
 
   void operator=(const SsdRun& other) {
     bits_ = other.bits_;
+    checksum_ = other.checksum_;
+    needsVerify_ = other.needsVerify_;
   }
   void operator=(SsdRun&& other) {
     bits_ = other.bits_;
+    checksum_ = other.checksum_;
+    needsVerify_ = other.needsVerify_;
+  }
+
+  // Returns a run recovered from a checkpoint. The data is checked against
+  // 'checksum' on first read.
+  static SsdRun recovered(uint64_t bits, uint32_t checksum) {
+    SsdRun run(bits);
+    run.checksum_ = checksum;
+    run.needsVerify_ = true;
+    return run;
   }
 
   uint64_t offset() const {
@@ -67,8 +81,24 @@ class SsdRun {
     return bits_;
   }
 
+  uint32_t checksum() const {
+    return checksum_;
+  }
+
+  // True if the data has not been read and checked against checksum() since
+  // the run was recovered from a checkpoint.
+  bool needsVerify() const {
+    return needsVerify_;
+  }
+
+  void setVerified() {
+    needsVerify_ = false;
+  }
+
  private:
   uint64_t bits_;
+  uint32_t checksum_{0};
+  bool needsVerify_{false};
 };
 
 // Represents an SsdFile entry that is planned for load or being
@@ -147,6 +177,8 @@ struct SsdCacheStats {
     writeCheckpointErrors = tsanAtomicValue(other.writeCheckpointErrors);
     readSsdErrors = tsanAtomicValue(other.readSsdErrors);
     readCheckpointErrors = tsanAtomicValue(other.readCheckpointErrors);
+    readSsdCorruptions = tsanAtomicValue(other.readSsdCorruptions);
+    entriesRecovered = tsanAtomicValue(other.entriesRecovered);
   }
 
   tsan_atomic<uint64_t> entriesWritten{0};
@@ -169,6 +201,11 @@ struct SsdCacheStats {
   tsan_atomic<uint32_t> writeCheckpointErrors{0};
   tsan_atomic<uint32_t> readSsdErrors{0};
   tsan_atomic<uint32_t> readCheckpointErrors{0};
+  // Count of entries recovered from a checkpoint whose data did not match
+  // their checksum on first read.
+  tsan_atomic<uint32_t> readSsdCorruptions{0};
+  // Count of entries recovered from checkpoint at startup.
+  tsan_atomic<uint64_t> entriesRecovered{0};
 };
 
 // A shard of SsdCache. Corresponds to one file on SSD.  The data
@@ -183,8 +220,10 @@ class SsdFile {
  public:
   static constexpr uint64_t kRegionSize = 1 << 26; // 64MB
 
-  // Constructs a cache backed by filename. Discards any previous
-  // contents of filename.
+  // Constructs a cache backed by filename. If 'checkpointInternalBytes' is
+  // non-0, recovers the entries of the last checkpoint, if any, and keeps a
+  // checksum of each entry so that recovered entries can be verified on first
+  // read. Otherwise discards any previous contents of filename.
   SsdFile(
       const std::string& filename,
       int32_t shardId,
@@ -205,7 +244,9 @@ class SsdFile {
   bool erase(RawFileCacheKey key);
 
   // Copies the data in 'ssdPins' into 'pins'. Coalesces IO for nearby
-  // entries if they are in ascending order and near enough.
+  // entries if they are in ascending order and near enough. Entries recovered
+  // from a checkpoint are checked against their checksum on first read. A
+  // mismatch erases the entry and throws like an IO error.
   CoalesceIoStats load(
       const std::vector<SsdPin>& ssdPins,
       const std::vector<CachePin>& pins);
@@ -271,7 +312,7 @@ class SsdFile {
  private:
   // 4 first bytes of a checkpoint file. Allows distinguishing between format
   // versions.
-  static constexpr const char* kCheckpointMagic = "CPT1";
+  static constexpr const char* kCheckpointMagic = "CPT2";
   // Magic number separating file names from cache entry data in checkpoint
   // file.
   static constexpr int64_t kCheckpointMapMarker = 0xfffffffffffffffe;
@@ -308,6 +349,18 @@ class SsdFile {
   // Verifies that 'entry' has the data at 'run'.
   void verifyWrite(AsyncDataCacheEntry& entry, SsdRun run);
 
+  // Checks the entries of 'pins' that were recovered from a checkpoint and
+  // read for the first time against their checksums. The whole run is checked
+  // even if only a prefix of it was read. Erases the entries that do not match
+  // and throws if there are any.
+  void verifyRecovered(
+      const std::vector<SsdPin>& ssdPins,
+      const std::vector<CachePin>& pins);
+
+  // Returns the checksum of 'run' given that 'entry' holds the data of its
+  // first entry.size() bytes.
+  uint32_t checksumRun(AsyncDataCacheEntry& entry, SsdRun run);
+
   // Deletes checkpoint files. If 'keepLog' is true, truncates and syncs the
   // eviction log and leaves this open.
   void deleteCheckpoint(bool keepLog = false);
@@ -391,6 +444,10 @@ class SsdFile {
   // checkpointing fails.
   int64_t checkpointIntervalBytes_{0};
 
+  // True if entries are written with a checksum. Set if checkpointing is on
+  // at construction, so that entries can be verified after a restart.
+  const bool checksumEnabled_;
+
   // Executor for async fsync in checkpoint.
   folly::Executor* executor_;
 
@@ -48,6 +48,11 @@ class StringIdMap {
   // new id if none exists. must be released with release() when no longer used.
   uint64_t makeId(std::string_view string);
 
+  // Like makeId() but assigns 'id' to a 'string' that has no id, unless 'id'
+  // is already used for another string. Used for restoring ids that were
+  // persisted before a restart.
+  uint64_t recoverId(uint64_t id, std::string_view string);
+
   // Decrements the use count of id and may free the associated memory if no
   // uses remain.
   void release(uint64_t id);
@@ -91,6 +96,11 @@ class StringIdLease {
     ids_->addReference(id_);
   }
 
+  // Makes a lease for 'string' and gives it 'id' if it has no id and 'id' is
+  // free. See StringIdMap::recoverId().
+  StringIdLease(StringIdMap& ids, uint64_t id, std::string_view string)
+      : ids_(&ids), id_(ids_->recoverId(id, string)) {}
+
   StringIdLease(const StringIdLease& other) {
     ids_ = other.ids_;
     id_ = other.id_;
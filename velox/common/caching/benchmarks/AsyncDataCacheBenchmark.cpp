@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/memory/MmapAllocator.h"
+#include "velox/common/time/Timer.h"
+
+DEFINE_int32(threads, 16, "Number of threads doing lookups");
+DEFINE_int32(shards, 0, "Number of cache shards, 0 for the default");
+DEFINE_int32(entries, 100'000, "Number of distinct entries looked up");
+DEFINE_int32(entry_bytes, 8192, "Size of each cache entry");
+DEFINE_int64(lookups, 1'000'000, "Number of lookups per thread");
+DEFINE_int32(files, 100, "Number of distinct files the entries come from");
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+// Measures the throughput and hit rate of AsyncDataCache::findOrCreate() when
+// many threads look up a working set that fits in the cache. A miss loads the
+// entry and makes it shared, so after warm up the run is dominated by hits.
+class AsyncDataCacheBenchmark {
+ public:
+  void run() {
+    const uint64_t workingSetBytes =
+        static_cast<uint64_t>(FLAGS_entries) * FLAGS_entry_bytes;
+    memory::MmapAllocator::Options options;
+    options.capacity = workingSetBytes * 2 + (256 << 20);
+    allocator_ = std::make_shared<memory::MmapAllocator>(options);
+    cache_ = AsyncDataCache::create(allocator_.get(), nullptr, FLAGS_shards);
+    for (auto i = 0; i < FLAGS_files; ++i) {
+      files_.emplace_back(fileIds(), fmt::format("benchmark_file_{}", i));
+    }
+
+    // Warm up single threaded so that the timed part measures hits.
+    runLookups(0, FLAGS_entries, false);
+
+    const auto startStats = cache_->refreshStats();
+    std::vector<std::thread> threads;
+    threads.reserve(FLAGS_threads);
+    uint64_t micros{0};
+    {
+      MicrosecondTimer timer(&micros);
+      for (int32_t i = 0; i < FLAGS_threads; ++i) {
+        threads.emplace_back([this, i]() { runLookups(i, FLAGS_lookups); });
+      }
+      for (auto& thread : threads) {
+        thread.join();
+      }
+    }
+    const auto stats = cache_->refreshStats();
+    const auto numLookups = static_cast<double>(FLAGS_threads) * FLAGS_lookups;
+    const auto numHits = stats.numHit - startStats.numHit;
+    std::cout << fmt::format(
+                     "{} threads, {} shards: {:.2f}M lookups/s, "
+                     "hit rate {:.2f}%, {} ms",
+                     FLAGS_threads,
+                     cache_->numShards(),
+                     numLookups / std::max<uint64_t>(micros, 1),
+                     100.0 * numHits / numLookups,
+                     micros / 1000)
+              << std::endl;
+    std::cout << stats.toString() << std::endl;
+    cache_->shutdown();
+  }
+
+ private:
+  void runLookups(int32_t threadIdx, int64_t numLookups, bool random = true) {
+    folly::Random::DefaultGenerator rng(threadIdx);
+    for (int64_t i = 0; i < numLookups; ++i) {
+      const int32_t n = random ? folly::Random::rand32(FLAGS_entries, rng) : i;
+      RawFileCacheKey key{
+          files_[n % files_.size()].id(),
+          static_cast<uint64_t>(n) * FLAGS_entry_bytes};
+      folly::SemiFuture<bool> wait(false);
+      auto pin = cache_->findOrCreate(key, FLAGS_entry_bytes, &wait);
+      if (pin.empty()) {
+        // Another thread is loading the entry. Count this as a miss.
+        continue;
+      }
+      if (pin.entry()->isExclusive()) {
+        pin.entry()->setExclusiveToShared();
+      }
+    }
+  }
+
+  std::shared_ptr<memory::MmapAllocator> allocator_;
+  std::shared_ptr<AsyncDataCache> cache_;
+  std::vector<StringIdLease> files_;
+};
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  AsyncDataCacheBenchmark().run();
+  return 0;
+}
@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fmt/format.h>
+#include <folly/Random.h>
+#include <folly/container/F14Map.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <list>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/caching/FrequencySketch.h"
+
+DEFINE_string(
+    trace,
+    "",
+    "File with one access per line as '<file number> <offset> <bytes>'. If "
+    "empty, replays a synthetic trace of a hot working set mixed with large "
+    "one-time scans");
+DEFINE_int64(capacity_mb, 256, "Simulated cache capacity");
+DEFINE_int32(admission_frequency, 2, "Minimum frequency for TinyLFU admission");
+DEFINE_int32(hot_entries, 2000, "Synthetic trace: entries in the hot set");
+DEFINE_int32(entry_kb, 64, "Synthetic trace: size of an entry");
+DEFINE_int32(scan_entries, 20000, "Synthetic trace: entries in each scan");
+DEFINE_int32(rounds, 20, "Synthetic trace: rounds of hot accesses and a scan");
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+namespace {
+
+struct Access {
+  uint64_t fileNum;
+  uint64_t offset;
+  uint64_t bytes;
+
+  uint64_t hash() const {
+    return FrequencySketch::hashKey(fileNum, offset);
+  }
+};
+
+std::vector<Access> readTrace(const std::string& path) {
+  std::ifstream in(path);
+  VELOX_CHECK(in.good(), "Cannot open trace {}", path);
+  std::vector<Access> trace;
+  Access access;
+  while (in >> access.fileNum >> access.offset >> access.bytes) {
+    trace.push_back(access);
+  }
+  return trace;
+}
+
+// Each round reads the hot set twice in random order and then scans
+// 'scan_entries' entries that are never read again.
+std::vector<Access> syntheticTrace() {
+  const uint64_t bytes = FLAGS_entry_kb << 10;
+  folly::Random::DefaultGenerator rng(1);
+  std::vector<Access> trace;
+  uint64_t scanFile = 1'000'000;
+  for (auto round = 0; round < FLAGS_rounds; ++round) {
+    for (auto i = 0; i < 2 * FLAGS_hot_entries; ++i) {
+      const auto n = folly::Random::rand32(FLAGS_hot_entries, rng);
+      trace.push_back({n % 100, (n / 100) * bytes, bytes});
+    }
+    ++scanFile;
+    for (auto i = 0; i < FLAGS_scan_entries; ++i) {
+      trace.push_back({scanFile, i * bytes, bytes});
+    }
+  }
+  return trace;
+}
+
+// Replays accesses against a cache of 'capacity' bytes.
+class CachePolicy {
+ public:
+  explicit CachePolicy(uint64_t capacity) : capacity_(capacity) {}
+
+  virtual ~CachePolicy() = default;
+
+  virtual std::string name() const = 0;
+
+  // Returns true on hit. A miss may or may not admit the entry.
+  virtual bool access(const Access& access) = 0;
+
+ protected:
+  const uint64_t capacity_;
+  uint64_t usedBytes_{0};
+};
+
+class LruPolicy : public CachePolicy {
+ public:
+  LruPolicy(uint64_t capacity, std::shared_ptr<FrequencySketch> sketch)
+      : CachePolicy(capacity), sketch_(std::move(sketch)) {}
+
+  std::string name() const override {
+    return sketch_ ? "LRU + TinyLFU" : "LRU";
+  }
+
+  bool access(const Access& access) override {
+    const auto hash = access.hash();
+    if (sketch_) {
+      sketch_->increment(hash);
+    }
+    auto it = map_.find(hash);
+    if (it != map_.end()) {
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return true;
+    }
+    while (usedBytes_ + access.bytes > capacity_ && !lru_.empty()) {
+      // TinyLFU admits the new entry only if it is more frequent than the
+      // entry it would replace.
+      if (sketch_ &&
+          sketch_->frequency(hash) <= sketch_->frequency(lru_.back().hash())) {
+        return false;
+      }
+      usedBytes_ -= lru_.back().bytes;
+      map_.erase(lru_.back().hash());
+      lru_.pop_back();
+    }
+    lru_.push_front(access);
+    map_[hash] = lru_.begin();
+    usedBytes_ += access.bytes;
+    return false;
+  }
+
+ private:
+  const std::shared_ptr<FrequencySketch> sketch_;
+  std::list<Access> lru_;
+  folly::F14FastMap<uint64_t, std::list<Access>::iterator> map_;
+};
+
+// Models CacheShard: a clock goes over the entries and evicts the one with
+// the highest score of time since last use divided by use count among a few
+// candidates. With a sketch, entries not accessed 'admission_frequency' times
+// start on probation with the highest score, like with
+// FLAGS_velox_cache_admission_frequency.
+class ScorePolicy : public CachePolicy {
+ public:
+  ScorePolicy(uint64_t capacity, std::shared_ptr<FrequencySketch> sketch)
+      : CachePolicy(capacity), sketch_(std::move(sketch)) {}
+
+  std::string name() const override {
+    return sketch_ ? "Score + probation" : "Score";
+  }
+
+  bool access(const Access& access) override {
+    ++now_;
+    const auto hash = access.hash();
+    if (sketch_) {
+      sketch_->increment(hash);
+    }
+    auto it = map_.find(hash);
+    if (it != map_.end()) {
+      auto& entry = entries_[it->second];
+      entry.lastUse = now_;
+      ++entry.numUses;
+      return true;
+    }
+    while (usedBytes_ + access.bytes > capacity_ && !map_.empty()) {
+      evictOne();
+    }
+    Entry entry{access, now_, 0};
+    if (sketch_ && sketch_->frequency(hash) < FLAGS_admission_frequency) {
+      entry.lastUse = 0;
+    }
+    int32_t index;
+    if (free_.empty()) {
+      index = entries_.size();
+      entries_.push_back(entry);
+    } else {
+      index = free_.back();
+      free_.pop_back();
+      entries_[index] = entry;
+    }
+    map_[hash] = index;
+    usedBytes_ += access.bytes;
+    return false;
+  }
+
+ private:
+  static constexpr int32_t kNumCandidates = 8;
+
+  struct Entry {
+    Access access;
+    uint64_t lastUse;
+    uint32_t numUses;
+    bool valid{true};
+
+    uint64_t score(uint64_t now) const {
+      return lastUse == 0 ? std::numeric_limits<uint64_t>::max()
+                          : (now - lastUse) / (1 + numUses);
+    }
+  };
+
+  void evictOne() {
+    const auto numCandidates =
+        std::min<size_t>(kNumCandidates, map_.size());
+    int32_t victim = -1;
+    for (size_t checked = 0; checked < numCandidates;) {
+      hand_ = (hand_ + 1) % entries_.size();
+      if (!entries_[hand_].valid) {
+        continue;
+      }
+      ++checked;
+      if (victim < 0 ||
+          entries_[hand_].score(now_) > entries_[victim].score(now_)) {
+        victim = static_cast<int32_t>(hand_);
+      }
+    }
+    auto& entry = entries_[victim];
+    usedBytes_ -= entry.access.bytes;
+    map_.erase(entry.access.hash());
+    entry.valid = false;
+    free_.push_back(victim);
+  }
+
+  const std::shared_ptr<FrequencySketch> sketch_;
+  std::vector<Entry> entries_;
+  std::vector<int32_t> free_;
+  folly::F14FastMap<uint64_t, int32_t> map_;
+  uint64_t now_{0};
+  size_t hand_{0};
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  const auto trace =
+      FLAGS_trace.empty() ? syntheticTrace() : readTrace(FLAGS_trace);
+  const uint64_t capacity = FLAGS_capacity_mb << 20;
+  // Sized like AsyncDataCache sizes its admission sketch.
+  const uint64_t sketchEntries = std::max<uint64_t>(4096, capacity >> 16);
+
+  std::vector<std::unique_ptr<CachePolicy>> policies;
+  policies.push_back(std::make_unique<LruPolicy>(capacity, nullptr));
+  policies.push_back(std::make_unique<LruPolicy>(
+      capacity, std::make_shared<FrequencySketch>(sketchEntries)));
+  policies.push_back(std::make_unique<ScorePolicy>(capacity, nullptr));
+  policies.push_back(std::make_unique<ScorePolicy>(
+      capacity, std::make_shared<FrequencySketch>(sketchEntries)));
+
+  uint64_t totalBytes = 0;
+  for (const auto& access : trace) {
+    totalBytes += access.bytes;
+  }
+  std::cout << fmt::format(
+                   "{} accesses, {} MB, cache {} MB",
+                   trace.size(),
+                   totalBytes >> 20,
+                   FLAGS_capacity_mb)
+            << std::endl;
+  for (auto& policy : policies) {
+    uint64_t hits = 0;
+    uint64_t hitBytes = 0;
+    for (const auto& access : trace) {
+      if (policy->access(access)) {
+        ++hits;
+        hitBytes += access.bytes;
+      }
+    }
+    std::cout << fmt::format(
+                     "{:<20} hit rate {:6.2f}% byte hit rate {:6.2f}%",
+                     policy->name(),
+                     100.0 * hits / std::max<size_t>(trace.size(), 1),
+                     100.0 * hitBytes / std::max<uint64_t>(totalBytes, 1))
+              << std::endl;
+  }
+  return 0;
+}
@@ -29,6 +29,7 @@
 
 #include <folly/executors/IOThreadPoolExecutor.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
+#include <folly/Random.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 
@@ -89,7 +90,10 @@ class AsyncDataCacheTest : public testing::Test {
     }
   }
 
-  void initializeCache(uint64_t maxBytes, int64_t ssdBytes = 0) {
+  void initializeCache(
+      uint64_t maxBytes,
+      int64_t ssdBytes = 0,
+      int32_t numShards = 0) {
     if (cache_ != nullptr) {
       cache_->shutdown();
     }
@@ -119,7 +123,8 @@ class AsyncDataCacheTest : public testing::Test {
     options.trackDefaultUsage = true;
     manager_ = std::make_unique<memory::MemoryManager>(options);
     allocator_ = static_cast<memory::MmapAllocator*>(manager_->allocator());
-    cache_ = AsyncDataCache::create(allocator_, std::move(ssdCache));
+    cache_ =
+        AsyncDataCache::create(allocator_, std::move(ssdCache), numShards);
     if (filenames_.empty()) {
       for (auto i = 0; i < kNumFiles; ++i) {
         auto name = fmt::format("testing_file_{}", i);
@@ -861,7 +866,7 @@ TEST_F(AsyncDataCacheTest, cacheStats) {
       "Cache size: 2.56KB tinySize: 257B large size: 2.31KB\n"
       "Cache entries: 100 read pins: 30 write pins: 20 pinned shared: 10.00MB pinned exclusive: 10.00MB\n"
       " num write wait: 244 empty entries: 20\n"
-      "Cache access miss: 2041 hit: 46 hit bytes: 1.34KB eviction: 463 eviction checks: 348 aged out: 10\n"
+      "Cache access miss: 2041 hit: 46 hit bytes: 1.34KB eviction: 463 eviction checks: 348 aged out: 10 probation: 0 ssd admission rejects: 0\n"
       "Prefetch entries: 30 bytes: 100B\n"
       "Alloc Megaclocks 0");
 
@@ -873,7 +878,7 @@ TEST_F(AsyncDataCacheTest, cacheStats) {
       "Cache size: 0B tinySize: 0B large size: 0B\n"
       "Cache entries: 0 read pins: 0 write pins: 0 pinned shared: 0B pinned exclusive: 0B\n"
       " num write wait: 0 empty entries: 0\n"
-      "Cache access miss: 0 hit: 0 hit bytes: 0B eviction: 0 eviction checks: 0 aged out: 0\n"
+      "Cache access miss: 0 hit: 0 hit bytes: 0B eviction: 0 eviction checks: 0 aged out: 0 probation: 0 ssd admission rejects: 0\n"
       "Prefetch entries: 0 bytes: 0B\n"
       "Alloc Megaclocks 0\n"
       "Allocated pages: 0 cached pages: 0\n"
@@ -897,13 +902,135 @@ TEST_F(AsyncDataCacheTest, cacheStats) {
       "Cache size: 0B tinySize: 0B large size: 0B\n"
       "Cache entries: 0 read pins: 0 write pins: 0 pinned shared: 0B pinned exclusive: 0B\n"
       " num write wait: 0 empty entries: 0\n"
-      "Cache access miss: 0 hit: 0 hit bytes: 0B eviction: 0 eviction checks: 0 aged out: 0\n"
+      "Cache access miss: 0 hit: 0 hit bytes: 0B eviction: 0 eviction checks: 0 aged out: 0 probation: 0 ssd admission rejects: 0\n"
       "Prefetch entries: 0 bytes: 0B\n"
       "Alloc Megaclocks 0\n"
       "Allocated pages: 0 cached pages: 0\n";
   ASSERT_EQ(cache_->toString(false), expectedShortCacheOutput);
 }
 
+TEST_F(AsyncDataCacheTest, numShards) {
+  initializeCache(16 << 20, 0, 16);
+  EXPECT_EQ(cache_->numShards(), 16);
+  initializeCache(16 << 20);
+  EXPECT_EQ(cache_->numShards(), AsyncDataCache::defaultNumShards());
+  EXPECT_GE(cache_->numShards(), 4);
+  EXPECT_LE(cache_->numShards(), 256);
+  VELOX_ASSERT_THROW(
+      initializeCache(16 << 20, 0, 12),
+      "Number of shards must be a power of 2");
+}
+
+TEST_F(AsyncDataCacheTest, admission) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_cache_admission_frequency = 2;
+  constexpr int32_t kSize = 16 << 10;
+  initializeCache(64 << 20, 512 << 20);
+  const auto& sketch = cache_->admissionSketch();
+  ASSERT_NE(sketch, nullptr);
+
+  auto load = [&](RawFileCacheKey key) {
+    auto pin = cache_->findOrCreate(key, kSize);
+    EXPECT_TRUE(pin.entry()->isExclusive());
+    initializeContents(key.fileNum + key.offset, pin.entry()->data());
+    pin.entry()->setExclusiveToShared();
+    return pin;
+  };
+
+  // A key seen once is admitted on probation and is not saved to SSD.
+  const RawFileCacheKey coldKey{filenames_[0].id(), 0};
+  sketch->increment(FrequencySketch::hashKey(coldKey.fileNum, coldKey.offset));
+  auto pin = load(coldKey);
+  EXPECT_TRUE(pin.entry()->isEvictable());
+  EXPECT_FALSE(pin.entry()->ssdSaveable());
+  pin.clear();
+  auto stats = cache_->refreshStats();
+  EXPECT_EQ(stats.numProbation, 1);
+  EXPECT_EQ(stats.numSsdAdmissionRejects, 1);
+
+  // A hit takes the entry off probation.
+  pin = cache_->findOrCreate(coldKey, kSize);
+  EXPECT_TRUE(pin.entry()->isShared());
+  EXPECT_FALSE(pin.entry()->isEvictable());
+  pin.clear();
+
+  // A key seen as often as the admission frequency is admitted normally.
+  const RawFileCacheKey hotKey{filenames_[1].id(), 0};
+  for (auto i = 0; i < 2; ++i) {
+    sketch->increment(FrequencySketch::hashKey(hotKey.fileNum, hotKey.offset));
+  }
+  pin = load(hotKey);
+  EXPECT_FALSE(pin.entry()->isEvictable());
+  EXPECT_TRUE(pin.entry()->ssdSaveable());
+  pin.clear();
+  stats = cache_->refreshStats();
+  EXPECT_EQ(stats.numProbation, 1);
+  EXPECT_EQ(stats.numSsdAdmissionRejects, 1);
+
+  // Without the flag there is no admission.
+  FLAGS_velox_cache_admission_frequency = 0;
+  initializeCache(64 << 20);
+  EXPECT_EQ(cache_->admissionSketch(), nullptr);
+  pin = load(RawFileCacheKey{filenames_[2].id(), 0});
+  EXPECT_FALSE(pin.entry()->isEvictable());
+}
+
+TEST_F(AsyncDataCacheTest, lockFreeHits) {
+  constexpr int32_t kNumEntries = 1000;
+  constexpr int32_t kSize = 8192;
+  constexpr int32_t kNumThreads = 16;
+  constexpr int32_t kNumLookups = 20000;
+  initializeCache(64 << 20, 0, 16);
+
+  auto populate = [&]() {
+    for (int32_t i = 0; i < kNumEntries; ++i) {
+      RawFileCacheKey key{filenames_[i % kNumFiles].id(), i * 100'000UL};
+      auto pin = cache_->findOrCreate(key, kSize);
+      if (pin.empty() || !pin.entry()->isExclusive()) {
+        continue;
+      }
+      initializeContents(key.fileNum + key.offset, pin.entry()->data());
+      pin.entry()->setExclusiveToShared();
+    }
+  };
+  populate();
+  const auto hitsBefore = cache_->refreshStats().numHit;
+
+  // Readers hit the entries concurrently while the last thread periodically
+  // clears the cache, so that lock-free pins race with eviction.
+  std::atomic<int64_t> numChecked{0};
+  runThreads(kNumThreads, [&](int32_t threadIdx) {
+    folly::Random::DefaultGenerator rng(threadIdx);
+    for (int32_t i = 0; i < kNumLookups; ++i) {
+      if (threadIdx == kNumThreads - 1 && i % 2000 == 0) {
+        cache_->clear();
+        continue;
+      }
+      const int32_t n = folly::Random::rand32(kNumEntries, rng);
+      RawFileCacheKey key{filenames_[n % kNumFiles].id(), n * 100'000UL};
+      folly::SemiFuture<bool> wait(false);
+      auto pin = cache_->findOrCreate(key, kSize, &wait);
+      if (pin.empty()) {
+        continue;
+      }
+      if (pin.entry()->isExclusive()) {
+        initializeContents(key.fileNum + key.offset, pin.entry()->data());
+        pin.entry()->setExclusiveToShared();
+        continue;
+      }
+      ASSERT_EQ(pin.entry()->key().fileNum.id(), key.fileNum);
+      ASSERT_EQ(pin.entry()->offset(), key.offset);
+      checkContents(*pin.entry());
+      ++numChecked;
+    }
+  });
+  EXPECT_GT(numChecked, 0);
+  const auto stats = cache_->refreshStats();
+  EXPECT_GE(stats.numHit - hitsBefore, numChecked);
+  EXPECT_EQ(stats.numExclusive, 0);
+  EXPECT_EQ(stats.numShared, 0);
+}
+
 TEST_F(AsyncDataCacheTest, shrinkCache) {
   constexpr uint64_t kRamBytes = 128UL << 20;
   constexpr uint64_t kSsdBytes = 512UL << 20;
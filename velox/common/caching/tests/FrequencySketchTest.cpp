@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FrequencySketch.h"
+#include "velox/common/caching/ScanTracker.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::cache;
+
+TEST(FrequencySketchTest, basic) {
+  FrequencySketch sketch(1000);
+  const auto hot = FrequencySketch::hashKey(1, 0);
+  const auto warm = FrequencySketch::hashKey(1, 1000);
+  for (auto i = 0; i < 5; ++i) {
+    sketch.increment(hot);
+  }
+  sketch.increment(warm);
+  EXPECT_GE(sketch.frequency(hot), 5);
+  EXPECT_GE(sketch.frequency(warm), 1);
+  EXPECT_LT(sketch.frequency(warm), sketch.frequency(hot));
+
+  // Keys that have not been seen are estimated at 0 unless all their counters
+  // collide with other keys.
+  int32_t numNonZero = 0;
+  for (auto i = 0; i < 1000; ++i) {
+    numNonZero += sketch.frequency(FrequencySketch::hashKey(2, i)) > 0;
+  }
+  EXPECT_LT(numNonZero, 10);
+
+  for (auto i = 0; i < 100; ++i) {
+    sketch.increment(hot);
+  }
+  EXPECT_EQ(sketch.frequency(hot), FrequencySketch::kMaxFrequency);
+
+  sketch.clear();
+  EXPECT_EQ(sketch.frequency(hot), 0);
+  EXPECT_EQ(sketch.frequency(warm), 0);
+}
+
+TEST(FrequencySketchTest, aging) {
+  constexpr int32_t kExpectedEntries = 100;
+  FrequencySketch sketch(kExpectedEntries);
+  const auto old = FrequencySketch::hashKey(1, 0);
+  for (auto i = 0; i < 12; ++i) {
+    sketch.increment(old);
+  }
+  EXPECT_GE(sketch.frequency(old), 12);
+  // A stream of distinct keys halves the counts of the old working set.
+  for (auto i = 0; i < 10 * kExpectedEntries; ++i) {
+    sketch.increment(FrequencySketch::hashKey(2, i));
+  }
+  EXPECT_EQ(sketch.numAgings(), 1);
+  EXPECT_LE(sketch.frequency(old), 7);
+  EXPECT_GE(sketch.frequency(old), 6);
+}
+
+TEST(FrequencySketchTest, scanTracker) {
+  constexpr int32_t kLoadQuantum = 1000;
+  auto sketch = std::make_shared<FrequencySketch>(1000);
+  ScanTracker tracker("scan", nullptr, kLoadQuantum, nullptr, sketch);
+  // A region of 2.5 load quanta is loaded into 3 cache entries.
+  tracker.recordAccess(1, 10'000, 2'500);
+  tracker.recordAccess(1, 10'000, 2'500);
+  for (auto offset : {10'000, 11'000, 12'000}) {
+    EXPECT_EQ(sketch->frequency(FrequencySketch::hashKey(1, offset)), 2);
+  }
+  EXPECT_EQ(sketch->frequency(FrequencySketch::hashKey(1, 13'000)), 0);
+
+  // Without a sketch the access is not recorded anywhere.
+  ScanTracker noSketch("scan2", nullptr, kLoadQuantum);
+  noSketch.recordAccess(1, 20'000, 100);
+}
@@ -14,11 +14,13 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
+#include <fcntl.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
@@ -58,7 +60,8 @@ class SsdFileTest : public testing::Test {
   void initializeCache(
       int64_t maxBytes,
       int64_t ssdBytes = 0,
-      bool setNoCowFlag = false) {
+      bool setNoCowFlag = false,
+      int64_t checkpointIntervalBytes = 0) {
     // tmpfs does not support O_DIRECT, so turn this off for testing.
     FLAGS_ssd_odirect = false;
     cache_ = AsyncDataCache::create(memory::memoryManager()->allocator());
@@ -66,14 +69,28 @@ class SsdFileTest : public testing::Test {
     fileName_ = StringIdLease(fileIds(), "fileInStorage");
 
     tempDirectory_ = exec::test::TempDirectoryPath::create();
+    openSsdFile(ssdBytes, setNoCowFlag, checkpointIntervalBytes);
+  }
+
+  // Creates 'ssdFile_' over the file in 'tempDirectory_'. If checkpointing is
+  // on, recovers the entries of the previous checkpoint of the same file.
+  void openSsdFile(
+      int64_t ssdBytes,
+      bool setNoCowFlag = false,
+      int64_t checkpointIntervalBytes = 0) {
+    ssdFile_.reset();
     ssdFile_ = std::make_unique<SsdFile>(
-        fmt::format("{}/ssdtest", tempDirectory_->path),
+        ssdPath(),
         0, // shardId
         bits::roundUp(ssdBytes, SsdFile::kRegionSize) / SsdFile::kRegionSize,
-        0, // checkpointInternalBytes
+        checkpointIntervalBytes,
         setNoCowFlag);
   }
 
+  std::string ssdPath() const {
+    return fmt::format("{}/ssdtest", tempDirectory_->path);
+  }
+
   static void initializeContents(int64_t sequence, memory::Allocation& alloc) {
     bool first = true;
     for (int32_t i = 0; i < alloc.numRuns(); ++i) {
@@ -304,6 +321,76 @@ TEST_F(SsdFileTest, writeAndRead) {
   }
 }
 
+TEST_F(SsdFileTest, recoverFromCheckpoint) {
+  constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
+  // The interval is large enough that only the explicit checkpoint is taken.
+  initializeCache(128 * kMB, kSsdSize, false, kSsdSize);
+  std::vector<TestEntry> entries;
+  {
+    auto pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 32 * kMB);
+    ssdFile_->write(pins);
+    for (auto& pin : pins) {
+      ASSERT_EQ(ssdFile_.get(), pin.entry()->ssdFile());
+      entries.emplace_back(
+          pin.entry()->key(), pin.entry()->ssdOffset(), pin.entry()->size());
+    }
+  }
+  ASSERT_GT(entries.size(), 2);
+  ssdFile_->checkpoint(true);
+
+  // Overwrite the start of the first entry and the end of the second entry on
+  // disk. Their checksums no longer match.
+  ASSERT_GT(entries[1].size, 128);
+  {
+    const auto fd = ::open(ssdPath().c_str(), O_WRONLY);
+    ASSERT_GE(fd, 0);
+    const std::string garbage(64, 'x');
+    ASSERT_EQ(
+        garbage.size(),
+        ::pwrite(fd, garbage.data(), garbage.size(), entries[0].ssdOffset));
+    ASSERT_EQ(
+        garbage.size(),
+        ::pwrite(
+            fd,
+            garbage.data(),
+            garbage.size(),
+            entries[1].ssdOffset + entries[1].size - garbage.size()));
+    ::close(fd);
+  }
+
+  openSsdFile(kSsdSize, false, kSsdSize);
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  EXPECT_EQ(entries.size(), stats.entriesRecovered);
+
+  // Drop the memory cache so that all reads come from SSD.
+  cache_->clear();
+  for (auto i = 0; i < entries.size(); ++i) {
+    const RawFileCacheKey key{fileName_.id(), entries[i].key.offset};
+    std::vector<CachePin> pins;
+    // The second entry is read with a prefix that does not cover the
+    // corrupted bytes.
+    const auto size = i == 1 ? entries[i].size / 2 : entries[i].size;
+    pins.push_back(cache_->findOrCreate(key, size, nullptr));
+    ASSERT_TRUE(pins.back().entry()->isExclusive());
+    std::vector<SsdPin> ssdPins;
+    ssdPins.push_back(ssdFile_->find(key));
+    ASSERT_FALSE(ssdPins.back().empty());
+    if (i < 2) {
+      VELOX_ASSERT_THROW(ssdFile_->load(ssdPins, pins), "Checksum mismatch");
+      ssdPins.clear();
+      // The corrupt entry is dropped and the next access goes to storage.
+      EXPECT_TRUE(ssdFile_->find(key).empty());
+      continue;
+    }
+    ssdFile_->load(ssdPins, pins);
+    checkContents(pins[0].entry()->data(), pins[0].entry()->size());
+  }
+  stats = SsdCacheStats();
+  ssdFile_->updateStats(stats);
+  EXPECT_EQ(2, stats.readSsdCorruptions);
+}
+
 #ifdef VELOX_SSD_FILE_TEST_SET_NO_COW_FLAG
 TEST_F(SsdFileTest, disabledCow) {
   LOG(ERROR) << "here";
@@ -53,3 +53,18 @@ TEST(StringIdMapTest, rehash) {
     EXPECT_EQ(ids[i].id(), StringIdLease(map, name).id());
   }
 }
+
+TEST(StringIdMapTest, recoverId) {
+  StringIdMap map;
+  StringIdLease recovered(map, 100, "file_1");
+  EXPECT_EQ(recovered.id(), 100);
+  EXPECT_EQ(map.string(100), "file_1");
+  // A string with an id keeps it.
+  EXPECT_EQ(StringIdLease(map, 200, "file_1").id(), 100);
+  // An id in use for another string is not reused.
+  StringIdLease other(map, 100, "file_2");
+  EXPECT_NE(other.id(), 100);
+  // New ids are above the recovered ones.
+  EXPECT_GT(other.id(), 100);
+  EXPECT_GT(StringIdLease(map, "file_3").id(), 100);
+}
@@ -16,6 +16,7 @@
 
 #include "velox/common/file/File.h"
 #include "velox/common/base/Fs.h"
+#include "velox/common/file/IoUring.h"
 
 #include <fmt/format.h>
 #include <glog/logging.h>
@@ -205,6 +206,23 @@ uint64_t LocalReadFile::preadv(
   return totalBytesRead;
 }
 
+folly::SemiFuture<uint64_t> LocalReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  auto* ioUring = IoUring::instance();
+  if (ioUring == nullptr) {
+    return ReadFile::preadvAsync(offset, buffers);
+  }
+  for (const auto& range : buffers) {
+    bytesRead_ += range.size();
+  }
+  return ioUring->preadv(fd_, offset, buffers);
+}
+
+bool LocalReadFile::hasPreadvAsync() const {
+  return IoUring::instance() != nullptr;
+}
+
 uint64_t LocalReadFile::size() const {
   return size_;
 }
@@ -217,10 +235,36 @@ uint64_t LocalReadFile::memoryUsage() const {
   return sizeof(FILE);
 }
 
+namespace {
+// Writes 'iovecs' to 'fd' at 'offset' through 'ioUring'. Returns the number of
+// bytes written.
+uint64_t appendWithIoUring(
+    IoUring& ioUring,
+    int32_t fd,
+    uint64_t offset,
+    const std::vector<struct iovec>& iovecs) {
+  uint64_t bytesToWrite{0};
+  for (const auto& iov : iovecs) {
+    bytesToWrite += iov.iov_len;
+  }
+  const auto bytesWritten =
+      ioUring.pwritev(fd, iovecs.data(), iovecs.size(), offset);
+  VELOX_CHECK_EQ(
+      bytesWritten,
+      bytesToWrite,
+      "io_uring write failure in LocalWriteFile::append, {} vs {}: {}",
+      bytesWritten,
+      bytesToWrite,
+      folly::errnoStr(errno));
+  return bytesToWrite;
+}
+} // namespace
+
 LocalWriteFile::LocalWriteFile(
     std::string_view path,
     bool shouldCreateParentDirectories,
-    bool shouldThrowOnFileAlreadyExists) {
+    bool shouldThrowOnFileAlreadyExists,
+    bool useIoUring) {
   auto dir = fs::path(path).parent_path();
   if (shouldCreateParentDirectories && !fs::exists(dir)) {
     VELOX_CHECK(
@@ -240,6 +284,27 @@ LocalWriteFile::LocalWriteFile(
           path);
     }
   }
+  ioUring_ = useIoUring ? IoUring::instance() : nullptr;
+  if (ioUring_ != nullptr) {
+    // Opens for appending like fopen() below. The writes are positioned so
+    // O_APPEND is not set.
+    fd_ = open(buf.get(), O_WRONLY | O_CREAT | O_CLOEXEC, 0666);
+    VELOX_CHECK_GE(
+        fd_,
+        0,
+        "open failure in LocalWriteFile constructor, {} {}.",
+        path,
+        folly::errnoStr(errno));
+    const auto size = lseek(fd_, 0, SEEK_END);
+    VELOX_CHECK_GE(
+        size,
+        0,
+        "lseek failure in LocalWriteFile constructor, {} {}.",
+        path,
+        folly::errnoStr(errno));
+    size_ = size;
+    return;
+  }
   auto* file = fopen(buf.get(), "ab");
   VELOX_CHECK_NOT_NULL(
       file,
@@ -261,6 +326,14 @@ LocalWriteFile::~LocalWriteFile() {
 
 void LocalWriteFile::append(std::string_view data) {
   VELOX_CHECK(!closed_, "file is closed");
+  if (ioUring_ != nullptr) {
+    size_ += appendWithIoUring(
+        *ioUring_,
+        fd_,
+        size_,
+        {{const_cast<char*>(data.data()), data.size()}});
+    return;
+  }
   const uint64_t bytesWritten = fwrite(data.data(), 1, data.size(), file_);
   VELOX_CHECK_EQ(
       bytesWritten,
@@ -273,6 +346,18 @@ void LocalWriteFile::append(std::string_view data) {
 
 void LocalWriteFile::append(std::unique_ptr<folly::IOBuf> data) {
   VELOX_CHECK(!closed_, "file is closed");
+  if (ioUring_ != nullptr) {
+    // Writes the whole chain with one vectored write.
+    std::vector<struct iovec> iovecs;
+    for (auto range : *data) {
+      if (!range.empty()) {
+        iovecs.push_back(
+            {const_cast<uint8_t*>(range.data()), range.size()});
+      }
+    }
+    size_ += appendWithIoUring(*ioUring_, fd_, size_, iovecs);
+    return;
+  }
   uint64_t totalBytesWritten{0};
   for (auto rangeIter = data->begin(); rangeIter != data->end(); ++rangeIter) {
     const auto bytesToWrite = rangeIter->size();
@@ -298,6 +383,10 @@ void LocalWriteFile::append(std::unique_ptr<folly::IOBuf> data) {
 
 void LocalWriteFile::flush() {
   VELOX_CHECK(!closed_, "file is closed");
+  if (ioUring_ != nullptr) {
+    // The appends are not buffered in user space.
+    return;
+  }
   auto ret = fflush(file_);
   VELOX_CHECK_EQ(
       ret,
@@ -307,6 +396,15 @@ void LocalWriteFile::flush() {
 }
 
 void LocalWriteFile::close() {
+  if (!closed_ && ioUring_ != nullptr) {
+    closed_ = true;
+    VELOX_CHECK_EQ(
+        ::close(fd_),
+        0,
+        "close failure in LocalWriteFile::close: {}.",
+        folly::errnoStr(errno));
+    return;
+  }
   if (!closed_) {
     auto ret = fclose(file_);
     VELOX_CHECK_EQ(
@@ -319,6 +417,9 @@ void LocalWriteFile::close() {
 }
 
 uint64_t LocalWriteFile::size() const {
+  if (ioUring_ != nullptr) {
+    return size_;
+  }
   return ftell(file_);
 }
 } // namespace facebook::velox
@@ -41,6 +41,8 @@
 
 namespace facebook::velox {
 
+class IoUring;
+
 // A read-only file.  All methods in this object should be thread safe.
 class ReadFile {
  public:
@@ -246,6 +248,14 @@ class LocalReadFile final : public ReadFile {
       uint64_t offset,
       const std::vector<folly::Range<char*>>& buffers) const final;
 
+  // Reads through the process-wide io_uring if available. Ranges with nullptr
+  // data are skipped without reading.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  bool hasPreadvAsync() const final;
+
   uint64_t memoryUsage() const final;
 
   bool shouldCoalesce() const final {
@@ -275,11 +285,15 @@ class LocalReadFile final : public ReadFile {
 class LocalWriteFile final : public WriteFile {
  public:
   // An error is thrown is a file already exists at |path|,
-  // unless flag shouldThrowOnFileAlreadyExists is false
+  // unless flag shouldThrowOnFileAlreadyExists is false. If 'useIoUring' is
+  // true and the process-wide io_uring is available, the appends are written
+  // through the ring without user space buffering. Each append is then one
+  // vectored write which is complete when the append returns.
   explicit LocalWriteFile(
       std::string_view path,
       bool shouldCreateParentDirectories = false,
-      bool shouldThrowOnFileAlreadyExists = true);
+      bool shouldThrowOnFileAlreadyExists = true,
+      bool useIoUring = false);
   ~LocalWriteFile();
 
   void append(std::string_view data) final;
@@ -289,8 +303,13 @@ class LocalWriteFile final : public WriteFile {
   uint64_t size() const final;
 
  private:
-  FILE* FOLLY_NONNULL file_;
-  mutable long size_;
+  // Null if writing through 'ioUring_'.
+  FILE* file_{nullptr};
+  // Set if writing through the ring, in which case 'fd_' is the file and
+  // 'size_' is its size.
+  IoUring* ioUring_{nullptr};
+  int32_t fd_{-1};
+  uint64_t size_{0};
   bool closed_{false};
 };
 
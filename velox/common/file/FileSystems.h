@@ -43,6 +43,9 @@ struct FileOptions {
 
   std::unordered_map<std::string, std::string> values;
   memory::MemoryPool* pool{nullptr};
+  /// If true, a local file is written through the process-wide io_uring if it
+  /// is available. Ignored by the other file systems.
+  bool useIoUring{false};
 };
 
 /// An abstract FileSystem
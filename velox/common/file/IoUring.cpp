@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUring.h"
+
+#include <folly/String.h>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <climits>
+#include <system_error>
+
+#include "velox/common/base/Exceptions.h"
+
+DEFINE_bool(
+    velox_io_uring,
+    true,
+    "Use io_uring for local file IO if Velox is built with io_uring support");
+DEFINE_int32(
+    velox_io_uring_queue_depth,
+    256,
+    "Number of submission queue entries of the process-wide io_uring");
+
+namespace facebook::velox {
+
+// static
+IoUring* IoUring::instance() {
+  static const std::unique_ptr<IoUring> instance = FLAGS_velox_io_uring
+      ? create(FLAGS_velox_io_uring_queue_depth)
+      : nullptr;
+  return instance.get();
+}
+
+#ifdef VELOX_ENABLE_IO_URING
+
+// static
+std::unique_ptr<IoUring> IoUring::create(uint32_t queueDepth) {
+  std::unique_ptr<IoUring> ioUring(new IoUring());
+  const auto rc = io_uring_queue_init(queueDepth, &ioUring->ring_, 0);
+  if (rc < 0) {
+    LOG(WARNING) << "io_uring is unavailable, falling back to synchronous IO: "
+                 << folly::errnoStr(-rc);
+    return nullptr;
+  }
+  ioUring->completionThread_ =
+      std::thread([ptr = ioUring.get()]() { ptr->reapCompletions(); });
+  return ioUring;
+}
+
+IoUring::~IoUring() {
+  {
+    // A nop without user data tells the completion thread to stop.
+    std::lock_guard<std::mutex> l(mutex_);
+    auto* sqe = io_uring_get_sqe(&ring_);
+    while (sqe == nullptr) {
+      io_uring_submit(&ring_);
+      sqe = io_uring_get_sqe(&ring_);
+    }
+    io_uring_prep_nop(sqe);
+    io_uring_sqe_set_data(sqe, nullptr);
+    io_uring_submit(&ring_);
+  }
+  completionThread_.join();
+  io_uring_queue_exit(&ring_);
+}
+
+folly::SemiFuture<uint64_t> IoUring::preadv(
+    int32_t fd,
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) {
+  auto request = std::make_unique<Request>();
+  std::vector<uint64_t> offsets;
+  std::vector<struct iovec>* iovecs = nullptr;
+  for (const auto& range : buffers) {
+    if (range.data() == nullptr) {
+      request->bytes += range.size();
+      offset += range.size();
+      iovecs = nullptr;
+      continue;
+    }
+    if (iovecs == nullptr || iovecs->size() >= static_cast<size_t>(IOV_MAX)) {
+      offsets.push_back(offset);
+      iovecs = &request->iovecs.emplace_back();
+    }
+    iovecs->push_back({range.data(), range.size()});
+    offset += range.size();
+  }
+  auto future = request->promise.getSemiFuture();
+  submit(fd, false, std::move(request), offsets);
+  return future;
+}
+
+ssize_t IoUring::pwritev(
+    int32_t fd,
+    const struct iovec* iovecs,
+    int32_t numIovecs,
+    uint64_t offset) {
+  auto request = std::make_unique<Request>();
+  std::vector<uint64_t> offsets;
+  for (auto i = 0; i < numIovecs; i += IOV_MAX) {
+    offsets.push_back(offset);
+    const auto end = std::min<int32_t>(numIovecs, i + IOV_MAX);
+    request->iovecs.emplace_back(iovecs + i, iovecs + end);
+    for (auto j = i; j < end; ++j) {
+      offset += iovecs[j].iov_len;
+    }
+  }
+  auto future = request->promise.getSemiFuture();
+  submit(fd, true, std::move(request), offsets);
+  auto result = std::move(future).getTry();
+  if (result.hasException()) {
+    auto* error = result.tryGetExceptionObject<std::system_error>();
+    errno = error != nullptr ? error->code().value() : EIO;
+    return -1;
+  }
+  return result.value();
+}
+
+void IoUring::submit(
+    int32_t fd,
+    bool write,
+    std::unique_ptr<Request> request,
+    const std::vector<uint64_t>& offsets) {
+  if (request->iovecs.empty()) {
+    request->promise.setValue(request->bytes);
+    return;
+  }
+  request->numPending = request->iovecs.size();
+  // The completion thread owns the request from here on.
+  auto* rawRequest = request.release();
+  std::lock_guard<std::mutex> l(mutex_);
+  for (size_t i = 0; i < rawRequest->iovecs.size(); ++i) {
+    auto* sqe = io_uring_get_sqe(&ring_);
+    while (sqe == nullptr) {
+      // The submission queue is full. Hand the queued entries to the kernel.
+      io_uring_submit(&ring_);
+      sqe = io_uring_get_sqe(&ring_);
+    }
+    const auto& iovecs = rawRequest->iovecs[i];
+    if (write) {
+      io_uring_prep_writev(sqe, fd, iovecs.data(), iovecs.size(), offsets[i]);
+    } else {
+      io_uring_prep_readv(sqe, fd, iovecs.data(), iovecs.size(), offsets[i]);
+    }
+    io_uring_sqe_set_data(sqe, rawRequest);
+  }
+  numSubmitted_ += rawRequest->iovecs.size();
+  io_uring_submit(&ring_);
+}
+
+void IoUring::reapCompletions() {
+  for (;;) {
+    struct io_uring_cqe* cqe;
+    const auto rc = io_uring_wait_cqe(&ring_, &cqe);
+    if (rc < 0) {
+      if (rc == -EINTR) {
+        continue;
+      }
+      LOG(FATAL) << "io_uring_wait_cqe failed: " << folly::errnoStr(-rc);
+    }
+    auto* request = static_cast<Request*>(io_uring_cqe_get_data(cqe));
+    const auto result = cqe->res;
+    io_uring_cqe_seen(&ring_, cqe);
+    if (request == nullptr) {
+      return;
+    }
+    if (result < 0) {
+      request->error = -result;
+    } else {
+      request->bytes += result;
+    }
+    if (--request->numPending > 0) {
+      continue;
+    }
+    std::unique_ptr<Request> finished(request);
+    if (finished->error != 0) {
+      finished->promise.setException(std::system_error(
+          finished->error,
+          std::system_category(),
+          "io_uring read or write failed"));
+    } else {
+      finished->promise.setValue(finished->bytes);
+    }
+  }
+}
+
+#else
+
+// static
+std::unique_ptr<IoUring> IoUring::create(uint32_t /*queueDepth*/) {
+  return nullptr;
+}
+
+IoUring::~IoUring() = default;
+
+folly::SemiFuture<uint64_t> IoUring::preadv(
+    int32_t /*fd*/,
+    uint64_t /*offset*/,
+    const std::vector<folly::Range<char*>>& /*buffers*/) {
+  VELOX_UNREACHABLE("Velox is built without io_uring support");
+}
+
+ssize_t IoUring::pwritev(
+    int32_t /*fd*/,
+    const struct iovec* /*iovecs*/,
+    int32_t /*numIovecs*/,
+    uint64_t /*offset*/) {
+  VELOX_UNREACHABLE("Velox is built without io_uring support");
+}
+
+#endif
+
+} // namespace facebook::velox
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <sys/uio.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <folly/Range.h>
+#include <folly/futures/Future.h>
+
+#ifdef VELOX_ENABLE_IO_URING
+#include <liburing.h>
+#endif
+
+namespace facebook::velox {
+
+/// Submits local file reads and writes through an io_uring. Submissions from
+/// any thread are added to the submission queue under a mutex and a
+/// background thread reaps completions and fulfills the futures. All IO of a
+/// single call is submitted with one io_uring_enter. Only available when built
+/// with VELOX_ENABLE_IO_URING and when the kernel allows creating a ring.
+/// Callers fall back to the synchronous system calls otherwise.
+class IoUring {
+ public:
+  /// Returns the process-wide ring or nullptr if io_uring is not compiled in,
+  /// is disabled with --velox_io_uring=false or cannot be created.
+  static IoUring* instance();
+
+  /// Creates a ring with 'queueDepth' submission queue entries. Returns
+  /// nullptr if io_uring is unavailable.
+  static std::unique_ptr<IoUring> create(uint32_t queueDepth);
+
+  ~IoUring();
+
+  /// Reads from 'fd' at 'offset' into 'buffers'. The buffers are filled left
+  /// to right. A buffer with nullptr data skips its size worth of bytes
+  /// without reading them. Each run of consecutive non-null buffers becomes
+  /// one read request. Returns the number of bytes read plus the number of
+  /// bytes skipped. The memory referenced by 'buffers' must stay valid until
+  /// the future completes.
+  folly::SemiFuture<uint64_t> preadv(
+      int32_t fd,
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers);
+
+  /// Writes 'iovecs' to 'fd' at 'offset' and waits for completion. Has the
+  /// same contract as ::pwritev: returns the number of bytes written or -1
+  /// with errno set.
+  ssize_t pwritev(
+      int32_t fd,
+      const struct iovec* iovecs,
+      int32_t numIovecs,
+      uint64_t offset);
+
+  /// Number of read and write requests submitted since creation.
+  uint64_t numSubmitted() const {
+    return numSubmitted_;
+  }
+
+ private:
+  // A read or write call split into one or more submission queue entries.
+  struct Request {
+    folly::Promise<uint64_t> promise;
+    // Backing storage for the iovecs of the entries. Must outlive the IO.
+    std::vector<std::vector<struct iovec>> iovecs;
+    // Bytes added to the result without IO, e.g. skipped ranges of a read.
+    uint64_t bytes{0};
+    int32_t numPending{0};
+    int32_t error{0};
+  };
+
+  IoUring() = default;
+
+  // Submits the entries of 'request'. One entry per element of
+  // 'request->iovecs'. 'offsets' has the file offset of each element.
+  void submit(
+      int32_t fd,
+      bool write,
+      std::unique_ptr<Request> request,
+      const std::vector<uint64_t>& offsets);
+
+  // Reaps completions until the ring is shut down.
+  void reapCompletions();
+
+  std::mutex mutex_;
+#ifdef VELOX_ENABLE_IO_URING
+  struct io_uring ring_;
+#endif
+  std::thread completionThread_;
+  std::atomic<uint64_t> numSubmitted_{0};
+};
+
+} // namespace facebook::velox
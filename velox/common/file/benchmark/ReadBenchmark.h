@@ -46,7 +46,7 @@ DECLARE_int32(measurement_size);
 
 namespace facebook::velox {
 
-enum class Mode { Pread = 0, Preadv = 1, Multiple = 2 };
+enum class Mode { Pread = 0, Preadv = 1, Multiple = 2, PreadvAsync = 3 };
 
 // Struct to read data into. If we read contiguous and then copy to
 // non-contiguous buffers, we read to 'buffer' and copy to
@@ -152,7 +152,8 @@ class ReadBenchmark {
       globalScratch.bufferCopy.resize(rangeSize);
       for (auto repeat = 0; repeat < repeats; ++repeat) {
         std::unique_ptr<folly::Promise<bool>> promise;
-        if (parallel) {
+        // Async reads are issued from this thread and need no executor.
+        if (parallel && mode != Mode::PreadvAsync) {
           auto [tempPromise, future] = folly::makePromiseContract<bool>();
           promise = std::make_unique<folly::Promise<bool>>();
           *promise = std::move(tempPromise);
@@ -256,6 +257,27 @@ class ReadBenchmark {
             }
             break;
           }
+          case Mode::PreadvAsync: {
+            // io_uring if available, otherwise the synchronous preadv.
+            label = readFile_->hasPreadvAsync() ? "1 preadvAsync"
+                                                : "1 preadvAsync (sync)";
+            std::vector<folly::Range<char*>> ranges;
+            for (auto start = 0; start < rangeSize; start += size + gap) {
+              ranges.push_back(folly::Range<char*>(
+                  globalScratch.buffer.data() + start, size));
+              if (gap && start + gap < rangeSize) {
+                ranges.push_back(folly::Range<char*>(nullptr, gap));
+              }
+            }
+            auto future = readFile_->preadvAsync(offset, ranges);
+            if (parallel) {
+              futures.push_back(
+                  std::move(future).deferValue([](uint64_t) { return true; }));
+            } else {
+              std::move(future).get();
+            }
+            break;
+          }
         }
       }
       if (parallel) {
@@ -289,6 +311,8 @@ class ReadBenchmark {
     randomReads(size, gap, count, repeats, Mode::Pread, true);
     randomReads(size, gap, count, repeats, Mode::Preadv, true);
     randomReads(size, gap, count, repeats, Mode::Multiple, true);
+    randomReads(size, gap, count, repeats, Mode::PreadvAsync, false);
+    randomReads(size, gap, count, repeats, Mode::PreadvAsync, true);
   }
 
   void run();
@@ -139,6 +139,51 @@ TEST(LocalFile, writeAndRead) {
   }
 }
 
+TEST(LocalFile, writeWithIoUring) {
+  // Writes through io_uring if available and falls back to buffered writes
+  // otherwise.
+  for (bool useIOBuf : {true, false}) {
+    auto tempFile = ::exec::test::TempFilePath::create();
+    const auto& filename = tempFile->path.c_str();
+    remove(filename);
+    {
+      LocalWriteFile writeFile(filename, false, true, true);
+      writeData(&writeFile, useIOBuf);
+      writeFile.flush();
+      ASSERT_EQ(writeFile.size(), 15 + kOneMB);
+    }
+    LocalReadFile readFile(filename);
+    readData(&readFile);
+  }
+}
+
+TEST(LocalFile, preadvAsync) {
+  auto tempFile = ::exec::test::TempFilePath::create();
+  const auto& filename = tempFile->path.c_str();
+  remove(filename);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile, true);
+  }
+  LocalReadFile readFile(filename);
+  char head[12];
+  char middle[4];
+  char tail[7];
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head, sizeof(head)),
+      folly::Range<char*>(nullptr, (char*)(uint64_t)500000),
+      folly::Range<char*>(middle, sizeof(middle)),
+      folly::Range<char*>(
+          nullptr,
+          (char*)(uint64_t)(15 + kOneMB - 500000 - sizeof(head) -
+                            sizeof(middle) - sizeof(tail))),
+      folly::Range<char*>(tail, sizeof(tail))};
+  ASSERT_EQ(15 + kOneMB, readFile.preadvAsync(0, buffers).get());
+  ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbbcc");
+  ASSERT_EQ(std::string_view(middle, sizeof(middle)), "cccc");
+  ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ccddddd");
+}
+
 TEST(LocalFile, viaRegistry) {
   filesystems::registerLocalFileSystem();
   auto tempFile = ::exec::test::TempFilePath::create();
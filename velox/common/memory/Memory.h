@@ -105,6 +105,12 @@ struct MemoryManagerOptions {
   /// NOTE: this only applies for MmapAllocator.
   int32_t mmapArenaCapacityRatio{10};
 
+  /// If true, keeps size classes per NUMA node of this machine and serves
+  /// allocations from the node of the calling thread.
+  ///
+  /// NOTE: this only applies for MmapAllocator.
+  bool numaAwareMmapAllocator{false};
+
   /// If not zero, reserve 'smallAllocationReservePct'% of space from
   /// 'allocatorCapacity' for ad hoc small allocations. And those allocations
   /// are delegated to std::malloc. If 'maxMallocBytes' is 0, this value will be
@@ -32,9 +32,18 @@ MmapAllocator::MmapAllocator(const Options& options)
               : options.capacity * options.smallAllocationReservePct / 100),
       capacity_(bits::roundUp(
           AllocationTraits::numPages(options.capacity - mallocReservedBytes_),
-          64 * sizeClassSizes_.back())) {
-  for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+          64 * sizeClassSizes_.back())),
+      numaTopology_(
+          options.numaTopology != nullptr &&
+                  options.numaTopology->numNodes() > 1
+              ? options.numaTopology
+              : nullptr),
+      numNumaNodes_(numaTopology_ != nullptr ? numaTopology_->numNodes() : 1) {
+  for (auto node = 0; node < numNumaNodes_; ++node) {
+    for (const auto& size : sizeClassSizes_) {
+      sizeClasses_.push_back(std::make_unique<SizeClass>(
+          capacity_ / size, size, numaTopology_ != nullptr ? node : -1));
+    }
   }
 
   if (useMmapArena_) {
@@ -114,14 +123,15 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
     }
   }
   MachinePageCount newMapsNeeded = 0;
+  const auto numaNode = currentNumaNode();
   for (int i = 0; i < mix.numSizes; ++i) {
     bool success;
     stats_.recordAllocate(
         AllocationTraits::pageBytes(sizeClassSizes_[mix.sizeIndices[i]]),
         mix.sizeCounts[i],
         [&]() {
-          success = sizeClasses_[mix.sizeIndices[i]]->allocate(
-              mix.sizeCounts[i], newMapsNeeded, out);
+          success = sizeClass(numaNode, mix.sizeIndices[i])
+                        .allocate(mix.sizeCounts[i], newMapsNeeded, out);
         });
     if (success && ((i > 0) || (mix.numSizes == 1)) &&
         testingHasInjectedFailure(InjectedFailure::kAllocate)) {
@@ -224,7 +234,7 @@ MachinePageCount MmapAllocator::freeNonContiguousInternal(
       // pages in the class. Note that size class indices in the
       // allocator are not necessarily the same as in the stats.
       const auto sizeIndex =
-          Stats::sizeIndex(AllocationTraits::pageBytes(sizeClassSizes_[i]));
+          Stats::sizeIndex(AllocationTraits::pageBytes(sizeClass->unitSize()));
       stats_.sizes[sizeIndex].freeClocks += clocks;
     }
     numFreed += pages;
@@ -395,6 +405,12 @@ bool MmapAllocator::allocateContiguousImpl(
           MAP_PRIVATE | MAP_ANONYMOUS,
           -1,
           0);
+      if (numaTopology_ != nullptr && data != MAP_FAILED && data != nullptr) {
+        // Best effort. Without the policy, the pages are backed on the node of
+        // the thread that first touches them.
+        NumaTopology::preferNode(
+            data, AllocationTraits::pageBytes(maxPages), currentNumaNode());
+      }
     }
   }
   // TODO: add handling of MAP_FAILED.
@@ -570,20 +586,37 @@ void MmapAllocator::markAllMapped(const Allocation& allocation) {
 
 MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   MachinePageCount numAway = 0;
-  for (int32_t i = sizeClasses_.size() - 1; i >= 0; --i) {
-    numAway += sizeClasses_[i]->adviseAway(target - numAway);
-    if (numAway >= target) {
-      break;
+  // Advises away the largest size classes first, over all nodes.
+  for (int32_t i = sizeClassSizes_.size() - 1; i >= 0; --i) {
+    for (auto node = 0; node < numNumaNodes_; ++node) {
+      numAway += sizeClass(node, i).adviseAway(target - numAway);
+      if (numAway >= target) {
+        numAdvisedPages_ += numAway;
+        return numAway;
+      }
     }
   }
   numAdvisedPages_ += numAway;
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+int32_t MmapAllocator::testingNumaNodeOf(void* address) const {
+  for (auto& sizeClass : sizeClasses_) {
+    if (sizeClass->isInRange(reinterpret_cast<uint8_t*>(address))) {
+      return std::max(0, sizeClass->numaNode());
+    }
+  }
+  return -1;
+}
+
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    int32_t numaNode)
     : capacity_(capacity),
       unitSize_(unitSize),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
+      numaNode_(numaNode),
       pageBitmapSize_(capacity_ / 64),
       // Min 8 words + 1 bit for every 512 bits in 'pageAllocated_'.
       mappedFreeLookup_((capacity_ / kPagesPerLookupBit / 64) + kSimdTail),
@@ -609,6 +642,11 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
         unitSize_);
   }
   address_ = reinterpret_cast<uint8_t*>(ptr);
+  if (numaNode_ >= 0 && !NumaTopology::preferNode(ptr, byteSize_, numaNode_)) {
+    const auto error = folly::errnoStr(errno);
+    VELOX_MEM_LOG(WARNING) << "Could not prefer NUMA node " << numaNode_
+                           << " for sizeClass " << unitSize_ << ": " << error;
+  }
 }
 
 MmapAllocator::SizeClass::~SizeClass() {
@@ -674,7 +712,11 @@ std::string MmapAllocator::SizeClass::toString() const {
           __builtin_popcountll(~pageAllocated_[i] & pageMapped_[i]);
     }
     auto mb = (AllocationTraits::pageBytes(count * unitSize_)) >> 20;
-    out << "[size " << unitSize_ << ": " << count << "(" << mb
+    out << "[size " << unitSize_;
+    if (numaNode_ >= 0) {
+      out << " node " << numaNode_;
+    }
+    out << ": " << count << "(" << mb
         << "MB) allocated " << mappedCount << " mapped";
     if (mappedFreeCount != numMappedFreePages_) {
       out << "Mismatched count of mapped free pages "
@@ -28,6 +28,7 @@
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/common/memory/MemoryPool.h"
 #include "velox/common/memory/MmapArena.h"
+#include "velox/common/memory/NumaTopology.h"
 
 namespace facebook::velox::memory {
 
@@ -47,6 +48,13 @@ using ClassPageCount = int32_t;
 /// mmap of the requested size (ContiguousAllocation). Small contiguous memory
 /// allocations less than 3/4 of smallest size class are still delegated to
 /// malloc.
+///
+/// If NUMA aware, there is a set of size classes for each NUMA node, each set
+/// with the address range for the whole capacity. An allocation is made from
+/// the set of the node of the calling thread and is backed by memory of that
+/// node while the node has free memory. The capacity applies to the total over
+/// all nodes. Mapped free pages of any node can be advised away to make room
+/// for an allocation on another node.
 class MmapAllocator : public MemoryAllocator {
  public:
   struct Options {
@@ -62,6 +70,11 @@ class MmapAllocator : public MemoryAllocator {
     /// capacity to single MmapArena capacity ratio.
     int32_t mmapArenaCapacityRatio = 10;
 
+    /// If set and with more than one node, keeps size classes per NUMA node
+    /// and prefers memory of the calling thread's node for allocations. Does
+    /// not apply to allocations served from the ManagedMmapArenas.
+    std::shared_ptr<const NumaTopology> numaTopology;
+
     /// If not zero, reserve 'smallAllocationReservePct'% of space from
     /// 'capacity' for ad hoc small allocations. And those allocations are
     /// delegated to std::malloc.
@@ -150,6 +163,16 @@ class MmapAllocator : public MemoryAllocator {
     return numMallocBytes_;
   }
 
+  /// Returns the number of NUMA nodes with their own size classes. 1 if not
+  /// NUMA aware.
+  int32_t numNumaNodes() const {
+    return numNumaNodes_;
+  }
+
+  /// Returns the NUMA node of the size class that contains 'address' or -1 if
+  /// 'address' is not in a size class.
+  int32_t testingNumaNodeOf(void* address) const;
+
   Stats stats() const override {
     auto stats = stats_;
     stats.numAdvise = numAdvisedPages_;
@@ -165,7 +188,9 @@ class MmapAllocator : public MemoryAllocator {
   // 'unitSize_' machine pages.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    // If 'numaNode' is not -1, the address range prefers memory of
+    // 'numaNode'.
+    SizeClass(size_t capacity, MachinePageCount unitSize, int32_t numaNode);
 
     ~SizeClass();
 
@@ -173,6 +198,10 @@ class MmapAllocator : public MemoryAllocator {
       return unitSize_;
     }
 
+    int32_t numaNode() const {
+      return numaNode_;
+    }
+
     // Allocates 'numPages' from 'this' and appends these to *out.
     // '*numUnmapped' is incremented by the number of pages that are not backed
     // by memory.
@@ -273,6 +302,10 @@ class MmapAllocator : public MemoryAllocator {
     // Size in bytes of the address range.
     const size_t byteSize_;
 
+    // NUMA node preferred for backing the address range. -1 if not NUMA
+    // aware.
+    const int32_t numaNode_;
+
     // Number of meaningful words in 'pageAllocated_'/'pageMapped'. The arrays
     // themselves are padded with extra zeros for SIMD access.
     const int32_t pageBitmapSize_;
@@ -373,6 +406,16 @@ class MmapAllocator : public MemoryAllocator {
 
   bool useMalloc(uint64_t bytes);
 
+  // Returns the size class with 'index' in 'sizeClassSizes_' for 'numaNode'.
+  SizeClass& sizeClass(int32_t numaNode, int32_t index) {
+    return *sizeClasses_[numaNode * sizeClassSizes_.size() + index];
+  }
+
+  // Returns the node whose size classes serve the calling thread.
+  int32_t currentNumaNode() const {
+    return numNumaNodes_ == 1 ? 0 : numaTopology_->currentNode();
+  }
+
   const Kind kind_;
 
   // If set true, allocations larger than the largest size class size will be
@@ -409,6 +452,14 @@ class MmapAllocator : public MemoryAllocator {
   // to std::malloc().
   const MachinePageCount capacity_ = 0;
 
+  // Set if NUMA aware.
+  const std::shared_ptr<const NumaTopology> numaTopology_;
+
+  // Number of nodes in 'numaTopology_', 1 if not NUMA aware.
+  const int32_t numNumaNodes_;
+
+  // The size classes of node 0 followed by those of node 1 and so on, each in
+  // the order of 'sizeClassSizes_'.
   std::vector<std::unique_ptr<SizeClass>> sizeClasses_;
 
   // Statistics.
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/memory/NumaTopology.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <fmt/format.h>
+#include <folly/Conv.h>
+#include <folly/String.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::memory {
+namespace {
+#ifdef __linux__
+// From <linux/mempolicy.h>.
+constexpr int kMpolPreferred = 1;
+
+std::string readLine(const std::string& path) {
+  std::ifstream in(path);
+  std::string line;
+  if (in.is_open()) {
+    std::getline(in, line);
+  }
+  return line;
+}
+
+// Node ids may have gaps. A node that is not online gets no CPUs.
+std::shared_ptr<const NumaTopology> readSystemTopology() {
+  const auto nodes =
+      NumaTopology::parseCpuList(readLine("/sys/devices/system/node/online"));
+  if (nodes.empty()) {
+    return nullptr;
+  }
+  std::vector<std::vector<int32_t>> nodeCpus(
+      *std::max_element(nodes.begin(), nodes.end()) + 1);
+  for (auto node : nodes) {
+    nodeCpus[node] = NumaTopology::parseCpuList(readLine(
+        fmt::format("/sys/devices/system/node/node{}/cpulist", node)));
+  }
+  return std::make_shared<NumaTopology>(std::move(nodeCpus));
+}
+#endif
+} // namespace
+
+NumaTopology::NumaTopology(std::vector<std::vector<int32_t>> nodeCpus)
+    : nodeCpus_(std::move(nodeCpus)) {
+  VELOX_CHECK(!nodeCpus_.empty(), "A NUMA topology needs at least one node");
+  for (auto node = 0; node < nodeCpus_.size(); ++node) {
+    for (auto cpu : nodeCpus_[node]) {
+      VELOX_CHECK_GE(cpu, 0);
+      if (cpu >= cpuToNode_.size()) {
+        cpuToNode_.resize(cpu + 1, 0);
+      }
+      cpuToNode_[cpu] = node;
+    }
+  }
+}
+
+// static
+std::shared_ptr<const NumaTopology> NumaTopology::system() {
+  static const std::shared_ptr<const NumaTopology> kSystem = []() {
+    std::shared_ptr<const NumaTopology> topology;
+#ifdef __linux__
+    topology = readSystemTopology();
+#endif
+    if (topology == nullptr) {
+      std::vector<int32_t> cpus(
+          std::max(1U, std::thread::hardware_concurrency()));
+      for (auto i = 0; i < cpus.size(); ++i) {
+        cpus[i] = i;
+      }
+      topology = std::make_shared<NumaTopology>(
+          std::vector<std::vector<int32_t>>{std::move(cpus)});
+    }
+    return topology;
+  }();
+  return kSystem;
+}
+
+// static
+std::vector<int32_t> NumaTopology::parseCpuList(const std::string& cpuList) {
+  std::vector<int32_t> cpus;
+  std::vector<folly::StringPiece> ranges;
+  folly::split(',', folly::trimWhitespace(cpuList), ranges);
+  for (auto range : ranges) {
+    if (range.empty()) {
+      continue;
+    }
+    const auto dash = range.find('-');
+    if (dash == folly::StringPiece::npos) {
+      cpus.push_back(folly::to<int32_t>(range));
+      continue;
+    }
+    const auto first = folly::to<int32_t>(range.subpiece(0, dash));
+    const auto last = folly::to<int32_t>(range.subpiece(dash + 1));
+    for (auto cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+int32_t NumaTopology::currentNode() const {
+  if (nodeCpus_.size() == 1) {
+    return 0;
+  }
+#ifdef __linux__
+  return nodeOfCpu(sched_getcpu());
+#else
+  return 0;
+#endif
+}
+
+bool NumaTopology::bindCurrentThread(int32_t node) const {
+  if (node < 0 || node >= nodeCpus_.size() || nodeCpus_[node].empty()) {
+    return false;
+  }
+#ifdef __linux__
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  for (auto cpu : nodeCpus_[node]) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &cpus);
+    }
+  }
+  return ::sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+#else
+  return false;
+#endif
+}
+
+// static
+bool NumaTopology::preferNode(void* address, uint64_t size, int32_t node) {
+#ifdef __linux__
+  constexpr int32_t kBitsPerWord = 8 * sizeof(unsigned long);
+  std::vector<unsigned long> mask(node / kBitsPerWord + 1);
+  mask[node / kBitsPerWord] = 1UL << (node % kBitsPerWord);
+  // The kernel reads 'maxnode' - 1 bits of the mask.
+  return ::syscall(
+             SYS_mbind,
+             address,
+             size,
+             kMpolPreferred,
+             mask.data(),
+             mask.size() * kBitsPerWord + 1,
+             0) == 0;
+#else
+  return false;
+#endif
+}
+
+std::string NumaTopology::toString() const {
+  std::stringstream out;
+  out << "NumaTopology[" << nodeCpus_.size() << " nodes";
+  for (auto node = 0; node < nodeCpus_.size(); ++node) {
+    out << " " << node << ": " << nodeCpus_[node].size() << " cpus";
+  }
+  out << "]";
+  return out.str();
+}
+
+} // namespace facebook::velox::memory
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace facebook::velox::memory {
+
+/// CPUs of each NUMA node of the machine. Nodes are numbered as in the kernel.
+/// A node may have no CPUs, e.g. a memory-only node.
+class NumaTopology {
+ public:
+  /// 'nodeCpus[i]' is the list of CPUs of node i.
+  explicit NumaTopology(std::vector<std::vector<int32_t>> nodeCpus);
+
+  /// Returns the topology of this machine, read once from sysfs. If this is
+  /// not available, e.g. on non-Linux systems, returns a single node with all
+  /// CPUs.
+  static std::shared_ptr<const NumaTopology> system();
+
+  /// Parses a sysfs CPU or node list like "0-3,8,10-11".
+  static std::vector<int32_t> parseCpuList(const std::string& cpuList);
+
+  int32_t numNodes() const {
+    return nodeCpus_.size();
+  }
+
+  const std::vector<int32_t>& cpus(int32_t node) const {
+    return nodeCpus_[node];
+  }
+
+  /// Returns the node of 'cpu'. Returns 0 for an unknown CPU.
+  int32_t nodeOfCpu(int32_t cpu) const {
+    return cpu >= 0 && cpu < static_cast<int32_t>(cpuToNode_.size())
+        ? cpuToNode_[cpu]
+        : 0;
+  }
+
+  /// Returns the node of the CPU the calling thread runs on. The thread may
+  /// migrate at any time, so this is a placement hint only.
+  int32_t currentNode() const;
+
+  /// Restricts the calling thread to the CPUs of 'node'. Returns false if
+  /// 'node' has no CPUs or the affinity could not be set.
+  bool bindCurrentThread(int32_t node) const;
+
+  /// Sets the memory policy of the 'size' bytes at 'address' to prefer
+  /// 'node'. Pages that are not yet backed by memory, including pages that
+  /// are advised away later, are backed from 'node' while it has free memory
+  /// and from the other nodes after that. Returns false if the policy could
+  /// not be set.
+  static bool preferNode(void* address, uint64_t size, int32_t node);
+
+  std::string toString() const;
+
+ private:
+  const std::vector<std::vector<int32_t>> nodeCpus_;
+  std::vector<int32_t> cpuToNode_;
+};
+
+} // namespace facebook::velox::memory
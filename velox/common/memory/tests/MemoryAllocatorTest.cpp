@@ -15,6 +15,7 @@
  */
 #include "velox/common/memory/MemoryAllocator.h"
 #include <fstream>
+#include <numeric>
 #include <thread>
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/memory/AllocationPool.h"
@@ -1888,4 +1889,58 @@ TEST_P(MemoryAllocatorTest, unmap) {
     ASSERT_EQ(instance_->unmap(numAllocated), 0);
   }
 }
+
+TEST(NumaTopologyTest, parseCpuList) {
+  EXPECT_TRUE(NumaTopology::parseCpuList("").empty());
+  EXPECT_TRUE(NumaTopology::parseCpuList("\n").empty());
+  EXPECT_EQ(std::vector<int32_t>{3}, NumaTopology::parseCpuList("3\n"));
+  EXPECT_EQ(
+      (std::vector<int32_t>{0, 1, 2, 3, 8, 10, 11}),
+      NumaTopology::parseCpuList("0-3,8,10-11"));
+
+  NumaTopology topology({{0, 2}, {}, {1, 3}});
+  EXPECT_EQ(3, topology.numNodes());
+  EXPECT_EQ(0, topology.nodeOfCpu(2));
+  EXPECT_EQ(2, topology.nodeOfCpu(3));
+  // Unknown CPUs are on node 0.
+  EXPECT_EQ(0, topology.nodeOfCpu(100));
+  EXPECT_GE(NumaTopology::system()->numNodes(), 1);
+}
+
+TEST(MmapAllocatorNumaTest, allocateOnCurrentNode) {
+  // All CPUs are on node 1, so all allocations come from the size classes of
+  // node 1. On a machine without node 1 the memory policy is not set and the
+  // allocator works the same.
+  std::vector<int32_t> cpus(4096);
+  std::iota(cpus.begin(), cpus.end(), 0);
+  MmapAllocator::Options options;
+  options.capacity = 256 << 20;
+  options.numaTopology = std::make_shared<NumaTopology>(
+      std::vector<std::vector<int32_t>>{{}, std::move(cpus)});
+  auto allocator = std::make_shared<MmapAllocator>(options);
+  ASSERT_EQ(2, allocator->numNumaNodes());
+
+  Allocation allocation;
+  ASSERT_TRUE(allocator->allocateNonContiguous(100, allocation));
+  for (auto i = 0; i < allocation.numRuns(); ++i) {
+    EXPECT_EQ(1, allocator->testingNumaNodeOf(allocation.runAt(i).data()));
+  }
+  auto* bytes = allocator->allocateBytes(8192);
+  EXPECT_EQ(1, allocator->testingNumaNodeOf(bytes));
+  EXPECT_TRUE(allocator->checkConsistency());
+  EXPECT_NE(std::string::npos, allocator->toString().find("node 1"));
+
+  allocator->freeBytes(bytes, 8192);
+  allocator->freeNonContiguous(allocation);
+  // The freed pages of node 1 can be advised away.
+  const auto numMapped = allocator->numMapped();
+  EXPECT_GT(numMapped, 0);
+  EXPECT_EQ(numMapped, allocator->unmap(numMapped));
+  EXPECT_TRUE(allocator->checkConsistency());
+
+  // A topology with a single node is the same as none.
+  options.numaTopology = std::make_shared<NumaTopology>(
+      std::vector<std::vector<int32_t>>{{0}});
+  EXPECT_EQ(1, std::make_shared<MmapAllocator>(options)->numNumaNodes());
+}
 } // namespace facebook::velox::memory
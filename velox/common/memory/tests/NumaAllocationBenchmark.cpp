@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include <folly/Benchmark.h>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include "velox/common/memory/MmapAllocator.h"
+#include "velox/common/time/Timer.h"
+
+DEFINE_uint64(
+    numa_bytes,
+    1UL << 30,
+    "Bytes allocated and accessed for each pair of NUMA nodes");
+DEFINE_uint32(numa_runs, 3, "Runs for each pair of NUMA nodes");
+
+using namespace facebook::velox;
+using namespace facebook::velox::memory;
+
+// Compares access to memory of the local NUMA node with access to memory of a
+// remote node. For each pair of nodes, a thread on the allocating node
+// allocates from the NUMA aware MmapAllocator, which takes the size classes of
+// that node. The thread then moves to the accessing node, where it first
+// writes the memory, which includes the page faults that back it, and then
+// reads it. Pairs with the same node are local.
+namespace {
+struct Result {
+  uint64_t allocateUs{0};
+  uint64_t writeUs{0};
+  uint64_t readUs{0};
+};
+
+Result runPair(
+    MmapAllocator& allocator,
+    const NumaTopology& topology,
+    int32_t allocateNode,
+    int32_t accessNode) {
+  Result result;
+  std::thread thread([&]() {
+    VELOX_CHECK(topology.bindCurrentThread(allocateNode));
+    Allocation allocation;
+    {
+      MicrosecondTimer timer(&result.allocateUs);
+      VELOX_CHECK(allocator.allocateNonContiguous(
+          AllocationTraits::numPages(FLAGS_numa_bytes), allocation));
+    }
+    VELOX_CHECK_EQ(
+        allocateNode, allocator.testingNumaNodeOf(allocation.runAt(0).data()));
+
+    VELOX_CHECK(topology.bindCurrentThread(accessNode));
+    {
+      MicrosecondTimer timer(&result.writeUs);
+      for (auto i = 0; i < allocation.numRuns(); ++i) {
+        auto run = allocation.runAt(i);
+        memset(run.data(), 1, run.numBytes());
+      }
+    }
+    uint64_t sum = 0;
+    {
+      MicrosecondTimer timer(&result.readUs);
+      for (auto i = 0; i < allocation.numRuns(); ++i) {
+        auto run = allocation.runAt(i);
+        const auto* words = run.data<uint64_t>();
+        const auto numWords = run.numBytes() / sizeof(uint64_t);
+        for (auto j = 0; j < numWords; ++j) {
+          sum += words[j];
+        }
+      }
+    }
+    folly::doNotOptimizeAway(sum);
+    allocator.freeNonContiguous(allocation);
+    // Gives the memory back so that the next run faults it in again.
+    allocator.unmap(allocator.numMapped());
+  });
+  thread.join();
+  return result;
+}
+
+double gigabytesPerSecond(uint64_t bytes, uint64_t micros) {
+  return micros == 0 ? 0 : bytes / 1000.0 / micros;
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  auto topology = NumaTopology::system();
+  LOG(INFO) << topology->toString();
+  std::vector<int32_t> nodes;
+  for (auto node = 0; node < topology->numNodes(); ++node) {
+    if (!topology->cpus(node).empty()) {
+      nodes.push_back(node);
+    }
+  }
+  if (nodes.size() < 2) {
+    LOG(INFO) << "Needs at least 2 NUMA nodes with CPUs";
+    return 0;
+  }
+
+  MmapAllocator::Options options;
+  options.capacity = 2 * FLAGS_numa_bytes;
+  options.numaTopology = topology;
+  MmapAllocator allocator(options);
+
+  std::cout << "alloc node\taccess node\talloc us\twrite GB/s\tread GB/s"
+            << std::endl;
+  for (auto allocateNode : nodes) {
+    for (auto accessNode : nodes) {
+      Result total;
+      for (auto i = 0; i < FLAGS_numa_runs; ++i) {
+        const auto result =
+            runPair(allocator, *topology, allocateNode, accessNode);
+        total.allocateUs += result.allocateUs;
+        total.writeUs += result.writeUs;
+        total.readUs += result.readUs;
+      }
+      const auto totalBytes = FLAGS_numa_bytes * FLAGS_numa_runs;
+      std::cout << allocateNode << "\t\t" << accessNode << "\t\t"
+                << total.allocateUs / FLAGS_numa_runs << "\t\t"
+                << gigabytesPerSecond(totalBytes, total.writeUs) << "\t\t"
+                << gigabytesPerSecond(totalBytes, total.readUs) << std::endl;
+    }
+  }
+  return 0;
+}
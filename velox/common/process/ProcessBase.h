@@ -63,6 +63,11 @@ bool hasAvx2();
 // flag.
 bool hasBmi2();
 
+// True if the machine has Intel AVX-512F and AVX-512BW instructions and these
+// are enabled with --avx512. Code using these must be compiled for the
+// avx512f and avx512bw targets, e.g. with __attribute__((target)).
+bool hasAvx512();
+
 } // namespace process
 } // namespace velox
 } // namespace facebook
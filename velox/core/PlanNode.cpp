@@ -2004,6 +2004,9 @@ void PartitionedOutputNode::addDetails(std::stringstream& stream) const {
   if (replicateNullsAndAny_) {
     stream << " replicate nulls and any";
   }
+  if (!requireColocatedKeys_) {
+    stream << " keys not co-located";
+  }
 }
 
 folly::dynamic PartitionedOutputNode::serialize() const {
@@ -2014,6 +2017,7 @@ folly::dynamic PartitionedOutputNode::serialize() const {
   obj["replicateNullsAndAny"] = replicateNullsAndAny_;
   obj["partitionFunctionSpec"] = partitionFunctionSpec_->serialize();
   obj["outputType"] = outputType_->serialize();
+  obj["requireColocatedKeys"] = requireColocatedKeys_;
   return obj;
 }
 
@@ -2030,7 +2034,10 @@ PlanNodePtr PartitionedOutputNode::create(
       ISerializable::deserialize<PartitionFunctionSpec>(
           obj["partitionFunctionSpec"], context),
       deserializeRowType(obj["outputType"]),
-      deserializeSingleSource(obj, context));
+      deserializeSingleSource(obj, context),
+      obj.count("requireColocatedKeys")
+          ? obj["requireColocatedKeys"].asBool()
+          : true);
 }
 
 TopNNode::TopNNode(
@@ -1079,6 +1079,16 @@ class PartitionFunctionSpec : public ISerializable {
   virtual ~PartitionFunctionSpec() = default;
 
   virtual std::string toString() const = 0;
+
+  /// Returns false if the rows with the same partitioning keys may be assigned
+  /// to different partitions. Such a function must not be used where the
+  /// consumers need all the rows of a key in the same partition, e.g. for a
+  /// final aggregation, a partitioned hash join or a window. LocalPartitionNode
+  /// rejects such a function and PartitionedOutputNode accepts it only if its
+  /// consumers are declared to not require co-located keys.
+  virtual bool colocatesKeys() const {
+    return true;
+  }
 };
 
 using PartitionFunctionSpecPtr = std::shared_ptr<const PartitionFunctionSpec>;
@@ -1138,6 +1148,13 @@ class LocalPartitionNode : public PlanNode {
         "Local repartitioning node requires at least one source");
 
     VELOX_USER_CHECK_NOT_NULL(partitionFunctionSpec_);
+    // The consumers of a local exchange are the keyed operators of the same
+    // plan, e.g. final aggregations and hash joins.
+    VELOX_USER_CHECK(
+        partitionFunctionSpec_->colocatesKeys(),
+        "Local repartitioning requires a partition function that co-locates "
+        "the keys: {}",
+        partitionFunctionSpec_->toString());
 
     for (auto i = 1; i < sources_.size(); ++i) {
       VELOX_USER_CHECK(
@@ -1200,6 +1217,10 @@ class PartitionedOutputNode : public PlanNode {
   static std::string kindString(Kind kind);
   static Kind stringToKind(std::string str);
 
+  /// @param requireColocatedKeys True if the consumers of the partitions need
+  /// all the rows of a key in the same partition, e.g. a final aggregation or
+  /// a partitioned hash join. A partition function that doesn't co-locate the
+  /// keys, see PartitionFunctionSpec::colocatesKeys(), is then rejected.
   PartitionedOutputNode(
       const PlanNodeId& id,
       Kind kind,
@@ -1208,7 +1229,8 @@ class PartitionedOutputNode : public PlanNode {
       bool replicateNullsAndAny,
       PartitionFunctionSpecPtr partitionFunctionSpec,
       RowTypePtr outputType,
-      PlanNodePtr source)
+      PlanNodePtr source,
+      bool requireColocatedKeys = true)
       : PlanNode(id),
         kind_(kind),
         sources_{{std::move(source)}},
@@ -1216,8 +1238,14 @@ class PartitionedOutputNode : public PlanNode {
         numPartitions_(numPartitions),
         replicateNullsAndAny_(replicateNullsAndAny),
         partitionFunctionSpec_(std::move(partitionFunctionSpec)),
-        outputType_(std::move(outputType)) {
+        outputType_(std::move(outputType)),
+        requireColocatedKeys_(requireColocatedKeys) {
     VELOX_USER_CHECK_GT(numPartitions, 0);
+    VELOX_USER_CHECK(
+        !requireColocatedKeys_ || partitionFunctionSpec_->colocatesKeys(),
+        "Partition function {} may assign the rows of a key to different "
+        "partitions and can't be used if the consumers require co-located keys",
+        partitionFunctionSpec_->toString());
     if (numPartitions == 1) {
       VELOX_USER_CHECK(
           keys_.empty(),
@@ -1320,6 +1348,16 @@ class PartitionedOutputNode : public PlanNode {
     return replicateNullsAndAny_;
   }
 
+  /// Returns true if the consumers need all the rows of a key in the same
+  /// partition.
+  bool requireColocatedKeys() const {
+    return requireColocatedKeys_;
+  }
+
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.outputBufferSpillEnabled();
+  }
+
   const PartitionFunctionSpecPtr& partitionFunctionSpecPtr() const {
     return partitionFunctionSpec_;
   }
@@ -1346,6 +1384,7 @@ class PartitionedOutputNode : public PlanNode {
   const bool replicateNullsAndAny_;
   const PartitionFunctionSpecPtr partitionFunctionSpec_;
   const RowTypePtr outputType_;
+  const bool requireColocatedKeys_;
 };
 
 FOLLY_ALWAYS_INLINE std::ostream& operator<<(
@@ -1656,6 +1695,10 @@ class MergeJoinNode : public AbstractJoinNode {
     return "MergeJoin";
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.mergeJoinSpillEnabled();
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
@@ -1699,6 +1742,14 @@ class NestedLoopJoinNode : public PlanNode {
     return "NestedLoopJoin";
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    // NOTE: as for now, we don't allow spilling for right and full joins. They
+    // need to track the matched build-side rows across all the probe drivers
+    // which requires the build-side rows to stay in memory.
+    return !isRightJoin(joinType_) && !isFullJoin(joinType_) &&
+        queryConfig.joinSpillEnabled();
+  }
+
   const TypedExprPtr& joinCondition() const {
     return joinCondition_;
   }
@@ -1819,6 +1870,10 @@ class TopNNode : public PlanNode {
     return isPartial_;
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.topNSpillEnabled();
+  }
+
   std::string_view name() const override {
     return "TopN";
   }
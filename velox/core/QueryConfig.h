@@ -147,6 +147,21 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// Number of input batches whose grouping keys are sampled into a
+  /// HyperLogLog sketch to estimate the reduction of partial aggregation. If
+  /// the estimated number of groups is at least
+  /// 'abandon_partial_aggregation_min_pct' % of the sampled rows, partial
+  /// aggregation is abandoned right after the sample. 0 disables sampling.
+  static constexpr const char* kPartialAggregationSampleBatches =
+      "partial_aggregation_sample_batches";
+
+  /// Number of input batches to pass through after partial aggregation has
+  /// been abandoned before sampling the grouping keys again. Partial
+  /// aggregation is resumed if the new sample shows enough reduction. 0
+  /// disables re-sampling. Only applies if sampling is enabled.
+  static constexpr const char* kPartialAggregationReprobeBatches =
+      "partial_aggregation_reprobe_batches";
+
   static constexpr const char* kAbandonPartialTopNRowNumberMinRows =
       "abandon_partial_topn_row_number_min_rows";
 
@@ -159,6 +174,22 @@ class QueryConfig {
   static constexpr const char* kMaxArbitraryBufferSize =
       "max_arbitrary_buffer_size";
 
+  /// If true, partitioned output buffers give each destination an equal share
+  /// of kMaxPartitionedOutputBufferSize as credit. Once the total buffered
+  /// size exceeds the limit, a producer is blocked only when it adds data to a
+  /// destination that is over its credit, and is resumed when that
+  /// destination drains. This keeps a slow consumer from blocking producers
+  /// that feed the other destinations.
+  static constexpr const char* kPartitionedOutputFlowControlEnabled =
+      "partitioned_output_flow_control_enabled";
+
+  /// If true and the registered vector serde is PrestoVectorSerde, the
+  /// partitioned output keeps the constant and dictionary encodings of the
+  /// columns of a page built from a single batch of input instead of
+  /// flattening them.
+  static constexpr const char* kPartitionedOutputPreserveEncodings =
+      "partitioned_output_preserve_encodings";
+
   /// Preferred size of batches in bytes to be returned by operators from
   /// Operator::getOutput. It is used when an estimate of average row size is
   /// known. Otherwise kPreferredOutputBatchRows is used.
@@ -178,6 +209,13 @@ class QueryConfig {
   /// output rows.
   static constexpr const char* kMaxOutputBatchRows = "max_output_batch_rows";
 
+  /// Minimum number of bytes of received pages the Exchange operator
+  /// accumulates before producing a batch, unless all data has been received.
+  /// Coalesces the small pages that producers flush early into larger batches.
+  /// 0 means the Exchange produces a batch from whatever data is available.
+  static constexpr const char* kMinExchangeOutputBatchBytes =
+      "min_exchange_output_batch_bytes";
+
   /// TableScan operator will exit getOutput() method after this many
   /// milliseconds even if it has no data to return yet. Zero means 'no time
   /// limit'.
@@ -222,6 +260,19 @@ class QueryConfig {
   static constexpr const char* kTopNRowNumberSpillEnabled =
       "topn_row_number_spill_enabled";
 
+  /// TopN spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kTopNSpillEnabled = "topn_spill_enabled";
+
+  /// MergeJoin spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kMergeJoinSpillEnabled =
+      "merge_join_spill_enabled";
+
+  /// PartitionedOutput spilling flag, only applies if "spill_enabled" flag is
+  /// set. If true, the pages buffered in the output buffer for slow consumers
+  /// can be spilled to disk under memory pressure.
+  static constexpr const char* kOutputBufferSpillEnabled =
+      "output_buffer_spill_enabled";
+
   /// The max memory that a final aggregation can use before spilling. If it 0,
   /// then there is no limit.
   static constexpr const char* kAggregationSpillMemoryThreshold =
@@ -289,12 +340,46 @@ class QueryConfig {
   static constexpr const char* kSpillFileCreateConfig =
       "spill_file_create_config";
 
+  /// The number of buffers per spill file to read ahead on the spill executor
+  /// while the restored data is consumed. Each buffer takes up to 1MB of the
+  /// operator memory per spill file being restored. If it is zero, spill files
+  /// are read synchronously on the driver thread.
+  static constexpr const char* kSpillNumReadAheadBuffers =
+      "spill_num_read_ahead_buffers";
+
+  /// The format of the rows spilled by order by. 'columnar' extracts the rows
+  /// into columns before serialization. 'row_container' copies the rows as-is
+  /// and restores them back into a row container. The other operators always
+  /// spill in the columnar format.
+  static constexpr const char* kOrderBySpillFormat = "order_by_spill_format";
+
   static constexpr const char* kSpillStartPartitionBit =
       "spiller_start_partition_bit";
 
   static constexpr const char* kJoinSpillPartitionBits =
       "join_spiller_partition_bits";
 
+  /// If true, a hash join restores a skewed spilled build partition in
+  /// memory-bounded chunks, each of which is joined with all the spilled probe
+  /// rows of the partition, instead of repartitioning it recursively. A
+  /// partition is skewed if it is past the max spill level or if repartitioning
+  /// it left most of its data in one sub-partition. Applies to inner, right and
+  /// right semi joins.
+  static constexpr const char* kJoinSpillSkewFallbackEnabled =
+      "join_spill_skew_fallback_enabled";
+
+  /// The minimum percentage of the bytes spilled from a restored hash join
+  /// build partition that must go to a single sub-partition for that
+  /// sub-partition to be considered skewed.
+  static constexpr const char* kJoinSpillSkewPartitionPct =
+      "join_spill_skew_partition_pct";
+
+  /// The memory usage in bytes at which a hash build operator stops reading a
+  /// skewed spilled partition and hands the chunk read so far to the probe
+  /// side.
+  static constexpr const char* kJoinSpillSkewChunkBytes =
+      "join_spill_skew_chunk_bytes";
+
   static constexpr const char* kMinSpillableReservationPct =
       "min_spillable_reservation_pct";
 
@@ -344,6 +429,58 @@ class QueryConfig {
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
       "min_table_rows_for_parallel_join_build";
 
+  /// The number of partitions a group-by hash table in hash mode is split
+  /// into when rehashing. The partitions are filled in parallel on the query
+  /// executor. 0 or 1 disables the parallel rehash. Only the rehash is
+  /// parallel. Input rows are still aggregated by the driver thread.
+  static constexpr const char* kParallelGroupByRehashPartitions =
+      "parallel_group_by_rehash_partitions";
+
+  /// The minimum number of group-by table entries per partition that can
+  /// trigger the parallel group-by table rehash.
+  static constexpr const char* kMinTableRowsForParallelGroupByRehash =
+      "min_table_rows_for_parallel_group_by_rehash";
+
+  /// If true, hash join and group-by tables in hash or normalized key mode
+  /// are probed in stages which prefetch the buckets and the matching rows of
+  /// many probed rows before comparing any keys. See
+  /// kHashTablePrefetchProbeMinBytes.
+  static constexpr const char* kHashTablePrefetchProbeEnabled =
+      "hash_table_prefetch_probe_enabled";
+
+  /// The minimum size in bytes of the bucket array of a hash table for which
+  /// the staged prefetching probe is used. Smaller tables are likely to be in
+  /// cache and are probed without the extra staging.
+  static constexpr const char* kHashTablePrefetchProbeMinBytes =
+      "hash_table_prefetch_probe_min_bytes";
+
+  /// If true, the hash join builds a Bloom filter on the join keys which
+  /// can't be pushed down as ranges or IN-lists, and pushes it down as a
+  /// dynamic filter to the probe side table scan.
+  static constexpr const char* kHashJoinBloomFilterEnabled =
+      "hash_join_bloom_filter_enabled";
+
+  /// The maximum number of build side rows to build the join key Bloom
+  /// filters for. The Bloom filter takes 2 bytes per build side row.
+  static constexpr const char* kHashJoinBloomFilterMaxRows =
+      "hash_join_bloom_filter_max_rows";
+
+  /// If true, the TopN operator pushes the range of the first sorting key
+  /// values that can still make the result down to the table scan as a
+  /// dynamic filter once it has accumulated 'count' rows.
+  static constexpr const char* kTopNDynamicFilterEnabled =
+      "topn_dynamic_filter_enabled";
+
+  /// The max number of bytes of the normalized sort keys encoded in front of
+  /// each row for prefix sort in order by, window and spill sorting. The keys
+  /// which don't fit are compared on ties. 0 disables prefix sort.
+  static constexpr const char* kPrefixSortNormalizedKeyMaxBytes =
+      "prefixsort_normalized_key_max_bytes";
+
+  /// The min number of rows to use prefix sort. Fewer rows are sorted with
+  /// std::sort.
+  static constexpr const char* kPrefixSortMinRows = "prefixsort_min_rows";
+
   /// If set to true, then during execution of tasks, the output vectors of
   /// every operator are validated for consistency. This is an expensive check
   /// so should only be used for debugging. It can help debug issues where
@@ -377,6 +514,18 @@ class QueryConfig {
   static constexpr const char* kDriverCpuTimeSliceLimitMs =
       "driver_cpu_time_slice_limit_ms";
 
+  /// If true, ungrouped pipelines that start with a table scan begin with
+  /// half of their drivers taking splits. The task activates more drivers
+  /// while the pipeline is CPU bound and parks drivers at split boundaries
+  /// while the pipeline is idle or blocked on its consumers.
+  static constexpr const char* kDynamicDriversEnabled =
+      "dynamic_drivers_enabled";
+
+  /// Maximum number of drivers taking splits across all pipelines of a task
+  /// scaled by 'dynamic_drivers_enabled'. 0 means no limit.
+  static constexpr const char* kDynamicDriversMaxActive =
+      "dynamic_drivers_max_active";
+
   // Timestamp unit used during Velox-Arrow conversion.
   static constexpr const char* kArrowBridgeTimestampUnit =
       "arrow_bridge_timestamp_unit";
@@ -404,6 +553,14 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  int32_t partialAggregationSampleBatches() const {
+    return get<int32_t>(kPartialAggregationSampleBatches, 0);
+  }
+
+  int32_t partialAggregationReprobeBatches() const {
+    return get<int32_t>(kPartialAggregationReprobeBatches, 1'000);
+  }
+
   int32_t abandonPartialTopNRowNumberMinRows() const {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinRows, 100'000);
   }
@@ -457,6 +614,14 @@ class QueryConfig {
     return get<uint64_t>(kMaxArbitraryBufferSize, kDefault);
   }
 
+  bool partitionedOutputFlowControlEnabled() const {
+    return get<bool>(kPartitionedOutputFlowControlEnabled, false);
+  }
+
+  bool partitionedOutputPreserveEncodings() const {
+    return get<bool>(kPartitionedOutputPreserveEncodings, false);
+  }
+
   uint64_t maxLocalExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxLocalExchangeBufferSize, kDefault);
@@ -485,6 +650,10 @@ class QueryConfig {
     return get<uint32_t>(kMaxOutputBatchRows, 10'000);
   }
 
+  uint64_t minExchangeOutputBatchBytes() const {
+    return get<uint64_t>(kMinExchangeOutputBatchBytes, 0);
+  }
+
   uint32_t tableScanGetOutputTimeLimitMs() const {
     return get<uint64_t>(kTableScanGetOutputTimeLimitMs, 5'000);
   }
@@ -594,6 +763,24 @@ class QueryConfig {
     return get<bool>(kTopNRowNumberSpillEnabled, true);
   }
 
+  /// Returns true if spilling is enabled for TopN operator. Must also check
+  /// the spillEnabled()!
+  bool topNSpillEnabled() const {
+    return get<bool>(kTopNSpillEnabled, true);
+  }
+
+  /// Returns true if spilling is enabled for MergeJoin operator. Must also
+  /// check the spillEnabled()!
+  bool mergeJoinSpillEnabled() const {
+    return get<bool>(kMergeJoinSpillEnabled, true);
+  }
+
+  /// Returns true if spilling is enabled for the output buffer of
+  /// PartitionedOutput operator. Must also check the spillEnabled()!
+  bool outputBufferSpillEnabled() const {
+    return get<bool>(kOutputBufferSpillEnabled, false);
+  }
+
   /// Returns a percentage of aggregation or join input batches that will be
   /// forced to spill for testing. 0 means no extra spilling.
   int32_t testingSpillPct() const {
@@ -632,6 +819,19 @@ class QueryConfig {
         kMaxBits, get<uint8_t>(kJoinSpillPartitionBits, kDefaultBits));
   }
 
+  bool joinSpillSkewFallbackEnabled() const {
+    return get<bool>(kJoinSpillSkewFallbackEnabled, true);
+  }
+
+  int32_t joinSpillSkewPartitionPct() const {
+    return get<int32_t>(kJoinSpillSkewPartitionPct, 90);
+  }
+
+  uint64_t joinSpillSkewChunkBytes() const {
+    static constexpr uint64_t kDefault = 128UL << 20;
+    return get<uint64_t>(kJoinSpillSkewChunkBytes, kDefault);
+  }
+
   uint64_t writerFlushThresholdBytes() const {
     return get<uint64_t>(kWriterFlushThresholdBytes, 96L << 20);
   }
@@ -659,6 +859,14 @@ class QueryConfig {
     return get<std::string>(kSpillFileCreateConfig, "");
   }
 
+  uint32_t spillNumReadAheadBuffers() const {
+    return get<uint32_t>(kSpillNumReadAheadBuffers, 0);
+  }
+
+  std::string orderBySpillFormat() const {
+    return get<std::string>(kOrderBySpillFormat, "columnar");
+  }
+
   /// Returns the minimal available spillable memory reservation in percentage
   /// of the current memory usage. Suppose the current memory usage size of M,
   /// available memory reservation size of N and min reservation percentage of
@@ -737,6 +945,43 @@ class QueryConfig {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
 
+  uint8_t parallelGroupByRehashPartitions() const {
+    return get<uint8_t>(kParallelGroupByRehashPartitions, 0);
+  }
+
+  uint32_t minTableRowsForParallelGroupByRehash() const {
+    return get<uint32_t>(kMinTableRowsForParallelGroupByRehash, 10'000);
+  }
+
+  bool hashTablePrefetchProbeEnabled() const {
+    return get<bool>(kHashTablePrefetchProbeEnabled, true);
+  }
+
+  uint64_t hashTablePrefetchProbeMinBytes() const {
+    static constexpr uint64_t kDefault = 16UL << 20;
+    return get<uint64_t>(kHashTablePrefetchProbeMinBytes, kDefault);
+  }
+
+  bool hashJoinBloomFilterEnabled() const {
+    return get<bool>(kHashJoinBloomFilterEnabled, false);
+  }
+
+  uint32_t hashJoinBloomFilterMaxRows() const {
+    return get<uint32_t>(kHashJoinBloomFilterMaxRows, 4'000'000);
+  }
+
+  bool topNDynamicFilterEnabled() const {
+    return get<bool>(kTopNDynamicFilterEnabled, true);
+  }
+
+  uint32_t prefixSortNormalizedKeyMaxBytes() const {
+    return get<uint32_t>(kPrefixSortNormalizedKeyMaxBytes, 128);
+  }
+
+  uint32_t prefixSortMinRows() const {
+    return get<uint32_t>(kPrefixSortMinRows, 130);
+  }
+
   bool validateOutputFromOperators() const {
     return get<bool>(kValidateOutputFromOperators, false);
   }
@@ -769,6 +1014,14 @@ class QueryConfig {
     return get<uint32_t>(kDriverCpuTimeSliceLimitMs, 0);
   }
 
+  bool dynamicDriversEnabled() const {
+    return get<bool>(kDynamicDriversEnabled, false);
+  }
+
+  uint32_t dynamicDriversMaxActive() const {
+    return get<uint32_t>(kDynamicDriversMaxActive, 0);
+  }
+
   template <typename T>
   T get(const std::string& key, const T& defaultValue) const {
     return config_->get<T>(key, defaultValue);
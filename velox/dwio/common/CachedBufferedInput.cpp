@@ -54,6 +54,7 @@ std::unique_ptr<SeekableInputStream> CachedBufferedInput::enqueue(
       RawFileCacheKey{fileNum_, region.offset}, region.length, id);
   if (tracker_) {
     tracker_->recordReference(id, region.length, fileNum_, groupId_);
+    tracker_->recordAccess(fileNum_, region.offset, region.length);
   }
   auto stream = std::make_unique<CacheInputStream>(
       this,
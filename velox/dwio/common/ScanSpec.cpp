@@ -415,7 +415,15 @@ std::shared_ptr<ScanSpec> ScanSpec::removeChild(const ScanSpec* child) {
 }
 
 void ScanSpec::addFilter(const Filter& filter) {
-  filter_ = filter_ ? filter_->mergeWith(&filter) : filter.clone();
+  if (filter_ == nullptr) {
+    filter_ = filter.clone();
+  } else if (filter.kind() == FilterKind::kBloomFilterValues) {
+    // Bloom filters merge with the other filter kinds but not the other way
+    // around.
+    filter_ = filter.mergeWith(filter_.get());
+  } else {
+    filter_ = filter_->mergeWith(&filter);
+  }
 }
 
 ScanSpec* ScanSpec::addField(const std::string& name, column_index_t channel) {
@@ -161,7 +161,19 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       queryConfig.writerFlushThresholdBytes(),
       queryConfig.testingSpillPct(),
       queryConfig.spillCompressionKind(),
-      queryConfig.spillFileCreateConfig());
+      queryConfig.spillFileCreateConfig(),
+      queryConfig.spillNumReadAheadBuffers(),
+      queryConfig.orderBySpillFormat(),
+      queryConfig.prefixSortNormalizedKeyMaxBytes() > 0
+          ? std::optional<common::PrefixSortConfig>(prefixSortConfig())
+          : std::nullopt);
+}
+
+common::PrefixSortConfig DriverCtx::prefixSortConfig() const {
+  const auto& queryConfig = task->queryCtx()->queryConfig();
+  return common::PrefixSortConfig(
+      queryConfig.prefixSortNormalizedKeyMaxBytes(),
+      queryConfig.prefixSortMinRows());
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -262,6 +262,9 @@ struct DriverCtx {
 
   /// Builds the spill config for the operator with specified 'operatorId'.
   std::optional<common::SpillConfig> makeSpillConfig(int32_t operatorId) const;
+
+  /// Builds the prefix sort config from the query config.
+  common::PrefixSortConfig prefixSortConfig() const;
 };
 
 constexpr const char* kOpMethodNone = "";
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/DriverScaling.h"
+
+namespace facebook::velox::exec {
+namespace {
+// A pipeline whose active drivers spend at least this share of their wall
+// time on CPU is considered CPU bound.
+constexpr double kScaleUpCpuRatio = 0.8;
+// A pipeline whose active drivers spend at most this share of their wall time
+// on CPU is considered idle.
+constexpr double kScaleDownCpuRatio = 0.3;
+// Consumer blocking above this share of the wall time means more drivers would
+// only produce data nobody reads.
+constexpr double kScaleUpMaxConsumerBlockedRatio = 0.05;
+// Consumer blocking above this share of the wall time means the active
+// drivers are mostly waiting for downstream to catch up.
+constexpr double kScaleDownConsumerBlockedRatio = 0.5;
+} // namespace
+
+std::string driverScalingName(DriverScaling scaling) {
+  switch (scaling) {
+    case DriverScaling::kKeep:
+      return "KEEP";
+    case DriverScaling::kScaleUp:
+      return "SCALE_UP";
+    case DriverScaling::kScaleDown:
+      return "SCALE_DOWN";
+  }
+  return "UNKNOWN";
+}
+
+DriverScaling decideDriverScaling(const DriverScalingInput& input) {
+  if (input.numActiveDrivers == 0 ||
+      input.wallNanos < kDriverScalingIntervalNanos) {
+    return DriverScaling::kKeep;
+  }
+  const double capacityNanos =
+      static_cast<double>(input.wallNanos) * input.numActiveDrivers;
+  const double cpuRatio = input.cpuNanos / capacityNanos;
+  const double consumerBlockedRatio =
+      input.consumerBlockedNanos / capacityNanos;
+  if (cpuRatio >= kScaleUpCpuRatio &&
+      consumerBlockedRatio <= kScaleUpMaxConsumerBlockedRatio &&
+      input.numActiveDrivers < input.maxDrivers && !input.atTaskLimit) {
+    return DriverScaling::kScaleUp;
+  }
+  if ((cpuRatio <= kScaleDownCpuRatio ||
+       consumerBlockedRatio >= kScaleDownConsumerBlockedRatio) &&
+      input.numActiveDrivers > 1) {
+    return DriverScaling::kScaleDown;
+  }
+  return DriverScaling::kKeep;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace facebook::velox::exec {
+
+/// Outcome of a driver count review for a pipeline running with
+/// 'dynamic_drivers_enabled'.
+enum class DriverScaling {
+  kKeep,
+  kScaleUp,
+  kScaleDown,
+};
+
+std::string driverScalingName(DriverScaling scaling);
+
+/// Resource use of a pipeline since its last driver count review.
+struct DriverScalingInput {
+  /// Number of drivers of the pipeline that were allowed to take splits.
+  uint32_t numActiveDrivers{0};
+  /// Maximum number of drivers the pipeline may have active.
+  uint32_t maxDrivers{0};
+  /// True if the per-task limit on active drivers has been reached.
+  bool atTaskLimit{false};
+  /// Wall time since the last review.
+  uint64_t wallNanos{0};
+  /// CPU time used by all drivers of the pipeline since the last review.
+  uint64_t cpuNanos{0};
+  /// Time the drivers of the pipeline spent blocked on downstream consumers
+  /// since the last review.
+  uint64_t consumerBlockedNanos{0};
+};
+
+/// Minimum wall time between two driver count reviews of a pipeline.
+constexpr uint64_t kDriverScalingIntervalNanos = 50'000'000;
+
+/// Decides whether a pipeline should get one more or one fewer active
+/// driver. Scales up when the active drivers are busy on CPU and are not held
+/// back by consumers. Scales down when the active drivers are mostly idle,
+/// e.g. waiting for splits or for an exchange.
+DriverScaling decideDriverScaling(const DriverScalingInput& input);
+
+} // namespace facebook::velox::exec
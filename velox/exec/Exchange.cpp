@@ -53,7 +53,7 @@ bool Exchange::getSplits(ContinueFuture* future) {
 }
 
 BlockingReason Exchange::isBlocked(ContinueFuture* future) {
-  if (!currentPages_.empty() || atEnd_) {
+  if (hasEnoughPages() || atEnd_) {
     return BlockingReason::kNotBlocked;
   }
 
@@ -64,13 +64,24 @@ BlockingReason Exchange::isBlocked(ContinueFuture* future) {
     getSplits(&splitFuture_);
   }
 
-  const auto maxBytes = getSerde()->supportsAppendInDeserialize()
-      ? preferredOutputBatchBytes_
+  // Serdes that cannot append in deserialize get one page at a time unless
+  // small pages are to be coalesced.
+  const bool coalesce = getSerde()->supportsAppendInDeserialize() ||
+      minOutputBatchBytes_ > 0;
+  const auto maxBytes = coalesce
+      ? std::max<uint64_t>(preferredOutputBatchBytes_ - currentPagesBytes_, 1)
       : 1;
 
   ContinueFuture dataFuture;
-  currentPages_ = exchangeClient_->next(maxBytes, &atEnd_, &dataFuture);
-  if (!currentPages_.empty() || atEnd_) {
+  auto pages = exchangeClient_->next(maxBytes, &atEnd_, &dataFuture);
+  for (auto& page : pages) {
+    currentPagesBytes_ += page->size();
+    currentPages_.push_back(std::move(page));
+  }
+  // Produce a batch if there is enough data, or if the batch is full while
+  // more data is queued, in which case 'dataFuture' is not set.
+  if (hasEnoughPages() || atEnd_ ||
+      (!currentPages_.empty() && !dataFuture.valid())) {
     if (atEnd_ && noMoreSplits_) {
       const auto numSplits = stats_.rlock()->numSplits;
       operatorCtx_->task()->multipleSplitsFinished(numSplits);
@@ -106,19 +117,31 @@ RowVectorPtr Exchange::getOutput() {
 
   uint64_t rawInputBytes{0};
   vector_size_t resultOffset = 0;
+  const bool append = getSerde()->supportsAppendInDeserialize();
+  std::vector<RowVectorPtr> pageResults;
   for (const auto& page : currentPages_) {
     rawInputBytes += page->size();
 
     auto inputStream = page->prepareStreamForDeserialize();
 
     while (!inputStream.atEnd()) {
-      getSerde()->deserialize(
-          &inputStream, pool(), outputType_, &result_, resultOffset);
-      resultOffset = result_->size();
+      if (append) {
+        getSerde()->deserialize(
+            &inputStream, pool(), outputType_, &result_, resultOffset);
+        resultOffset = result_->size();
+      } else {
+        RowVectorPtr pageResult;
+        getSerde()->deserialize(&inputStream, pool(), outputType_, &pageResult);
+        pageResults.push_back(std::move(pageResult));
+      }
     }
   }
+  if (!append) {
+    concatenateResults(pageResults);
+  }
 
   currentPages_.clear();
+  currentPagesBytes_ = 0;
 
   {
     auto lockedStats = stats_.wlock();
@@ -129,9 +152,34 @@ RowVectorPtr Exchange::getOutput() {
   return result_;
 }
 
+void Exchange::concatenateResults(std::vector<RowVectorPtr>& vectors) {
+  if (vectors.size() == 1) {
+    result_ = std::move(vectors[0]);
+    return;
+  }
+
+  vector_size_t numRows = 0;
+  for (const auto& vector : vectors) {
+    numRows += vector->size();
+  }
+  if (result_ != nullptr && result_.use_count() == 1) {
+    result_->prepareForReuse();
+    result_->resize(numRows);
+  } else {
+    result_ = BaseVector::create<RowVector>(outputType_, numRows, pool());
+  }
+
+  vector_size_t offset = 0;
+  for (const auto& vector : vectors) {
+    result_->copy(vector.get(), offset, 0, vector->size());
+    offset += vector->size();
+  }
+}
+
 void Exchange::close() {
   SourceOperator::close();
   currentPages_.clear();
+  currentPagesBytes_ = 0;
   result_ = nullptr;
   if (exchangeClient_) {
     recordExchangeClientStats();
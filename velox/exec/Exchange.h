@@ -47,6 +47,9 @@ class Exchange : public SourceOperator {
             operatorType),
         preferredOutputBatchBytes_{
             driverCtx->queryConfig().preferredOutputBatchBytes()},
+        minOutputBatchBytes_{std::min(
+            driverCtx->queryConfig().minExchangeOutputBatchBytes(),
+            preferredOutputBatchBytes_)},
         processSplits_{operatorCtx_->driverCtx()->driverId == 0},
         exchangeClient_{std::move(exchangeClient)} {}
 
@@ -79,8 +82,23 @@ class Exchange : public SourceOperator {
   /// operator's stats.
   void recordExchangeClientStats();
 
+  /// Returns true if 'currentPages_' hold enough data to produce a batch.
+  bool hasEnoughPages() const {
+    return !currentPages_.empty() &&
+        (atEnd_ || currentPagesBytes_ >= minOutputBatchBytes_);
+  }
+
+  /// Sets 'result_' to the concatenation of 'vectors'. Used with serdes that
+  /// cannot append to an existing vector when deserializing. Reuses 'result_'
+  /// if it is not referenced elsewhere.
+  void concatenateResults(std::vector<RowVectorPtr>& vectors);
+
   const uint64_t preferredOutputBatchBytes_;
 
+  /// See QueryConfig::kMinExchangeOutputBatchBytes. Not more than
+  /// 'preferredOutputBatchBytes_'.
+  const uint64_t minOutputBatchBytes_;
+
   /// True if this operator is responsible for fetching splits from the Task and
   /// passing these to ExchangeClient.
   const bool processSplits_;
@@ -95,6 +113,8 @@ class Exchange : public SourceOperator {
 
   std::shared_ptr<ExchangeClient> exchangeClient_;
   std::vector<std::unique_ptr<SerializedPage>> currentPages_;
+  /// Total size of 'currentPages_'.
+  uint64_t currentPagesBytes_{0};
   bool atEnd_{false};
 };
 
@@ -59,6 +59,7 @@ GroupingSet::GroupingSet(
       isPartial_(isPartial),
       isRawInput_(isRawInput),
       queryConfig_(operatorCtx->task()->queryCtx()->queryConfig()),
+      executor_(operatorCtx->task()->queryCtx()->executor()),
       aggregates_(std::move(aggregates)),
       masks_(extractMaskChannels(aggregates_)),
       ignoreNullKeys_(ignoreNullKeys),
@@ -348,6 +349,15 @@ void GroupingSet::createHashTable() {
     table_ = HashTable<false>::createForAggregation(
         std::move(hashers_), accumulators(false), &pool_);
   }
+  if (queryConfig_.parallelGroupByRehashPartitions() > 1) {
+    table_->setParallelGroupByRehash(
+        executor_,
+        queryConfig_.parallelGroupByRehashPartitions(),
+        queryConfig_.minTableRowsForParallelGroupByRehash());
+  }
+  table_->setPrefetchProbe(
+      queryConfig_.hashTablePrefetchProbeEnabled(),
+      queryConfig_.hashTablePrefetchProbeMinBytes());
 
   RowContainer& rows = *table_->rows();
   initializeAggregates(aggregates_, rows, false);
@@ -1007,7 +1017,7 @@ bool GroupingSet::getOutputWithSpill(
 
     VELOX_CHECK_NULL(merge_);
     auto spillPartition = spiller_->finishSpill();
-    merge_ = spillPartition.createOrderedReader(&pool_);
+    merge_ = spillPartition.createOrderedReader(&pool_, spillConfig_);
   }
   VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
   if (merge_ == nullptr) {
@@ -1182,6 +1192,21 @@ void GroupingSet::abandonPartialAggregation() {
   table_.reset();
 }
 
+void GroupingSet::resumePartialAggregation() {
+  VELOX_CHECK(abandonedPartialAggregation_);
+  VELOX_CHECK_NULL(table_);
+  VELOX_CHECK_NOT_NULL(intermediateRows_);
+  // The hashers have been moved into the abandoned table, make new ones.
+  const auto& keyTypes = intermediateRows_->keyTypes();
+  hashers_.clear();
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    hashers_.push_back(
+        std::make_unique<VectorHasher>(keyTypes[i], keyChannels_[i]));
+  }
+  intermediateRows_.reset();
+  abandonedPartialAggregation_ = false;
+}
+
 namespace {
 // Recursive resize all children.
 
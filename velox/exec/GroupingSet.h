@@ -135,6 +135,10 @@ class GroupingSet {
   // non-productive. Must be called before toIntermediate() is used.
   void abandonPartialAggregation();
 
+  /// Undoes abandonPartialAggregation(). The hash table is recreated on the
+  /// next addInput().
+  void resumePartialAggregation();
+
   /// Translates the raw input in input to accumulators initialized from a
   /// single input row. Passes grouping keys through.
   void toIntermediate(const RowVectorPtr& input, RowVectorPtr& result);
@@ -272,6 +276,8 @@ class GroupingSet {
   const bool isPartial_;
   const bool isRawInput_;
   const core::QueryConfig& queryConfig_;
+  // Executor for the parallel rehash of 'table_'.
+  folly::Executor* const executor_;
 
   std::vector<AggregateInfo> aggregates_;
   AggregationMasks masks_;
@@ -45,6 +45,10 @@ HashAggregation::HashAggregation(
           driverCtx->queryConfig().abandonPartialAggregationMinRows()),
       abandonPartialAggregationMinPct_(
           driverCtx->queryConfig().abandonPartialAggregationMinPct()),
+      partialAggregationSampleBatches_(
+          driverCtx->queryConfig().partialAggregationSampleBatches()),
+      partialAggregationReprobeBatches_(
+          driverCtx->queryConfig().partialAggregationReprobeBatches()),
       maxPartialAggregationMemoryUsage_(
           driverCtx->queryConfig().maxPartialAggregationMemoryUsage()) {}
 
@@ -108,6 +112,14 @@ void HashAggregation::initialize() {
       &nonReclaimableSection_,
       operatorCtx_.get());
 
+  if (samplingEnabled()) {
+    sampleHashers_ =
+        createVectorHashers(inputType, aggregationNode_->groupingKeys());
+    sampleAllocator_ = std::make_unique<HashStringAllocator>(pool());
+    sampleHll_ = std::make_unique<common::hll::DenseHll>(
+        kSampleHllIndexBitLength, sampleAllocator_.get());
+  }
+
   aggregationNode_.reset();
 }
 
@@ -122,7 +134,8 @@ void HashAggregation::addInput(RowVectorPtr input) {
     mayPushdown_ = operatorCtx_->driver()->mayPushdownAggregation(this);
     pushdownChecked_ = true;
   }
-  if (abandonedPartialAggregation_) {
+  if (abandonedPartialAggregation_ &&
+      !maybeResumePartialAggregation(*input)) {
     input_ = input;
     numInputRows_ += input->size();
     return;
@@ -130,13 +143,18 @@ void HashAggregation::addInput(RowVectorPtr input) {
   groupingSet_->addInput(input, mayPushdown_);
   numInputRows_ += input->size();
 
+  if (sampleHll_ != nullptr && sampleInput(*input)) {
+    abandonAfterSampling_ = finishSampling();
+  }
+
   updateRuntimeStats();
 
   // NOTE: we should not trigger partial output flush in case of global
   // aggregation as the final aggregator will handle it the same way as the
   // partial aggregator. Hence, we have to use more memory anyway.
   const bool abandonPartialEarly = isPartialOutput_ && !isGlobal_ &&
-      abandonPartialAggregationEarly(groupingSet_->numDistinct());
+      (abandonAfterSampling_ ||
+       abandonPartialAggregationEarly(groupingSet_->numDistinct()));
   if (isPartialOutput_ && !isGlobal_ &&
       (abandonPartialEarly ||
        groupingSet_->isPartialFull(maxPartialAggregationMemoryUsage_))) {
@@ -159,6 +177,66 @@ void HashAggregation::addInput(RowVectorPtr input) {
   }
 }
 
+bool HashAggregation::sampleInput(const RowVector& input) {
+  VELOX_CHECK_NOT_NULL(sampleHll_);
+  const SelectivityVector rows(input.size());
+  sampleHashes_.resize(input.size());
+  for (auto i = 0; i < sampleHashers_.size(); ++i) {
+    auto& hasher = sampleHashers_[i];
+    hasher->decode(*input.childAt(hasher->channel()), rows);
+    hasher->hash(rows, i > 0, sampleHashes_);
+  }
+  for (auto row = 0; row < input.size(); ++row) {
+    sampleHll_->insertHash(sampleHashes_[row]);
+  }
+  numSampledRows_ += input.size();
+  return ++numSampledBatches_ >= partialAggregationSampleBatches_;
+}
+
+bool HashAggregation::finishSampling() {
+  VELOX_CHECK_NOT_NULL(sampleHll_);
+  const int64_t estimate = sampleHll_->cardinality();
+  const int64_t estimatePct =
+      numSampledRows_ == 0 ? 0 : 100 * estimate / numSampledRows_;
+  {
+    auto lockedStats = stats_.wlock();
+    lockedStats->addRuntimeStat(
+        "partialAggregationEstimatedDistinct", RuntimeCounter(estimate));
+    lockedStats->addRuntimeStat(
+        "partialAggregationEstimatedPct", RuntimeCounter(estimatePct));
+  }
+  sampleHll_.reset();
+  numSampledBatches_ = 0;
+  numSampledRows_ = 0;
+  return estimatePct >= abandonPartialAggregationMinPct_;
+}
+
+bool HashAggregation::maybeResumePartialAggregation(const RowVector& input) {
+  VELOX_CHECK(abandonedPartialAggregation_);
+  if (!samplingEnabled() || partialAggregationReprobeBatches_ == 0) {
+    return false;
+  }
+  if (sampleHll_ == nullptr) {
+    if (++numPassThroughBatches_ < partialAggregationReprobeBatches_) {
+      return false;
+    }
+    numPassThroughBatches_ = 0;
+    sampleHll_ = std::make_unique<common::hll::DenseHll>(
+        kSampleHllIndexBitLength, sampleAllocator_.get());
+  }
+  if (!sampleInput(input) || finishSampling()) {
+    return false;
+  }
+
+  VELOX_CHECK_NULL(input_);
+  groupingSet_->resumePartialAggregation();
+  abandonedPartialAggregation_ = false;
+  numInputRows_ = 0;
+  numOutputRows_ = 0;
+  addRuntimeStat("resumedPartialAggregation", RuntimeCounter(1));
+  return true;
+}
+
 void HashAggregation::updateRuntimeStats() {
   // Report range sizes and number of distinct values for the group-by keys.
   const auto& hashers = groupingSet_->hashLookup().hashers;
@@ -224,12 +302,27 @@ void HashAggregation::resetPartialOutputIfNeed() {
   groupingSet_->resetTable();
   partialFull_ = false;
   if (!finished_) {
-    maybeIncreasePartialAggregationMemoryUsage(aggregationPct);
+    if (abandonAfterSampling_) {
+      addRuntimeStat(
+          "abandonedPartialAggregationBySampling", RuntimeCounter(1));
+      abandonPartialAggregation();
+    } else {
+      maybeIncreasePartialAggregationMemoryUsage(aggregationPct);
+    }
   }
   numOutputRows_ = 0;
   numInputRows_ = 0;
 }
 
+void HashAggregation::abandonPartialAggregation() {
+  groupingSet_->abandonPartialAggregation();
+  pool()->release();
+  addRuntimeStat("abandonedPartialAggregation", RuntimeCounter(1));
+  abandonedPartialAggregation_ = true;
+  abandonAfterSampling_ = false;
+  numPassThroughBatches_ = 0;
+}
+
 void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
     double aggregationPct) {
   // If more than this many are unique at full memory, give up on partial agg.
@@ -241,10 +334,7 @@ void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
       (aggregationPct > kPartialMinFinalPct &&
        maxPartialAggregationMemoryUsage_ >=
            maxExtendedPartialAggregationMemoryUsage_)) {
-    groupingSet_->abandonPartialAggregation();
-    pool()->release();
-    addRuntimeStat("abandonedPartialAggregation", RuntimeCounter(1));
-    abandonedPartialAggregation_ = true;
+    abandonPartialAggregation();
     return;
   }
   const int64_t extendedPartialAggregationMemoryUsage = std::min(
@@ -448,6 +538,8 @@ void HashAggregation::close() {
 
   output_ = nullptr;
   groupingSet_.reset();
+  sampleHll_.reset();
+  sampleAllocator_.reset();
 }
 
 void HashAggregation::abort() {
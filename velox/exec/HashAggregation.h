@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/hyperloglog/DenseHll.h"
 #include "velox/exec/GroupingSet.h"
 #include "velox/exec/Operator.h"
 
@@ -53,6 +54,10 @@ class HashAggregation : public Operator {
   void abort() override;
 
  private:
+  // Index bits of the HyperLogLog sketch used for sampling grouping keys. The
+  // standard error of the estimate is 2.3%.
+  static constexpr int8_t kSampleHllIndexBitLength = 11;
+
   void updateRuntimeStats();
 
   void prepareOutput(vector_size_t size);
@@ -72,6 +77,32 @@ class HashAggregation : public Operator {
   // 'abandonPartialAggregationMinPct_' % of rows are unique.
   bool abandonPartialAggregationEarly(int64_t numOutput) const;
 
+  // Gives up on partial aggregation and converts the subsequent input to
+  // intermediate results. Must be called after the groups have been flushed.
+  void abandonPartialAggregation();
+
+  // Returns true if the grouping keys of the input are sampled into
+  // 'sampleHll_' to estimate the reduction of partial aggregation.
+  bool samplingEnabled() const {
+    return partialAggregationSampleBatches_ > 0 && isPartialOutput_ &&
+        !isGlobal_;
+  }
+
+  // Adds the grouping keys of 'input' to 'sampleHll_'. Returns true if the
+  // sample is complete.
+  bool sampleInput(const RowVector& input);
+
+  // Ends the sampling and records the estimated number of groups in runtime
+  // stats. Returns true if the estimate shows that partial aggregation does
+  // not reduce the data enough to be worthwhile.
+  bool finishSampling();
+
+  // Called on each input batch while partial aggregation is abandoned.
+  // Re-samples the grouping keys every 'partialAggregationReprobeBatches_'
+  // batches. Returns true if partial aggregation has been resumed and
+  // 'input' should be aggregated.
+  bool maybeResumePartialAggregation(const RowVector& input);
+
   RowVectorPtr getDistinctOutput();
 
   // Invoked to record the spilling stats in operator stats after processing all
@@ -93,9 +124,32 @@ class HashAggregation : public Operator {
   // are unique, the partial aggregation is not worthwhile.
   const int32_t abandonPartialAggregationMinPct_;
 
+  // Number of input batches to sample for estimating the number of groups.
+  // 0 disables sampling.
+  const int32_t partialAggregationSampleBatches_;
+  // Number of input batches to pass through after abandoning partial
+  // aggregation before sampling again. 0 disables re-sampling.
+  const int32_t partialAggregationReprobeBatches_;
+
   int64_t maxPartialAggregationMemoryUsage_;
   std::unique_ptr<GroupingSet> groupingSet_;
 
+  // Hashers for the grouping keys of the sampled input. Separate from the
+  // hashers of 'groupingSet_' which may compute value ids instead of hashes.
+  std::vector<std::unique_ptr<VectorHasher>> sampleHashers_;
+  std::unique_ptr<HashStringAllocator> sampleAllocator_;
+  // Sketch of the sampled grouping keys. Not null while sampling.
+  std::unique_ptr<common::hll::DenseHll> sampleHll_;
+  raw_vector<uint64_t> sampleHashes_;
+  int32_t numSampledBatches_{0};
+  int64_t numSampledRows_{0};
+  // Number of batches passed through since partial aggregation was abandoned
+  // or last sampled.
+  int32_t numPassThroughBatches_{0};
+  // True if sampling found partial aggregation non-productive. Partial
+  // aggregation is abandoned on the next flush.
+  bool abandonAfterSampling_{false};
+
   // Size of a single output row estimated using
   // 'groupingSet_->estimateRowSize()'. If spilling, this value is set to max
   // 'groupingSet_->estimateRowSize()' across all accumulated data set.
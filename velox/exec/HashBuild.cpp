@@ -68,6 +68,18 @@ HashBuild::HashBuild(
           planNodeId())),
       spillMemoryThreshold_(
           operatorCtx_->driverCtx()->queryConfig().joinSpillMemoryThreshold()),
+      skewFallbackEnabled_(
+          operatorCtx_->driverCtx()
+              ->queryConfig()
+              .joinSpillSkewFallbackEnabled() &&
+          !nullAware_ &&
+          (isInnerJoin(joinType_) || isRightJoin(joinType_) ||
+           isRightSemiFilterJoin(joinType_) ||
+           isRightSemiProjectJoin(joinType_))),
+      skewPartitionPct_(
+          operatorCtx_->driverCtx()->queryConfig().joinSpillSkewPartitionPct()),
+      skewChunkBytes_(
+          operatorCtx_->driverCtx()->queryConfig().joinSpillSkewChunkBytes()),
       keyChannelMap_(joinNode_->rightKeys().size()) {
   VELOX_CHECK(pool()->trackUsage());
   VELOX_CHECK_NOT_NULL(joinBridge_);
@@ -192,10 +204,14 @@ void HashBuild::setupTable() {
           pool());
     }
   }
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  table_->setPrefetchProbe(
+      queryConfig.hashTablePrefetchProbeEnabled(),
+      queryConfig.hashTablePrefetchProbeMinBytes());
   analyzeKeys_ = table_->hashMode() != BaseHashTable::HashMode::kHash;
 }
 
-void HashBuild::setupSpiller(SpillPartition* spillPartition) {
+void HashBuild::setupSpiller(SpillPartition* spillPartition, bool skewed) {
   VELOX_CHECK_NULL(spiller_);
   VELOX_CHECK_NULL(spillInputReader_);
 
@@ -217,13 +233,28 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
               << spillPartition->toString()
               << ", memory pool: " << pool()->name();
 
-    spillInputReader_ = spillPartition->createUnorderedReader(pool());
+    spillInputReader_ =
+        spillPartition->createUnorderedReader(pool(), spillConfig());
 
     const auto startBit = spillPartition->id().partitionBitOffset() +
         spillConfig.joinPartitionBits;
+    const bool exceededMaxSpillLevel =
+        spillConfig.exceedJoinSpillLevelLimit(startBit);
+    // Repartitioning a skewed partition doesn't split its dominant keys. It is
+    // built and probed in memory-bounded chunks instead.
+    if ((skewed || exceededMaxSpillLevel) && skewFallbackEnabled_) {
+      LOG(INFO) << "Restore skewed spill partition "
+                << spillPartition->id().toString() << " in chunks of "
+                << succinctBytes(skewChunkBytes_)
+                << ", exceeded max spill level: " << exceededMaxSpillLevel
+                << ", memory pool: " << pool()->name();
+      restoringSkewedPartition_ = true;
+      startedSkewFallback_ = true;
+      return;
+    }
     // Disable spilling if exceeding the max spill level and the query might run
     // out of memory if the restored partition still can't fit in memory.
-    if (spillConfig.exceedJoinSpillLevelLimit(startBit)) {
+    if (exceededMaxSpillLevel) {
       RECORD_METRIC_VALUE(kMetricMaxSpillLevelExceededCount);
       LOG(WARNING) << "Exceeded spill level limit: "
                    << spillConfig.maxSpillLevel
@@ -803,6 +834,17 @@ bool HashBuild::finishHashBuild() {
     }
   }
   recordSpillStats();
+  recordSpillPartitionStats(spillPartitions);
+  auto skewedSpillPartitionIds = findSkewedSpillPartitions(spillPartitions);
+
+  bool hasMoreSkewChunks{false};
+  if (restoringSkewedPartition_) {
+    hasMoreSkewChunks = hasMoreSkewInput_;
+    for (auto* build : otherBuilds) {
+      VELOX_CHECK(build->restoringSkewedPartition_);
+      hasMoreSkewChunks |= build->hasMoreSkewInput_;
+    }
+  }
 
   // TODO: re-enable parallel join build with spilling triggered after
   // https://github.com/facebookincubator/velox/issues/3567 is fixed.
@@ -813,8 +855,16 @@ bool HashBuild::finishHashBuild() {
       allowParallelJoinBuild ? operatorCtx_->task()->queryCtx()->executor()
                              : nullptr);
   addRuntimeStats();
+  auto bloomFilters = spillPartitions.empty()
+      ? createBloomFilters(numRows)
+      : std::vector<std::shared_ptr<common::Filter>>{};
   if (joinBridge_->setHashTable(
-          std::move(table_), std::move(spillPartitions), joinHasNullKeys_)) {
+          std::move(table_),
+          std::move(spillPartitions),
+          joinHasNullKeys_,
+          std::move(bloomFilters),
+          std::move(skewedSpillPartitionIds),
+          hasMoreSkewChunks)) {
     spillGroup_->restart();
   }
 
@@ -824,6 +874,161 @@ bool HashBuild::finishHashBuild() {
   return true;
 }
 
+namespace {
+// Returns true if a Bloom filter should be built for the join key of
+// 'hasher'. This is the case if the key type is supported and HashProbe can't
+// push down an IN-list of the distinct key values instead.
+bool needsBloomFilter(const VectorHasher& hasher, bool isHashMode) {
+  switch (hasher.typeKind()) {
+    case TypeKind::TINYINT:
+      [[fallthrough]];
+    case TypeKind::SMALLINT:
+      [[fallthrough]];
+    case TypeKind::INTEGER:
+      [[fallthrough]];
+    case TypeKind::BIGINT:
+      return isHashMode || hasher.distinctOverflow();
+    case TypeKind::VARCHAR:
+      [[fallthrough]];
+    case TypeKind::VARBINARY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+using BloomFilterType = common::BloomFilterValues::BloomFilterType;
+
+// Allocates the Bloom filters of a hash join build from the memory pool of the
+// HashBuild operator. The filters are pushed down to the probe side and may
+// outlive the operator, so this keeps a reference to the pool.
+class PoolBloomFilterMemory : public common::BloomFilterMemory {
+ public:
+  explicit PoolBloomFilterMemory(std::shared_ptr<memory::MemoryPool> pool)
+      : pool_(std::move(pool)) {}
+
+  void* allocate(size_t bytes) override {
+    return pool_->allocate(bytes);
+  }
+
+  void free(void* p, size_t bytes) override {
+    pool_->free(p, bytes);
+  }
+
+ private:
+  const std::shared_ptr<memory::MemoryPool> pool_;
+};
+
+template <typename T>
+void addToBloomFilter(
+    const DecodedVector& keys,
+    vector_size_t numKeys,
+    BloomFilterType& bloomFilter) {
+  for (vector_size_t i = 0; i < numKeys; ++i) {
+    if (keys.isNullAt(i)) {
+      continue;
+    }
+    if constexpr (std::is_same_v<T, StringView>) {
+      const auto value = keys.valueAt<StringView>(i);
+      bloomFilter.insert(common::BloomFilterValues::hashBytes(
+          std::string_view(value.data(), value.size())));
+    } else {
+      bloomFilter.insert(
+          common::BloomFilterValues::hashInt64(keys.valueAt<T>(i)));
+    }
+  }
+}
+
+void addToBloomFilter(
+    const DecodedVector& keys,
+    vector_size_t numKeys,
+    BloomFilterType& bloomFilter) {
+  switch (keys.base()->typeKind()) {
+    case TypeKind::TINYINT:
+      addToBloomFilter<int8_t>(keys, numKeys, bloomFilter);
+      break;
+    case TypeKind::SMALLINT:
+      addToBloomFilter<int16_t>(keys, numKeys, bloomFilter);
+      break;
+    case TypeKind::INTEGER:
+      addToBloomFilter<int32_t>(keys, numKeys, bloomFilter);
+      break;
+    case TypeKind::BIGINT:
+      addToBloomFilter<int64_t>(keys, numKeys, bloomFilter);
+      break;
+    case TypeKind::VARCHAR:
+      [[fallthrough]];
+    case TypeKind::VARBINARY:
+      addToBloomFilter<StringView>(keys, numKeys, bloomFilter);
+      break;
+    default:
+      VELOX_UNREACHABLE(
+          "Unsupported Bloom filter key type: {}",
+          keys.base()->type()->toString());
+  }
+}
+} // namespace
+
+std::vector<std::shared_ptr<common::Filter>> HashBuild::createBloomFilters(
+    uint64_t numRows) {
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  if (!queryConfig.hashJoinBloomFilterEnabled() || numRows == 0 ||
+      numRows > queryConfig.hashJoinBloomFilterMaxRows()) {
+    return {};
+  }
+  // NOTE: HashProbe only pushes down dynamic filters for these join types.
+  if (!isInnerJoin(joinType_) && !isLeftSemiFilterJoin(joinType_) &&
+      !isRightSemiFilterJoin(joinType_) && !isRightSemiProjectJoin(joinType_)) {
+    return {};
+  }
+
+  const auto& hashers = table_->hashers();
+  const bool isHashMode = table_->hashMode() == BaseHashTable::HashMode::kHash;
+  std::vector<std::shared_ptr<BloomFilterType>> bloomFilters(hashers.size());
+  std::vector<column_index_t> bloomFilterKeys;
+  const common::BloomFilterAllocator<uint64_t> allocator(
+      std::make_shared<PoolBloomFilterMemory>(pool()->shared_from_this()));
+  for (column_index_t i = 0; i < hashers.size(); ++i) {
+    if (!needsBloomFilter(*hashers[i], isHashMode)) {
+      continue;
+    }
+    bloomFilters[i] = std::make_shared<BloomFilterType>(allocator);
+    bloomFilters[i]->reset(numRows);
+    bloomFilterKeys.push_back(i);
+  }
+  if (bloomFilterKeys.empty()) {
+    return {};
+  }
+
+  constexpr int32_t kBatchSize = 1'024;
+  std::vector<char*> rows(kBatchSize);
+  std::vector<VectorPtr> keys(hashers.size());
+  DecodedVector decodedKeys;
+  BaseHashTable::RowsIterator iter;
+  for (;;) {
+    const auto numBatchRows = table_->listAllRows(
+        &iter, kBatchSize, RowContainer::kUnlimited, rows.data());
+    if (numBatchRows == 0) {
+      break;
+    }
+    for (auto key : bloomFilterKeys) {
+      if (keys[key] == nullptr) {
+        keys[key] = BaseVector::create(hashers[key]->type(), 0, pool());
+      }
+      table_->rows()->extractColumn(rows.data(), numBatchRows, key, keys[key]);
+      decodedKeys.decode(*keys[key]);
+      addToBloomFilter(decodedKeys, numBatchRows, *bloomFilters[key]);
+    }
+  }
+
+  std::vector<std::shared_ptr<common::Filter>> filters(hashers.size());
+  for (auto key : bloomFilterKeys) {
+    filters[key] = std::make_shared<common::BloomFilterValues>(
+        std::move(bloomFilters[key]), false);
+  }
+  return filters;
+}
+
 void HashBuild::recordSpillStats() {
   if (spiller_ != nullptr) {
     const auto spillStats = spiller_->stats();
@@ -835,6 +1040,53 @@ void HashBuild::recordSpillStats() {
     spillStats.spillMaxLevelExceededCount = 1;
     Operator::recordSpillStats(spillStats);
   }
+  if (startedSkewFallback_) {
+    startedSkewFallback_ = false;
+    common::SpillStats spillStats;
+    spillStats.spillSkewFallbackCount = 1;
+    Operator::recordSpillStats(spillStats);
+  }
+}
+
+void HashBuild::recordSpillPartitionStats(
+    const SpillPartitionSet& spillPartitions) {
+  if (spillPartitions.empty()) {
+    return;
+  }
+  common::SpillStats spillStats;
+  for (const auto& [id, partition] : spillPartitions) {
+    const auto level = std::min<int32_t>(
+        spillConfig()->joinSpillLevel(id.partitionBitOffset()),
+        common::SpillStats::kNumSpillLevels - 1);
+    spillStats.spilledPartitionBytesByLevel[level] += partition->size();
+  }
+  Operator::recordSpillStats(spillStats);
+}
+
+SpillPartitionIdSet HashBuild::findSkewedSpillPartitions(
+    const SpillPartitionSet& spillPartitions) const {
+  // The partitions spilled while building from the original input are split
+  // by the hash bits for the first time. Only a failure to split a restored
+  // partition again indicates skew.
+  if (!skewFallbackEnabled_ || !isInputFromSpill() || spillPartitions.empty()) {
+    return {};
+  }
+  uint64_t totalBytes{0};
+  const SpillPartition* largest{nullptr};
+  for (const auto& [id, partition] : spillPartitions) {
+    totalBytes += partition->size();
+    if (largest == nullptr || partition->size() > largest->size()) {
+      largest = partition.get();
+    }
+  }
+  if (largest->size() * 100 < totalBytes * skewPartitionPct_) {
+    return {};
+  }
+  LOG(INFO) << "Spill partition " << largest->id().toString() << " has "
+            << succinctBytes(largest->size()) << " of "
+            << succinctBytes(totalBytes)
+            << " spilled bytes and is restored through the skew fallback";
+  return {largest->id()};
 }
 
 void HashBuild::ensureTableFits(uint64_t numRows) {
@@ -882,6 +1134,21 @@ void HashBuild::postHashBuildProcess() {
 void HashBuild::setupSpillInput(HashJoinBridge::SpillInput spillInput) {
   checkRunning();
 
+  if (spillInput.nextSkewChunk) {
+    // Builds the next chunk of the skewed partition from the rest of the shard
+    // read so far.
+    VELOX_CHECK(restoringSkewedPartition_);
+    VELOX_CHECK_NOT_NULL(spillInputReader_);
+    table_.reset();
+    setupTable();
+    if (!hasMoreSkewInput_) {
+      noMoreInputInternal();
+      return;
+    }
+    processSpillInput();
+    return;
+  }
+
   if (spillInput.spillPartition == nullptr) {
     setState(State::kFinish);
     return;
@@ -890,6 +1157,8 @@ void HashBuild::setupSpillInput(HashJoinBridge::SpillInput spillInput) {
   table_.reset();
   spiller_.reset();
   spillInputReader_.reset();
+  restoringSkewedPartition_ = false;
+  hasMoreSkewInput_ = false;
 
   // Reset the key and dependent channels as the spilled data columns have
   // already been ordered.
@@ -900,7 +1169,7 @@ void HashBuild::setupSpillInput(HashJoinBridge::SpillInput spillInput) {
       keyChannels_.size());
 
   setupTable();
-  setupSpiller(spillInput.spillPartition.get());
+  setupSpiller(spillInput.spillPartition.get(), spillInput.skewed);
 
   // Start to process spill input.
   processSpillInput();
@@ -914,12 +1183,21 @@ void HashBuild::processSpillInput() {
     if (!isRunning()) {
       return;
     }
+    if (restoringSkewedPartition_ &&
+        pool()->currentBytes() >= skewChunkBytes_) {
+      // Hands the chunk read so far over to the probe side. The rest of the
+      // shard is read for the next chunk.
+      hasMoreSkewInput_ = true;
+      noMoreInputInternal();
+      return;
+    }
     if (operatorCtx_->driver()->shouldYield()) {
       state_ = State::kYield;
       future_ = ContinueFuture{folly::Unit{}};
       return;
     }
   }
+  hasMoreSkewInput_ = false;
   noMoreInputInternal();
 }
 
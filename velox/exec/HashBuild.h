@@ -137,7 +137,23 @@ class HashBuild final : public Operator {
   // source. The function will need to setup a spill input reader to read input
   // from the spilled data for restoring. If the spilled data can't still fit
   // in memory, then we will recursively spill part(s) of its data on disk.
-  void setupSpiller(SpillPartition* spillPartition = nullptr);
+  // If 'skewed' is true or the partition is past the max spill level, the
+  // partition is restored through the skew fallback instead if
+  // 'skewFallbackEnabled_' is true: no spiller is set up and the partition is
+  // read in chunks of up to 'skewChunkBytes_'.
+  void setupSpiller(
+      SpillPartition* spillPartition = nullptr,
+      bool skewed = false);
+
+  // Returns the ids of the partitions in 'spillPartitions' which are spilled
+  // from a restored partition and hold at least 'skewPartitionPct_' of the
+  // spilled bytes. Repartitioning such a partition again is unlikely to split
+  // it as it is dominated by one or a few join keys.
+  SpillPartitionIdSet findSkewedSpillPartitions(
+      const SpillPartitionSet& spillPartitions) const;
+
+  // Records the spilled bytes of 'spillPartitions' per spill level.
+  void recordSpillPartitionStats(const SpillPartitionSet& spillPartitions);
 
   // Invoked when either there is no more input from the build source or from
   // the spill input reader during the restoring.
@@ -162,6 +178,15 @@ class HashBuild final : public Operator {
   // the query if the memory reservation fails.
   void ensureTableFits(uint64_t numRows);
 
+  // Invoked by the last build driver after the join table has been built from
+  // 'numRows' rows to build Bloom filters on the join keys which can't be
+  // pushed down to the probe side as ranges or IN-lists. Returns an empty
+  // vector if no Bloom filter has been built, otherwise one entry per join key
+  // which is null if there is no Bloom filter for that key. The filters are
+  // allocated from the memory pool of 'this'.
+  std::vector<std::shared_ptr<common::Filter>> createBloomFilters(
+      uint64_t numRows);
+
   // Invoked to reserve memory for 'input' if disk spilling is enabled. The
   // function returns true on success, otherwise false.
   bool reserveMemory(const RowVectorPtr& input);
@@ -260,6 +285,28 @@ class HashBuild final : public Operator {
 
   bool exceededMaxSpillLevelLimit_{false};
 
+  // True if skewed spilled partitions are restored in chunks. See
+  // QueryConfig::kJoinSpillSkewFallbackEnabled.
+  const bool skewFallbackEnabled_;
+
+  // See QueryConfig::kJoinSpillSkewPartitionPct.
+  const int32_t skewPartitionPct_;
+
+  // See QueryConfig::kJoinSpillSkewChunkBytes.
+  const uint64_t skewChunkBytes_;
+
+  // True if the partition being restored is read in chunks through the skew
+  // fallback.
+  bool restoringSkewedPartition_{false};
+
+  // True if this operator has stopped reading its shard of a skewed partition
+  // at the end of a chunk and there may be more input for the next chunk.
+  bool hasMoreSkewInput_{false};
+
+  // True if this operator has started the skew fallback for a partition since
+  // the spill stats were last recorded.
+  bool startedSkewFallback_{false};
+
   std::shared_ptr<SpillOperatorGroup> spillGroup_;
 
   State state_{State::kRunning};
@@ -32,7 +32,10 @@ void HashJoinBridge::addBuilder() {
 bool HashJoinBridge::setHashTable(
     std::unique_ptr<BaseHashTable> table,
     SpillPartitionSet spillPartitionSet,
-    bool hasNullKeys) {
+    bool hasNullKeys,
+    std::vector<std::shared_ptr<common::Filter>> bloomFilters,
+    SpillPartitionIdSet skewedSpillPartitionIds,
+    bool hasMoreSkewChunks) {
   VELOX_CHECK_NOT_NULL(table, "setHashTable called with null table");
 
   auto spillPartitionIdSet = toSpillPartitionIdSet(spillPartitionSet);
@@ -44,6 +47,8 @@ bool HashJoinBridge::setHashTable(
     VELOX_CHECK(started_);
     VELOX_CHECK(!buildResult_.has_value());
     VELOX_CHECK(restoringSpillShards_.empty());
+    VELOX_CHECK_EQ(numPendingSkewChunkBuilders_, 0);
+    VELOX_CHECK(!skewChunkPartitionId_.has_value());
 
     if (restoringSpillPartitionId_.has_value()) {
       for (const auto& id : spillPartitionIdSet) {
@@ -58,14 +63,25 @@ bool HashJoinBridge::setHashTable(
       VELOX_CHECK_EQ(spillPartitionSets_.count(id), 0);
       spillPartitionSets_.emplace(id, std::move(partitionEntry.second));
     }
+    for (const auto& id : skewedSpillPartitionIds) {
+      VELOX_CHECK_EQ(spillPartitionSets_.count(id), 1);
+      skewedSpillPartitionIds_.insert(id);
+    }
+    if (hasMoreSkewChunks) {
+      VELOX_CHECK(restoringSpillPartitionId_.has_value());
+      skewChunkPartitionId_ = restoringSpillPartitionId_;
+    }
     buildResult_ = HashBuildResult(
         std::move(table),
         std::move(restoringSpillPartitionId_),
         std::move(spillPartitionIdSet),
-        hasNullKeys);
+        hasNullKeys,
+        std::move(bloomFilters),
+        hasMoreSkewChunks);
     restoringSpillPartitionId_.reset();
+    restoringSkewedPartition_ = false;
 
-    hasSpillData = !spillPartitionSets_.empty();
+    hasSpillData = !spillPartitionSets_.empty() || hasMoreSkewChunks;
     promises = std::move(promises_);
   }
   notify(std::move(promises));
@@ -124,9 +140,20 @@ bool HashJoinBridge::probeFinished() {
     // table from the next spill partition now.
     buildResult_.reset();
 
-    if (!spillPartitionSets_.empty()) {
+    if (skewChunkPartitionId_.has_value()) {
+      // The HashBuild operators continue to read their shards of the skewed
+      // partition to build its next chunk.
+      hasSpillInput = true;
+      restoringSpillPartitionId_ = std::move(skewChunkPartitionId_);
+      skewChunkPartitionId_.reset();
+      restoringSkewedPartition_ = true;
+      numPendingSkewChunkBuilders_ = numBuilders_;
+      promises = std::move(promises_);
+    } else if (!spillPartitionSets_.empty()) {
       hasSpillInput = true;
       restoringSpillPartitionId_ = spillPartitionSets_.begin()->first;
+      restoringSkewedPartition_ =
+          skewedSpillPartitionIds_.erase(*restoringSpillPartitionId_) > 0;
       restoringSpillShards_ =
           spillPartitionSets_.begin()->second->split(numBuilders_);
       VELOX_CHECK_EQ(restoringSpillShards_.size(), numBuilders_);
@@ -149,7 +176,7 @@ std::optional<HashJoinBridge::SpillInput> HashJoinBridge::spillInputOrFuture(
       !restoringSpillPartitionId_.has_value() || !buildResult_.has_value());
 
   if (!restoringSpillPartitionId_.has_value()) {
-    if (spillPartitionSets_.empty()) {
+    if (spillPartitionSets_.empty() && !skewChunkPartitionId_.has_value()) {
       return HashJoinBridge::SpillInput{};
     } else {
       promises_.emplace_back("HashJoinBridge::spillInputOrFuture");
@@ -157,10 +184,14 @@ std::optional<HashJoinBridge::SpillInput> HashJoinBridge::spillInputOrFuture(
       return std::nullopt;
     }
   }
+  if (numPendingSkewChunkBuilders_ > 0) {
+    --numPendingSkewChunkBuilders_;
+    return SpillInput(nullptr, true, true);
+  }
   VELOX_CHECK(!restoringSpillShards_.empty());
   auto spillShard = std::move(restoringSpillShards_.back());
   restoringSpillShards_.pop_back();
-  return SpillInput(std::move(spillShard));
+  return SpillInput(std::move(spillShard), restoringSkewedPartition_);
 }
 
 bool isLeftNullAwareJoinWithFilter(
@@ -19,6 +19,7 @@
 #include "velox/exec/JoinBridge.h"
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/Spill.h"
+#include "velox/type/Filter.h"
 
 namespace facebook::velox::exec {
 
@@ -38,11 +39,24 @@ class HashJoinBridge : public JoinBridge {
   /// 'spillPartitionSet' contains the spilled partitions while building
   /// 'table'. The function returns true if there is spill data to restore
   /// after HashProbe operators process 'table', otherwise false. This only
-  /// applies if the disk spilling is enabled.
+  /// applies if the disk spilling is enabled. 'bloomFilters' contains the
+  /// optional Bloom filters built on the join keys of 'table' to push down to
+  /// the probe side. It is either empty or has one entry per join key which is
+  /// null if no Bloom filter has been built for that key.
+  /// 'skewedSpillPartitionIds' is the subset of the partitions in
+  /// 'spillPartitionSet' which are to be restored through the skew fallback:
+  /// their build side is restored in memory-bounded chunks and each chunk is
+  /// probed with all the spilled probe rows of the partition.
+  /// 'hasMoreSkewChunks' is true if 'table' is a chunk of a skewed partition
+  /// and more chunks of that partition remain to be built after the probe side
+  /// has processed 'table'.
   bool setHashTable(
       std::unique_ptr<BaseHashTable> table,
       SpillPartitionSet spillPartitionSet,
-      bool hasNullKeys);
+      bool hasNullKeys,
+      std::vector<std::shared_ptr<common::Filter>> bloomFilters = {},
+      SpillPartitionIdSet skewedSpillPartitionIds = {},
+      bool hasMoreSkewChunks = false);
 
   void setAntiJoinHasNullKeys();
 
@@ -57,11 +71,15 @@ class HashJoinBridge : public JoinBridge {
         std::shared_ptr<BaseHashTable> _table,
         std::optional<SpillPartitionId> _restoredPartitionId,
         SpillPartitionIdSet _spillPartitionIds,
-        bool _hasNullKeys)
+        bool _hasNullKeys,
+        std::vector<std::shared_ptr<common::Filter>> _bloomFilters = {},
+        bool _hasMoreSkewChunks = false)
         : hasNullKeys(_hasNullKeys),
           table(std::move(_table)),
           restoredPartitionId(std::move(_restoredPartitionId)),
-          spillPartitionIds(std::move(_spillPartitionIds)) {}
+          spillPartitionIds(std::move(_spillPartitionIds)),
+          bloomFilters(std::move(_bloomFilters)),
+          hasMoreSkewChunks(_hasMoreSkewChunks) {}
 
     HashBuildResult() : hasNullKeys(true) {}
 
@@ -69,6 +87,12 @@ class HashJoinBridge : public JoinBridge {
     std::shared_ptr<BaseHashTable> table;
     std::optional<SpillPartitionId> restoredPartitionId;
     SpillPartitionIdSet spillPartitionIds;
+    std::vector<std::shared_ptr<common::Filter>> bloomFilters;
+    /// True if 'table' is a chunk of the skewed partition
+    /// 'restoredPartitionId' and more chunks of it will follow. The probe side
+    /// then keeps the spilled probe data of the partition to read it again
+    /// for the next chunk.
+    bool hasMoreSkewChunks{false};
   };
 
   /// Invoked by HashProbe operator to get the table to probe which is built by
@@ -87,13 +111,22 @@ class HashJoinBridge : public JoinBridge {
 
   /// Contains the spill input for one HashBuild operator: a shard of previously
   /// spilled partition data. 'spillPartition' is null if there is no more spill
-  /// data to restore.
+  /// data to restore. 'skewed' is true if the partition is to be restored
+  /// through the skew fallback. 'nextSkewChunk' is true if the HashBuild
+  /// operator is to build the next chunk of the skewed partition from the
+  /// shard it is already reading. 'spillPartition' is null in this case.
   struct SpillInput {
     explicit SpillInput(
-        std::unique_ptr<SpillPartition> spillPartition = nullptr)
-        : spillPartition(std::move(spillPartition)) {}
+        std::unique_ptr<SpillPartition> spillPartition = nullptr,
+        bool skewed = false,
+        bool nextSkewChunk = false)
+        : spillPartition(std::move(spillPartition)),
+          skewed(skewed),
+          nextSkewChunk(nextSkewChunk) {}
 
     std::unique_ptr<SpillPartition> spillPartition;
+    bool skewed;
+    bool nextSkewChunk;
   };
 
   /// Invoked by HashBuild operator to get one of previously spilled partition
@@ -129,6 +162,22 @@ class HashJoinBridge : public JoinBridge {
   // This set can grow if HashBuild operator cannot load full partition in
   // memory and engages in recursive spilling.
   SpillPartitionSet spillPartitionSets_;
+
+  // The partitions in 'spillPartitionSets_' to restore through the skew
+  // fallback.
+  SpillPartitionIdSet skewedSpillPartitionIds_;
+
+  // True if 'restoringSpillPartitionId_' is restored through the skew
+  // fallback.
+  bool restoringSkewedPartition_{false};
+
+  // Set to the skewed partition of the current table if more chunks of it
+  // remain to be built once the probe side has finished with the table.
+  std::optional<SpillPartitionId> skewChunkPartitionId_;
+
+  // The number of HashBuild operators which have yet to be told to build the
+  // next chunk of the skewed partition 'restoringSpillPartitionId_'.
+  uint32_t numPendingSkewChunkBuilders_{0};
 };
 
 // Indicates if 'joinNode' is null-aware anti or left semi project join type and
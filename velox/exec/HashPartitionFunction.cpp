@@ -56,13 +56,7 @@ void HashPartitionFunction::init(
   }
 }
 
-std::optional<uint32_t> HashPartitionFunction::partition(
-    const RowVector& input,
-    std::vector<uint32_t>& partitions) {
-  if (hashers_.empty()) {
-    return 0u;
-  }
-
+void HashPartitionFunction::computeHashes(const RowVector& input) {
   const auto size = input.size();
   rows_.resize(size);
   rows_.setAll();
@@ -77,7 +71,18 @@ std::optional<uint32_t> HashPartitionFunction::partition(
       hashers_[i]->hashPrecomputed(rows_, i > 0, hashes_);
     }
   }
+}
+
+std::optional<uint32_t> HashPartitionFunction::partition(
+    const RowVector& input,
+    std::vector<uint32_t>& partitions) {
+  if (hashers_.empty()) {
+    return 0u;
+  }
 
+  computeHashes(input);
+
+  const auto size = input.size();
   partitions.resize(size);
   if (hashBitRange_.has_value()) {
     for (auto i = 0; i < size; ++i) {
@@ -150,4 +155,143 @@ core::PartitionFunctionSpecPtr HashPartitionFunctionSpec::deserialize(
   return std::make_shared<HashPartitionFunctionSpec>(
       ISerializable::deserialize<RowType>(obj["inputType"]), keys, constValues);
 }
+
+SkewedHashPartitionFunction::SkewedHashPartitionFunction(
+    int numPartitions,
+    const RowTypePtr& inputType,
+    const std::vector<column_index_t>& keyChannels)
+    : HashPartitionFunction(numPartitions, inputType, keyChannels) {
+  VELOX_CHECK(!keyChannels.empty());
+  for (const auto channel : keyChannels) {
+    VELOX_CHECK_NE(channel, kConstantChannel);
+  }
+  summary_.setCapacity(kSummaryCapacity);
+}
+
+std::optional<uint32_t> SkewedHashPartitionFunction::partition(
+    const RowVector& input,
+    std::vector<uint32_t>& partitions) {
+  computeHashes(input);
+
+  const auto size = input.size();
+  updateHotKeys(size);
+
+  partitions.resize(size);
+  if (hotKeys_.empty()) {
+    for (auto i = 0; i < size; ++i) {
+      partitions[i] = hashes_[i] % numPartitions_;
+    }
+    return std::nullopt;
+  }
+
+  for (auto i = 0; i < size; ++i) {
+    const auto hash = hashes_[i];
+    auto it = hotKeys_.find(hash);
+    if (it == hotKeys_.end()) {
+      partitions[i] = hash % numPartitions_;
+      continue;
+    }
+    auto& hotKey = it->second;
+    if (!isHotKey(input, i, hotKey)) {
+      partitions[i] = hash % numPartitions_;
+      continue;
+    }
+    const auto offset = hotKey.next++ % hotKey.numPartitions;
+    partitions[i] = (hash % numPartitions_ + offset) % numPartitions_;
+    if (offset != 0) {
+      ++numHotKeyRows_;
+    }
+  }
+  return std::nullopt;
+}
+
+bool SkewedHashPartitionFunction::isHotKey(
+    const RowVector& input,
+    vector_size_t row,
+    HotKey& hotKey) {
+  if (hotKey.values.empty()) {
+    // The hot key is most likely the one of the first row with its hash.
+    hotKey.values.reserve(hashers_.size());
+    for (const auto& hasher : hashers_) {
+      const auto& column = input.childAt(hasher->channel());
+      auto value = BaseVector::create(column->type(), 1, input.pool());
+      value->copy(column.get(), 0, row, 1);
+      hotKey.values.push_back(std::move(value));
+    }
+    return true;
+  }
+  for (auto i = 0; i < hashers_.size(); ++i) {
+    if (!input.childAt(hashers_[i]->channel())
+             ->equalValueAt(hotKey.values[i].get(), row, 0)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void SkewedHashPartitionFunction::updateHotKeys(vector_size_t numRows) {
+  auto row = nextSample_;
+  for (; row < numRows; row += kSampleStride) {
+    summary_.insert(hashes_[row]);
+    ++numSampledRows_;
+  }
+  nextSample_ = row - numRows;
+
+  if (numSampledRows_ < kMinSampledRows || numPartitions_ == 1) {
+    return;
+  }
+
+  folly::F14FastMap<uint64_t, HotKey> hotKeys;
+  for (const auto& [hash, count] : summary_.topK(kMaxHotKeys)) {
+    // Number of partitions' fair shares of rows taken by this key.
+    const auto shares = count * numPartitions_ / numSampledRows_;
+    if (shares < 1) {
+      // 'topK' is sorted by count.
+      break;
+    }
+    HotKey hotKey{static_cast<uint32_t>(
+        std::min<int64_t>(shares + 1, numPartitions_))};
+    if (auto it = hotKeys_.find(hash); it != hotKeys_.end()) {
+      hotKey.next = it->second.next;
+      hotKey.values = std::move(it->second.values);
+    }
+    hotKeys.emplace(hash, hotKey);
+  }
+  hotKeys_ = std::move(hotKeys);
+}
+
+std::unique_ptr<core::PartitionFunction>
+SkewedHashPartitionFunctionSpec::create(int numPartitions) const {
+  return std::make_unique<exec::SkewedHashPartitionFunction>(
+      numPartitions, inputType_, keyChannels_);
+}
+
+std::string SkewedHashPartitionFunctionSpec::toString() const {
+  std::ostringstream keys;
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    if (i > 0) {
+      keys << ", ";
+    }
+    keys << inputType_->nameOf(keyChannels_[i]);
+  }
+  return fmt::format("SKEWED HASH({})", keys.str());
+}
+
+folly::dynamic SkewedHashPartitionFunctionSpec::serialize() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["name"] = "SkewedHashPartitionFunctionSpec";
+  obj["inputType"] = inputType_->serialize();
+  obj["keyChannels"] = ISerializable::serialize(keyChannels_);
+  return obj;
+}
+
+// static
+core::PartitionFunctionSpecPtr SkewedHashPartitionFunctionSpec::deserialize(
+    const folly::dynamic& obj,
+    void* context) {
+  return std::make_shared<SkewedHashPartitionFunctionSpec>(
+      ISerializable::deserialize<RowType>(obj["inputType"]),
+      ISerializable::deserialize<std::vector<column_index_t>>(
+          obj["keyChannels"], context));
+}
 } // namespace facebook::velox::exec
@@ -15,9 +15,11 @@
  */
 #pragma once
 
+#include <folly/container/F14Map.h>
 #include <velox/exec/HashBitRange.h>
 #include <velox/exec/VectorHasher.h>
 #include "velox/core/PlanNode.h"
+#include "velox/functions/lib/ApproxMostFrequentStreamSummary.h"
 
 namespace facebook::velox::exec {
 
@@ -51,11 +53,10 @@ class HashPartitionFunction : public core::PartitionFunction {
     return numPartitions_;
   }
 
- private:
-  void init(
-      const RowTypePtr& inputType,
-      const std::vector<column_index_t>& keyChannels,
-      const std::vector<VectorPtr>& constValues);
+ protected:
+  /// Computes the hashes of the partitioning keys of 'input' into 'hashes_'.
+  /// Requires non-empty 'hashers_'.
+  void computeHashes(const RowVector& input);
 
   const int numPartitions_;
   const std::optional<HashBitRange> hashBitRange_ = std::nullopt;
@@ -64,6 +65,88 @@ class HashPartitionFunction : public core::PartitionFunction {
   // Reusable memory.
   SelectivityVector rows_;
   raw_vector<uint64_t> hashes_;
+
+ private:
+  void init(
+      const RowTypePtr& inputType,
+      const std::vector<column_index_t>& keyChannels,
+      const std::vector<VectorPtr>& constValues);
+};
+
+/// Hash partitions rows like HashPartitionFunction but spreads the rows of
+/// frequent keys over several partitions. Keeps approximate counts of the most
+/// frequent key hashes in a sample of the rows. A key whose share of the rows
+/// is more than 1 / numPartitions is hot. Rows of a hot key are assigned
+/// round-robin to as many consecutive partitions, starting at the key's hash
+/// partition, as needed to bring its share per partition below that.
+///
+/// Hot keys are tracked by their hash. The key values of the first row seen
+/// with the hash of a new hot key are kept, and only the rows with these values
+/// are spread, so that a key whose hash collides with a hot key stays in its
+/// hash partition.
+///
+/// Rows with the same key may land in different partitions and nothing
+/// replicates the rows of the other side of a join to the partitions of a
+/// spread key. This is unsafe for all the plans which rely on the co-location
+/// of the keys, e.g. final aggregations, partitioned hash joins and windows.
+/// A PartitionedOutputNode accepts the function only with
+/// 'requireColocatedKeys' set to false. See
+/// core::PartitionFunctionSpec::colocatesKeys().
+class SkewedHashPartitionFunction : public HashPartitionFunction {
+ public:
+  SkewedHashPartitionFunction(
+      int numPartitions,
+      const RowTypePtr& inputType,
+      const std::vector<column_index_t>& keyChannels);
+
+  std::optional<uint32_t> partition(
+      const RowVector& input,
+      std::vector<uint32_t>& partitions) override;
+
+  /// Returns the number of currently hot keys.
+  size_t numHotKeys() const {
+    return hotKeys_.size();
+  }
+
+  /// Returns the number of rows assigned to partitions other than their hash
+  /// partition's because their key was hot.
+  uint64_t numHotKeyRows() const {
+    return numHotKeyRows_;
+  }
+
+ private:
+  // One in this many rows is added to 'summary_'.
+  static constexpr int32_t kSampleStride = 8;
+  // Number of key hashes tracked by 'summary_'.
+  static constexpr int32_t kSummaryCapacity = 64;
+  // Maximum number of hot keys.
+  static constexpr int32_t kMaxHotKeys = 16;
+  // Number of sampled rows before any key is considered hot.
+  static constexpr int64_t kMinSampledRows = 1'000;
+
+  struct HotKey {
+    // Number of partitions the rows of the key are spread over.
+    uint32_t numPartitions;
+    // Round-robin counter over 'numPartitions'.
+    uint32_t next{0};
+    // Single row vectors with the values of the key columns. Empty until the
+    // first row with the hash of the key is seen.
+    std::vector<VectorPtr> values;
+  };
+
+  // Samples 'hashes_' into 'summary_' and recomputes 'hotKeys_'.
+  void updateHotKeys(vector_size_t numRows);
+
+  // Returns true if the keys of 'row' in 'input' are equal to 'hotKey''s
+  // values. Sets the values from 'row' if they are not set yet.
+  bool isHotKey(const RowVector& input, vector_size_t row, HotKey& hotKey);
+
+  functions::ApproxMostFrequentStreamSummary<uint64_t> summary_;
+  int64_t numSampledRows_{0};
+  // Offset of the next row to sample in the next batch.
+  int32_t nextSample_{0};
+  folly::F14FastMap<uint64_t, HotKey> hotKeys_;
+  uint64_t numHotKeyRows_{0};
 };
 
 /// Factory class to create HashPartitionFunction
@@ -97,4 +180,35 @@ class HashPartitionFunctionSpec : public core::PartitionFunctionSpec {
   const std::vector<column_index_t> keyChannels_;
   const std::vector<VectorPtr> constValues_;
 };
+
+/// Factory class to create SkewedHashPartitionFunction. 'keyChannels' must not
+/// be empty or contain constants.
+class SkewedHashPartitionFunctionSpec : public core::PartitionFunctionSpec {
+ public:
+  SkewedHashPartitionFunctionSpec(
+      RowTypePtr inputType,
+      std::vector<column_index_t> keyChannels)
+      : inputType_{std::move(inputType)}, keyChannels_{std::move(keyChannels)} {
+  }
+
+  std::unique_ptr<core::PartitionFunction> create(
+      int numPartitions) const override;
+
+  std::string toString() const override;
+
+  /// Returns false as the rows of hot keys are spread over several partitions.
+  bool colocatesKeys() const override {
+    return false;
+  }
+
+  folly::dynamic serialize() const override;
+
+  static core::PartitionFunctionSpecPtr deserialize(
+      const folly::dynamic& obj,
+      void* context);
+
+ private:
+  const RowTypePtr inputType_;
+  const std::vector<column_index_t> keyChannels_;
+};
 } // namespace facebook::velox::exec
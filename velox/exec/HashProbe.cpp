@@ -222,7 +222,8 @@ void HashProbe::initializeFilter(
 
 void HashProbe::maybeSetupSpillInput(
     const std::optional<SpillPartitionId>& restoredPartitionId,
-    const SpillPartitionIdSet& spillPartitionIds) {
+    const SpillPartitionIdSet& spillPartitionIds,
+    bool hasMoreSkewChunks) {
   VELOX_CHECK_NULL(spillInputReader_);
 
   // If 'restoredPartitionId' is not null, then 'table_' is built from the
@@ -231,10 +232,21 @@ void HashProbe::maybeSetupSpillInput(
   if (restoredPartitionId.has_value()) {
     auto iter = spillPartitionSet_.find(restoredPartitionId.value());
     VELOX_CHECK(iter != spillPartitionSet_.end());
-    auto partition = std::move(iter->second);
-    VELOX_CHECK_EQ(partition->id(), restoredPartitionId.value());
-    spillInputReader_ = partition->createUnorderedReader(pool());
-    spillPartitionSet_.erase(iter);
+    VELOX_CHECK_EQ(iter->second->id(), restoredPartitionId.value());
+    if (hasMoreSkewChunks) {
+      // 'table_' is one chunk of a skewed build partition. The probe partition
+      // is read again for each following chunk, so we read from a copy of its
+      // spill files and keep the partition.
+      VELOX_CHECK(spillPartitionIds.empty());
+      SpillPartition partition(iter->first, iter->second->files());
+      spillInputReader_ =
+          partition.createUnorderedReader(pool(), &spillConfig_.value());
+    } else {
+      auto partition = std::move(iter->second);
+      spillInputReader_ =
+          partition->createUnorderedReader(pool(), &spillConfig_.value());
+      spillPartitionSet_.erase(iter);
+    }
   }
 
   VELOX_CHECK_NULL(spiller_);
@@ -294,7 +306,9 @@ void HashProbe::asyncWaitForHashTable() {
   VELOX_CHECK_NOT_NULL(table_);
 
   maybeSetupSpillInput(
-      hashBuildResult->restoredPartitionId, hashBuildResult->spillPartitionIds);
+      hashBuildResult->restoredPartitionId,
+      hashBuildResult->spillPartitionIds,
+      hashBuildResult->hasMoreSkewChunks);
 
   if (table_->numDistinct() == 0) {
     if (skipProbeOnEmptyBuild()) {
@@ -312,24 +326,36 @@ void HashProbe::asyncWaitForHashTable() {
   } else if (
       (isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
        isRightSemiFilterJoin(joinType_) || isRightSemiProjectJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      !isSpillInput() && !hasMoreSpillData()) {
     // Find out whether there are any upstream operators that can accept
     // dynamic filters on all or a subset of the join keys. Create dynamic
-    // filters to push down.
+    // filters to push down. The keys with a small number of distinct values
+    // are pushed down as IN-lists. The others are pushed down as Bloom filters
+    // if the build side has built them.
     //
     // NOTE: this optimization is not applied in the following cases: (1) if the
     // probe input is read from spilled data and there is no upstream operators
     // involved; (2) if there is spill data to restore, then we can't filter
     // probe inputs solely based on the current table's join keys.
     const auto& buildHashers = table_->hashers();
+    const auto& bloomFilters = hashBuildResult->bloomFilters;
+    VELOX_CHECK(
+        bloomFilters.empty() || bloomFilters.size() == keyChannels_.size());
     auto channels = operatorCtx_->driverCtx()->driver->canPushdownFilters(
         this, keyChannels_);
     for (auto i = 0; i < keyChannels_.size(); i++) {
-      if (channels.find(keyChannels_[i]) != channels.end()) {
-        if (auto filter = buildHashers[i]->getFilter(false)) {
-          dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
-        }
+      if (channels.find(keyChannels_[i]) == channels.end()) {
+        continue;
+      }
+      std::shared_ptr<common::Filter> filter;
+      if (table_->hashMode() != BaseHashTable::HashMode::kHash) {
+        filter = buildHashers[i]->getFilter(false);
+      }
+      if (filter == nullptr && !bloomFilters.empty()) {
+        filter = bloomFilters[i];
+      }
+      if (filter != nullptr) {
+        dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
       }
     }
   }
@@ -491,9 +517,12 @@ void HashProbe::clearDynamicFilters() {
   // The join can be completely replaced with a pushed down
   // filter when the following conditions are met:
   //  * hash table has a single key with unique values,
-  //  * build side has no dependent columns.
+  //  * build side has no dependent columns,
+  //  * the pushed down filter is exact, i.e. not a Bloom filter.
   if (keyChannels_.size() == 1 && !table_->hasDuplicateKeys() &&
-      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty()) {
+      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty() &&
+      dynamicFilters_.begin()->second->kind() !=
+          common::FilterKind::kBloomFilterValues) {
     canReplaceWithDynamicFilter_ = true;
   }
 
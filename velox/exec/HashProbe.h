@@ -87,10 +87,12 @@ class HashProbe : public Operator {
   // 'restoredSpillPartitionId' is not null. If 'spillPartitionIds' is not
   // empty, then spilling has been triggered at the build side and the function
   // will set up a spiller and the associated data structures to spill probe
-  // inputs.
+  // inputs. If 'hasMoreSkewChunks' is true, the spilled probe partition is kept
+  // to be read again for the next chunk of the skewed build partition.
   void maybeSetupSpillInput(
       const std::optional<SpillPartitionId>& restoredSpillPartitionId,
-      const SpillPartitionIdSet& spillPartitionIds);
+      const SpillPartitionIdSet& spillPartitionIds,
+      bool hasMoreSkewChunks);
 
   // Sets up 'filter_' and related members.p
   void initializeFilter(
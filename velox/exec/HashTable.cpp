@@ -23,6 +23,10 @@
 #include "velox/exec/OperatorUtils.h"
 #include "velox/vector/VectorTypeUtils.h"
 
+#if XSIMD_WITH_SSE2
+#include <immintrin.h>
+#endif
+
 using facebook::velox::common::testutil::TestValue;
 
 namespace facebook::velox::exec {
@@ -124,6 +128,46 @@ class ProbeState {
     }
   }
 
+  // Same as firstProbe() but with the tags of the first bucket already loaded
+  // in 'tags' and the positions of the wanted tag in these in 'hits'.
+  template <Operation op = Operation::kProbe, typename Table>
+  inline void firstProbe(
+      const Table& table,
+      int32_t firstKey,
+      BaseHashTable::TagVector tags,
+      BaseHashTable::MaskType hits) {
+    tagsInTable_ = tags;
+    table.incrementTagLoads();
+    hits_ = hits;
+    if (hits_) {
+      loadNextHit<op>(table, firstKey);
+    }
+  }
+
+  // Calls firstProbe() on 'state1' to 'state4'. If 'useAvx512' is true, the
+  // tags of the 4 buckets are compared to the 4 wanted tags with a single
+  // AVX-512 instruction.
+  template <Operation op = Operation::kProbe, typename Table>
+  static inline void firstProbe4(
+      bool useAvx512,
+      const Table& table,
+      int32_t firstKey,
+      ProbeState& state1,
+      ProbeState& state2,
+      ProbeState& state3,
+      ProbeState& state4) {
+#if XSIMD_WITH_SSE2
+    if (useAvx512) {
+      firstProbe4Avx512<op>(table, firstKey, state1, state2, state3, state4);
+      return;
+    }
+#endif
+    state1.firstProbe<op>(table, firstKey);
+    state2.firstProbe<op>(table, firstKey);
+    state3.firstProbe<op>(table, firstKey);
+    state4.firstProbe<op>(table, firstKey);
+  }
+
   template <Operation op, typename Compare, typename Insert, typename Table>
   inline char* fullProbe(
       Table& table,
@@ -257,6 +301,56 @@ class ProbeState {
  private:
   static constexpr uint8_t kNotSet = 0xff;
 
+#if XSIMD_WITH_SSE2
+  // Loads the tags of the first buckets of 'state1' to 'state4' into one 64
+  // byte vector and compares these to the 4 wanted tags with one instruction.
+  // Must only be called if process::hasAvx512() is true.
+  template <Operation op, typename Table>
+  __attribute__((__target__("avx512f,avx512bw"))) static void
+  firstProbe4Avx512(
+      const Table& table,
+      int32_t firstKey,
+      ProbeState& state1,
+      ProbeState& state2,
+      ProbeState& state3,
+      ProbeState& state4) {
+    auto* tags = reinterpret_cast<uint8_t*>(table.table_);
+    const auto tags1 = BaseHashTable::loadTags(tags, state1.bucketOffset_);
+    const auto tags2 = BaseHashTable::loadTags(tags, state2.bucketOffset_);
+    const auto tags3 = BaseHashTable::loadTags(tags, state3.bucketOffset_);
+    const auto tags4 = BaseHashTable::loadTags(tags, state4.bucketOffset_);
+    __m512i tagsInTable = _mm512_castsi128_si512(tags1);
+    tagsInTable = _mm512_inserti32x4(tagsInTable, tags2, 1);
+    tagsInTable = _mm512_inserti32x4(tagsInTable, tags3, 2);
+    tagsInTable = _mm512_inserti32x4(tagsInTable, tags4, 3);
+    __m512i wantedTags = _mm512_castsi128_si512(state1.wantedTags_);
+    wantedTags = _mm512_inserti32x4(wantedTags, state2.wantedTags_, 1);
+    wantedTags = _mm512_inserti32x4(wantedTags, state3.wantedTags_, 2);
+    wantedTags = _mm512_inserti32x4(wantedTags, state4.wantedTags_, 3);
+    const uint64_t hits = _mm512_cmpeq_epi8_mask(tagsInTable, wantedTags);
+    state1.firstProbe<op>(
+        table,
+        firstKey,
+        tags1,
+        static_cast<BaseHashTable::MaskType>(hits));
+    state2.firstProbe<op>(
+        table,
+        firstKey,
+        tags2,
+        static_cast<BaseHashTable::MaskType>(hits >> 16));
+    state3.firstProbe<op>(
+        table,
+        firstKey,
+        tags3,
+        static_cast<BaseHashTable::MaskType>(hits >> 32));
+    state4.firstProbe<op>(
+        table,
+        firstKey,
+        tags4,
+        static_cast<BaseHashTable::MaskType>(hits >> 48));
+  }
+#endif
+
   template <Operation op, typename Table>
   inline void loadNextHit(Table& table, int32_t firstKey) {
     const int32_t hit = bits::getAndClearLastSetBit(hits_);
@@ -413,6 +507,53 @@ FOLLY_ALWAYS_INLINE void HashTable<ignoreNullKeys>::fullProbe(
       !isJoin && extraCheck);
 }
 
+template <bool ignoreNullKeys>
+template <bool isJoin, bool isNormalizedKey>
+void HashTable<ignoreNullKeys>::prefetchProbe(HashLookup& lookup) {
+  constexpr ProbeState::Operation op =
+      isJoin ? ProbeState::Operation::kProbe : ProbeState::Operation::kInsert;
+  constexpr int32_t kFirstKey =
+      isNormalizedKey ? -static_cast<int32_t>(sizeof(normalized_key_t)) : 0;
+  constexpr int32_t kGroupSize = kPrefetchProbeGroupSize;
+  static_assert(kGroupSize % 4 == 0);
+  ProbeState states[kGroupSize];
+  int32_t probeIndex = 0;
+  const int32_t numProbes = lookup.rows.size();
+  const vector_size_t* rows = lookup.rows.data();
+  const uint64_t* hashes = lookup.hashes.data();
+  const bool useAvx512 = process::hasAvx512();
+  for (; probeIndex + kGroupSize <= numProbes; probeIndex += kGroupSize) {
+    // Prefetches the buckets of all rows in the group.
+    for (int32_t i = 0; i < kGroupSize; ++i) {
+      const auto row = rows[probeIndex + i];
+      states[i].preProbe(*this, hashes[row], row);
+    }
+    // Compares the tags and prefetches the first matching row of each probe.
+    for (int32_t i = 0; i < kGroupSize; i += 4) {
+      ProbeState::firstProbe4<op>(
+          useAvx512,
+          *this,
+          kFirstKey,
+          states[i],
+          states[i + 1],
+          states[i + 2],
+          states[i + 3]);
+    }
+    // Compares the keys. In a group by, an earlier probe of the group may
+    // have inserted into a bucket whose tags a later probe has already
+    // loaded, so the later probes reload their tags.
+    for (int32_t i = 0; i < kGroupSize; ++i) {
+      fullProbe<isJoin, isNormalizedKey>(lookup, states[i], i > 0);
+    }
+  }
+  for (; probeIndex < numProbes; ++probeIndex) {
+    const auto row = rows[probeIndex];
+    states[0].preProbe(*this, hashes[row], row);
+    states[0].firstProbe<op>(*this, kFirstKey);
+    fullProbe<isJoin, isNormalizedKey>(lookup, states[0], false);
+  }
+}
+
 namespace {
 // Normalized keys have non0-random bits. Bits need to be propagated
 // up to make a tag byte and down so that non-lowest bits of
@@ -457,7 +598,15 @@ void HashTable<ignoreNullKeys>::groupProbe(HashLookup& lookup) {
   checkSize(lookup.rows.size(), false);
   if (hashMode_ == HashMode::kNormalizedKey) {
     populateNormalizedKeys(lookup, sizeBits_);
-    groupNormalizedKeyProbe(lookup);
+    if (usePrefetchProbe()) {
+      prefetchProbe<false, true>(lookup);
+    } else {
+      groupNormalizedKeyProbe(lookup);
+    }
+    return;
+  }
+  if (usePrefetchProbe()) {
+    prefetchProbe<false, false>(lookup);
     return;
   }
   ProbeState state1;
@@ -467,6 +616,7 @@ void HashTable<ignoreNullKeys>::groupProbe(HashLookup& lookup) {
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
   auto rows = lookup.rows.data();
+  const bool useAvx512 = process::hasAvx512();
   for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
     int32_t row = rows[probeIndex];
     state1.preProbe(*this, lookup.hashes[row], row);
@@ -477,10 +627,8 @@ void HashTable<ignoreNullKeys>::groupProbe(HashLookup& lookup) {
     row = rows[probeIndex + 3];
     state4.preProbe(*this, lookup.hashes[row], row);
 
-    state1.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
-    state2.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
-    state3.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
-    state4.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
+    ProbeState::firstProbe4<ProbeState::Operation::kInsert>(
+        useAvx512, *this, 0, state1, state2, state3, state4);
 
     fullProbe<false>(lookup, state1, false);
     fullProbe<false>(lookup, state2, true);
@@ -506,6 +654,7 @@ void HashTable<ignoreNullKeys>::groupNormalizedKeyProbe(HashLookup& lookup) {
   auto rows = lookup.rows.data();
   constexpr int32_t kKeyOffset =
       -static_cast<int32_t>(sizeof(normalized_key_t));
+  const bool useAvx512 = process::hasAvx512();
   for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
     int32_t row = rows[probeIndex];
     state1.preProbe(*this, lookup.hashes[row], row);
@@ -515,10 +664,8 @@ void HashTable<ignoreNullKeys>::groupNormalizedKeyProbe(HashLookup& lookup) {
     state3.preProbe(*this, lookup.hashes[row], row);
     row = rows[probeIndex + 3];
     state4.preProbe(*this, lookup.hashes[row], row);
-    state1.firstProbe<ProbeState::Operation::kInsert>(*this, kKeyOffset);
-    state2.firstProbe<ProbeState::Operation::kInsert>(*this, kKeyOffset);
-    state3.firstProbe<ProbeState::Operation::kInsert>(*this, kKeyOffset);
-    state4.firstProbe<ProbeState::Operation::kInsert>(*this, kKeyOffset);
+    ProbeState::firstProbe4<ProbeState::Operation::kInsert>(
+        useAvx512, *this, kKeyOffset, state1, state2, state3, state4);
     fullProbe<false, true>(lookup, state1, false);
     fullProbe<false, true>(lookup, state2, true);
     fullProbe<false, true>(lookup, state3, true);
@@ -595,6 +742,10 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
     joinNormalizedKeyProbe(lookup);
     return;
   }
+  if (usePrefetchProbe()) {
+    prefetchProbe<true, false>(lookup);
+    return;
+  }
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
   const vector_size_t* rows = lookup.rows.data();
@@ -602,6 +753,7 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   ProbeState state2;
   ProbeState state3;
   ProbeState state4;
+  const bool useAvx512 = process::hasAvx512();
   for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
     int32_t row = rows[probeIndex];
     state1.preProbe(*this, lookup.hashes[row], row);
@@ -611,10 +763,8 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
     state3.preProbe(*this, lookup.hashes[row], row);
     row = rows[probeIndex + 3];
     state4.preProbe(*this, lookup.hashes[row], row);
-    state1.firstProbe(*this, 0);
-    state2.firstProbe(*this, 0);
-    state3.firstProbe(*this, 0);
-    state4.firstProbe(*this, 0);
+    ProbeState::firstProbe4(
+        useAvx512, *this, 0, state1, state2, state3, state4);
     fullProbe<true>(lookup, state1, false);
     fullProbe<true>(lookup, state2, false);
     fullProbe<true>(lookup, state3, false);
@@ -682,13 +832,21 @@ void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
   char** hits = lookup.hits.data();
   constexpr int32_t kKeyOffset =
       -static_cast<int32_t>(sizeof(normalized_key_t));
+  const bool useAvx512 = process::hasAvx512();
   for (; probeIndex + groupSize <= numProbes; probeIndex += groupSize) {
     for (int32_t i = 0; i < groupSize; ++i) {
       int32_t row = rows[probeIndex + i];
       states[i].preProbe(*this, hashes[row], row);
     }
-    for (int32_t i = 0; i < groupSize; ++i) {
-      states[i].firstProbe(*this, kKeyOffset);
+    for (int32_t i = 0; i < groupSize; i += 4) {
+      ProbeState::firstProbe4(
+          useAvx512,
+          *this,
+          kKeyOffset,
+          states[i],
+          states[i + 1],
+          states[i + 2],
+          states[i + 3]);
     }
     for (int32_t i = 0; i < groupSize; ++i) {
       hits[states[i].row()] = states[i].joinNormalizedKeyFullProbe(*this, keys);
@@ -839,6 +997,31 @@ void syncWorkItems(
 }
 } // namespace
 
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::setBuildPartitionBounds(uint8_t numPartitions) {
+  buildPartitionBounds_.resize(numPartitions + 1);
+
+  // Pad the tail of buildPartitionBounds_ to max int.
+  std::fill(
+      buildPartitionBounds_.begin(),
+      buildPartitionBounds_.begin() + buildPartitionBounds_.capacity(),
+      std::numeric_limits<PartitionBoundIndexType>::max());
+
+  // The partitioning is in terms of ranges of bucket offset.
+  for (auto i = 0; i < numPartitions; ++i) {
+    // The bounds are the closes tag/row pointer group bound, always cache
+    // line aligned.
+    buildPartitionBounds_[i] =
+        bits::roundUp(((sizeMask_ + 1) / numPartitions) * i, kBucketSize);
+    // Bounds must always be positive
+    VELOX_CHECK_GE(
+        buildPartitionBounds_[i],
+        0,
+        "Turn on VELOX_ENABLE_INT64_BUILD_PARTITION_BOUND to avoid integer overflow in buildPartitionBounds_");
+  }
+  buildPartitionBounds_.back() = sizeMask_ + 1;
+}
+
 template <bool ignoreNullKeys>
 bool HashTable<ignoreNullKeys>::canApplyParallelJoinBuild() const {
   if (!isJoinBuild_ || buildExecutor_ == nullptr) {
@@ -854,6 +1037,23 @@ bool HashTable<ignoreNullKeys>::canApplyParallelJoinBuild() const {
       minTableSizeForParallelJoinBuild_;
 }
 
+template <bool ignoreNullKeys>
+bool HashTable<ignoreNullKeys>::canApplyParallelGroupByRehash() const {
+  if (isJoinBuild_ || buildExecutor_ == nullptr) {
+    return false;
+  }
+  // Only kHash mode hashes rows without touching the VectorHasher state, so
+  // that several threads can hash the rows concurrently.
+  if (hashMode_ != HashMode::kHash) {
+    return false;
+  }
+  if (numParallelGroupByRehashPartitions_ <= 1) {
+    return false;
+  }
+  return (capacity_ / numParallelGroupByRehashPartitions_) >
+      minTableSizeForParallelGroupByRehash_;
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::parallelJoinBuild() {
   TestValue::adjust(
@@ -865,26 +1065,7 @@ void HashTable<ignoreNullKeys>::parallelJoinBuild() {
       minTableSizeForParallelJoinBuild_,
       "Less than {} entries per partition for parallel build",
       minTableSizeForParallelJoinBuild_);
-  buildPartitionBounds_.resize(numPartitions + 1);
-  // Pad the tail of buildPartitionBounds_ to max int.
-  std::fill(
-      buildPartitionBounds_.begin(),
-      buildPartitionBounds_.begin() + buildPartitionBounds_.capacity(),
-      std::numeric_limits<PartitionBoundIndexType>::max());
-
-  // The partitioning is in terms of ranges of bucket offset.
-  for (auto i = 0; i < numPartitions; ++i) {
-    // The bounds are the closes tag/row pointer group bound, always cache
-    // line aligned.
-    buildPartitionBounds_[i] =
-        bits::roundUp(((sizeMask_ + 1) / numPartitions) * i, kBucketSize);
-    // Bounds must always be positive
-    VELOX_CHECK_GE(
-        buildPartitionBounds_[i],
-        0,
-        "Turn on VELOX_ENABLE_INT64_BUILD_PARTITION_BOUND to avoid integer overflow in buildPartitionBounds_");
-  }
-  buildPartitionBounds_.back() = sizeMask_ + 1;
+  setBuildPartitionBounds(numPartitions);
   std::vector<std::shared_ptr<AsyncSource<bool>>> partitionSteps;
   std::vector<std::shared_ptr<AsyncSource<bool>>> buildSteps;
   // rowPartitions are used in the async threads, so declare them before the
@@ -1033,6 +1214,145 @@ void HashTable<ignoreNullKeys>::buildJoinPartition(
   }
 }
 
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::parallelGroupByRehash() {
+  TestValue::adjust(
+      "facebook::velox::exec::HashTable::parallelGroupByRehash", rows_->pool());
+  constexpr int32_t kBatch = 1024;
+  const uint8_t numPartitions = numParallelGroupByRehashPartitions_;
+  setBuildPartitionBounds(numPartitions);
+
+  // A group-by table keeps adding rows to its RowContainer, so the rows can't
+  // be partitioned with RowPartitions as in parallelJoinBuild(). Instead, all
+  // rows are listed once together with their hashes and partition numbers.
+  // These are allocated from the pool of the RowContainer since they are
+  // proportional to the size of the table.
+  const auto numRows = rows_->numRows();
+  auto& pool = *rows_->pool();
+  PoolVector<char*> rows(numRows, pool);
+  PoolVector<uint64_t> hashes(numRows, pool);
+  PoolVector<uint8_t> partitions(numRows, pool);
+  RowContainerIterator iter;
+  int64_t numListed = 0;
+  while (numListed < numRows) {
+    const auto numBatchRows = rows_->listRows(
+        &iter, numRows - numListed, rows.data() + numListed);
+    VELOX_CHECK_GT(numBatchRows, 0);
+    numListed += numBatchRows;
+  }
+
+  std::vector<std::shared_ptr<AsyncSource<bool>>> partitionSteps;
+  std::vector<std::shared_ptr<AsyncSource<bool>>> buildSteps;
+  auto sync = folly::makeGuard([&]() {
+    // This is executed on returning path, possibly in unwinding, so must not
+    // throw.
+    std::exception_ptr error;
+    syncWorkItems(partitionSteps, error, offThreadBuildTiming_, true);
+    syncWorkItems(buildSteps, error, offThreadBuildTiming_, true);
+  });
+
+  // The parallel hashing and partitioning step. Each thread processes a
+  // contiguous range of 'rows'.
+  const auto rowsPerStep = bits::divRoundUp(numRows, numPartitions);
+  for (auto i = 0; i < numPartitions; ++i) {
+    const auto begin = std::min<int64_t>(numRows, i * rowsPerStep);
+    const auto end = std::min<int64_t>(numRows, begin + rowsPerStep);
+    partitionSteps.push_back(std::make_shared<AsyncSource<bool>>(
+        [this, begin, end, &rows, &hashes, &partitions]() {
+          for (auto row = begin; row < end; row += kBatch) {
+            const auto numBatchRows = std::min<int64_t>(kBatch, end - row);
+            for (auto k = 0; k < hashers_.size(); ++k) {
+              rows_->hash(
+                  k,
+                  folly::Range<char**>(rows.data() + row, numBatchRows),
+                  k > 0,
+                  hashes.data() + row);
+            }
+          }
+          for (auto row = begin; row < end; ++row) {
+            partitions[row] = findPartition(
+                bucketOffset(hashes[row]),
+                buildPartitionBounds_.data(),
+                buildPartitionBounds_.size());
+          }
+          return std::make_unique<bool>(true);
+        }));
+    VELOX_CHECK(!partitionSteps.empty());
+    buildExecutor_->add([step = partitionSteps.back()]() { step->prepare(); });
+  }
+
+  std::exception_ptr error;
+  syncWorkItems(partitionSteps, error, offThreadBuildTiming_);
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+
+  // The parallel table building step.
+  std::vector<std::vector<char*>> overflowPerPartition(numPartitions);
+  for (auto i = 0; i < numPartitions; ++i) {
+    buildSteps.push_back(std::make_shared<AsyncSource<bool>>(
+        [this, i, &overflowPerPartition, &rows, &hashes, &partitions]() {
+          buildGroupByPartition(
+              i, rows, hashes, partitions, overflowPerPartition[i]);
+          return std::make_unique<bool>(true);
+        }));
+    VELOX_CHECK(!buildSteps.empty());
+    buildExecutor_->add([step = buildSteps.back()]() { step->prepare(); });
+  }
+  syncWorkItems(buildSteps, error, offThreadBuildTiming_);
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+
+  raw_vector<uint64_t> overflowHashes;
+  for (auto& overflows : overflowPerPartition) {
+    overflowHashes.resize(overflows.size());
+    hashRows(
+        folly::Range<char**>(overflows.data(), overflows.size()),
+        false,
+        overflowHashes);
+    insertForGroupBy(
+        overflows.data(), overflowHashes.data(), overflows.size(), nullptr);
+  }
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::buildGroupByPartition(
+    uint8_t partition,
+    const PoolVector<char*>& rows,
+    const PoolVector<uint64_t>& hashes,
+    const PoolVector<uint8_t>& partitions,
+    std::vector<char*>& overflow) {
+  constexpr int32_t kBatch = 1024;
+  raw_vector<char*> batchRows(kBatch);
+  raw_vector<uint64_t> batchHashes(kBatch);
+  TableInsertPartitionInfo partitionInfo{
+      buildPartitionBounds_[partition],
+      buildPartitionBounds_[partition + 1],
+      overflow};
+  int32_t numBatchRows = 0;
+  for (auto i = 0; i < rows.size(); ++i) {
+    if (partitions[i] != partition) {
+      continue;
+    }
+    batchRows[numBatchRows] = rows[i];
+    batchHashes[numBatchRows] = hashes[i];
+    if (++numBatchRows == kBatch) {
+      insertForGroupBy(
+          batchRows.data(),
+          batchHashes.data(),
+          numBatchRows,
+          &partitionInfo);
+      numBatchRows = 0;
+    }
+  }
+  insertForGroupBy(
+      batchRows.data(),
+      batchHashes.data(),
+      numBatchRows,
+      &partitionInfo);
+}
+
 template <bool ignoreNullKeys>
 bool HashTable<ignoreNullKeys>::insertBatch(
     char** groups,
@@ -1054,8 +1374,10 @@ template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::insertForGroupBy(
     char** groups,
     uint64_t* hashes,
-    int32_t numGroups) {
+    int32_t numGroups,
+    TableInsertPartitionInfo* partitionInfo) {
   if (hashMode_ == HashMode::kArray) {
+    VELOX_CHECK_NULL(partitionInfo);
     for (auto i = 0; i < numGroups; ++i) {
       auto index = hashes[i];
       VELOX_CHECK_LT(index, capacity_);
@@ -1076,9 +1398,19 @@ void HashTable<ignoreNullKeys>::insertForGroupBy(
             reinterpret_cast<char*>(table_) +
             bucketOffset(hashes[i + kPrefetchDistance]));
       }
+      const auto startOffset = offset;
       bool inserted{false};
       for (int64_t numProbedBuckets = 0; numProbedBuckets < numBuckets();
            ++numProbedBuckets) {
+        if (partitionInfo != nullptr &&
+            (!partitionInfo->inRange(offset) ||
+             (numProbedBuckets > 0 && offset <= startOffset))) {
+          // The row would go past the end of the partition or wrap around.
+          // It is inserted after all partitions have been built.
+          partitionInfo->addOverflow(groups[i]);
+          inserted = true;
+          break;
+        }
         MaskType free =
             ~simd::toBitMask(
                 BaseHashTable::TagVector::batch_bool_type(tagsInTable)) &
@@ -1216,6 +1548,10 @@ void HashTable<ignoreNullKeys>::rehash(bool initNormalizedKeys) {
     parallelJoinBuild();
     return;
   }
+  if (canApplyParallelGroupByRehash()) {
+    parallelGroupByRehash();
+    return;
+  }
   raw_vector<uint64_t> hashes;
   hashes.resize(kHashBatchSize);
   char* groups[kHashBatchSize];
@@ -250,6 +250,25 @@ class BaseHashTable {
       std::vector<std::unique_ptr<BaseHashTable>> tables,
       folly::Executor* executor = nullptr) = 0;
 
+  /// Enables parallel rehash of a group-by table in kHash mode. The table is
+  /// split into 'numPartitions' ranges of buckets which are filled in
+  /// parallel on 'executor' once each range has more than
+  /// 'minTableSizePerPartition' entries. Only the rehash is parallel. New
+  /// groups are inserted and aggregates are updated by the calling thread.
+  virtual void setParallelGroupByRehash(
+      folly::Executor* executor,
+      uint8_t numPartitions,
+      uint32_t minTableSizePerPartition) = 0;
+
+  /// Enables or disables the staged probe of groupProbe() and joinProbe() in
+  /// kHash and kNormalizedKey modes. The staged probe processes the probed
+  /// rows in groups: it first prefetches the buckets of all rows in the
+  /// group, then compares the tags and prefetches the first matching rows and
+  /// only then compares the keys. This hides the cache misses of tables that
+  /// do not fit in cache. It is used only if the table is at least
+  /// 'minTableBytes' bytes.
+  virtual void setPrefetchProbe(bool enabled, uint64_t minTableBytes) = 0;
+
   /// Returns the memory footprint in bytes for any data structures
   /// owned by 'this'.
   virtual int64_t allocatedBytes() const = 0;
@@ -527,6 +546,21 @@ class HashTable : public BaseHashTable {
       std::vector<std::unique_ptr<BaseHashTable>> tables,
       folly::Executor* executor = nullptr) override;
 
+  void setParallelGroupByRehash(
+      folly::Executor* executor,
+      uint8_t numPartitions,
+      uint32_t minTableSizePerPartition) override {
+    VELOX_CHECK(!isJoinBuild_);
+    buildExecutor_ = executor;
+    numParallelGroupByRehashPartitions_ = numPartitions;
+    minTableSizeForParallelGroupByRehash_ = minTableSizePerPartition;
+  }
+
+  void setPrefetchProbe(bool enabled, uint64_t minTableBytes) override {
+    prefetchProbe_ = enabled;
+    minTableBytesForPrefetchProbe_ = minTableBytes;
+  }
+
   uint64_t hashTableSizeIncrease(int32_t numNewDistinct) const override {
     if (numDistinct_ + numNewDistinct > rehashSize()) {
       // If rehashed, the table adds size_ entries (i.e. doubles),
@@ -573,6 +607,10 @@ class HashTable : public BaseHashTable {
   }
 
  private:
+  // A vector allocated from a memory pool for per-row build state.
+  template <typename T>
+  using PoolVector = std::vector<T, memory::StlAllocator<T>>;
+
   // Enables debug stats for collisions for debug build.
 #ifdef NDEBUG
   static constexpr bool kTrackLoads = false;
@@ -728,8 +766,18 @@ class HashTable : public BaseHashTable {
   // Inserts 'numGroups' entries into 'this'. 'groups' point to
   // contents in a RowContainer owned by 'this'. 'hashes' are the hash
   // numbers or array indices (if kArray mode) for each
-  // group. 'groups' is expected to have no duplicate keys.
-  void insertForGroupBy(char** groups, uint64_t* hashes, int32_t numGroups);
+  // group. 'groups' is expected to have no duplicate keys. If not null,
+  // 'partitionInfo' restricts the inserts to a range of the table as in
+  // insertForJoin.
+  void insertForGroupBy(
+      char** groups,
+      uint64_t* hashes,
+      int32_t numGroups,
+      TableInsertPartitionInfo* partitionInfo = nullptr);
+
+  // Splits the table into 'numPartitions' ranges of bucket offsets and
+  // records these in 'buildPartitionBounds_'.
+  void setBuildPartitionBounds(uint8_t numPartitions);
 
   // Checks if we can apply parallel table build optimization for hash join.
   // The function returns true if all of the following conditions:
@@ -758,6 +806,28 @@ class HashTable : public BaseHashTable {
       const std::vector<std::unique_ptr<RowPartitions>>& rowPartitions,
       std::vector<char*>& overflow);
 
+  // Returns true if a group-by table in kHash mode has been enabled for
+  // parallel rehash with setParallelGroupByRehash() and each of its partitions
+  // has more than 'minTableSizeForParallelGroupByRehash_' entries.
+  bool canApplyParallelGroupByRehash() const;
+
+  // Rehashes a group-by table with 'numParallelGroupByRehashPartitions_'
+  // threads using 'buildExecutor_'. The rows are hashed and assigned a
+  // partition in parallel. Then each thread inserts the rows of its partition.
+  // Rows that would overflow past the end of their partition are inserted
+  // sequentially after all else.
+  void parallelGroupByRehash();
+
+  // Inserts the rows of 'rows' whose 'partitions' entry is 'partition' into
+  // 'this'. 'hashes' are the hash numbers of 'rows'. The rows that would have
+  // gone past the end of the partition are returned in 'overflow'.
+  void buildGroupByPartition(
+      uint8_t partition,
+      const PoolVector<char*>& rows,
+      const PoolVector<uint64_t>& hashes,
+      const PoolVector<uint8_t>& partitions,
+      std::vector<char*>& overflow);
+
   // Assigns a partition to each row of 'subtable' in RowPartitions of
   // subtable's RowContainer. If 'hashMode_' is kNormalizedKeys, records the
   // normalized key of each row below the row in its container.
@@ -785,6 +855,23 @@ class HashTable : public BaseHashTable {
   template <bool isJoin, bool isNormalizedKey = false>
   void fullProbe(HashLookup& lookup, ProbeState& state, bool extraCheck);
 
+  // Number of rows that are in flight at the same time in prefetchProbe().
+  static constexpr int32_t kPrefetchProbeGroupSize = 32;
+
+  // Returns true if the staged probe is enabled and the table is large enough
+  // for it. See setPrefetchProbe().
+  bool usePrefetchProbe() const {
+    return prefetchProbe_ &&
+        capacity_ * tableSlotSize() >= minTableBytesForPrefetchProbe_;
+  }
+
+  // Probes 'lookup' in stages over groups of kPrefetchProbeGroupSize rows.
+  // The buckets of all rows in a group are prefetched before the tags of any
+  // are compared and the first hits of all rows are prefetched before any
+  // keys are compared.
+  template <bool isJoin, bool isNormalizedKey>
+  void prefetchProbe(HashLookup& lookup);
+
   // Shortcut path for group by with normalized keys.
   void groupNormalizedKeyProbe(HashLookup& lookup);
 
@@ -936,12 +1023,25 @@ class HashTable : public BaseHashTable {
   // of cache line  size.
   raw_vector<PartitionBoundIndexType> buildPartitionBounds_;
 
-  // Executor for parallelizing hash join build. This may be the
+  // Executor for parallelizing hash join and group-by build. This may be the
   // executor for Drivers. If this executor is indefinitely taken by
   // other work, the thread of prepareJoinTables() will sequentially
   // execute the parallel build steps.
   folly::Executor* buildExecutor_{nullptr};
 
+  // Number of partitions for parallel rehash of a group-by table. 0 or 1
+  // disables the parallel rehash.
+  uint8_t numParallelGroupByRehashPartitions_{0};
+
+  // The min number of table entries per partition to trigger parallel
+  // group-by table rehash.
+  uint32_t minTableSizeForParallelGroupByRehash_{0};
+
+  // If true, groupProbe() and joinProbe() use prefetchProbe() for tables of
+  // at least 'minTableBytesForPrefetchProbe_' bytes.
+  bool prefetchProbe_{false};
+  uint64_t minTableBytesForPrefetchProbe_{0};
+
   //  Counts parallel build rows. Used for consistency check.
   std::atomic<int64_t> numParallelBuildRows_{0};
 
@@ -77,16 +77,15 @@ void LocalExchangeQueue::noMoreProducers() {
 
 BlockingReason LocalExchangeQueue::enqueue(
     RowVectorPtr input,
+    int64_t inputBytes,
     ContinueFuture* future) {
-  auto inputBytes = input->estimateFlatSize();
-
   std::vector<ContinuePromise> consumerPromises;
   bool blockedOnConsumer = false;
   bool isClosed = queue_.withWLock([&](auto& queue) {
     if (closed_) {
       return true;
     }
-    queue.push(std::move(input));
+    queue.push({std::move(input), inputBytes});
     consumerPromises = std::move(consumerPromises_);
 
     if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
@@ -139,11 +138,11 @@ BlockingReason LocalExchangeQueue::next(
       return BlockingReason::kWaitForProducer;
     }
 
-    *data = queue.front();
+    *data = std::move(queue.front().data);
+    const auto bytes = queue.front().bytes;
     queue.pop();
 
-    memoryPromises =
-        memoryManager_->decreaseMemoryUsage((*data)->estimateFlatSize());
+    memoryPromises = memoryManager_->decreaseMemoryUsage(bytes);
 
     return BlockingReason::kNotBlocked;
   });
@@ -152,7 +151,7 @@ BlockingReason LocalExchangeQueue::next(
 }
 
 bool LocalExchangeQueue::isFinishedLocked(
-    const std::queue<RowVectorPtr>& queue) const {
+    const std::queue<Entry>& queue) const {
   if (closed_) {
     return true;
   }
@@ -174,7 +173,7 @@ void LocalExchangeQueue::close() {
   queue_.withWLock([&](auto& queue) {
     uint64_t freedBytes = 0;
     while (!queue.empty()) {
-      freedBytes += queue.front()->estimateFlatSize();
+      freedBytes += queue.front().bytes;
       queue.pop();
     }
 
@@ -260,27 +259,6 @@ LocalPartition::LocalPartition(
 }
 
 namespace {
-std::vector<BufferPtr> allocateIndexBuffers(
-    const std::vector<vector_size_t>& sizes,
-    memory::MemoryPool* pool) {
-  std::vector<BufferPtr> indexBuffers;
-  indexBuffers.reserve(sizes.size());
-  for (auto size : sizes) {
-    indexBuffers.push_back(allocateIndices(size, pool));
-  }
-  return indexBuffers;
-}
-
-std::vector<vector_size_t*> getRawIndices(
-    const std::vector<BufferPtr>& indexBuffers) {
-  std::vector<vector_size_t*> rawIndices;
-  rawIndices.reserve(indexBuffers.size());
-  for (auto& buffer : indexBuffers) {
-    rawIndices.emplace_back(buffer->asMutable<vector_size_t>());
-  }
-  return rawIndices;
-}
-
 RowVectorPtr
 wrapChildren(const RowVectorPtr& input, vector_size_t size, BufferPtr indices) {
   std::vector<VectorPtr> wrappedChildren;
@@ -295,10 +273,24 @@ wrapChildren(const RowVectorPtr& input, vector_size_t size, BufferPtr indices) {
 }
 } // namespace
 
+void LocalPartition::enqueue(
+    uint32_t partition,
+    RowVectorPtr data,
+    int64_t dataBytes) {
+  ContinueFuture future;
+  auto reason =
+      queues_[partition]->enqueue(std::move(data), dataBytes, &future);
+  if (reason != BlockingReason::kNotBlocked) {
+    blockingReasons_.push_back(reason);
+    futures_.push_back(std::move(future));
+  }
+}
+
 void LocalPartition::addInput(RowVectorPtr input) {
+  const auto inputBytes = input->estimateFlatSize();
   {
     auto lockedStats = stats_.wlock();
-    lockedStats->addOutputVector(input->estimateFlatSize(), input->size());
+    lockedStats->addOutputVector(inputBytes, input->size());
   }
 
   // Lazy vectors must be loaded or processed.
@@ -306,59 +298,57 @@ void LocalPartition::addInput(RowVectorPtr input) {
     child->loadedVector();
   }
 
+  // Gather and round-robin exchanges hand over 'input' as is. The consumer
+  // shares the ownership of the vector with no copy.
   if (numPartitions_ == 1) {
-    ContinueFuture future;
-    auto blockingReason = queues_[0]->enqueue(input, &future);
-    if (blockingReason != BlockingReason::kNotBlocked) {
-      blockingReasons_.push_back(blockingReason);
-      futures_.push_back(std::move(future));
-    }
+    enqueue(0, std::move(input), inputBytes);
     return;
   }
 
   const auto singlePartition =
       partitionFunction_->partition(*input, partitions_);
   if (singlePartition.has_value()) {
-    ContinueFuture future;
-    auto blockingReason =
-        queues_[singlePartition.value()]->enqueue(input, &future);
-    if (blockingReason != BlockingReason::kNotBlocked) {
-      blockingReasons_.push_back(blockingReason);
-      futures_.push_back(std::move(future));
-    }
+    enqueue(singlePartition.value(), std::move(input), inputBytes);
     return;
   }
 
+  // Each partition gets a dictionary wrapped view over 'input'. The row
+  // numbers of all partitions are stored in one buffer, ordered by
+  // partition, and each partition wraps its slice of the buffer.
   const auto numInput = input->size();
-  std::vector<vector_size_t> maxIndex(numPartitions_, 0);
+  partitionSizes_.assign(numPartitions_, 0);
   for (auto i = 0; i < numInput; ++i) {
-    ++maxIndex[partitions_[i]];
+    ++partitionSizes_[partitions_[i]];
   }
-  auto indexBuffers = allocateIndexBuffers(maxIndex, pool());
-  auto rawIndices = getRawIndices(indexBuffers);
 
-  std::fill(maxIndex.begin(), maxIndex.end(), 0);
+  std::vector<vector_size_t> offsets(numPartitions_);
+  for (auto i = 1; i < numPartitions_; ++i) {
+    offsets[i] = offsets[i - 1] + partitionSizes_[i - 1];
+  }
+
+  auto indices = allocateIndices(numInput, pool());
+  auto* rawIndices = indices->asMutable<vector_size_t>();
   for (auto i = 0; i < numInput; ++i) {
-    auto partition = partitions_[i];
-    rawIndices[partition][maxIndex[partition]] = i;
-    ++maxIndex[partition];
+    rawIndices[offsets[partitions_[i]]++] = i;
   }
 
+  vector_size_t offset = 0;
   for (auto i = 0; i < numPartitions_; i++) {
-    auto partitionSize = maxIndex[i];
+    const auto partitionSize = partitionSizes_[i];
     if (partitionSize == 0) {
       // Do not enqueue empty partitions.
       continue;
     }
-    auto partitionData =
-        wrapChildren(input, partitionSize, std::move(indexBuffers[i]));
-
-    ContinueFuture future;
-    auto reason = queues_[i]->enqueue(partitionData, &future);
-    if (reason != BlockingReason::kNotBlocked) {
-      blockingReasons_.push_back(reason);
-      futures_.push_back(std::move(future));
-    }
+    auto partitionData = wrapChildren(
+        input,
+        partitionSize,
+        BaseVector::sliceBuffer(
+            *INTEGER(), indices, offset, partitionSize, pool()));
+    offset += partitionSize;
+
+    // The partitions share the buffers of 'input'. Each is accounted its
+    // share of the input bytes.
+    enqueue(i, std::move(partitionData), inputBytes * partitionSize / numInput);
   }
 }
 
@@ -66,8 +66,12 @@ class LocalExchangeQueue {
 
   /// Used by a producer to add data. Returning kNotBlocked if can accept more
   /// data. Otherwise returns kWaitForConsumer and sets future that will be
-  /// completed when ready to accept more data.
-  BlockingReason enqueue(RowVectorPtr input, ContinueFuture* future);
+  /// completed when ready to accept more data. 'inputBytes' is the memory
+  /// usage accounted for 'input' until it is fetched. The vectors sharing the
+  /// buffers of one producer input, e.g. its dictionary wrapped partitions,
+  /// are accounted their share of the input bytes.
+  BlockingReason
+  enqueue(RowVectorPtr input, int64_t inputBytes, ContinueFuture* future);
 
   /// Called by a producer to indicate that no more data will be added.
   void noMoreData();
@@ -89,11 +93,17 @@ class LocalExchangeQueue {
   void close();
 
  private:
-  bool isFinishedLocked(const std::queue<RowVectorPtr>& queue) const;
+  // Buffered vector and the bytes accounted for it in 'memoryManager_'.
+  struct Entry {
+    RowVectorPtr data;
+    int64_t bytes;
+  };
+
+  bool isFinishedLocked(const std::queue<Entry>& queue) const;
 
   std::shared_ptr<LocalExchangeMemoryManager> memoryManager_;
   const int partition_;
-  folly::Synchronized<std::queue<RowVectorPtr>> queue_;
+  folly::Synchronized<std::queue<Entry>> queue_;
   // Satisfied when data becomes available or all producers report that they
   // finished producing, e.g. queue_ is not empty or noMoreProducers_ is true
   // and pendingProducers_ is zero.
@@ -172,6 +182,10 @@ class LocalPartition : public Operator {
   bool isFinished() override;
 
  private:
+  // Adds 'data' accounted as 'dataBytes' to the queue of 'partition'. Records
+  // the blocking reason and future if the queue is full.
+  void enqueue(uint32_t partition, RowVectorPtr data, int64_t dataBytes);
+
   const std::vector<std::shared_ptr<LocalExchangeQueue>> queues_;
   const size_t numPartitions_;
   std::unique_ptr<core::PartitionFunction> partitionFunction_;
@@ -181,6 +195,9 @@ class LocalPartition : public Operator {
 
   /// Reusable memory for hash calculation.
   std::vector<uint32_t> partitions_;
+
+  /// Reusable memory for the number of rows in each partition.
+  std::vector<vector_size_t> partitionSizes_;
 };
 
 } // namespace facebook::velox::exec
@@ -14,10 +14,13 @@
  * limitations under the License.
  */
 #include "velox/exec/MergeJoin.h"
+#include "velox/common/testutil/TestValue.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/FieldReference.h"
 
+using facebook::velox::common::testutil::TestValue;
+
 namespace facebook::velox::exec {
 
 MergeJoin::MergeJoin(
@@ -29,7 +32,10 @@ MergeJoin::MergeJoin(
           joinNode->outputType(),
           operatorId,
           joinNode->id(),
-          "MergeJoin"),
+          "MergeJoin",
+          joinNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
       outputBatchSize_{outputBatchRows()},
       joinType_{joinNode->joinType()},
       numKeys_{joinNode->leftKeys().size()},
@@ -55,6 +61,7 @@ void MergeJoin::initialize() {
   for (auto& key : joinNode_->rightKeys()) {
     rightKeys_.push_back(rightType->getChildIdx(key->name()));
   }
+  rightType_ = rightType;
 
   for (auto i = 0; i < leftType->size(); ++i) {
     auto name = leftType->nameOf(i);
@@ -159,6 +166,17 @@ BlockingReason MergeJoin::isBlocked(ContinueFuture* future) {
   return BlockingReason::kNotBlocked;
 }
 
+void MergeJoin::close() {
+  if (rightSource_) {
+    rightSource_->close();
+  }
+  clearRightMatchSpill();
+  if (noMoreInput_ && !spillStats_.empty()) {
+    recordSpillStats(spillStats_);
+  }
+  Operator::close();
+}
+
 bool MergeJoin::needsInput() const {
   return input_ == nullptr;
 }
@@ -346,7 +364,200 @@ void MergeJoin::prepareOutput() {
   }
 }
 
+bool MergeJoin::canSpillRightMatch() const {
+  if (!rightMatch_.has_value() || rightMatch_->inputs.size() <= 1) {
+    return false;
+  }
+  // A spilled match produces the output right side batch by batch, so the
+  // output rows of a left side row are not consecutive as required by
+  // 'leftJoinTracker_'.
+  if (leftJoinTracker_.has_value()) {
+    return false;
+  }
+  // Can't spill once the match has started to produce output.
+  if (rightMatch_->cursor.has_value()) {
+    return false;
+  }
+  return rightMatchSpiller_ == nullptr || !rightMatchSpiller_->finalized();
+}
+
+bool MergeJoin::reclaimableBytes(uint64_t& reclaimableBytes) const {
+  reclaimableBytes = 0;
+  if (!canReclaim()) {
+    return false;
+  }
+  reclaimableBytes = pool()->reservedBytes();
+  if (canSpillRightMatch()) {
+    const auto& inputs = rightMatch_->inputs;
+    for (auto i = 0; i < inputs.size() - 1; ++i) {
+      reclaimableBytes += inputs[i]->retainedSize();
+    }
+  }
+  return true;
+}
+
+void MergeJoin::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& /*stats*/) {
+  VELOX_CHECK(canReclaim());
+  VELOX_CHECK(!nonReclaimableSection_);
+
+  if (!canSpillRightMatch()) {
+    // Nothing to spill.
+    return;
+  }
+  spillRightMatch();
+
+  // Release the minimum reserved memory.
+  pool()->release();
+}
+
+void MergeJoin::spillRightMatch() {
+  VELOX_CHECK(canSpillRightMatch());
+
+  if (rightMatchSpiller_ == nullptr) {
+    const auto& spillConfig = spillConfig_.value();
+    rightMatchSpiller_ = std::make_unique<Spiller>(
+        Spiller::Type::kMergeJoin,
+        rightType_,
+        HashBitRange{},
+        &spillConfig,
+        spillConfig.maxFileSize);
+    rightMatchSpiller_->setPartitionsSpilled({0});
+  }
+
+  auto& inputs = rightMatch_->inputs;
+  const auto numSpillInputs = inputs.size() - 1;
+  for (auto i = 0; i < numSpillInputs; ++i) {
+    const auto& input = inputs[i];
+    // Ensure vectors are lazy loaded before spilling.
+    loadColumns(input, *operatorCtx_->execCtx());
+    const auto startIndex = i == 0 ? rightMatch_->startIndex : 0;
+    if (startIndex == 0) {
+      rightMatchSpiller_->spill(0, input);
+    } else {
+      rightMatchSpiller_->spill(
+          0,
+          std::static_pointer_cast<RowVector>(
+              input->slice(startIndex, input->size() - startIndex)));
+    }
+  }
+  inputs.erase(inputs.begin(), inputs.begin() + numSpillInputs);
+  // The first in-memory batch is no longer the first batch of the match.
+  rightMatch_->startIndex = 0;
+}
+
+void MergeJoin::startRightMatchRead() {
+  VELOX_CHECK_NOT_NULL(rightMatchSpiller_);
+  VELOX_CHECK(rightMatch_->complete);
+
+  rightMatchSpillFiles_ = rightMatchSpiller_->finishSpill().files();
+  spillStats_ += rightMatchSpiller_->stats();
+
+  std::vector<std::unique_ptr<BatchStream>> streams;
+  streams.reserve(rightMatchSpillFiles_.size());
+  for (const auto& fileInfo : rightMatchSpillFiles_) {
+    streams.push_back(FileSpillBatchStream::create(
+        SpillReadFile::create(fileInfo, pool())));
+  }
+  rightMatchSpillReader_ =
+      std::make_unique<UnorderedStreamReader<BatchStream>>(std::move(streams));
+  // Don't read into a batch shared with 'rightMatch_'.
+  rightMatchBatch_ = nullptr;
+  nextRightMatchInput_ = 0;
+
+  const bool hasBatch = nextRightMatchBatch();
+  VELOX_CHECK(hasBatch);
+  rightMatchBatchIndex_ = 0;
+}
+
+bool MergeJoin::nextRightMatchBatch() {
+  ++rightMatchBatchIndex_;
+  if (rightMatchSpillReader_ != nullptr) {
+    if (rightMatchSpillReader_->nextBatch(rightMatchBatch_)) {
+      // Only the rows with matching keys have been spilled.
+      rightMatchBatchStart_ = 0;
+      rightMatchBatchEnd_ = rightMatchBatch_->size();
+      return true;
+    }
+    rightMatchSpillReader_.reset();
+  }
+
+  const auto& inputs = rightMatch_->inputs;
+  if (nextRightMatchInput_ >= inputs.size()) {
+    return false;
+  }
+  const auto index = nextRightMatchInput_++;
+  rightMatchBatch_ = inputs[index];
+  rightMatchBatchStart_ = index == 0 ? rightMatch_->startIndex : 0;
+  rightMatchBatchEnd_ = index == inputs.size() - 1 ? rightMatch_->endIndex
+                                                   : rightMatchBatch_->size();
+  return true;
+}
+
+void MergeJoin::clearRightMatchSpill() {
+  rightMatchSpillReader_.reset();
+  rightMatchBatch_.reset();
+  rightMatchSpillFiles_.clear();
+  rightMatchSpiller_.reset();
+}
+
+bool MergeJoin::addSpilledToOutput() {
+  prepareOutput();
+
+  // Iterates over the right side batches in the outer loop so that the spilled
+  // rows are read back once per match. The output is resumed from the left
+  // side row in 'leftMatch_->cursor' and the right side row in
+  // 'rightMatch_->cursor' of the current 'rightMatchBatch_'.
+  bool resume = rightMatch_->cursor.has_value();
+  if (resume) {
+    VELOX_CHECK_EQ(rightMatch_->cursor->batchIndex, rightMatchBatchIndex_);
+  } else {
+    startRightMatchRead();
+  }
+
+  const size_t numLefts = leftMatch_->inputs.size();
+  do {
+    const size_t firstLeft = resume ? leftMatch_->cursor->batchIndex : 0;
+    for (size_t l = firstLeft; l < numLefts; ++l) {
+      const auto& left = leftMatch_->inputs[l];
+      auto leftStart = l == 0 ? leftMatch_->startIndex : 0;
+      const auto leftEnd =
+          l == numLefts - 1 ? leftMatch_->endIndex : left->size();
+      if (resume) {
+        leftStart = leftMatch_->cursor->index;
+      }
+
+      for (auto i = leftStart; i < leftEnd; ++i) {
+        auto rightStart = rightMatchBatchStart_;
+        if (resume) {
+          rightStart = rightMatch_->cursor->index;
+          resume = false;
+        }
+        for (auto j = rightStart; j < rightMatchBatchEnd_; ++j) {
+          if (outputSize_ == outputBatchSize_) {
+            leftMatch_->setCursor(l, i);
+            rightMatch_->setCursor(rightMatchBatchIndex_, j);
+            return true;
+          }
+          addOutputRow(left, i, rightMatchBatch_, j);
+        }
+      }
+    }
+  } while (nextRightMatchBatch());
+
+  leftMatch_.reset();
+  rightMatch_.reset();
+  clearRightMatchSpill();
+
+  return outputSize_ == outputBatchSize_;
+}
+
 bool MergeJoin::addToOutput() {
+  if (rightMatchSpiller_ != nullptr) {
+    return addSpilledToOutput();
+  }
+
   prepareOutput();
 
   size_t firstLeftBatch;
@@ -522,6 +733,13 @@ RowVectorPtr MergeJoin::doGetOutput() {
       if (!findEndOfMatch(rightMatch_.value(), rightInput_, rightKeys_)) {
         // Continue looking for the end of the match.
         rightInput_ = nullptr;
+        TestValue::adjust(
+            "facebook::velox::exec::MergeJoin::getOutput::rightMatch", this);
+        // Test-only spill path.
+        if (canSpill() && spillConfig_->testSpillPct > 0 &&
+            canSpillRightMatch()) {
+          spillRightMatch();
+        }
         return nullptr;
       }
       if (rightMatch_->inputs.back() == rightInput_) {
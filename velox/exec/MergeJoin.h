@@ -18,6 +18,7 @@
 
 #include "velox/exec/MergeSource.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/Spill.h"
 
 namespace facebook::velox::exec {
 class MergeJoin : public Operator {
@@ -39,12 +40,15 @@ class MergeJoin : public Operator {
 
   bool isFinished() override;
 
-  void close() override {
-    if (rightSource_) {
-      rightSource_->close();
-    }
-    Operator::close();
-  }
+  bool reclaimableBytes(uint64_t& reclaimableBytes) const override;
+
+  /// Spills the right-side rows with matching keys buffered in 'rightMatch_'
+  /// to disk. This bounds the memory usage of a merge join with heavily skewed
+  /// join keys.
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
+  void close() override;
 
  private:
   // Sets up 'filter_' and related member variables.
@@ -155,6 +159,31 @@ class MergeJoin : public Operator {
   /// it is null.
   void prepareOutput();
 
+  // Returns true if 'rightMatch_' can spill, i.e. it has more than one batch
+  // of input buffered and the output has not started yet. Left joins with a
+  // filter don't spill as 'leftJoinTracker_' requires the output rows of a
+  // left side row to be consecutive.
+  bool canSpillRightMatch() const;
+
+  // Spills all but the last batch of 'rightMatch_' to disk. The last batch
+  // stays in memory as findEndOfMatch() compares the next batch of right side
+  // input against its last row. Only the rows with matching keys are spilled
+  // and the spilled batches are removed from 'rightMatch_'.
+  void spillRightMatch();
+
+  // Starts reading the right-side rows of a spilled 'rightMatch_'. Reads the
+  // spilled rows first, followed by the in-memory batches of 'rightMatch_'.
+  // Finishes the spill of 'rightMatch_'.
+  void startRightMatchRead();
+
+  // Advances to the next batch of a spilled 'rightMatch_'. Sets
+  // 'rightMatchBatch_' and the range of rows with matching keys in it. Returns
+  // false if all the batches have been read.
+  bool nextRightMatchBatch();
+
+  // Resets the spill state of 'rightMatch_' after it has been fully processed.
+  void clearRightMatchSpill();
+
   // Appends a cartesian product of the current set of matching rows, leftMatch_
   // x rightMatch_, to output_. Returns true if output_ is full. Sets
   // leftMatchCursor_ and rightMatchCursor_ if output_ filled up before all the
@@ -164,6 +193,12 @@ class MergeJoin : public Operator {
   // rightMatchCursor_ if output_ filled up before all rows were added.
   bool addToOutput();
 
+  // Same as addToOutput() for a spilled 'rightMatch_'. Reads back the
+  // right-side rows from disk once and joins each batch with all the left-side
+  // rows in 'leftMatch_' before reading the next one. Only one spilled batch is
+  // held in memory at a time.
+  bool addSpilledToOutput();
+
   // Adds one row of output by copying values from left and right batches at the
   // specified rows. Advances outputSize_. Assumes that output_ has room.
   //
@@ -351,6 +386,9 @@ class MergeJoin : public Operator {
   // driver has started execution. It is reset after the initialization.
   std::shared_ptr<const core::MergeJoinNode> joinNode_;
 
+  // The type of the right side input.
+  RowTypePtr rightType_;
+
   std::vector<column_index_t> leftKeys_;
   std::vector<column_index_t> rightKeys_;
   std::vector<IdentityProjection> leftProjections_;
@@ -408,5 +446,34 @@ class MergeJoin : public Operator {
 
   // True if all the right side data has been received.
   bool noMoreRightInput_{false};
+
+  // Spills the right-side rows of 'rightMatch_' under memory pressure. Set on
+  // the first spill of 'rightMatch_' and reset after all the output of the
+  // match has been produced.
+  std::unique_ptr<Spiller> rightMatchSpiller_;
+
+  // The spill files of 'rightMatch_'. Set after the match is complete and
+  // read once while producing the output of the match.
+  SpillFiles rightMatchSpillFiles_;
+
+  // Reads 'rightMatchSpillFiles_'. Reset after all the spilled rows have been
+  // read.
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> rightMatchSpillReader_;
+
+  // The current batch of a spilled 'rightMatch_' and the range of rows with
+  // matching keys in it.
+  RowVectorPtr rightMatchBatch_;
+  vector_size_t rightMatchBatchStart_{0};
+  vector_size_t rightMatchBatchEnd_{0};
+
+  // The ordinal of 'rightMatchBatch_' in the read of 'rightMatch_'.
+  size_t rightMatchBatchIndex_{0};
+
+  // Index of the next in-memory batch in 'rightMatch_' to read after all the
+  // spilled rows have been read.
+  size_t nextRightMatchInput_{0};
+
+  // The accumulated spill stats of the right-side matches.
+  common::SpillStats spillStats_;
 };
 } // namespace facebook::velox::exec
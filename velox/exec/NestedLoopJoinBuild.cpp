@@ -18,12 +18,15 @@
 
 namespace facebook::velox::exec {
 
-void NestedLoopJoinBridge::setData(std::vector<RowVectorPtr> buildVectors) {
+void NestedLoopJoinBridge::setData(
+    std::vector<RowVectorPtr> buildVectors,
+    SpillFiles spillFiles) {
   std::vector<ContinuePromise> promises;
   {
     std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK(!buildVectors_.has_value(), "setData must be called only once");
     buildVectors_ = std::move(buildVectors);
+    spillFiles_ = std::move(spillFiles);
     promises = std::move(promises_);
   }
   notify(std::move(promises));
@@ -41,6 +44,12 @@ std::optional<std::vector<RowVectorPtr>> NestedLoopJoinBridge::dataOrFuture(
   return std::nullopt;
 }
 
+SpillFiles NestedLoopJoinBridge::spillFiles() {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(buildVectors_.has_value(), "Build side data is not ready yet");
+  return spillFiles_;
+}
+
 NestedLoopJoinBuild::NestedLoopJoinBuild(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -50,7 +59,10 @@ NestedLoopJoinBuild::NestedLoopJoinBuild(
           nullptr,
           operatorId,
           joinNode->id(),
-          "NestedLoopJoinBuild") {}
+          "NestedLoopJoinBuild",
+          joinNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt) {}
 
 void NestedLoopJoinBuild::addInput(RowVectorPtr input) {
   if (input->size() > 0) {
@@ -59,9 +71,50 @@ void NestedLoopJoinBuild::addInput(RowVectorPtr input) {
       child->loadedVector();
     }
     dataVectors_.emplace_back(std::move(input));
+
+    // Test-only spill path.
+    if (canSpill() && spillConfig_->testSpillPct > 0) {
+      spill();
+    }
   }
 }
 
+void NestedLoopJoinBuild::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& /*stats*/) {
+  VELOX_CHECK(canReclaim());
+  VELOX_CHECK(!nonReclaimableSection_);
+
+  // NOTE: the build vectors are either handed over to the probe side or
+  // waiting to be collected by the last build driver after no more input.
+  if (noMoreInput_ || dataVectors_.empty()) {
+    return;
+  }
+  spill();
+
+  // Release the minimum reserved memory.
+  pool()->release();
+}
+
+void NestedLoopJoinBuild::spill() {
+  VELOX_CHECK(canSpill());
+  if (spiller_ == nullptr) {
+    const auto& spillConfig = spillConfig_.value();
+    spiller_ = std::make_unique<Spiller>(
+        Spiller::Type::kNestedLoopJoinBuild,
+        asRowType(dataVectors_.front()->type()),
+        HashBitRange{},
+        &spillConfig,
+        spillConfig.maxFileSize);
+    spiller_->setPartitionsSpilled({0});
+  }
+
+  for (const auto& vector : dataVectors_) {
+    spiller_->spill(0, vector);
+  }
+  dataVectors_.clear();
+}
+
 BlockingReason NestedLoopJoinBuild::isBlocked(ContinueFuture* future) {
   if (!future_.valid()) {
     return BlockingReason::kNotBlocked;
@@ -72,6 +125,13 @@ BlockingReason NestedLoopJoinBuild::isBlocked(ContinueFuture* future) {
 
 void NestedLoopJoinBuild::noMoreInput() {
   Operator::noMoreInput();
+  if (spiller_ != nullptr) {
+    // Finishing the spill flushes the buffered spill data to the files, so
+    // the stats are complete only after this.
+    spillFiles_ = spiller_->finishSpill().files();
+    recordSpillStats(spiller_->stats());
+  }
+
   std::vector<ContinuePromise> promises;
   std::vector<std::shared_ptr<Driver>> peers;
   // The last Driver to hit NestedLoopJoinBuild::finish gathers the data from
@@ -84,6 +144,8 @@ void NestedLoopJoinBuild::noMoreInput() {
     return;
   }
 
+  SpillFiles spillFiles = std::move(spillFiles_);
+
   {
     auto promisesGuard = folly::makeGuard([&]() {
       // Realize the promises so that the other Drivers (which were not
@@ -102,13 +164,17 @@ void NestedLoopJoinBuild::noMoreInput() {
           dataVectors_.begin(),
           build->dataVectors_.begin(),
           build->dataVectors_.end());
+      spillFiles.insert(
+          spillFiles.end(),
+          build->spillFiles_.begin(),
+          build->spillFiles_.end());
     }
   }
 
   operatorCtx_->task()
       ->getNestedLoopJoinBridge(
           operatorCtx_->driverCtx()->splitGroupId, planNodeId())
-      ->setData(std::move(dataVectors_));
+      ->setData(std::move(dataVectors_), std::move(spillFiles));
 }
 
 bool NestedLoopJoinBuild::isFinished() {
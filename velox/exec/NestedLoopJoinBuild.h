@@ -17,17 +17,28 @@
 
 #include "velox/exec/JoinBridge.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/Spill.h"
 
 namespace facebook::velox::exec {
 
 class NestedLoopJoinBridge : public JoinBridge {
  public:
-  void setData(std::vector<RowVectorPtr> buildVectors);
+  /// Hands over the build side data to the probe side. 'buildVectors' are the
+  /// build vectors kept in memory. 'spillFiles' are the files of the build
+  /// vectors spilled under memory pressure, if any.
+  void setData(
+      std::vector<RowVectorPtr> buildVectors,
+      SpillFiles spillFiles = {});
 
   std::optional<std::vector<RowVectorPtr>> dataOrFuture(ContinueFuture* future);
 
+  /// Returns the spill files of the build side. Must be called after
+  /// dataOrFuture() has returned the build vectors.
+  SpillFiles spillFiles();
+
  private:
   std::optional<std::vector<RowVectorPtr>> buildVectors_;
+  SpillFiles spillFiles_;
 };
 
 class NestedLoopJoinBuild : public Operator {
@@ -53,14 +64,30 @@ class NestedLoopJoinBuild : public Operator {
 
   bool isFinished() override;
 
+  /// Spills the buffered build vectors to disk. The probe side streams the
+  /// spilled vectors back from disk for each probe input.
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
   void close() override {
     dataVectors_.clear();
+    spiller_.reset();
     Operator::close();
   }
 
  private:
+  // Spills 'dataVectors_' and clears them.
+  void spill();
+
   std::vector<RowVectorPtr> dataVectors_;
 
+  // Spills the build vectors under memory pressure. Created on the first
+  // spill.
+  std::unique_ptr<Spiller> spiller_;
+
+  // The files of 'spiller_', set when the spill is finished at no more input.
+  SpillFiles spillFiles_;
+
   // Future for synchronizing with other Drivers of the same pipeline. All build
   // Drivers must be completed before making data available for the probe side.
   ContinueFuture future_{ContinueFuture::makeEmpty()};
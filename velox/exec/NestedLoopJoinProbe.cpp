@@ -117,6 +117,8 @@ void NestedLoopJoinProbe::close() {
     joinCondition_->clear();
   }
   buildVectors_.reset();
+  buildSpillFile_.reset();
+  spilledBuildVector_.reset();
   Operator::close();
 }
 
@@ -132,6 +134,7 @@ void NestedLoopJoinProbe::addInput(RowVectorPtr input) {
   if (needsProbeMismatch(joinType_)) {
     probeMatched_.resizeFill(input_->size(), false);
   }
+  startBuildSpillRead();
 }
 
 RowVectorPtr NestedLoopJoinProbe::getOutput() {
@@ -268,6 +271,8 @@ void NestedLoopJoinProbe::finishProbeInput() {
   VELOX_CHECK_NOT_NULL(input_);
   input_.reset();
   buildIndex_ = 0;
+  buildSpillFile_.reset();
+  spilledBuildVector_.reset();
   if (!noMoreInput_) {
     return;
   }
@@ -278,6 +283,46 @@ void NestedLoopJoinProbe::finishProbeInput() {
   beginBuildMismatch();
 }
 
+void NestedLoopJoinProbe::advanceBuildIndex() {
+  ++buildIndex_;
+  if (buildIndex_ >= buildVectors_->size()) {
+    nextSpilledBuildVector();
+  }
+}
+
+void NestedLoopJoinProbe::startBuildSpillRead() {
+  if (buildSpillFiles_.empty()) {
+    return;
+  }
+  VELOX_CHECK_NULL(buildSpillFile_);
+  VELOX_CHECK_NULL(spilledBuildVector_);
+  nextBuildSpillFile_ = 0;
+  if (buildVectors_->empty()) {
+    nextSpilledBuildVector();
+  }
+}
+
+void NestedLoopJoinProbe::nextSpilledBuildVector() {
+  spilledBuildVector_ = nullptr;
+  for (;;) {
+    if (buildSpillFile_ == nullptr) {
+      if (nextBuildSpillFile_ >= buildSpillFiles_.size()) {
+        return;
+      }
+      buildSpillFile_ = SpillReadFile::create(
+          buildSpillFiles_[nextBuildSpillFile_++], pool());
+    }
+    // NOTE: read into a new vector as the previous batch might still be
+    // referenced by the output.
+    RowVectorPtr batch;
+    if (buildSpillFile_->nextBatch(batch)) {
+      spilledBuildVector_ = std::move(batch);
+      return;
+    }
+    buildSpillFile_.reset();
+  }
+}
+
 void NestedLoopJoinProbe::noMoreInput() {
   Operator::noMoreInput();
   if (state_ != ProbeOperatorState::kRunning || input_ != nullptr) {
@@ -335,7 +380,12 @@ bool NestedLoopJoinProbe::getBuildData(ContinueFuture* future) {
   }
 
   buildVectors_ = std::move(buildData);
-  if (buildVectors_->empty()) {
+  buildSpillFiles_ =
+      operatorCtx_->task()
+          ->getNestedLoopJoinBridge(
+              operatorCtx_->driverCtx()->splitGroupId, planNodeId())
+          ->spillFiles();
+  if (buildVectors_->empty() && buildSpillFiles_.empty()) {
     buildSideEmpty_ = true;
   }
   return true;
@@ -346,7 +396,7 @@ vector_size_t NestedLoopJoinProbe::getNumProbeRows() const {
   VELOX_CHECK(!hasProbedAllBuildData());
 
   const auto inputSize = input_->size();
-  auto numBuildRows = buildVectors_.value()[buildIndex_]->size();
+  auto numBuildRows = currentBuildVector()->size();
   vector_size_t numProbeRows;
   if (numBuildRows > outputBatchSize_) {
     numProbeRows = 1;
@@ -365,7 +415,7 @@ RowVectorPtr NestedLoopJoinProbe::getCrossProduct(
   VELOX_CHECK_GT(probeCnt, 0);
   VELOX_CHECK(!hasProbedAllBuildData());
 
-  const auto buildSize = buildVectors_.value()[buildIndex_]->size();
+  const auto buildSize = currentBuildVector()->size();
   const auto numOutputRows = probeCnt * buildSize;
   const bool probeCntChanged = (probeCnt != numPrevProbedRows_);
   numPrevProbedRows_ = probeCnt;
@@ -399,7 +449,7 @@ RowVectorPtr NestedLoopJoinProbe::getCrossProduct(
       probeIndices_);
   projectChildren(
       projectedChildren,
-      buildVectors_.value()[buildIndex_],
+      currentBuildVector(),
       buildProjections,
       numOutputRows,
       buildIndices_);
@@ -416,9 +466,8 @@ bool NestedLoopJoinProbe::advanceProbeRows(vector_size_t probeCnt) {
   probeRow_ = 0;
   numPrevProbedRows_ = 0;
   do {
-    ++buildIndex_;
-  } while (!hasProbedAllBuildData() &&
-           !buildVectors_.value()[buildIndex_]->size());
+    advanceBuildIndex();
+  } while (!hasProbedAllBuildData() && !currentBuildVector()->size());
   return hasProbedAllBuildData();
 }
 
@@ -490,7 +539,7 @@ RowVectorPtr NestedLoopJoinProbe::doMatch(vector_size_t probeCnt) {
       probeOutMapping_);
   projectChildren(
       projectedChildren,
-      buildVectors_.value()[buildIndex_],
+      currentBuildVector(),
       buildProjections_,
       numOutputRows,
       buildOutMapping_);
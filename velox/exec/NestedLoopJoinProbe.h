@@ -18,6 +18,7 @@
 #include "velox/exec/NestedLoopJoinBuild.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/ProbeOperatorState.h"
+#include "velox/exec/SpillFile.h"
 
 namespace facebook::velox::exec {
 class NestedLoopJoinProbe : public Operator {
@@ -87,9 +88,32 @@ class NestedLoopJoinProbe : public Operator {
   bool advanceProbeRows(vector_size_t probeCnt);
 
   bool hasProbedAllBuildData() const {
-    return (buildIndex_ == buildVectors_.value().size());
+    return buildIndex_ >= buildVectors_.value().size() &&
+        spilledBuildVector_ == nullptr;
   }
 
+  // Returns the build side vector at 'buildIndex_'. The build vectors kept in
+  // memory come first, followed by the ones read back from the spill files.
+  const RowVectorPtr& currentBuildVector() const {
+    VELOX_DCHECK(!hasProbedAllBuildData());
+    if (buildIndex_ < buildVectors_->size()) {
+      return buildVectors_.value()[buildIndex_];
+    }
+    return spilledBuildVector_;
+  }
+
+  // Advances 'buildIndex_' to the next build side vector. Reads the next batch
+  // from the build side spill files once past the in-memory build vectors.
+  void advanceBuildIndex();
+
+  // Starts to read the build side spill files from the beginning for the
+  // current probe input. This is a no-op if the build side didn't spill.
+  void startBuildSpillRead();
+
+  // Reads the next batch from the build side spill files into
+  // 'spilledBuildVector_'. Sets it to null after all the spill files are read.
+  void nextSpilledBuildVector();
+
   // Wraps rows of 'data' that are not selected in 'matched' and projects
   // to the output according to 'projections'. 'nullProjections' is used to
   // create null column vectors in output for outer join. 'unmatchedMapping' is
@@ -153,6 +177,15 @@ class NestedLoopJoinProbe : public Operator {
   // Index into buildData_ for the build side vector to process on next call to
   // getOutput().
   size_t buildIndex_{0};
+  // The spill files of the build side vectors. The spilled vectors are read
+  // back one batch at a time for each probe input.
+  SpillFiles buildSpillFiles_;
+  // Index into 'buildSpillFiles_' for the next spill file to read.
+  size_t nextBuildSpillFile_{0};
+  std::unique_ptr<SpillReadFile> buildSpillFile_;
+  // The spilled build vector to process after all the in-memory build
+  // vectors have been processed.
+  RowVectorPtr spilledBuildVector_;
   std::vector<IdentityProjection> buildProjections_;
   BufferPtr buildIndices_;
 
@@ -368,6 +368,25 @@ void Operator::recordSpillStats(const common::SpillStats& spillStats) {
     common::updateGlobalMaxSpillLevelExceededCount(
         spillStats.spillMaxLevelExceededCount);
   }
+
+  if (spillStats.spillSkewFallbackCount != 0) {
+    lockedStats->addRuntimeStat(
+        "spillSkewFallback",
+        RuntimeCounter{
+            static_cast<int64_t>(spillStats.spillSkewFallbackCount)});
+    common::updateGlobalSpillSkewFallbackCount(
+        spillStats.spillSkewFallbackCount);
+  }
+
+  for (auto level = 0; level < common::SpillStats::kNumSpillLevels; ++level) {
+    const auto bytes = spillStats.spilledPartitionBytesByLevel[level];
+    if (bytes != 0) {
+      lockedStats->addRuntimeStat(
+          fmt::format("spilledPartitionBytesLevel{}", level),
+          RuntimeCounter{
+              static_cast<int64_t>(bytes), RuntimeCounter::Unit::kBytes});
+    }
+  }
 }
 
 std::string Operator::toString() const {
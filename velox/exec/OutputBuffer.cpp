@@ -41,6 +41,11 @@ std::vector<std::shared_ptr<SerializedPage>> ArbitraryBuffer::getPages(
 
   std::vector<std::shared_ptr<SerializedPage>> pages;
   uint64_t bytesRemoved{0};
+  while (bytesRemoved < maxBytes && !spilledPages_.empty()) {
+    pages.push_back(spiller_->read(spilledPages_.front()));
+    bytesRemoved += pages.back()->size();
+    spilledPages_.pop_front();
+  }
   while (bytesRemoved < maxBytes && !pages_.empty()) {
     if (pages_.front() == nullptr) {
       // NOTE: keep the end marker in arbitrary buffer to signal all the
@@ -56,10 +61,22 @@ std::vector<std::shared_ptr<SerializedPage>> ArbitraryBuffer::getPages(
   return pages;
 }
 
+void ArbitraryBuffer::spill(
+    OutputBufferSpiller& spiller,
+    std::vector<std::shared_ptr<SerializedPage>>& freed) {
+  spiller_ = &spiller;
+  while (!pages_.empty() && pages_.front() != nullptr) {
+    spilledPages_.push_back(spiller.write(pages_.front()));
+    freed.push_back(std::move(pages_.front()));
+    pages_.pop_front();
+  }
+}
+
 std::string ArbitraryBuffer::toString() const {
   return fmt::format(
-      "[ARBITRARY_BUFFER PAGES[{}] NO MORE DATA[{}]]",
+      "[ARBITRARY_BUFFER PAGES[{}] SPILLED PAGES[{}] NO MORE DATA[{}]]",
       pages_.size() - !!hasNoMoreData(),
+      spilledPages_.size(),
       hasNoMoreData());
 }
 
@@ -74,22 +91,32 @@ void DestinationBuffer::Stats::recordEnqueue(const SerializedPage& data) {
 void DestinationBuffer::Stats::recordAcknowledge(const SerializedPage& data) {
   const auto numRows = data.numRows();
   VELOX_CHECK(numRows.has_value(), "SerializedPage's numRows must be valid");
-  const int64_t size = data.size();
-  bytesBuffered -= size;
+  recordSent(data.size(), numRows.value());
+}
+
+void DestinationBuffer::Stats::recordDelete(const SerializedPage& data) {
+  recordAcknowledge(data);
+}
+
+void DestinationBuffer::Stats::recordDelete(
+    const OutputBufferSpiller::SpilledPage& data) {
+  VELOX_CHECK(
+      data.numRows.has_value(), "SerializedPage's numRows must be valid");
+  recordSent(data.size, data.numRows.value());
+}
+
+void DestinationBuffer::Stats::recordSent(int64_t bytes, int64_t rows) {
+  bytesBuffered -= bytes;
   VELOX_DCHECK_GE(bytesBuffered, 0, "bytesBuffered must be non-negative");
-  rowsBuffered -= numRows.value();
+  rowsBuffered -= rows;
   VELOX_DCHECK_GE(rowsBuffered, 0, "rowsBuffered must be non-negative");
   --pagesBuffered;
   VELOX_DCHECK_GE(pagesBuffered, 0, "pagesBuffered must be non-negative");
-  bytesSent += size;
-  rowsSent += numRows.value();
+  bytesSent += bytes;
+  rowsSent += rows;
   ++pagesSent;
 }
 
-void DestinationBuffer::Stats::recordDelete(const SerializedPage& data) {
-  recordAcknowledge(data);
-}
-
 std::vector<std::unique_ptr<folly::IOBuf>> DestinationBuffer::getData(
     uint64_t maxBytes,
     int64_t sequence,
@@ -100,6 +127,9 @@ std::vector<std::unique_ptr<folly::IOBuf>> DestinationBuffer::getData(
   if (arbitraryBuffer != nullptr) {
     loadData(arbitraryBuffer, maxBytes);
   }
+  if (sequence - sequence_ >= data_.size()) {
+    loadPending(maxBytes);
+  }
 
   if (sequence - sequence_ > data_.size()) {
     VLOG(1) << this << " Out of order get: " << sequence << " over "
@@ -132,21 +162,71 @@ std::vector<std::unique_ptr<folly::IOBuf>> DestinationBuffer::getData(
       break;
     }
   }
+  fetchedSequence_ =
+      std::max<int64_t>(fetchedSequence_, sequence + result.size());
   return result;
 }
 
 void DestinationBuffer::enqueue(std::shared_ptr<SerializedPage> data) {
   // Drop duplicate end markers.
-  if (data == nullptr && !data_.empty() && data_.back() == nullptr) {
+  if (data == nullptr && hasEndMarker()) {
     return;
   }
 
   if (data != nullptr) {
     stats_.recordEnqueue(*data);
   }
+  if (!pending_.empty()) {
+    pending_.push_back({std::move(data), std::nullopt});
+    return;
+  }
   data_.push_back(std::move(data));
 }
 
+bool DestinationBuffer::hasEndMarker() const {
+  if (!pending_.empty()) {
+    const auto& last = pending_.back();
+    return last.page == nullptr && !last.spilled.has_value();
+  }
+  return !data_.empty() && data_.back() == nullptr;
+}
+
+void DestinationBuffer::loadPending(uint64_t maxBytes) {
+  uint64_t loadedBytes{0};
+  while (!pending_.empty() && loadedBytes < maxBytes) {
+    auto& pending = pending_.front();
+    if (pending.spilled.has_value()) {
+      pending.page = spiller_->read(pending.spilled.value());
+    }
+    if (pending.page != nullptr) {
+      loadedBytes += pending.page->size();
+    }
+    data_.push_back(std::move(pending.page));
+    pending_.pop_front();
+  }
+}
+
+void DestinationBuffer::spill(
+    OutputBufferSpiller& spiller,
+    std::vector<std::shared_ptr<SerializedPage>>& freed) {
+  spiller_ = &spiller;
+  // The pages which may be fetched again stay in memory. The others are
+  // moved to 'pending_', ahead of the pages there.
+  const auto numFetched =
+      std::max<int64_t>(fetchedSequence_ - sequence_, 0);
+  while (static_cast<int64_t>(data_.size()) > numFetched) {
+    pending_.push_front({std::move(data_.back()), std::nullopt});
+    data_.pop_back();
+  }
+  for (auto& pending : pending_) {
+    if (pending.page == nullptr) {
+      continue;
+    }
+    pending.spilled = spiller.write(pending.page);
+    freed.push_back(std::move(pending.page));
+  }
+}
+
 DataAvailable DestinationBuffer::getAndClearNotify() {
   if (notify_ == nullptr) {
     return DataAvailable();
@@ -163,7 +243,8 @@ DataAvailable DestinationBuffer::getAndClearNotify() {
 
 void DestinationBuffer::finish() {
   VELOX_CHECK_NULL(notify_, "notify must be cleared before finish");
-  VELOX_CHECK(data_.empty(), "data must be fetched before finish");
+  VELOX_CHECK(
+      data_.empty() && pending_.empty(), "data must be fetched before finish");
   stats_.finished = true;
 }
 
@@ -232,6 +313,15 @@ DestinationBuffer::deleteResults() {
     freed.push_back(std::move(data_[i]));
   }
   data_.clear();
+  for (auto& pending : pending_) {
+    if (pending.page != nullptr) {
+      stats_.recordDelete(*pending.page);
+      freed.push_back(std::move(pending.page));
+    } else if (pending.spilled.has_value()) {
+      stats_.recordDelete(pending.spilled.value());
+    }
+  }
+  pending_.clear();
   return freed;
 }
 
@@ -242,6 +332,7 @@ DestinationBuffer::Stats DestinationBuffer::stats() const {
 std::string DestinationBuffer::toString() {
   std::stringstream out;
   out << "[available: " << data_.size() << ", "
+      << "pending: " << pending_.size() << ", "
       << "sequence: " << sequence_ << ", "
       << (notify_ ? "notify registered, " : "") << this << "]";
   return out.str();
@@ -271,6 +362,13 @@ uint64_t maxBufferSize(
   return config.maxPartitionedOutputBufferSize();
 }
 
+bool flowControlEnabled(
+    const core::QueryConfig& config,
+    PartitionedOutputNode::Kind bufferKind) {
+  return bufferKind == PartitionedOutputNode::Kind::kPartitioned &&
+      config.partitionedOutputFlowControlEnabled();
+}
+
 } // namespace
 
 OutputBuffer::OutputBuffer(
@@ -282,6 +380,11 @@ OutputBuffer::OutputBuffer(
       kind_(kind),
       maxSize_(maxBufferSize(task_->queryCtx()->queryConfig(), kind)),
       continueSize_((maxSize_ * kContinuePct) / 100),
+      flowControl_(
+          flowControlEnabled(task_->queryCtx()->queryConfig(), kind)),
+      destinationCredit_(
+          flowControl_ ? maxSize_ / std::max(numDestinations, 1) : 0),
+      continueCredit_((destinationCredit_ * kContinuePct) / 100),
       arbitraryBuffer_(
           isArbitrary() ? std::make_unique<ArbitraryBuffer>() : nullptr),
       numDrivers_(numDrivers) {
@@ -290,6 +393,9 @@ OutputBuffer::OutputBuffer(
     buffers_.push_back(std::make_unique<DestinationBuffer>());
   }
   finishedBufferStats_.resize(numDestinations);
+  if (flowControl_) {
+    destinationPromises_.resize(numDestinations);
+  }
 }
 
 void OutputBuffer::updateOutputBuffers(int numBuffers, bool noMoreBuffers) {
@@ -388,10 +494,13 @@ bool OutputBuffer::enqueue(
       default:
         VELOX_UNREACHABLE(PartitionedOutputNode::kindString(kind_));
     }
+    updateAfterUnspillLocked();
 
-    if (totalSize_ > maxSize_ && future) {
-      promises_.emplace_back("OutputBuffer::enqueue");
-      *future = promises_.back().getSemiFuture();
+    if (totalSize_ > maxSize_ && future && shouldBlockLocked(destination)) {
+      auto& promises =
+          flowControl_ ? destinationPromises_[destination] : promises_;
+      promises.emplace_back("OutputBuffer::enqueue");
+      *future = promises.back().getSemiFuture();
       blocked = true;
     }
   }
@@ -404,6 +513,22 @@ bool OutputBuffer::enqueue(
   return blocked;
 }
 
+bool OutputBuffer::shouldBlockLocked(int destination) {
+  if (!flowControl_) {
+    return true;
+  }
+  // The destinations within their credit keep accepting data. Since the
+  // credits add up to 'maxSize_', some destination is over its credit.
+  auto* buffer = buffers_[destination].get();
+  if (buffer == nullptr ||
+      static_cast<uint64_t>(buffer->bytesBuffered()) <= destinationCredit_) {
+    ++unblockedEnqueues_;
+    return false;
+  }
+  buffer->recordBlockedEnqueue();
+  return true;
+}
+
 void OutputBuffer::enqueueBroadcastOutputLocked(
     std::unique_ptr<SerializedPage> data,
     std::vector<DataAvailable>& dataAvailableCbs) {
@@ -514,6 +639,7 @@ void OutputBuffer::checkIfDone(bool oneDriverFinished) {
         }
       }
     }
+    updateAfterUnspillLocked();
   }
 
   // Notify outside of mutex.
@@ -555,6 +681,7 @@ void OutputBuffer::acknowledge(int destination, int64_t sequence) {
     }
     freed = buffer->acknowledge(sequence, false);
     updateAfterAcknowledgeLocked(freed, promises);
+    updateDestinationAfterAcknowledgeLocked(destination, promises);
   }
   releaseAfterAcknowledge(freed, promises);
 }
@@ -582,7 +709,36 @@ void OutputBuffer::updateAfterAcknowledgeLocked(
   VELOX_CHECK_GE(totalSize_, 0);
   if (totalSize_ < continueSize_) {
     promises = std::move(promises_);
+    for (auto& destinationPromises : destinationPromises_) {
+      for (auto& promise : destinationPromises) {
+        promises.push_back(std::move(promise));
+      }
+      destinationPromises.clear();
+    }
+  }
+}
+
+void OutputBuffer::updateAfterUnspillLocked() {
+  if (spiller_ != nullptr) {
+    totalSize_ += spiller_->takeReadBytes();
+  }
+}
+
+void OutputBuffer::updateDestinationAfterAcknowledgeLocked(
+    int destination,
+    std::vector<ContinuePromise>& promises) {
+  if (!flowControl_ || destinationPromises_[destination].empty()) {
+    return;
+  }
+  auto* buffer = buffers_[destination].get();
+  if (buffer != nullptr &&
+      static_cast<uint64_t>(buffer->bytesBuffered()) >= continueCredit_) {
+    return;
   }
+  for (auto& promise : destinationPromises_[destination]) {
+    promises.push_back(std::move(promise));
+  }
+  destinationPromises_[destination].clear();
 }
 
 bool OutputBuffer::deleteResults(int destination) {
@@ -606,7 +762,9 @@ bool OutputBuffer::deleteResults(int destination) {
     buffers_[destination] = nullptr;
     ++numFinalAcknowledges_;
     isFinished = isFinishedLocked();
+    updateAfterUnspillLocked();
     updateAfterAcknowledgeLocked(freed, promises);
+    updateDestinationAfterAcknowledgeLocked(destination, promises);
   }
 
   // Outside of mutex.
@@ -647,7 +805,9 @@ void OutputBuffer::getData(
         sequence);
     freed = buffer->acknowledge(sequence, true);
     updateAfterAcknowledgeLocked(freed, promises);
+    updateDestinationAfterAcknowledgeLocked(destination, promises);
     data = buffer->getData(maxBytes, sequence, notify, arbitraryBuffer_.get());
+    updateAfterUnspillLocked();
   }
   releaseAfterAcknowledge(freed, promises);
   if (!data.empty()) {
@@ -655,6 +815,43 @@ void OutputBuffer::getData(
   }
 }
 
+common::SpillStats OutputBuffer::spill(
+    const common::SpillConfig& config,
+    memory::MemoryPool* pool) {
+  if (OutputBufferSpiller::readingOnThread()) {
+    return {};
+  }
+  std::vector<std::shared_ptr<SerializedPage>> freed;
+  std::vector<ContinuePromise> promises;
+  common::SpillStats spillStats;
+  {
+    std::unique_lock<std::mutex> l(mutex_, std::try_to_lock);
+    if (!l.owns_lock()) {
+      return {};
+    }
+    if (spiller_ == nullptr) {
+      spiller_ = std::make_unique<OutputBufferSpiller>(config, pool);
+    }
+    if (isArbitrary()) {
+      arbitraryBuffer_->spill(*spiller_, freed);
+    }
+    for (auto& buffer : buffers_) {
+      if (buffer != nullptr) {
+        buffer->spill(*spiller_, freed);
+      }
+    }
+    spillStats = spiller_->finishRun();
+
+    // A broadcast page is spilled by each destination. Count it once so that
+    // its memory is released if no other reference is left.
+    std::sort(freed.begin(), freed.end());
+    freed.erase(std::unique(freed.begin(), freed.end()), freed.end());
+    updateAfterAcknowledgeLocked(freed, promises);
+  }
+  releaseAfterAcknowledge(freed, promises);
+  return spillStats;
+}
+
 void OutputBuffer::terminate() {
   VELOX_CHECK(!task_->isRunning());
 
@@ -662,6 +859,12 @@ void OutputBuffer::terminate() {
   {
     std::lock_guard<std::mutex> l(mutex_);
     outstandingPromises.swap(promises_);
+    for (auto& destinationPromises : destinationPromises_) {
+      for (auto& promise : destinationPromises) {
+        outstandingPromises.push_back(std::move(promise));
+      }
+      destinationPromises.clear();
+    }
   }
   for (auto& promise : outstandingPromises) {
     promise.setValue();
@@ -675,8 +878,12 @@ std::string OutputBuffer::toString() {
 
 std::string OutputBuffer::toStringLocked() const {
   std::stringstream out;
+  auto numBlocked = promises_.size();
+  for (const auto& destinationPromises : destinationPromises_) {
+    numBlocked += destinationPromises.size();
+  }
   out << "[OutputBuffer[" << kind_ << "] totalSize_=" << totalSize_
-      << "b, num producers blocked=" << promises_.size()
+      << "b, num producers blocked=" << numBlocked
       << ", completed=" << numFinished_ << "/" << numDrivers_ << ", "
       << (atEnd_ ? "at end, " : "") << "destinations: " << std::endl;
   for (auto i = 0; i < buffers_.size(); ++i) {
@@ -712,7 +919,12 @@ OutputBuffer::Stats OutputBuffer::stats() {
     }
   }
   return OutputBuffer::Stats(
-      kind_, noMoreBuffers_, atEnd_, isFinishedLocked(), bufferStats);
+      kind_,
+      noMoreBuffers_,
+      atEnd_,
+      isFinishedLocked(),
+      bufferStats,
+      unblockedEnqueues_);
 }
 
 } // namespace facebook::velox::exec
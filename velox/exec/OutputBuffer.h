@@ -17,6 +17,7 @@
 
 #include "velox/core/PlanNode.h"
 #include "velox/exec/ExchangeQueue.h"
+#include "velox/exec/OutputBufferSpiller.h"
 
 namespace facebook::velox::exec {
 
@@ -48,7 +49,8 @@ class ArbitraryBuffer {
  public:
   /// Returns true if this arbitrary buffer has no buffered pages.
   bool empty() const {
-    return pages_.empty() || (pages_.size() == 1 && pages_.back() == nullptr);
+    return spilledPages_.empty() &&
+        (pages_.empty() || (pages_.size() == 1 && pages_.back() == nullptr));
   }
 
   /// Returns true if this arbitrary buffer will not receive any new pages from
@@ -65,12 +67,21 @@ class ArbitraryBuffer {
   void enqueue(std::unique_ptr<SerializedPage> page);
 
   /// Returns a number of pages with total bytes no less than 'maxBytes' if
-  /// there are sufficient buffered pages.
+  /// there are sufficient buffered pages. Spilled pages are read back first.
   std::vector<std::shared_ptr<SerializedPage>> getPages(uint64_t maxBytes);
 
+  /// Writes the buffered pages to 'spiller' and moves them to 'freed'.
+  void spill(
+      OutputBufferSpiller& spiller,
+      std::vector<std::shared_ptr<SerializedPage>>& freed);
+
   std::string toString() const;
 
  private:
+  // Spilled pages, in order. These come before 'pages_'.
+  std::deque<OutputBufferSpiller::SpilledPage> spilledPages_;
+  // Set on the first spill.
+  OutputBufferSpiller* spiller_{nullptr};
   std::deque<std::shared_ptr<SerializedPage>> pages_;
 };
 
@@ -88,6 +99,8 @@ class DestinationBuffer {
 
     void recordDelete(const SerializedPage& data);
 
+    void recordDelete(const OutputBufferSpiller::SpilledPage& data);
+
     bool finished{false};
 
     /// Number of buffered bytes / rows / pages.
@@ -99,6 +112,13 @@ class DestinationBuffer {
     int64_t bytesSent{0};
     int64_t rowsSent{0};
     int64_t pagesSent{0};
+
+    /// Number of enqueues that blocked the producer because this destination
+    /// was over its credit. Only set with partitioned output flow control.
+    int64_t blockedEnqueues{0};
+
+   private:
+    void recordSent(int64_t bytes, int64_t rows);
   };
 
   void enqueue(std::shared_ptr<SerializedPage> data);
@@ -142,15 +162,52 @@ class DestinationBuffer {
   // Finishes this destination buffer, set finished stats.
   void finish();
 
+  // Writes the pages which have not been fetched to 'spiller' and moves them
+  // to 'freed'. The spilled pages are read back when they are fetched.
+  void spill(
+      OutputBufferSpiller& spiller,
+      std::vector<std::shared_ptr<SerializedPage>>& freed);
+
+  // Returns the number of bytes enqueued and not yet acknowledged or deleted.
+  int64_t bytesBuffered() const {
+    return stats_.bytesBuffered;
+  }
+
+  // Records that a producer was blocked after adding data to this buffer.
+  void recordBlockedEnqueue() {
+    ++stats_.blockedEnqueues;
+  }
+
   // Returns the stats of this buffer.
   Stats stats() const;
 
   std::string toString();
 
  private:
+  // A page which follows 'data_' after a spill. It is either in memory or
+  // spilled, or is the end marker if neither.
+  struct PendingPage {
+    std::shared_ptr<SerializedPage> page;
+    std::optional<OutputBufferSpiller::SpilledPage> spilled;
+  };
+
+  // Returns true if the end marker has been enqueued.
+  bool hasEndMarker() const;
+
+  // Moves pages with up to 'maxBytes' bytes from 'pending_' to 'data_',
+  // reading back the spilled ones.
+  void loadPending(uint64_t maxBytes);
+
   std::vector<std::shared_ptr<SerializedPage>> data_;
   // The sequence number of the first in 'data_'.
   int64_t sequence_ = 0;
+  // The sequence number after the last item returned by getData().
+  int64_t fetchedSequence_{0};
+  // The pages after 'data_'. Non-empty only after a spill, in which case new
+  // pages are added here to keep them in order.
+  std::deque<PendingPage> pending_;
+  // Set on the first spill.
+  OutputBufferSpiller* spiller_{nullptr};
   DataAvailableCallback notify_ = nullptr;
   // The sequence number of the first item to pass to 'notify'.
   int64_t notifySequence_{0};
@@ -168,12 +225,14 @@ class OutputBuffer {
         bool _noMoreBuffers,
         bool _noMoreData,
         bool _finished,
-        const std::vector<DestinationBuffer::Stats>& _buffersStats)
+        const std::vector<DestinationBuffer::Stats>& _buffersStats,
+        int64_t _unblockedEnqueues = 0)
         : kind(_kind),
           noMoreBuffers(_noMoreBuffers),
           noMoreData(_noMoreData),
           finished(_finished),
-          buffersStats(_buffersStats) {}
+          buffersStats(_buffersStats),
+          unblockedEnqueues(_unblockedEnqueues) {}
 
     const core::PartitionedOutputNode::Kind kind;
 
@@ -184,6 +243,11 @@ class OutputBuffer {
 
     /// Stats of the OutputBuffer's destinations.
     const std::vector<DestinationBuffer::Stats> buffersStats;
+
+    /// Number of enqueues made while the buffered size was over the limit that
+    /// did not block the producer because the destination was within its
+    /// credit. Only set with partitioned output flow control.
+    const int64_t unblockedEnqueues;
   };
 
   OutputBuffer(
@@ -251,6 +315,19 @@ class OutputBuffer {
   // Gets the Stats of this output buffer.
   Stats stats();
 
+  /// Writes the buffered pages which have not been sent to the consumers to
+  /// disk and frees their memory. The spilled pages are read back into 'pool'
+  /// when fetched. The first call sets 'config' and 'pool' for all spills of
+  /// this buffer. Resumes the blocked producers if enough memory is freed.
+  /// Returns the stats of the spill, which are empty if nothing was spilled.
+  ///
+  /// Skips spilling if the buffer is in use, e.g. reading back spilled pages.
+  /// Reading back allocates memory under the buffer's mutex, which may
+  /// trigger memory arbitration and a spill of this buffer.
+  common::SpillStats spill(
+      const common::SpillConfig& config,
+      memory::MemoryPool* pool);
+
  private:
   // Percentage of maxSize below which a blocked producer should
   // be unblocked.
@@ -267,6 +344,17 @@ class OutputBuffer {
       const std::vector<std::shared_ptr<SerializedPage>>& freed,
       std::vector<ContinuePromise>& promises);
 
+  // Adds the producer promises blocked on 'destination' to 'promises' if the
+  // destination is below 'continueCredit_' or deleted. Used with partitioned
+  // output flow control only.
+  void updateDestinationAfterAcknowledgeLocked(
+      int destination,
+      std::vector<ContinuePromise>& promises);
+
+  // Returns true if a producer which added data to 'destination' should be
+  // blocked. Updates flow control stats.
+  bool shouldBlockLocked(int destination);
+
   /// Given an updated total number of broadcast buffers, add any missing ones
   /// and enqueue data that has been produced so far (e.g. dataToBroadcast_).
   void addOutputBuffersLocked(int numBuffers);
@@ -284,6 +372,9 @@ class OutputBuffer {
       std::unique_ptr<SerializedPage> data,
       std::vector<DataAvailable>& dataAvailableCbs);
 
+  // Adds the size of the spilled pages read back to 'totalSize_'.
+  void updateAfterUnspillLocked();
+
   std::string toStringLocked() const;
 
   FOLLY_ALWAYS_INLINE bool isBroadcast() const {
@@ -306,6 +397,14 @@ class OutputBuffer {
   // When 'totalSize_' goes below 'continueSize_', blocked producers are
   // resumed.
   const uint64_t continueSize_;
+  // True if producers of a partitioned output are blocked per destination.
+  // See QueryConfig::kPartitionedOutputFlowControlEnabled.
+  const bool flowControl_;
+  // With 'flowControl_', the number of bytes a destination may buffer once
+  // 'totalSize_' is over 'maxSize_' before producers adding to it are blocked.
+  const uint64_t destinationCredit_;
+  // Producers blocked on a destination are resumed when it goes below this.
+  const uint64_t continueCredit_;
   const std::unique_ptr<ArbitraryBuffer> arbitraryBuffer_;
 
   // Total number of drivers expected to produce results. This number will
@@ -326,11 +425,17 @@ class OutputBuffer {
   // Actual data size in 'buffers_'.
   uint64_t totalSize_ = 0;
   std::vector<ContinuePromise> promises_;
+  // With 'flowControl_', the producers blocked on each destination.
+  std::vector<std::vector<ContinuePromise>> destinationPromises_;
+  // See Stats::unblockedEnqueues.
+  int64_t unblockedEnqueues_{0};
   // The next buffer index in 'buffers_' to load data from arbitrary buffer
   // which is only used by arbitrary output type.
   int32_t nextArbitraryLoadBufferIndex_{0};
   // One buffer per destination.
   std::vector<std::unique_ptr<DestinationBuffer>> buffers_;
+  // Created on the first spill.
+  std::unique_ptr<OutputBufferSpiller> spiller_;
   // The sizes of buffers_ and finishedBufferStats_ are the same, but
   // finishedBufferStats_[i] is set if and only if buffers_[i] is null as
   // the buffer is finished and deleted.
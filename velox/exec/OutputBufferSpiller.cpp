@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/OutputBufferSpiller.h"
+
+#include <folly/ScopeGuard.h>
+
+#include "velox/buffer/Buffer.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/time/Timer.h"
+#include "velox/exec/SpillFile.h"
+
+namespace facebook::velox::exec {
+
+OutputBufferSpiller::OutputBufferSpiller(
+    const common::SpillConfig& config,
+    memory::MemoryPool* pool)
+    : config_(config), pool_(pool) {
+  VELOX_CHECK_NOT_NULL(pool_);
+}
+
+OutputBufferSpiller::~OutputBufferSpiller() = default;
+
+OutputBufferSpiller::SpilledPage OutputBufferSpiller::write(
+    const std::shared_ptr<SerializedPage>& page) {
+  VELOX_CHECK_NOT_NULL(page);
+  auto it = runPages_.find(page.get());
+  if (it != runPages_.end()) {
+    return it->second;
+  }
+
+  if (writeFile_ == nullptr) {
+    VELOX_CHECK_NOT_NULL(
+        config_.getSpillDirPathCb, "Spill directory callback not specified.");
+    const std::string& spillDir = config_.getSpillDirPathCb();
+    VELOX_CHECK(!spillDir.empty(), "Spill directory does not exist");
+    writeFile_ = SpillWriteFile::create(
+        paths_.size(),
+        fmt::format(
+            "{}/{}-output-{}", spillDir, config_.fileNamePrefix, paths_.size()),
+        config_.fileCreateConfig);
+    runStats_ = common::SpillStats();
+  }
+
+  SpilledPage spilled{
+      static_cast<uint32_t>(paths_.size()),
+      writeFile_->size(),
+      page->size(),
+      page->numRows()};
+  uint64_t writeTimeUs{0};
+  {
+    MicrosecondTimer timer(&writeTimeUs);
+    writeFile_->write(page->getIOBuf());
+  }
+  runStats_.spilledBytes += spilled.size;
+  runStats_.spilledInputBytes += spilled.size;
+  runStats_.spilledRows += spilled.numRows.value_or(0);
+  runStats_.spillWriteTimeUs += writeTimeUs;
+  ++runStats_.spillDiskWrites;
+  runPages_.emplace(page.get(), spilled);
+  return spilled;
+}
+
+common::SpillStats OutputBufferSpiller::finishRun() {
+  if (writeFile_ == nullptr) {
+    return {};
+  }
+  writeFile_->finish();
+  if (config_.updateAndCheckSpillLimitCb != nullptr) {
+    config_.updateAndCheckSpillLimitCb(writeFile_->size());
+  }
+  paths_.push_back(writeFile_->path());
+  files_.emplace_back();
+  readPages_.emplace_back();
+  writeFile_.reset();
+  runPages_.clear();
+
+  runStats_.spillRuns = 1;
+  runStats_.spilledFiles = 1;
+  return std::exchange(runStats_, common::SpillStats());
+}
+
+std::shared_ptr<SerializedPage> OutputBufferSpiller::read(
+    const SpilledPage& page) {
+  VELOX_CHECK_LT(page.file, paths_.size(), "Page of an unfinished spill run");
+  auto& readPages = readPages_[page.file];
+  auto it = readPages.find(page.offset);
+  if (it != readPages.end()) {
+    if (auto shared = it->second.lock()) {
+      return shared;
+    }
+  }
+
+  auto& file = files_[page.file];
+  if (file == nullptr) {
+    const auto& path = paths_[page.file];
+    file = filesystems::getFileSystem(path, nullptr)->openFileForRead(path);
+  }
+
+  // The IOBuf keeps the buffer alive, also in the clones that are sent to the
+  // consumer.
+  std::unique_ptr<BufferPtr> buffer;
+  {
+    readingOnThread_ = true;
+    SCOPE_EXIT {
+      readingOnThread_ = false;
+    };
+    buffer = std::make_unique<BufferPtr>(
+        AlignedBuffer::allocate<char>(page.size, pool_));
+  }
+  auto* data = (*buffer)->asMutable<char>();
+  file->pread(page.offset, page.size, data);
+  readBytes_ += page.size;
+  auto iobuf = folly::IOBuf::takeOwnership(
+      data,
+      page.size,
+      [](void* /*buf*/, void* userData) {
+        delete static_cast<BufferPtr*>(userData);
+      },
+      buffer.release());
+  auto result =
+      std::make_shared<SerializedPage>(std::move(iobuf), nullptr, page.numRows);
+  readPages[page.offset] = result;
+  if (readPages.size() >= pruneReadPagesSize_) {
+    for (auto pruneIt = readPages.begin(); pruneIt != readPages.end();) {
+      if (pruneIt->second.expired()) {
+        pruneIt = readPages.erase(pruneIt);
+      } else {
+        ++pruneIt;
+      }
+    }
+    pruneReadPagesSize_ =
+        std::max(kMinPruneReadPagesSize, 2 * readPages.size());
+  }
+  return result;
+}
+
+} // namespace facebook::velox::exec
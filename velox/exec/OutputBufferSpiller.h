@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/base/SpillConfig.h"
+#include "velox/common/base/SpillStats.h"
+#include "velox/common/file/File.h"
+#include "velox/exec/ExchangeQueue.h"
+
+namespace facebook::velox::exec {
+
+class SpillWriteFile;
+
+/// Writes the serialized pages of an OutputBuffer to spill files and reads
+/// them back. Each spill run writes a new file. This class is not thread-safe,
+/// the OutputBuffer calls it under its mutex.
+class OutputBufferSpiller {
+ public:
+  /// Location of a spilled page.
+  struct SpilledPage {
+    /// Index of the spill run which wrote the page.
+    uint32_t file;
+    uint64_t offset;
+    uint64_t size;
+    std::optional<int64_t> numRows;
+  };
+
+  /// 'pool' is used to allocate the pages read back.
+  OutputBufferSpiller(
+      const common::SpillConfig& config,
+      memory::MemoryPool* pool);
+
+  ~OutputBufferSpiller();
+
+  /// Writes 'page' to the file of the current spill run, starting a new run if
+  /// needed. A page shared by several destinations of a broadcast buffer is
+  /// written once per run.
+  SpilledPage write(const std::shared_ptr<SerializedPage>& page);
+
+  /// Finishes the current spill run and returns its stats. Returns empty stats
+  /// if nothing was written since the last call.
+  common::SpillStats finishRun();
+
+  /// Reads back a page written by a finished spill run. A page which is still
+  /// held from an earlier read is returned without reading it again, so that
+  /// the destinations of a broadcast buffer share the page read back.
+  std::shared_ptr<SerializedPage> read(const SpilledPage& page);
+
+  /// Returns the number of bytes read back since the last call. A page shared
+  /// by several reads is counted once.
+  uint64_t takeReadBytes() {
+    return std::exchange(readBytes_, 0);
+  }
+
+  /// Returns true if the calling thread is reading back a spilled page.
+  static bool readingOnThread() {
+    return readingOnThread_;
+  }
+
+ private:
+  static inline thread_local bool readingOnThread_{false};
+
+  const common::SpillConfig config_;
+  memory::MemoryPool* const pool_;
+
+  // The file of the current spill run. Null if no run is in progress.
+  std::unique_ptr<SpillWriteFile> writeFile_;
+  // Pages written by the current spill run.
+  folly::F14FastMap<const SerializedPage*, SpilledPage> runPages_;
+  common::SpillStats runStats_;
+
+  // Paths of the files of the finished spill runs.
+  std::vector<std::string> paths_;
+  // Files of the finished spill runs, opened on first read.
+  std::vector<std::unique_ptr<ReadFile>> files_;
+  // The pages read back from each finished spill run by their offset. The
+  // entries of the pages which are no longer held are removed when the map
+  // grows past 'pruneReadPagesSize_'.
+  std::vector<folly::F14FastMap<uint64_t, std::weak_ptr<SerializedPage>>>
+      readPages_;
+  size_t pruneReadPagesSize_{kMinPruneReadPagesSize};
+  uint64_t readBytes_{0};
+
+  static constexpr size_t kMinPruneReadPagesSize{1'024};
+};
+
+} // namespace facebook::velox::exec
@@ -27,6 +27,9 @@ void registerPartitionFunctionSerDe() {
   registry.Register(
       "RoundRobinPartitionFunctionSpec",
       RoundRobinPartitionFunctionSpec::deserialize);
+  registry.Register(
+      "SkewedHashPartitionFunctionSpec",
+      SkewedHashPartitionFunctionSpec::deserialize);
 }
 
 } // namespace facebook::velox::exec
@@ -17,8 +17,23 @@
 #include "velox/exec/PartitionedOutput.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/Task.h"
+#include "velox/serializers/PrestoSerializer.h"
 
 namespace facebook::velox::exec {
+namespace {
+std::unique_ptr<VectorSerde::Options> makeSerdeOptions(
+    const core::QueryConfig& queryConfig) {
+  if (!queryConfig.partitionedOutputPreserveEncodings() ||
+      dynamic_cast<serializer::presto::PrestoVectorSerde*>(getVectorSerde()) ==
+          nullptr) {
+    return nullptr;
+  }
+  auto options =
+      std::make_unique<serializer::presto::PrestoVectorSerde::PrestoOptions>();
+  options->preserveEncodings = true;
+  return options;
+}
+} // namespace
 
 namespace detail {
 BlockingReason Destination::advance(
@@ -55,7 +70,7 @@ BlockingReason Destination::advance(
   if (!current_) {
     current_ = std::make_unique<VectorStreamGroup>(pool_);
     auto rowType = asRowType(output->type());
-    current_->createStreamTree(rowType, rowsInCurrent_);
+    current_->createStreamTree(rowType, rowsInCurrent_, serdeOptions_);
   }
   current_->append(
       output, folly::Range(&rows_[firstRow], rowIdx_ - firstRow), scratch);
@@ -119,7 +134,10 @@ PartitionedOutput::PartitionedOutput(
           planNode->outputType(),
           operatorId,
           planNode->id(),
-          "PartitionedOutput"),
+          "PartitionedOutput",
+          planNode->canSpill(ctx->queryConfig())
+              ? ctx->makeSpillConfig(operatorId)
+              : std::nullopt),
       keyChannels_(toChannels(planNode->inputType(), planNode->keys())),
       numDestinations_(planNode->numPartitions()),
       replicateNullsAndAny_(planNode->isReplicateNullsAndAny()),
@@ -127,6 +145,9 @@ PartitionedOutput::PartitionedOutput(
           numDestinations_ == 1
               ? nullptr
               : planNode->partitionFunctionSpec().create(numDestinations_)),
+      skewedPartitionFunction_(
+          dynamic_cast<const SkewedHashPartitionFunction*>(
+              partitionFunction_.get())),
       outputChannels_(calculateOutputChannels(
           planNode->inputType(),
           planNode->outputType(),
@@ -140,7 +161,8 @@ PartitionedOutput::PartitionedOutput(
       maxBufferedBytes_(ctx->task->queryCtx()
                             ->queryConfig()
                             .maxPartitionedOutputBufferSize()),
-      eagerFlush_(eagerFlush) {
+      eagerFlush_(eagerFlush),
+      serdeOptions_(makeSerdeOptions(ctx->queryConfig())) {
   if (!planNode->isPartitioned()) {
     VELOX_USER_CHECK_EQ(numDestinations_, 1);
   }
@@ -182,7 +204,12 @@ void PartitionedOutput::initializeDestinations() {
     auto taskId = operatorCtx_->taskId();
     for (int i = 0; i < numDestinations_; ++i) {
       destinations_.push_back(std::make_unique<detail::Destination>(
-          taskId, i, pool(), eagerFlush_, [&](uint64_t bytes, uint64_t rows) {
+          taskId,
+          i,
+          pool(),
+          eagerFlush_,
+          serdeOptions_.get(),
+          [&](uint64_t bytes, uint64_t rows) {
             auto lockedStats = stats_.wlock();
             lockedStats->addOutputVector(bytes, rows);
           }));
@@ -369,6 +396,8 @@ RowVectorPtr PartitionedOutput::getOutput() {
     }
 
     bufferManager->noMoreData(operatorCtx_->task()->taskId());
+    recordPartitionStats(*bufferManager);
+    recordSpillStats(spillStats_);
     finished_ = true;
   }
   // The input is fully processed, drop the reference to allow reuse.
@@ -377,6 +406,60 @@ RowVectorPtr PartitionedOutput::getOutput() {
   return nullptr;
 }
 
+void PartitionedOutput::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& /*stats*/) {
+  VELOX_CHECK(canReclaim());
+  auto bufferManager = bufferManager_.lock();
+  if (bufferManager == nullptr) {
+    return;
+  }
+  auto buffer = bufferManager->getBufferIfExists(operatorCtx_->taskId());
+  if (buffer == nullptr) {
+    return;
+  }
+  // NOTE: the pages of all the drivers are spilled. The pages under
+  // construction in 'destinations_' are not.
+  spillStats_ += buffer->spill(spillConfig_.value(), pool());
+}
+
+void PartitionedOutput::recordPartitionStats(
+    OutputBufferManager& bufferManager) {
+  if (numDestinations_ == 1) {
+    return;
+  }
+  if (skewedPartitionFunction_ != nullptr) {
+    auto lockedStats = stats_.wlock();
+    lockedStats->addRuntimeStat(
+        kHotPartitionKeys,
+        RuntimeCounter(skewedPartitionFunction_->numHotKeys()));
+    lockedStats->addRuntimeStat(
+        kHotKeyRows, RuntimeCounter(skewedPartitionFunction_->numHotKeyRows()));
+  }
+
+  // The last driver to finish records the bytes of each destination enqueued
+  // by all the drivers.
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), operatorCtx_->driver(), nullptr, promises, peers)) {
+    return;
+  }
+  const auto bufferStats = bufferManager.stats(operatorCtx_->taskId());
+  if (!bufferStats.has_value()) {
+    return;
+  }
+  auto lockedStats = stats_.wlock();
+  for (const auto& destinationStats : bufferStats->buffersStats) {
+    // The pages which are deleted or spilled count as sent.
+    lockedStats->addRuntimeStat(
+        kPartitionBytes,
+        RuntimeCounter(
+            destinationStats.bytesBuffered + destinationStats.bytesSent,
+            RuntimeCounter::Unit::kBytes));
+  }
+}
+
 bool PartitionedOutput::isFinished() {
   return finished_;
 }
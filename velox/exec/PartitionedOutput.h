@@ -16,6 +16,7 @@
 #pragma once
 
 #include <folly/Random.h>
+#include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/vector/VectorStream.h"
@@ -32,11 +33,13 @@ class Destination {
       int destination,
       memory::MemoryPool* pool,
       bool eagerFlush,
+      const VectorSerde::Options* serdeOptions,
       std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued)
       : taskId_(taskId),
         destination_(destination),
         pool_(pool),
         eagerFlush_(eagerFlush),
+        serdeOptions_(serdeOptions),
         recordEnqueued_(std::move(recordEnqueued)) {
     setTargetSizePct();
   }
@@ -103,6 +106,9 @@ class Destination {
   const int destination_;
   memory::MemoryPool* const pool_;
   const bool eagerFlush_;
+  // The options to create the serializer of 'current_' with. Null for the
+  // defaults of the vector serde.
+  const VectorSerde::Options* const serdeOptions_;
   const std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued_;
 
   // Bytes serialized in 'current_'
@@ -182,7 +188,28 @@ class PartitionedOutput : public Operator {
     destinations_.clear();
   }
 
+  bool canReclaim() const override {
+    return canSpill() && !finished_;
+  }
+
+  /// Spills the pages in the task's output buffer which have not been sent to
+  /// the consumers.
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
+  /// Runtime stat with one sample per destination holding the bytes enqueued
+  /// for it by all the drivers of the task. Reported by the last driver to
+  /// finish if there is more than one destination.
+  static inline const std::string kPartitionBytes = "partitionBytes";
+  /// Runtime stats reported on finish if the partition function is a
+  /// SkewedHashPartitionFunction: the number of hot keys at the end and the
+  /// number of rows moved off their hash partition.
+  static inline const std::string kHotPartitionKeys = "hotPartitionKeys";
+  static inline const std::string kHotKeyRows = "hotKeyRows";
+
  private:
+  void recordPartitionStats(OutputBufferManager& bufferManager);
+
   void initializeInput(RowVectorPtr input);
 
   void initializeDestinations();
@@ -198,12 +225,17 @@ class PartitionedOutput : public Operator {
   const int numDestinations_;
   const bool replicateNullsAndAny_;
   std::unique_ptr<core::PartitionFunction> partitionFunction_;
+  // Set if 'partitionFunction_' spreads hot keys over multiple partitions.
+  const SkewedHashPartitionFunction* skewedPartitionFunction_;
   // Empty if column order in the output is exactly the same as in input.
   const std::vector<column_index_t> outputChannels_;
   const std::weak_ptr<exec::OutputBufferManager> bufferManager_;
   const std::function<void()> bufferReleaseFn_;
   const int64_t maxBufferedBytes_;
   const bool eagerFlush_;
+  // Set if the destinations keep the encodings of the output columns. See
+  // QueryConfig::kPartitionedOutputPreserveEncodings.
+  const std::unique_ptr<VectorSerde::Options> serdeOptions_;
 
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   ContinueFuture future_;
@@ -211,6 +243,8 @@ class PartitionedOutput : public Operator {
   std::vector<vector_size_t*> sizePointers_;
   std::vector<vector_size_t> rowSize_;
   std::vector<std::unique_ptr<detail::Destination>> destinations_;
+  // Stats of the output buffer spills made by this operator.
+  common::SpillStats spillStats_;
   bool replicatedAny_{false};
   RowVectorPtr output_;
 
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/PrefixSort.h"
+
+#include "velox/exec/prefixsort/PrefixSortAlgorithm.h"
+
+namespace facebook::velox::exec {
+
+using prefixsort::PrefixSortEncoder;
+
+namespace {
+// Max number of bytes of a string key to encode. Longer prefixes rarely
+// break more ties and make every swap in the sort more expensive.
+constexpr uint32_t kMaxStringPrefixBytes = 16;
+
+// Returns the number of bytes to encode a fixed width key of 'kind', or
+// std::nullopt if keys of 'kind' are not encoded.
+std::optional<uint32_t> fixedWidthEncodedSize(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::INTEGER:
+      return PrefixSortEncoder::encodedSize<int32_t>();
+    case TypeKind::BIGINT:
+      return PrefixSortEncoder::encodedSize<int64_t>();
+    case TypeKind::REAL:
+      return PrefixSortEncoder::encodedSize<float>();
+    case TypeKind::DOUBLE:
+      return PrefixSortEncoder::encodedSize<double>();
+    case TypeKind::TIMESTAMP:
+      return PrefixSortEncoder::encodedSize<Timestamp>();
+    default:
+      return std::nullopt;
+  }
+}
+
+template <typename T>
+FOLLY_ALWAYS_INLINE void encodeKey(
+    const PrefixSortEncoder& encoder,
+    const char* row,
+    RowColumn column,
+    char* dest) {
+  if (RowContainer::isNullAt(row, column)) {
+    encoder.encode(std::optional<T>(), dest);
+  } else {
+    encoder.encode(
+        std::optional<T>(*reinterpret_cast<const T*>(row + column.offset())),
+        dest);
+  }
+}
+
+FOLLY_ALWAYS_INLINE char* rowAt(const char* entry, uint32_t encodeSize) {
+  char* row;
+  std::memcpy(&row, entry + encodeSize, sizeof(char*));
+  return row;
+}
+} // namespace
+
+// static
+PrefixSortLayout PrefixSortLayout::make(
+    const RowContainer& rowContainer,
+    const std::vector<CompareFlags>& compareFlags,
+    uint32_t maxNormalizedKeyBytes) {
+  const auto& keyTypes = rowContainer.keyTypes();
+  VELOX_CHECK(compareFlags.empty() || compareFlags.size() <= keyTypes.size());
+
+  PrefixSortLayout layout;
+  layout.numKeys = compareFlags.empty() ? keyTypes.size() : compareFlags.size();
+  layout.compareFlags = compareFlags;
+  layout.compareFlags.resize(layout.numKeys);
+  for (auto i = 0; i < layout.numKeys; ++i) {
+    const auto& flags = layout.compareFlags[i];
+    const auto kind = keyTypes[i]->kind();
+    const auto remainingBytes = maxNormalizedKeyBytes - layout.encodeSize;
+    const bool isString =
+        kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY;
+    uint32_t keySize;
+    if (isString) {
+      // A string key needs at least one byte after its null byte.
+      if (remainingBytes < 2) {
+        break;
+      }
+      keySize = std::min(remainingBytes, 1 + kMaxStringPrefixBytes);
+    } else {
+      const auto size = fixedWidthEncodedSize(kind);
+      if (!size.has_value() || size.value() > remainingBytes) {
+        break;
+      }
+      keySize = size.value();
+    }
+    layout.keySizes.push_back(keySize);
+    layout.encoders.emplace_back(flags.ascending, flags.nullsFirst);
+    layout.encodeSize += keySize;
+    ++layout.numEncodedKeys;
+    if (isString) {
+      // The truncated string doesn't order the rows with equal prefixes, so
+      // the keys after it can't be encoded.
+      break;
+    }
+    ++layout.numExactKeys;
+  }
+  layout.entrySize = layout.encodeSize + sizeof(char*);
+  return layout;
+}
+
+// static
+void PrefixSort::encodeRow(
+    const PrefixSortLayout& layout,
+    const RowContainer& rowContainer,
+    char* row,
+    char* dest) {
+  char* const entry = dest;
+  for (auto i = 0; i < layout.numEncodedKeys; ++i) {
+    const auto& encoder = layout.encoders[i];
+    const auto column = rowContainer.columnAt(i);
+    switch (rowContainer.keyTypes()[i]->kind()) {
+      case TypeKind::INTEGER:
+        encodeKey<int32_t>(encoder, row, column, dest);
+        break;
+      case TypeKind::BIGINT:
+        encodeKey<int64_t>(encoder, row, column, dest);
+        break;
+      case TypeKind::REAL:
+        encodeKey<float>(encoder, row, column, dest);
+        break;
+      case TypeKind::DOUBLE:
+        encodeKey<double>(encoder, row, column, dest);
+        break;
+      case TypeKind::TIMESTAMP:
+        encodeKey<Timestamp>(encoder, row, column, dest);
+        break;
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY: {
+        if (RowContainer::isNullAt(row, column)) {
+          encoder.encode(std::nullopt, dest, layout.keySizes[i]);
+          break;
+        }
+        std::string storage;
+        const auto value = HashStringAllocator::contiguousString(
+            *reinterpret_cast<const StringView*>(row + column.offset()),
+            storage);
+        encoder.encode(
+            std::optional<StringView>(value), dest, layout.keySizes[i]);
+        break;
+      }
+      default:
+        VELOX_UNREACHABLE(
+            "Unsupported prefix sort key type: {}",
+            rowContainer.keyTypes()[i]->toString());
+    }
+    dest += layout.keySizes[i];
+  }
+  std::memcpy(entry + layout.encodeSize, &row, sizeof(char*));
+}
+
+// static
+void PrefixSort::sort(
+    RowContainer* rowContainer,
+    const std::vector<CompareFlags>& compareFlags,
+    const common::PrefixSortConfig& config,
+    memory::MemoryPool* pool,
+    folly::Range<char**> rows) {
+  if (config.maxNormalizedKeyBytes == 0 || rows.size() < config.minNumRows) {
+    stdSort(rowContainer, compareFlags, rows);
+    return;
+  }
+  const auto layout = PrefixSortLayout::make(
+      *rowContainer, compareFlags, config.maxNormalizedKeyBytes);
+  if (layout.numEncodedKeys == 0) {
+    stdSort(rowContainer, compareFlags, rows);
+    return;
+  }
+
+  const auto entrySize = layout.entrySize;
+  // The encoded keys are allocated on top of the memory already used by the
+  // rows being sorted. Falls back to std::sort which needs no extra memory if
+  // they don't fit. The reservation is released by the caller.
+  if (!pool->maybeReserve((rows.size() + 1) * entrySize)) {
+    stdSort(rowContainer, compareFlags, rows);
+    return;
+  }
+  auto entries = AlignedBuffer::allocate<char>(rows.size() * entrySize, pool);
+  auto swapBuffer = AlignedBuffer::allocate<char>(entrySize, pool);
+  char* const start = entries->asMutable<char>();
+  char* const end = start + rows.size() * entrySize;
+  for (auto i = 0; i < rows.size(); ++i) {
+    encodeRow(layout, *rowContainer, rows[i], start + i * entrySize);
+  }
+
+  const auto encodeSize = layout.encodeSize;
+  const auto numExactKeys = layout.numExactKeys;
+  const bool allKeysExact = numExactKeys == layout.numKeys;
+  prefixsort::PrefixSortRunner runner(
+      entrySize, swapBuffer->asMutable<char>());
+  runner.quickSort(start, end, [&](char* left, char* right) -> int32_t {
+    if (auto result = std::memcmp(left, right, encodeSize)) {
+      return result;
+    }
+    if (allKeysExact) {
+      return 0;
+    }
+    return compareRows(
+        rowContainer,
+        layout.compareFlags,
+        numExactKeys,
+        rowAt(left, encodeSize),
+        rowAt(right, encodeSize));
+  });
+
+  for (auto i = 0; i < rows.size(); ++i) {
+    rows[i] = rowAt(start + i * entrySize, encodeSize);
+  }
+}
+
+// static
+void PrefixSort::stdSort(
+    RowContainer* rowContainer,
+    const std::vector<CompareFlags>& compareFlags,
+    folly::Range<char**> rows) {
+  std::vector<CompareFlags> flags = compareFlags;
+  if (flags.empty()) {
+    flags.resize(rowContainer->keyTypes().size());
+  }
+  std::sort(
+      rows.begin(), rows.end(), [&](const char* left, const char* right) {
+        return compareRows(rowContainer, flags, 0, left, right) < 0;
+      });
+}
+} // namespace facebook::velox::exec
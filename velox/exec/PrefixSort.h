@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/PrefixSortConfig.h"
+#include "velox/exec/RowContainer.h"
+#include "velox/exec/prefixsort/PrefixSortEncoder.h"
+
+namespace facebook::velox::exec {
+
+/// Describes how the leading sort keys of a RowContainer are encoded into
+/// memcmp comparable prefixes for PrefixSort.
+struct PrefixSortLayout {
+  /// Returns the layout for the keys of 'rowContainer' sorted by
+  /// 'compareFlags' with at most 'maxNormalizedKeyBytes' of encoded keys.
+  /// 'compareFlags' is either empty for the default flags or has one entry per
+  /// key column.
+  static PrefixSortLayout make(
+      const RowContainer& rowContainer,
+      const std::vector<CompareFlags>& compareFlags,
+      uint32_t maxNormalizedKeyBytes);
+
+  /// Number of bytes of the encoded keys in front of the row pointer.
+  uint32_t encodeSize{0};
+
+  /// Number of bytes of an entry: the encoded keys plus the row pointer.
+  uint32_t entrySize{0};
+
+  /// Number of key columns to sort by.
+  uint32_t numKeys{0};
+
+  /// Number of leading keys which are encoded. Zero if the first key can't be
+  /// encoded in which case prefix sort doesn't apply.
+  uint32_t numEncodedKeys{0};
+
+  /// Number of leading keys which are encoded exactly. The rows with equal
+  /// prefixes are compared by the keys from this one on. It is one less than
+  /// 'numEncodedKeys' if the last encoded key is a truncated string.
+  uint32_t numExactKeys{0};
+
+  /// Number of bytes of each encoded key including its null byte.
+  std::vector<uint32_t> keySizes;
+
+  std::vector<prefixsort::PrefixSortEncoder> encoders;
+
+  /// Flags of all 'numKeys' keys.
+  std::vector<CompareFlags> compareFlags;
+};
+
+/// Sorts the rows of a RowContainer by its leading key columns. Copies the
+/// normalized keys of each row followed by the row pointer into a
+/// contiguous buffer and sorts it with PrefixSortRunner::quickSort using
+/// memcmp on the keys. The keys which are not encoded exactly are compared
+/// through the RowContainer when the prefixes are equal.
+class PrefixSort {
+ public:
+  /// Sorts 'rows' of 'rowContainer' by the first 'compareFlags.size()' key
+  /// columns, or by all the key columns if 'compareFlags' is empty. Falls
+  /// back to std::sort if prefix sort is disabled by 'config', there are
+  /// fewer than 'config.minNumRows' rows or the first key can't be encoded.
+  /// The buffers for the encoded keys are allocated from 'pool' after reserving
+  /// memory for them. Falls back to std::sort if the reservation fails. The
+  /// caller releases the unused reservation of 'pool' after sorting.
+  static void sort(
+      RowContainer* rowContainer,
+      const std::vector<CompareFlags>& compareFlags,
+      const common::PrefixSortConfig& config,
+      memory::MemoryPool* pool,
+      folly::Range<char**> rows);
+
+ private:
+  static void stdSort(
+      RowContainer* rowContainer,
+      const std::vector<CompareFlags>& compareFlags,
+      folly::Range<char**> rows);
+
+  // Compares 'left' and 'right' by the keys from 'startKey' on.
+  FOLLY_ALWAYS_INLINE static int32_t compareRows(
+      RowContainer* rowContainer,
+      const std::vector<CompareFlags>& compareFlags,
+      uint32_t startKey,
+      const char* left,
+      const char* right) {
+    for (auto i = startKey; i < compareFlags.size(); ++i) {
+      if (auto result =
+              rowContainer->compare(left, right, i, compareFlags[i])) {
+        return result;
+      }
+    }
+    return 0;
+  }
+
+  // Encodes the keys of 'row' into 'dest' followed by the row pointer.
+  static void encodeRow(
+      const PrefixSortLayout& layout,
+      const RowContainer& rowContainer,
+      char* row,
+      char* dest);
+};
+} // namespace facebook::velox::exec
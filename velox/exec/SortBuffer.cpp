@@ -16,6 +16,7 @@
 
 #include "SortBuffer.h"
 #include "velox/exec/MemoryReclaimer.h"
+#include "velox/exec/PrefixSort.h"
 
 namespace facebook::velox::exec {
 
@@ -26,13 +27,15 @@ SortBuffer::SortBuffer(
     velox::memory::MemoryPool* pool,
     tsan_atomic<bool>* nonReclaimableSection,
     const common::SpillConfig* spillConfig,
-    uint64_t spillMemoryThreshold)
+    uint64_t spillMemoryThreshold,
+    const common::PrefixSortConfig& prefixSortConfig)
     : input_(input),
       sortCompareFlags_(sortCompareFlags),
       pool_(pool),
       nonReclaimableSection_(nonReclaimableSection),
       spillConfig_(spillConfig),
-      spillMemoryThreshold_(spillMemoryThreshold) {
+      spillMemoryThreshold_(spillMemoryThreshold),
+      prefixSortConfig_(prefixSortConfig) {
   VELOX_CHECK_GE(input_->size(), sortCompareFlags_.size());
   VELOX_CHECK_GT(sortCompareFlags_.size(), 0);
   VELOX_CHECK_EQ(sortColumnIndices.size(), sortCompareFlags_.size());
@@ -112,19 +115,12 @@ void SortBuffer::noMoreInput() {
     sortedRows_.resize(numInputRows_);
     RowContainerIterator iter;
     data_->listRows(&iter, numInputRows_, sortedRows_.data());
-    std::sort(
-        sortedRows_.begin(),
-        sortedRows_.end(),
-        [this](const char* leftRow, const char* rightRow) {
-          for (vector_size_t index = 0; index < sortCompareFlags_.size();
-               ++index) {
-            if (auto result = data_->compare(
-                    leftRow, rightRow, index, sortCompareFlags_[index])) {
-              return result < 0;
-            }
-          }
-          return false;
-        });
+    PrefixSort::sort(
+        data_.get(),
+        sortCompareFlags_,
+        prefixSortConfig_,
+        pool_,
+        folly::Range<char**>(sortedRows_.data(), sortedRows_.size()));
   } else {
     // Spill the remaining in-memory state to disk if spilling has been
     // triggered on this sort buffer. This is to simplify query OOM prevention
@@ -148,7 +144,11 @@ RowVectorPtr SortBuffer::getOutput(uint32_t maxOutputRows) {
 
   prepareOutput(maxOutputRows);
   if (spiller_ != nullptr) {
-    getOutputWithSpill();
+    if (spiller_->format() == common::SpillFormat::kRowContainer) {
+      getOutputWithSerializedRowSpill();
+    } else {
+      getOutputWithSpill();
+    }
   } else {
     getOutputWithoutSpill();
   }
@@ -163,6 +163,11 @@ void SortBuffer::spill() {
   if (data_->numRows() == 0) {
     return;
   }
+  // The output is already produced from the spilled rows. 'data_' only holds
+  // the rows restored to produce the current output batch.
+  if (spillMerger_ != nullptr) {
+    return;
+  }
   updateEstimatedOutputRowSize();
 
   if (sortedRows_.empty()) {
@@ -269,7 +274,8 @@ void SortBuffer::spillInput() {
         spillerStoreType_,
         data_->keyTypes().size(),
         sortCompareFlags_,
-        spillConfig_);
+        spillConfig_,
+        spillConfig_->orderBySpillFormat);
   }
   spiller_->spill();
   data_->clear();
@@ -289,7 +295,8 @@ void SortBuffer::spillOutput() {
       Spiller::Type::kOrderByOutput,
       data_.get(),
       spillerStoreType_,
-      spillConfig_);
+      spillConfig_,
+      spillConfig_->orderBySpillFormat);
   auto spillRows = std::vector<char*>(
       sortedRows_.begin() + numOutputRows_, sortedRows_.end());
   spiller_->spill(spillRows);
@@ -386,10 +393,43 @@ void SortBuffer::getOutputWithSpill() {
   numOutputRows_ += output_->size();
 }
 
+void SortBuffer::getOutputWithSerializedRowSpill() {
+  VELOX_CHECK_NOT_NULL(spillMerger_);
+  VELOX_DCHECK_EQ(sortedRows_.size(), 0);
+
+  // Frees the rows restored for the previous output batch which is not
+  // referenced anymore as 'output_' is reused.
+  data_->clear();
+  restoredRows_.resize(output_->size());
+  for (auto i = 0; i < output_->size(); ++i) {
+    SpillMergeStream* stream = spillMerger_->next();
+    VELOX_CHECK_NOT_NULL(stream);
+    // The serialized rows are the last column. The input spiller puts the
+    // sort keys before them, the output spiller spills no sort keys.
+    const auto& spilled = stream->current();
+    const auto* serializedRows =
+        spilled.childAt(spilled.childrenSize() - 1)
+            ->asUnchecked<FlatVector<StringView>>();
+    restoredRows_[i] = data_->newRow();
+    data_->storeSerializedRow(
+        *serializedRows, stream->currentIndex(), restoredRows_[i]);
+    stream->pop();
+  }
+
+  for (const auto& columnProjection : columnMap_) {
+    data_->extractColumn(
+        restoredRows_.data(),
+        output_->size(),
+        columnProjection.inputChannel,
+        output_->childAt(columnProjection.outputChannel));
+  }
+  numOutputRows_ += output_->size();
+}
+
 void SortBuffer::finishSpill() {
   VELOX_CHECK_NULL(spillMerger_);
   auto spillPartition = spiller_->finishSpill();
-  spillMerger_ = spillPartition.createOrderedReader(pool());
+  spillMerger_ = spillPartition.createOrderedReader(pool(), spillConfig_);
 }
 
 } // namespace facebook::velox::exec
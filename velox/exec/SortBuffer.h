@@ -37,7 +37,9 @@ class SortBuffer {
       velox::memory::MemoryPool* pool,
       tsan_atomic<bool>* nonReclaimableSection,
       const common::SpillConfig* spillConfig = nullptr,
-      uint64_t spillMemoryThreshold = 0);
+      uint64_t spillMemoryThreshold = 0,
+      const common::PrefixSortConfig& prefixSortConfig =
+          common::PrefixSortConfig());
 
   void addInput(const VectorPtr& input);
 
@@ -80,6 +82,9 @@ class SortBuffer {
   void prepareOutput(uint32_t maxOutputRows);
   void getOutputWithoutSpill();
   void getOutputWithSpill();
+  // Produces the output from the rows spilled in
+  // 'common::SpillFormat::kRowContainer' by copying them back into 'data_'.
+  void getOutputWithSerializedRowSpill();
   // Spill during input stage.
   void spillInput();
   // Spill during output stage.
@@ -101,6 +106,8 @@ class SortBuffer {
   //
   // NOTE: 'spillMemoryThreshold_' only applies if disk spilling is enabled.
   const uint64_t spillMemoryThreshold_;
+  // Used to sort the rows in 'data_' if there is no spilling.
+  const common::PrefixSortConfig prefixSortConfig_;
 
   // The column projection map between 'input_' and 'spillerStoreType_' as sort
   // buffer stores the sort columns first in 'data_'.
@@ -124,6 +131,8 @@ class SortBuffer {
   // Records the source rows to copy to 'output_' in order.
   std::vector<const RowVector*> spillSources_;
   std::vector<vector_size_t> spillSourceRows_;
+  // The rows in 'data_' restored from spill for the current output batch.
+  std::vector<char*> restoredRows_;
   // Counts input batches to trigger spilling for test.
   uint64_t spillTestCounter_{0};
 
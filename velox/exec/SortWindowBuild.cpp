@@ -16,6 +16,7 @@
 
 #include "velox/exec/SortWindowBuild.h"
 #include "velox/exec/MemoryReclaimer.h"
+#include "velox/exec/PrefixSort.h"
 
 namespace facebook::velox::exec {
 
@@ -43,11 +44,13 @@ SortWindowBuild::SortWindowBuild(
     const std::shared_ptr<const core::WindowNode>& node,
     velox::memory::MemoryPool* pool,
     const common::SpillConfig* spillConfig,
-    tsan_atomic<bool>* nonReclaimableSection)
+    tsan_atomic<bool>* nonReclaimableSection,
+    const common::PrefixSortConfig& prefixSortConfig)
     : WindowBuild(node, pool, spillConfig, nonReclaimableSection),
       numPartitionKeys_{node->partitionKeys().size()},
       spillCompareFlags_{
           makeSpillCompareFlags(numPartitionKeys_, node->sortingOrders())},
+      prefixSortConfig_(prefixSortConfig),
       pool_(pool) {
   VELOX_CHECK_NOT_NULL(pool_);
   allKeyInfo_.reserve(partitionKeyInfo_.size() + sortKeyInfo_.size());
@@ -184,20 +187,21 @@ void SortWindowBuild::computePartitionStartRows() {
 }
 
 void SortWindowBuild::sortPartitions() {
-  // This is a very inefficient but easy implementation to order the input rows
-  // by partition keys + sort keys.
+  // Order the input rows by partition keys + sort keys.
   // Sort the pointers to the rows in RowContainer (data_) instead of sorting
   // the rows.
   sortedRows_.resize(numRows_);
   RowContainerIterator iter;
   data_->listRows(&iter, numRows_, sortedRows_.data());
 
-  std::sort(
-      sortedRows_.begin(),
-      sortedRows_.end(),
-      [this](const char* leftRow, const char* rightRow) {
-        return compareRowsWithKeys(leftRow, rightRow, allKeyInfo_);
-      });
+  PrefixSort::sort(
+      data_.get(),
+      spillCompareFlags_,
+      prefixSortConfig_,
+      pool_,
+      folly::Range<char**>(sortedRows_.data(), sortedRows_.size()));
+  // Releases the unused memory reservation after sorting.
+  pool_->release();
 
   computePartitionStartRows();
 }
@@ -214,7 +218,7 @@ void SortWindowBuild::noMoreInput() {
 
     VELOX_CHECK_NULL(merge_);
     auto spillPartition = spiller_->finishSpill();
-    merge_ = spillPartition.createOrderedReader(pool_);
+    merge_ = spillPartition.createOrderedReader(pool_, spillConfig_);
   } else {
     // At this point we have seen all the input rows. The operator is
     // being prepared to output rows now.
@@ -30,7 +30,9 @@ class SortWindowBuild : public WindowBuild {
       const std::shared_ptr<const core::WindowNode>& node,
       velox::memory::MemoryPool* pool,
       const common::SpillConfig* spillConfig,
-      tsan_atomic<bool>* nonReclaimableSection);
+      tsan_atomic<bool>* nonReclaimableSection,
+      const common::PrefixSortConfig& prefixSortConfig =
+          common::PrefixSortConfig());
 
   bool needsInput() override {
     // No partitions are available yet, so can consume input rows.
@@ -78,9 +80,11 @@ class SortWindowBuild : public WindowBuild {
   // keys are set to default values. Compare flags for sorting keys match
   // sorting order specified in the plan node.
   //
-  // Used to sort 'data_' while spilling.
+  // Used to sort 'data_' while spilling and in sortPartitions().
   const std::vector<CompareFlags> spillCompareFlags_;
 
+  const common::PrefixSortConfig prefixSortConfig_;
+
   memory::MemoryPool* const pool_;
 
   // allKeyInfo_ is a combination of (partitionKeyInfo_ and sortKeyInfo_).
@@ -23,6 +23,19 @@
 using facebook::velox::common::testutil::TestValue;
 
 namespace facebook::velox::exec {
+namespace {
+std::unique_ptr<SpillReadFile> createSpillReadFile(
+    const SpillFileInfo& fileInfo,
+    memory::MemoryPool* pool,
+    const common::SpillConfig* spillConfig) {
+  if (spillConfig == nullptr) {
+    return SpillReadFile::create(fileInfo, pool);
+  }
+  return SpillReadFile::create(
+      fileInfo, pool, spillConfig->numReadAheadBuffers, spillConfig->executor);
+}
+} // namespace
+
 void SpillMergeStream::pop() {
   if (++index_ >= size_) {
     setNextBatch();
@@ -228,13 +241,15 @@ std::string SpillPartition::toString() const {
 }
 
 std::unique_ptr<UnorderedStreamReader<BatchStream>>
-SpillPartition::createUnorderedReader(memory::MemoryPool* pool) {
+SpillPartition::createUnorderedReader(
+    memory::MemoryPool* pool,
+    const common::SpillConfig* spillConfig) {
   VELOX_CHECK_NOT_NULL(pool);
   std::vector<std::unique_ptr<BatchStream>> streams;
   streams.reserve(files_.size());
   for (auto& fileInfo : files_) {
-    streams.push_back(
-        FileSpillBatchStream::create(SpillReadFile::create(fileInfo, pool)));
+    streams.push_back(FileSpillBatchStream::create(
+        createSpillReadFile(fileInfo, pool, spillConfig)));
   }
   files_.clear();
   return std::make_unique<UnorderedStreamReader<BatchStream>>(
@@ -242,12 +257,14 @@ SpillPartition::createUnorderedReader(memory::MemoryPool* pool) {
 }
 
 std::unique_ptr<TreeOfLosers<SpillMergeStream>>
-SpillPartition::createOrderedReader(memory::MemoryPool* pool) {
+SpillPartition::createOrderedReader(
+    memory::MemoryPool* pool,
+    const common::SpillConfig* spillConfig) {
   std::vector<std::unique_ptr<SpillMergeStream>> streams;
   streams.reserve(files_.size());
   for (auto& fileInfo : files_) {
-    streams.push_back(
-        FileSpillMergeStream::create(SpillReadFile::create(fileInfo, pool)));
+    streams.push_back(FileSpillMergeStream::create(
+        createSpillReadFile(fileInfo, pool, spillConfig)));
   }
   files_.clear();
   // Check if the partition is empty or not.
@@ -280,6 +280,12 @@ class SpillPartition {
     return size_;
   }
 
+  /// Returns the spill files of this partition. Used by the operators which
+  /// need to read the spilled data more than once.
+  const SpillFiles& files() const {
+    return files_;
+  }
+
   /// Invoked to split this spill partition into 'numShards' to process in
   /// parallel.
   ///
@@ -287,14 +293,20 @@ class SpillPartition {
   std::vector<std::unique_ptr<SpillPartition>> split(int numShards);
 
   /// Invoked to create an unordered stream reader from this spill partition.
-  /// The created reader will take the ownership of the spill files.
+  /// The created reader will take the ownership of the spill files. If
+  /// 'spillConfig' is set, the spill files are read ahead on its executor.
   std::unique_ptr<UnorderedStreamReader<BatchStream>> createUnorderedReader(
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      const common::SpillConfig* spillConfig = nullptr);
 
   /// Invoked to create an ordered stream reader from this spill partition.
-  /// The created reader will take the ownership of the spill files.
+  /// The created reader will take the ownership of the spill files. If
+  /// 'spillConfig' is set, the spill files are read ahead on its executor so
+  /// that the next batch of each file is read while the current ones are
+  /// merged.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> createOrderedReader(
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      const common::SpillConfig* spillConfig = nullptr);
 
   std::string toString() const;
 
@@ -28,12 +28,85 @@ namespace {
 static const bool kDefaultUseLosslessTimestamp = true;
 } // namespace
 
+SpillInputStream::SpillInputStream(
+    std::unique_ptr<ReadFile>&& file,
+    BufferPtr buffer,
+    std::vector<BufferPtr> readAheadBuffers,
+    folly::Executor* executor)
+    : file_(std::move(file)),
+      size_(file_->size()),
+      executor_(readAheadBuffers.empty() ? nullptr : executor),
+      buffer_(std::move(buffer)),
+      freeBuffers_(std::move(readAheadBuffers)) {
+  next(true);
+}
+
+SpillInputStream::~SpillInputStream() {
+  // The read-ahead uses 'file_' and the buffers allocated from the operator's
+  // memory pool, so it must complete before this is destroyed. A read-ahead
+  // not started on 'executor_' yet runs on this thread.
+  for (auto& readAhead : readAheads_) {
+    try {
+      readAhead->move();
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Spill file read-ahead failed: " << e.what();
+    }
+  }
+}
+
 void SpillInputStream::next(bool /*throwIfPastEnd*/) {
-  const int32_t readBytes = std::min(size_ - offset_, buffer_->capacity());
-  VELOX_CHECK_LT(0, readBytes, "Reading past end of spill file");
+  int32_t readBytes{0};
+  uint64_t readWaitTimeUs{0};
+  if (executor_ == nullptr) {
+    readBytes = std::min(size_ - offset_, buffer_->capacity());
+    VELOX_CHECK_LT(0, readBytes, "Reading past end of spill file");
+    {
+      MicrosecondTimer timer(&readWaitTimeUs);
+      file_->pread(offset_, readBytes, buffer_->asMutable<char>());
+    }
+    offset_ += readBytes;
+  } else {
+    // The consumed buffer is recycled for read-ahead.
+    freeBuffers_.push_back(std::move(buffer_));
+    scheduleReadAheads();
+    VELOX_CHECK(!readAheads_.empty(), "Reading past end of spill file");
+    auto readAhead = std::move(readAheads_.front());
+    readAheads_.pop_front();
+    std::unique_ptr<ReadAhead> range;
+    {
+      MicrosecondTimer timer(&readWaitTimeUs);
+      range = readAhead->move();
+    }
+    VELOX_CHECK_NOT_NULL(range);
+    buffer_ = std::move(range->buffer);
+    readBytes = range->size;
+    scheduleReadAheads();
+  }
   setRange({buffer_->asMutable<uint8_t>(), readBytes, 0});
-  file_->pread(offset_, readBytes, buffer_->asMutable<char>());
-  offset_ += readBytes;
+  common::updateGlobalSpillReadStats(readBytes, readWaitTimeUs);
+  addThreadLocalRuntimeStat(
+      "spillReadWaitTime",
+      RuntimeCounter(
+          readWaitTimeUs * Timestamp::kNanosecondsInMicrosecond,
+          RuntimeCounter::Unit::kNanos));
+}
+
+void SpillInputStream::scheduleReadAheads() {
+  while (!freeBuffers_.empty() && offset_ < size_) {
+    auto buffer = std::move(freeBuffers_.back());
+    freeBuffers_.pop_back();
+    const uint64_t offset = offset_;
+    const uint64_t readBytes = std::min(size_ - offset, buffer->capacity());
+    offset_ += readBytes;
+    auto readAhead = std::make_shared<AsyncSource<ReadAhead>>(
+        [this, buffer = std::move(buffer), offset, readBytes]() mutable {
+          file_->pread(offset, readBytes, buffer->asMutable<char>());
+          return std::make_unique<ReadAhead>(
+              ReadAhead{std::move(buffer), readBytes});
+        });
+    readAheads_.push_back(readAhead);
+    executor_->add([readAhead]() { readAhead->prepare(); });
+  }
 }
 
 std::unique_ptr<SpillWriteFile> SpillWriteFile::create(
@@ -50,12 +123,15 @@ SpillWriteFile::SpillWriteFile(
     const std::string& fileCreateConfig)
     : id_(id), path_(fmt::format("{}-{}", pathPrefix, ordinalCounter_++)) {
   auto fs = filesystems::getFileSystem(path_, nullptr);
-  file_ = fs->openFileForWrite(
-      path_,
-      filesystems::FileOptions{
-          {{filesystems::FileOptions::kFileCreateConfig.toString(),
-            fileCreateConfig}},
-          nullptr});
+  filesystems::FileOptions options{
+      {{filesystems::FileOptions::kFileCreateConfig.toString(),
+        fileCreateConfig}},
+      nullptr};
+  // Spill files are written in large buffered chunks which go to the kernel
+  // without copying them into a FILE buffer.
+  options.useIoUring = true;
+  file_ = fs->openFileForWrite(path_, options);
+  appendIOBuf_ = dynamic_cast<LocalWriteFile*>(file_.get()) != nullptr;
 }
 
 void SpillWriteFile::finish() {
@@ -73,6 +149,13 @@ uint64_t SpillWriteFile::size() const {
 }
 
 uint64_t SpillWriteFile::write(std::unique_ptr<folly::IOBuf> iobuf) {
+  if (appendIOBuf_) {
+    // A local file writes the whole chain with one vectored write if it goes
+    // through io_uring.
+    const auto writtenBytes = iobuf->computeChainDataLength();
+    file_->append(std::move(iobuf));
+    return writtenBytes;
+  }
   uint64_t writtenBytes{0};
   // TODO: extend velox file system to support write with a chained io buffers.
   for (auto& range : *iobuf) {
@@ -269,7 +352,9 @@ std::vector<uint32_t> SpillWriter::testingSpilledFileIds() const {
 
 std::unique_ptr<SpillReadFile> SpillReadFile::create(
     const SpillFileInfo& fileInfo,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    uint32_t numReadAheadBuffers,
+    folly::Executor* executor) {
   return std::unique_ptr<SpillReadFile>(new SpillReadFile(
       fileInfo.id,
       fileInfo.path,
@@ -278,7 +363,9 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
       fileInfo.numSortKeys,
       fileInfo.sortFlags,
       fileInfo.compressionKind,
-      pool));
+      pool,
+      numReadAheadBuffers,
+      executor));
 }
 
 SpillReadFile::SpillReadFile(
@@ -289,7 +376,9 @@ SpillReadFile::SpillReadFile(
     uint32_t numSortKeys,
     const std::vector<CompareFlags>& sortCompareFlags,
     common::CompressionKind compressionKind,
-    memory::MemoryPool* pool)
+    memory::MemoryPool* pool,
+    uint32_t numReadAheadBuffers,
+    folly::Executor* executor)
     : id_(id),
       path_(path),
       size_(size),
@@ -303,10 +392,23 @@ SpillReadFile::SpillReadFile(
       (1 << 20) - AlignedBuffer::kPaddedSize; // 1MB - padding.
   auto fs = filesystems::getFileSystem(path_, nullptr);
   auto file = fs->openFileForRead(path_);
-  auto buffer = AlignedBuffer::allocate<char>(
-      std::min<uint64_t>(size_, kMaxReadBufferSize), pool_);
-  input_ =
-      std::make_unique<SpillInputStream>(std::move(file), std::move(buffer));
+  const uint64_t bufferSize = std::min<uint64_t>(size_, kMaxReadBufferSize);
+  auto buffer = AlignedBuffer::allocate<char>(bufferSize, pool_);
+  std::vector<BufferPtr> readAheadBuffers;
+  if (executor != nullptr && size_ > bufferSize) {
+    // No more buffers than the ranges following the first one are needed.
+    const auto numBuffers = std::min<uint64_t>(
+        numReadAheadBuffers, bits::divRoundUp(size_, bufferSize) - 1);
+    for (auto i = 0; i < numBuffers; ++i) {
+      readAheadBuffers.push_back(
+          AlignedBuffer::allocate<char>(bufferSize, pool_));
+    }
+  }
+  input_ = std::make_unique<SpillInputStream>(
+      std::move(file),
+      std::move(buffer),
+      std::move(readAheadBuffers),
+      executor);
 }
 
 bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
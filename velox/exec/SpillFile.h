@@ -16,8 +16,11 @@
 
 #pragma once
 
+#include <deque>
+
 #include <folly/container/F14Set.h>
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/SpillStats.h"
 #include "velox/common/compression/Compression.h"
@@ -75,6 +78,8 @@ class SpillWriteFile {
   const std::string path_;
 
   std::unique_ptr<WriteFile> file_;
+  // True if 'file_' supports appending a chain of IOBufs.
+  bool appendIOBuf_{false};
   // Byte size of the backing file. Set when finishing writing.
   uint64_t size_{0};
 };
@@ -203,27 +208,52 @@ class SpillWriter {
 /// remainingSize() APIs do not work properly.
 class SpillInputStream : public ByteInputStream {
  public:
-  /// Reads from 'input' using 'buffer' for buffering reads.
-  SpillInputStream(std::unique_ptr<ReadFile>&& file, BufferPtr buffer)
-      : file_(std::move(file)),
-        size_(file_->size()),
-        buffer_(std::move(buffer)) {
-    next(true);
-  }
+  /// Reads from 'input' using 'buffer' for buffering reads. If 'executor' is
+  /// set, the following ranges of the file are read into 'readAheadBuffers' on
+  /// 'executor' while 'buffer' is consumed. The buffers are recycled between
+  /// the reader and 'executor' so that 'readAheadBuffers.size()' reads are in
+  /// flight at most.
+  SpillInputStream(
+      std::unique_ptr<ReadFile>&& file,
+      BufferPtr buffer,
+      std::vector<BufferPtr> readAheadBuffers = {},
+      folly::Executor* executor = nullptr);
+
+  /// Waits for the in-flight read-ahead before the buffers are freed.
+  ~SpillInputStream() override;
 
   /// True if all of the file has been read into vectors.
   bool atEnd() const override {
-    return offset_ >= size_ && ranges()[0].position >= ranges()[0].size;
+    return offset_ >= size_ && readAheads_.empty() &&
+        ranges()[0].position >= ranges()[0].size;
   }
 
  private:
+  // A range of the file read ahead into 'buffer'.
+  struct ReadAhead {
+    BufferPtr buffer;
+    uint64_t size;
+  };
+
   void next(bool throwIfPastEnd) override;
 
+  // Starts reading the next ranges of the file into the free buffers.
+  void scheduleReadAheads();
+
   const std::unique_ptr<ReadFile> file_;
   const uint64_t size_;
-  const BufferPtr buffer_;
+  folly::Executor* const executor_;
+
+  // The buffer being consumed.
+  BufferPtr buffer_;
 
-  // Offset of first byte not in 'buffer_'
+  // The buffers available for read-ahead.
+  std::vector<BufferPtr> freeBuffers_;
+
+  // The scheduled read-ahead in file offset order.
+  std::deque<std::shared_ptr<AsyncSource<ReadAhead>>> readAheads_;
+
+  // Offset of first byte not in 'buffer_' or 'readAheads_'.
   uint64_t offset_ = 0;
 };
 
@@ -236,9 +266,14 @@ class SpillInputStream : public ByteInputStream {
 /// rmdir() call.
 class SpillReadFile {
  public:
+  /// Creates a reader of the spill file described by 'fileInfo'. If
+  /// 'executor' is set, 'numReadAheadBuffers' buffers are used to read the
+  /// file ahead of its consumption on 'executor'.
   static std::unique_ptr<SpillReadFile> create(
       const SpillFileInfo& fileInfo,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      uint32_t numReadAheadBuffers = 0,
+      folly::Executor* executor = nullptr);
 
   uint32_t id() const {
     return id_;
@@ -272,7 +307,9 @@ class SpillReadFile {
       uint32_t numSortKeys,
       const std::vector<CompareFlags>& sortCompareFlags,
       common::CompressionKind compressionKind,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      uint32_t numReadAheadBuffers,
+      folly::Executor* executor);
 
   // The spill file id which is monotonically increasing and unique for each
   // associated spill partition.
@@ -19,6 +19,7 @@
 #include "velox/common/base/AsyncSource.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Aggregate.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/external/timsort/TimSort.hpp"
 
 using facebook::velox::common::testutil::TestValue;
@@ -30,6 +31,25 @@ namespace {
 
 #define CHECK_FINALIZED() \
   VELOX_CHECK(finalized_, "Spiller hasn't been finalized yet");
+
+// Returns the type of the spilled rows in 'SpillFormat::kRowContainer' which
+// consists of the leading 'numSortingKeys' columns of 'rowType' followed by
+// the serialized rows.
+RowTypePtr serializedRowType(
+    const RowTypePtr& rowType,
+    int32_t numSortingKeys) {
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  names.reserve(numSortingKeys + 1);
+  types.reserve(numSortingKeys + 1);
+  for (auto i = 0; i < numSortingKeys; ++i) {
+    names.push_back(rowType->nameOf(i));
+    types.push_back(rowType->childAt(i));
+  }
+  names.push_back(Spiller::kSerializedRowColumnName);
+  types.push_back(VARBINARY());
+  return ROW(std::move(names), std::move(types));
+}
 } // namespace
 
 Spiller::Spiller(
@@ -38,7 +58,8 @@ Spiller::Spiller(
     RowTypePtr rowType,
     int32_t numSortingKeys,
     const std::vector<CompareFlags>& sortCompareFlags,
-    const common::SpillConfig* spillConfig)
+    const common::SpillConfig* spillConfig,
+    common::SpillFormat format)
     : Spiller(
           type,
           container,
@@ -54,7 +75,9 @@ Spiller::Spiller(
           spillConfig->compressionKind,
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
-          spillConfig->fileCreateConfig) {
+          spillConfig->fileCreateConfig,
+          format,
+          spillConfig->prefixSortConfig) {
   VELOX_CHECK(
       type_ == Type::kOrderByInput || type_ == Type::kAggregateInput,
       "Unexpected spiller type: {}",
@@ -67,7 +90,8 @@ Spiller::Spiller(
     Type type,
     RowContainer* container,
     RowTypePtr rowType,
-    const common::SpillConfig* spillConfig)
+    const common::SpillConfig* spillConfig,
+    common::SpillFormat format)
     : Spiller(
           type,
           container,
@@ -83,7 +107,9 @@ Spiller::Spiller(
           spillConfig->compressionKind,
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
-          spillConfig->fileCreateConfig) {
+          spillConfig->fileCreateConfig,
+          format,
+          std::nullopt) {
   VELOX_CHECK(
       type_ == Type::kAggregateOutput || type_ == Type::kOrderByOutput,
       "Unexpected spiller type: {}",
@@ -113,12 +139,10 @@ Spiller::Spiller(
           spillConfig->compressionKind,
           spillConfig->executor,
           0,
-          spillConfig->fileCreateConfig) {
-  VELOX_CHECK_EQ(
-      type_,
-      Type::kHashJoinProbe,
-      "Unexpected spiller type: {}",
-      typeName(type_));
+          spillConfig->fileCreateConfig,
+          common::SpillFormat::kColumnar,
+          std::nullopt) {
+  VELOX_CHECK(spillsVectors(), "Unexpected spiller type: {}", typeName(type_));
 }
 
 Spiller::Spiller(
@@ -143,7 +167,9 @@ Spiller::Spiller(
           spillConfig->compressionKind,
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
-          spillConfig->fileCreateConfig) {
+          spillConfig->fileCreateConfig,
+          common::SpillFormat::kColumnar,
+          std::nullopt) {
   VELOX_CHECK_EQ(
       type_,
       Type::kHashJoinBuild,
@@ -166,13 +192,20 @@ Spiller::Spiller(
     common::CompressionKind compressionKind,
     folly::Executor* executor,
     uint64_t maxSpillRunRows,
-    const std::string& fileCreateConfig)
+    const std::string& fileCreateConfig,
+    common::SpillFormat format,
+    std::optional<common::PrefixSortConfig> prefixSortConfig)
     : type_(type),
       container_(container),
       executor_(executor),
       bits_(bits),
-      rowType_(std::move(rowType)),
+      format_(format),
+      rowType_(
+          format_ == common::SpillFormat::kRowContainer
+              ? serializedRowType(rowType, numSortingKeys)
+              : std::move(rowType)),
       maxSpillRunRows_(maxSpillRunRows),
+      prefixSortConfig_(std::move(prefixSortConfig)),
       state_(
           getSpillDirPathCb,
           updateAndCheckSpillLimitCb,
@@ -189,7 +222,13 @@ Spiller::Spiller(
   TestValue::adjust(
       "facebook::velox::exec::Spiller", const_cast<HashBitRange*>(&bits_));
 
-  VELOX_CHECK_EQ(container_ == nullptr, type_ == Type::kHashJoinProbe);
+  VELOX_CHECK_EQ(container_ == nullptr, spillsVectors());
+  // The accumulators are not covered by the serialized rows.
+  VELOX_CHECK(
+      format_ == common::SpillFormat::kColumnar ||
+          container_->accumulators().empty(),
+      "Spill format {} doesn't support accumulators",
+      common::spillFormatName(format_));
   spillRuns_.reserve(state_.maxPartitions());
   for (int i = 0; i < state_.maxPartitions(); ++i) {
     spillRuns_.emplace_back(*memory::spillMemoryPool());
@@ -205,6 +244,16 @@ void Spiller::extractSpill(folly::Range<char**> rows, RowVectorPtr& resultPtr) {
     resultPtr->resize(rows.size());
   }
   auto result = resultPtr.get();
+  if (format_ == common::SpillFormat::kRowContainer) {
+    // The leading sort key columns are used to merge the sorted spill runs.
+    const auto numSortingKeys = rowType_->size() - 1;
+    for (auto i = 0; i < numSortingKeys; ++i) {
+      container_->extractColumn(
+          rows.data(), rows.size(), i, result->childAt(i));
+    }
+    container_->extractSerializedRows(rows, result->childAt(numSortingKeys));
+    return;
+  }
   auto& types = container_->columnTypes();
   for (auto i = 0; i < types.size(); ++i) {
     container_->extractColumn(rows.data(), rows.size(), i, result->childAt(i));
@@ -224,7 +273,7 @@ int64_t Spiller::extractSpillVector(
     int64_t maxBytes,
     RowVectorPtr& spillVector,
     size_t& nextBatchIndex) {
-  VELOX_CHECK_NE(type_, Type::kHashJoinProbe);
+  VELOX_CHECK(!spillsVectors());
 
   auto limit = std::min<size_t>(rows.size() - nextBatchIndex, maxRows);
   VELOX_CHECK(!rows.empty());
@@ -336,13 +385,24 @@ void Spiller::ensureSorted(SpillRun& run) {
   uint64_t sortTimeUs{0};
   {
     MicrosecondTimer timer(&sortTimeUs);
-    gfx::timsort(
-        run.rows.begin(),
-        run.rows.end(),
-        [&](const char* left, const char* right) {
-          return container_->compareRows(
-                     left, right, state_.sortCompareFlags()) < 0;
-        });
+    if (prefixSortConfig_.has_value()) {
+      PrefixSort::sort(
+          container_,
+          state_.sortCompareFlags(),
+          prefixSortConfig_.value(),
+          memory::spillMemoryPool(),
+          folly::Range<char**>(run.rows.data(), run.rows.size()));
+      // Releases the memory reserved by the sort on the spill pool.
+      memory::spillMemoryPool()->release();
+    } else {
+      gfx::timsort(
+          run.rows.begin(),
+          run.rows.end(),
+          [&](const char* left, const char* right) {
+            return container_->compareRows(
+                       left, right, state_.sortCompareFlags()) < 0;
+          });
+    }
     run.sorted = true;
   }
 
@@ -352,7 +412,7 @@ void Spiller::ensureSorted(SpillRun& run) {
 }
 
 std::unique_ptr<Spiller::SpillStatus> Spiller::writeSpill(int32_t partition) {
-  VELOX_CHECK_NE(type_, Type::kHashJoinProbe);
+  VELOX_CHECK(!spillsVectors());
   // Target size of a single vector of spilled content. One of
   // these will be materialized at a time for each stream of the
   // merge.
@@ -456,7 +516,7 @@ void Spiller::updateSpillSortTime(uint64_t timeUs) {
 }
 
 bool Spiller::needSort() const {
-  return type_ != Type::kHashJoinProbe && type_ != Type::kHashJoinBuild &&
+  return !spillsVectors() && type_ != Type::kHashJoinBuild &&
       type_ != Type::kAggregateOutput && type_ != Type::kOrderByOutput;
 }
 
@@ -471,7 +531,7 @@ void Spiller::spill(const RowContainerIterator& startRowIter) {
 
 void Spiller::spill(const RowContainerIterator* startRowIter) {
   CHECK_NOT_FINALIZED();
-  VELOX_CHECK_NE(type_, Type::kHashJoinProbe);
+  VELOX_CHECK(!spillsVectors());
   VELOX_CHECK_NE(type_, Type::kOrderByOutput);
 
   markAllPartitionsSpilled();
@@ -519,7 +579,7 @@ void Spiller::markAllPartitionsSpilled() {
 void Spiller::spill(uint32_t partition, const RowVectorPtr& spillVector) {
   CHECK_NOT_FINALIZED();
   VELOX_CHECK(
-      type_ == Type::kHashJoinProbe || type_ == Type::kHashJoinBuild,
+      spillsVectors() || type_ == Type::kHashJoinBuild,
       "Unexpected spiller type: {}",
       typeName(type_));
   if (FOLLY_UNLIKELY(!state_.isPartitionSpilled(partition))) {
@@ -660,6 +720,10 @@ std::string Spiller::typeName(Type type) {
       return "AGGREGATE_INPUT";
     case Type::kAggregateOutput:
       return "AGGREGATE_OUTPUT";
+    case Type::kNestedLoopJoinBuild:
+      return "NESTED_LOOP_JOIN_BUILD";
+    case Type::kMergeJoin:
+      return "MERGE_JOIN";
     default:
       VELOX_UNREACHABLE("Unknown type: {}", static_cast<int>(type));
   }
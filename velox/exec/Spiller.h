@@ -39,8 +39,12 @@ class Spiller {
     kOrderByInput = 4,
     // Used for order by output processing stage.
     kOrderByOutput = 5,
+    // Used for nested loop join build.
+    kNestedLoopJoinBuild = 6,
+    // Used for the right side matches of merge join.
+    kMergeJoin = 7,
     // Number of spiller types.
-    kNumTypes = 6,
+    kNumTypes = 8,
   };
 
   static std::string typeName(Type);
@@ -51,22 +55,29 @@ class Spiller {
   /// partition by default.
 
   /// type == Type::kOrderByInput || type == Type::kAggregateInput
+  ///
+  /// 'format' specifies the format of the spilled rows. The caller must
+  /// restore the rows spilled in 'common::SpillFormat::kRowContainer' into a
+  /// RowContainer with the same layout as 'container'.
   Spiller(
       Type type,
       RowContainer* container,
       RowTypePtr rowType,
       int32_t numSortingKeys,
       const std::vector<CompareFlags>& sortCompareFlags,
-      const common::SpillConfig* spillConfig);
+      const common::SpillConfig* spillConfig,
+      common::SpillFormat format = common::SpillFormat::kColumnar);
 
   /// type == Type::kAggregateOutput || type == Type::kOrderByOutput
   Spiller(
       Type type,
       RowContainer* container,
       RowTypePtr rowType,
-      const common::SpillConfig* spillConfig);
+      const common::SpillConfig* spillConfig,
+      common::SpillFormat format = common::SpillFormat::kColumnar);
 
-  /// type == Type::kHashJoinProbe
+  /// type == Type::kHashJoinProbe || type == Type::kNestedLoopJoinBuild ||
+  /// type == Type::kMergeJoin
   Spiller(
       Type type,
       RowTypePtr rowType,
@@ -87,6 +98,18 @@ class Spiller {
     return type_;
   }
 
+  /// The name of the column holding the serialized rows in
+  /// 'SpillFormat::kRowContainer'.
+  static inline const std::string kSerializedRowColumnName = "__row";
+
+  /// Returns the format of the spilled rows. In 'SpillFormat::kRowContainer',
+  /// the spilled rows are the sort key columns followed by the rows serialized
+  /// by RowContainer::extractSerializedRows(). They are restored with
+  /// RowContainer::storeSerializedRow().
+  common::SpillFormat format() const {
+    return format_;
+  }
+
   /// Spills all the rows from 'this' to disk. The spilled rows stays in the
   /// row container. The caller needs to erase the spilled rows from the row
   /// container.
@@ -159,11 +182,8 @@ class Spiller {
 
   /// Invokes to set a set of 'partitions' as spilling.
   void setPartitionsSpilled(const SpillPartitionNumSet& partitions) {
-    VELOX_CHECK_EQ(
-        type_,
-        Spiller::Type::kHashJoinProbe,
-        "Unexpected spiller type: ",
-        typeName(type_));
+    VELOX_CHECK(
+        spillsVectors(), "Unexpected spiller type: {}", typeName(type_));
     for (const auto& partition : partitions) {
       state_.setPartitionSpilled(partition);
     }
@@ -194,7 +214,9 @@ class Spiller {
       common::CompressionKind compressionKind,
       folly::Executor* executor,
       uint64_t maxSpillRunRows,
-      const std::string& fileCreateConfig);
+      const std::string& fileCreateConfig,
+      common::SpillFormat format,
+      std::optional<common::PrefixSortConfig> prefixSortConfig);
 
   // Invoked to spill. If 'startRowIter' is not null, then we only spill rows
   // from row container starting at the offset pointed by 'startRowIter'.
@@ -292,6 +314,13 @@ class Spiller {
   // non hash join types of spilling.
   bool needSort() const;
 
+  // True if 'this' spills the vectors passed to spill(partition, vector)
+  // instead of the rows of a RowContainer.
+  bool spillsVectors() const {
+    return type_ == Type::kHashJoinProbe ||
+        type_ == Type::kNestedLoopJoinBuild || type_ == Type::kMergeJoin;
+  }
+
   void updateSpillFillTime(uint64_t timeUs);
 
   void updateSpillSortTime(uint64_t timeUs);
@@ -302,8 +331,14 @@ class Spiller {
   RowContainer* const container_{nullptr};
   folly::Executor* const executor_;
   const HashBitRange bits_;
+  const common::SpillFormat format_;
+  // The type of the spilled rows. In 'SpillFormat::kRowContainer', it
+  // consists of the sort key columns and 'kSerializedRowColumnName'.
   const RowTypePtr rowType_;
   const uint64_t maxSpillRunRows_;
+  // If set, the spill runs are sorted with prefix sort, otherwise with
+  // timsort.
+  const std::optional<common::PrefixSortConfig> prefixSortConfig_;
 
   // True if all rows of spilling partitions are in 'spillRuns_', so
   // that one can start reading these back. This means that the rows
@@ -91,6 +91,10 @@ class TableScan : public SourceOperator {
 
   const int32_t maxSplitPreloadPerDriver_{0};
 
+  // True if the task may park this driver at split boundaries to adjust the
+  // number of drivers reading splits.
+  const bool dynamicDrivers_;
+
   // Callback passed to getSplitOrFuture() for triggering async
   // preload. The callback's lifetime is the lifetime of 'this'. This
   // callback can schedule preloads on an executor. These preloads may
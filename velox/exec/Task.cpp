@@ -23,6 +23,7 @@
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/time/Timer.h"
+#include "velox/exec/DriverScaling.h"
 #include "velox/exec/Exchange.h"
 #include "velox/exec/HashBuild.h"
 #include "velox/exec/LocalPlanner.h"
@@ -692,9 +693,53 @@ void Task::createDriverFactoriesLocked(uint32_t maxDrivers) {
         factory->inputDriver, factory->outputDriver);
   }
 
+  if (queryCtx_->queryConfig().dynamicDriversEnabled()) {
+    initDynamicPipelinesLocked();
+  }
+
   validateGroupedExecutionLeafNodes();
 }
 
+void Task::initDynamicPipelinesLocked() {
+  const auto maxActive = queryCtx_->queryConfig().dynamicDriversMaxActive();
+  uint32_t numTargetDrivers = 0;
+  for (uint32_t pipelineId = 0; pipelineId < driverFactories_.size();
+       ++pipelineId) {
+    const auto& factory = driverFactories_[pipelineId];
+    if (factory->groupedExecution || factory->numDrivers <= 1) {
+      continue;
+    }
+    auto scanNode = std::dynamic_pointer_cast<const core::TableScanNode>(
+        factory->planNodes.front());
+    if (scanNode == nullptr) {
+      continue;
+    }
+    // Start with half of the planned drivers and let the observed CPU use
+    // decide the rest. Every pipeline keeps at least one active driver.
+    uint32_t targetDrivers = std::max<uint32_t>(1, factory->numDrivers / 2);
+    if (maxActive > 0) {
+      targetDrivers = std::max<uint32_t>(
+          1,
+          std::min<uint32_t>(
+              targetDrivers,
+              maxActive > numTargetDrivers ? maxActive - numTargetDrivers
+                                           : 0));
+    }
+    numTargetDrivers += targetDrivers;
+    auto& pipeline = dynamicPipelines_[pipelineId];
+    pipeline.planNodeId = scanNode->id();
+    pipeline.targetDrivers = targetDrivers;
+  }
+}
+
+uint32_t Task::numTargetDynamicDriversLocked() const {
+  uint32_t numTargetDrivers = 0;
+  for (const auto& [_, pipeline] : dynamicPipelines_) {
+    numTargetDrivers += pipeline.targetDrivers;
+  }
+  return numTargetDrivers;
+}
+
 void Task::createAndStartDrivers(uint32_t concurrentSplitGroups) {
   std::unique_lock<std::mutex> l(mutex_);
   VELOX_CHECK(
@@ -1303,6 +1348,16 @@ void Task::noMoreSplits(const core::PlanNodeId& planNodeId) {
     if (!isRunningLocked()) {
       exchangeClient = getExchangeClientLocked(planNodeId);
     }
+
+    // Parked drivers resume to drain the remaining splits and finish.
+    for (auto& [_, pipeline] : dynamicPipelines_) {
+      if (pipeline.planNodeId == planNodeId) {
+        for (auto& promise : pipeline.parkedPromises) {
+          splitPromises.push_back(std::move(promise));
+        }
+        pipeline.parkedPromises.clear();
+      }
+    }
   }
 
   for (auto& promise : splitPromises) {
@@ -1363,6 +1418,127 @@ BlockingReason Task::getSplitOrFuture(
       preload);
 }
 
+BlockingReason Task::maybeParkDriver(
+    const DriverCtx& driverCtx,
+    Operator* op,
+    ContinueFuture& future) {
+  std::vector<ContinuePromise> unparked;
+  auto blockingReason = BlockingReason::kNotBlocked;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = dynamicPipelines_.find(driverCtx.pipelineId);
+    if (it == dynamicPipelines_.end() || !isRunningLocked() ||
+        getPlanNodeSplitsStateLocked(it->second.planNodeId).noMoreSplits) {
+      return BlockingReason::kNotBlocked;
+    }
+    auto& pipeline = it->second;
+    reviewDriverScalingLocked(it->first, pipeline, op, unparked);
+
+    uint32_t numAliveDrivers = 0;
+    for (const auto& driver : drivers_) {
+      if (driver != nullptr &&
+          driver->driverCtx()->pipelineId == driverCtx.pipelineId) {
+        ++numAliveDrivers;
+      }
+    }
+    const auto numActiveDrivers =
+        numAliveDrivers - pipeline.parkedPromises.size();
+    if (numActiveDrivers > pipeline.targetDrivers) {
+      auto [promise, parkedFuture] = makeVeloxContinuePromiseContract(
+          fmt::format("Task::maybeParkDriver {}", taskId_));
+      future = std::move(parkedFuture);
+      pipeline.parkedPromises.push_back(std::move(promise));
+      blockingReason = BlockingReason::kWaitForSplit;
+    }
+  }
+
+  for (auto& promise : unparked) {
+    promise.setValue();
+  }
+  return blockingReason;
+}
+
+void Task::reviewDriverScalingLocked(
+    uint32_t pipelineId,
+    DynamicPipeline& pipeline,
+    Operator* op,
+    std::vector<ContinuePromise>& unparked) {
+  const auto nowMicros = getCurrentTimeMicro();
+  if (pipeline.lastReviewMicros == 0) {
+    pipeline.lastReviewMicros = nowMicros;
+    return;
+  }
+  const uint64_t wallNanos = (nowMicros - pipeline.lastReviewMicros) * 1'000;
+  if (wallNanos < kDriverScalingIntervalNanos) {
+    return;
+  }
+
+  // Cumulative CPU and consumer blocking time of the finished and the running
+  // drivers of the pipeline.
+  uint64_t cpuNanos{0};
+  uint64_t consumerBlockedNanos{0};
+  const auto addStats = [&](const OperatorStats& stats) {
+    cpuNanos += stats.addInputTiming.cpuNanos +
+        stats.getOutputTiming.cpuNanos + stats.finishTiming.cpuNanos;
+    auto it = stats.runtimeStats.find("blockedWaitForConsumerWallNanos");
+    if (it != stats.runtimeStats.end()) {
+      consumerBlockedNanos += it->second.sum;
+    }
+  };
+  for (const auto& stats : taskStats_.pipelineStats[pipelineId].operatorStats) {
+    addStats(stats);
+  }
+  uint32_t numAliveDrivers = 0;
+  for (const auto& driver : drivers_) {
+    if (driver == nullptr || driver->driverCtx()->pipelineId != pipelineId) {
+      continue;
+    }
+    ++numAliveDrivers;
+    for (auto* driverOp : driver->operators()) {
+      addStats(*driverOp->stats().rlock());
+    }
+  }
+
+  const auto maxActive = queryCtx_->queryConfig().dynamicDriversMaxActive();
+  DriverScalingInput input;
+  input.numActiveDrivers = numAliveDrivers - pipeline.parkedPromises.size();
+  input.maxDrivers = numAliveDrivers;
+  input.atTaskLimit =
+      maxActive > 0 && numTargetDynamicDriversLocked() >= maxActive;
+  input.wallNanos = wallNanos;
+  input.cpuNanos = cpuNanos - std::min(cpuNanos, pipeline.lastCpuNanos);
+  input.consumerBlockedNanos = consumerBlockedNanos -
+      std::min(consumerBlockedNanos, pipeline.lastConsumerBlockedNanos);
+  pipeline.lastReviewMicros = nowMicros;
+  pipeline.lastCpuNanos = cpuNanos;
+  pipeline.lastConsumerBlockedNanos = consumerBlockedNanos;
+
+  const auto scaling = decideDriverScaling(input);
+  switch (scaling) {
+    case DriverScaling::kKeep:
+      return;
+    case DriverScaling::kScaleUp:
+      pipeline.targetDrivers = input.numActiveDrivers + 1;
+      if (!pipeline.parkedPromises.empty()) {
+        unparked.push_back(std::move(pipeline.parkedPromises.back()));
+        pipeline.parkedPromises.pop_back();
+      }
+      op->addRuntimeStat("driverScaleUps", RuntimeCounter(1));
+      break;
+    case DriverScaling::kScaleDown:
+      pipeline.targetDrivers = input.numActiveDrivers - 1;
+      op->addRuntimeStat("driverScaleDowns", RuntimeCounter(1));
+      break;
+  }
+  op->addRuntimeStat("activeDrivers", RuntimeCounter(pipeline.targetDrivers));
+  VLOG(1) << "Task " << taskId_ << " pipeline " << pipelineId << " "
+          << driverScalingName(scaling) << " to " << pipeline.targetDrivers
+          << " of " << numAliveDrivers << " drivers, cpu "
+          << succinctNanos(input.cpuNanos) << ", wall "
+          << succinctNanos(input.wallNanos) << ", consumer blocked "
+          << succinctNanos(input.consumerBlockedNanos);
+}
+
 BlockingReason Task::getSplitOrFutureLocked(
     SplitsStore& splitsStore,
     exec::Split& split,
@@ -1829,6 +2005,11 @@ ContinueFuture Task::terminate(TaskState terminalState) {
       splitGroupStates.push_back(std::move(splitGroupState.second));
     }
 
+    // Resume the parked drivers so that they see the task is terminated.
+    for (auto& [_, pipeline] : dynamicPipelines_) {
+      movePromisesOut(pipeline.parkedPromises, splitPromises);
+    }
+
     // Collect all outstanding split promises from all splits state structures.
     for (auto& pair : splitsStates_) {
       auto& splitState = pair.second;
@@ -344,6 +344,17 @@ class Task : public std::enable_shared_from_this<Task> {
       std::function<void(std::shared_ptr<connector::ConnectorSplit>)> preload =
           nullptr);
 
+  /// Called by a table scan before it asks for a new split when
+  /// 'dynamic_drivers_enabled' is set. Reviews the number of active drivers
+  /// of the scan's pipeline and returns kWaitForSplit with 'future' set if the
+  /// calling driver is to stay parked until the pipeline scales up again or
+  /// receives no-more-splits. Returns kNotBlocked otherwise. Scaling decisions
+  /// are recorded as runtime stats of 'op'.
+  BlockingReason maybeParkDriver(
+      const DriverCtx& driverCtx,
+      Operator* op,
+      ContinueFuture& future);
+
   void splitFinished();
 
   void multipleSplitsFinished(int32_t numSplits);
@@ -771,6 +782,37 @@ class Task : public std::enable_shared_from_this<Task> {
       int32_t maxPreloadSplits,
       std::function<void(std::shared_ptr<connector::ConnectorSplit>)> preload);
 
+  // Driver scaling state of a pipeline that runs with
+  // 'dynamic_drivers_enabled'. All planned drivers of the pipeline are
+  // created; the ones above 'targetDrivers' park at their next split boundary.
+  struct DynamicPipeline {
+    // Id of the table scan node the pipeline starts with.
+    core::PlanNodeId planNodeId;
+    // Number of drivers allowed to take splits.
+    uint32_t targetDrivers{0};
+    // Promises of the parked drivers.
+    std::vector<ContinuePromise> parkedPromises;
+    // Cumulative stats of the pipeline at the last review.
+    uint64_t lastReviewMicros{0};
+    uint64_t lastCpuNanos{0};
+    uint64_t lastConsumerBlockedNanos{0};
+  };
+
+  // Sets up driver scaling for the eligible pipelines after
+  // 'driverFactories_' are created.
+  void initDynamicPipelinesLocked();
+
+  // Reviews the driver count of 'pipeline' and updates 'targetDrivers'. Moves
+  // the promises of the drivers to resume into 'unparked'.
+  void reviewDriverScalingLocked(
+      uint32_t pipelineId,
+      DynamicPipeline& pipeline,
+      Operator* op,
+      std::vector<ContinuePromise>& unparked);
+
+  // Returns the sum of 'targetDrivers' across 'dynamicPipelines_'.
+  uint32_t numTargetDynamicDriversLocked() const;
+
   // Creates for the given split group and fills up the 'SplitGroupState'
   // structure, which stores inter-operator state (local exchange, bridges).
   void createSplitGroupStateLocked(uint32_t splitGroupId);
@@ -1021,6 +1063,10 @@ class Task : public std::enable_shared_from_this<Task> {
 
   TaskStats taskStats_;
 
+  // Driver scaling state keyed by pipeline id. Empty unless
+  // 'dynamic_drivers_enabled' is set.
+  std::unordered_map<uint32_t, DynamicPipeline> dynamicPipelines_;
+
   /// Stores inter-operator state (exchange, bridges) per split group.
   /// During ungrouped execution we use the [0] entry in this vector.
   std::unordered_map<uint32_t, SplitGroupState> splitGroupStates_;
@@ -15,11 +15,128 @@
  */
 #include <folly/container/F14Map.h>
 
+#include "velox/common/base/SimdUtil.h"
 #include "velox/exec/ContainerRowSerde.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/exec/TopN.h"
+#include "velox/type/Filter.h"
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::exec {
+
+namespace {
+
+std::vector<column_index_t> reorderInputChannels(
+    const RowTypePtr& inputType,
+    const std::vector<core::FieldAccessTypedExprPtr>& sortingKeys) {
+  const auto size = inputType->size();
+
+  std::vector<column_index_t> channels;
+  channels.reserve(size);
+
+  std::vector<bool> isSortingKey(size);
+  for (const auto& key : sortingKeys) {
+    channels.push_back(exprToChannel(key.get(), inputType));
+    isSortingKey[channels.back()] = true;
+  }
+
+  for (auto i = 0; i < size; ++i) {
+    if (!isSortingKey[i]) {
+      channels.push_back(i);
+    }
+  }
+
+  return channels;
+}
+
+RowTypePtr reorderInputType(
+    const RowTypePtr& inputType,
+    const std::vector<column_index_t>& channels) {
+  const auto size = inputType->size();
+
+  VELOX_CHECK_EQ(size, channels.size());
+
+  std::vector<std::string> names;
+  names.reserve(size);
+
+  std::vector<TypePtr> types;
+  types.reserve(size);
+
+  for (auto channel : channels) {
+    names.push_back(inputType->nameOf(channel));
+    types.push_back(inputType->childAt(channel));
+  }
+
+  return ROW(std::move(names), std::move(types));
+}
+
+std::vector<CompareFlags> makeSpillCompareFlags(
+    const std::vector<core::SortOrder>& sortingOrders) {
+  std::vector<CompareFlags> compareFlags;
+  compareFlags.reserve(sortingOrders.size());
+
+  for (const auto& order : sortingOrders) {
+    compareFlags.push_back(
+        {order.isNullsFirst(), order.isAscending(), false /*equalsOnly*/});
+  }
+
+  return compareFlags;
+}
+
+// Returns a [start, end) slice of the 'types' vector.
+std::vector<TypePtr>
+slice(const std::vector<TypePtr>& types, int32_t start, int32_t end) {
+  std::vector<TypePtr> result;
+  result.reserve(end - start);
+  for (auto i = start; i < end; ++i) {
+    result.push_back(types[i]);
+  }
+  return result;
+}
+
+// Sets 'rows' to the rows of 'decoded' passing 'filter'. Returns the number of
+// passing rows. Tests a SIMD batch of values at a time if 'decoded' is flat and
+// has no nulls.
+template <typename T>
+vector_size_t filterRows(
+    const DecodedVector& decoded,
+    const common::Filter& filter,
+    vector_size_t numRows,
+    vector_size_t* rows) {
+  vector_size_t numPassed = 0;
+  if (decoded.isIdentityMapping() && !decoded.mayHaveNulls()) {
+    constexpr vector_size_t kBatchSize = xsimd::batch<T>::size;
+    const auto* values = decoded.data<T>();
+    vector_size_t row = 0;
+    for (; row + kBatchSize <= numRows; row += kBatchSize) {
+      uint64_t passed = simd::toBitMask(
+          filter.testValues(xsimd::batch<T>::load_unaligned(values + row)));
+      while (passed) {
+        rows[numPassed++] = row + __builtin_ctzll(passed);
+        passed &= passed - 1;
+      }
+    }
+    for (; row < numRows; ++row) {
+      if (filter.testInt64(values[row])) {
+        rows[numPassed++] = row;
+      }
+    }
+    return numPassed;
+  }
+
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    if (decoded.isNullAt(row)) {
+      if (filter.testNull()) {
+        rows[numPassed++] = row;
+      }
+    } else if (filter.testInt64(decoded.valueAt<T>(row))) {
+      rows[numPassed++] = row;
+    }
+  }
+  return numPassed;
+}
+} // namespace
+
 TopN::TopN(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -29,44 +146,51 @@ TopN::TopN(
           topNNode->outputType(),
           operatorId,
           topNNode->id(),
-          "TopN"),
+          "TopN",
+          topNNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
       count_(topNNode->count()),
-      data_(std::make_unique<RowContainer>(outputType_->children(), pool())),
+      numSortingKeys_(topNNode->sortingKeys().size()),
+      inputChannels_(
+          reorderInputChannels(outputType_, topNNode->sortingKeys())),
+      inputType_(reorderInputType(outputType_, inputChannels_)),
+      spillCompareFlags_(makeSpillCompareFlags(topNNode->sortingOrders())),
+      dynamicFilterEnabled_(
+          driverCtx->queryConfig().topNDynamicFilterEnabled()),
+      data_(std::make_unique<RowContainer>(
+          slice(inputType_->children(), 0, numSortingKeys_),
+          slice(inputType_->children(), numSortingKeys_, inputType_->size()),
+          pool())),
       comparator_(
-          outputType_,
+          inputType_,
           topNNode->sortingKeys(),
           topNNode->sortingOrders(),
           data_.get()),
       topRows_(comparator_),
-      decodedVectors_(outputType_->children().size()) {
-  const auto numColumns{outputType_->children().size()};
-  const auto numSortingKeys{topNNode->sortingKeys().size()};
-  sortingKeyColumns_.reserve(numSortingKeys);
-  std::vector<bool> isSortingKey(numColumns);
-  for (const auto& key : topNNode->sortingKeys()) {
-    sortingKeyColumns_.emplace_back(exprToChannel(key.get(), outputType_));
-    isSortingKey[sortingKeyColumns_.back()] = true;
-  }
-  if (numColumns > numSortingKeys) {
-    nonKeyColumns_.reserve(numColumns - numSortingKeys);
-    for (column_index_t i = 0; i < numColumns; ++i) {
-      if (!isSortingKey[i]) {
-        nonKeyColumns_.emplace_back(i);
-      }
-    }
-  }
-}
+      decodedVectors_(inputType_->size()) {}
 
 void TopN::addInput(RowVectorPtr input) {
-  for (const auto col : sortingKeyColumns_) {
-    decodedVectors_[col].decode(*input->childAt(col));
+  ensureInputFits(input);
+
+  for (auto i = 0; i < numSortingKeys_; ++i) {
+    decodedVectors_[i].decode(*input->childAt(inputChannels_[i]));
   }
 
-  const bool hasNonKeyColumn{!nonKeyColumns_.empty()};
+  const auto numInput = input->size();
+  const bool filtered = filterByThreshold(numInput);
+  const auto numCandidates = filtered ? candidateRows_.size() : numInput;
+  if (filtered) {
+    addRuntimeStat(
+        "thresholdFilteredRows", RuntimeCounter(numInput - numCandidates));
+  }
+
+  const bool hasNonKeyColumn{inputType_->size() > numSortingKeys_};
   // Maps passed rows of 'data_' to the corresponding input row number. These
   // input rows of non-key columns are later stored into data_.
   folly::F14FastMap<void*, vector_size_t> passedRows;
-  for (auto row = 0; row < input->size(); ++row) {
+  for (auto i = 0; i < numCandidates; ++i) {
+    const vector_size_t row = filtered ? candidateRows_[i] : i;
     char* newRow = nullptr;
     if (topRows_.size() < count_) {
       newRow = data_->newRow();
@@ -82,7 +206,7 @@ void TopN::addInput(RowVectorPtr input) {
     }
 
     data_->initializeFields(newRow);
-    for (const auto col : sortingKeyColumns_) {
+    for (auto col = 0; col < numSortingKeys_; ++col) {
       data_->store(decodedVectors_[col], row, newRow, col);
     }
 
@@ -93,8 +217,8 @@ void TopN::addInput(RowVectorPtr input) {
   }
 
   if (hasNonKeyColumn && !passedRows.empty()) {
-    for (const auto col : nonKeyColumns_) {
-      decodedVectors_[col].decode(*input->childAt(col));
+    for (auto col = numSortingKeys_; col < inputType_->size(); ++col) {
+      decodedVectors_[col].decode(*input->childAt(inputChannels_[col]));
       for (const auto [dataRow, inputRow] : passedRows) {
         data_->store(
             decodedVectors_[col],
@@ -104,6 +228,109 @@ void TopN::addInput(RowVectorPtr input) {
       }
     }
   }
+
+  updateThreshold();
+}
+
+bool TopN::supportsThreshold() const {
+  switch (inputType_->childAt(0)->kind()) {
+    case TypeKind::BIGINT:
+    case TypeKind::INTEGER:
+    case TypeKind::SMALLINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool TopN::filterByThreshold(vector_size_t numInput) {
+  if (thresholdFilter_ == nullptr) {
+    return false;
+  }
+
+  candidateRows_.resize(numInput);
+  const auto& decoded = decodedVectors_[0];
+  vector_size_t numPassed;
+  switch (inputType_->childAt(0)->kind()) {
+    case TypeKind::BIGINT:
+      numPassed = filterRows<int64_t>(
+          decoded, *thresholdFilter_, numInput, candidateRows_.data());
+      break;
+    case TypeKind::INTEGER:
+      numPassed = filterRows<int32_t>(
+          decoded, *thresholdFilter_, numInput, candidateRows_.data());
+      break;
+    case TypeKind::SMALLINT:
+      numPassed = filterRows<int16_t>(
+          decoded, *thresholdFilter_, numInput, candidateRows_.data());
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+  candidateRows_.resize(numPassed);
+  return true;
+}
+
+void TopN::updateThreshold() {
+  if (topRows_.size() < count_ || !supportsThreshold()) {
+    return;
+  }
+
+  const char* topRow = topRows_.top();
+  const auto column = data_->columnAt(0);
+  if (RowContainer::isNullAt(topRow, column)) {
+    return;
+  }
+
+  int64_t value;
+  switch (inputType_->childAt(0)->kind()) {
+    case TypeKind::BIGINT:
+      value = RowContainer::valueAt<int64_t>(topRow, column.offset());
+      break;
+    case TypeKind::INTEGER:
+      value = RowContainer::valueAt<int32_t>(topRow, column.offset());
+      break;
+    case TypeKind::SMALLINT:
+      value = RowContainer::valueAt<int16_t>(topRow, column.offset());
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+
+  if (threshold_ == value) {
+    return;
+  }
+  threshold_ = value;
+
+  // The rows with the same first key as the top row are still compared on the
+  // rest of the keys. Nulls pass only if they sort before the non-null values.
+  const auto& flags = spillCompareFlags_[0];
+  if (flags.ascending) {
+    thresholdFilter_ = std::make_shared<common::BigintRange>(
+        std::numeric_limits<int64_t>::min(), value, flags.nullsFirst);
+  } else {
+    thresholdFilter_ = std::make_shared<common::BigintRange>(
+        value, std::numeric_limits<int64_t>::max(), flags.nullsFirst);
+  }
+
+  if (canPushdownThreshold()) {
+    dynamicFilters_[inputChannels_[0]] = thresholdFilter_;
+  }
+}
+
+bool TopN::canPushdownThreshold() {
+  if (!canPushdownThreshold_.has_value()) {
+    // NOTE: the filter is not pushed down if nulls sort first. The upstream
+    // operators, e.g. an outer join, may produce null keys which must not be
+    // dropped at the table scan.
+    const auto channel = inputChannels_[0];
+    canPushdownThreshold_ = dynamicFilterEnabled_ &&
+        !spillCompareFlags_[0].nullsFirst &&
+        operatorCtx_->driverCtx()
+                ->driver->canPushdownFilters(this, {channel})
+                .count(channel) > 0;
+  }
+  return canPushdownThreshold_.value();
 }
 
 RowVectorPtr TopN::getOutput() {
@@ -111,6 +338,10 @@ RowVectorPtr TopN::getOutput() {
     return nullptr;
   }
 
+  if (merge_ != nullptr) {
+    return getOutputFromSpill();
+  }
+
   const auto numRowsToReturn = std::min<vector_size_t>(
       outputBatchSize_, rows_.size() - numRowsReturned_);
   VELOX_CHECK_GT(numRowsToReturn, 0);
@@ -118,20 +349,77 @@ RowVectorPtr TopN::getOutput() {
   auto result = BaseVector::create<RowVector>(
       outputType_, numRowsToReturn, operatorCtx_->pool());
 
-  for (auto i = 0; i < outputType_->size(); ++i) {
+  for (auto i = 0; i < inputChannels_.size(); ++i) {
     data_->extractColumn(
         rows_.data() + numRowsReturned_,
         numRowsToReturn,
         i,
-        result->childAt(i));
+        result->childAt(inputChannels_[i]));
   }
   numRowsReturned_ += numRowsToReturn;
   finished_ = (numRowsReturned_ == rows_.size());
   return result;
 }
 
+RowVectorPtr TopN::getOutputFromSpill() {
+  VELOX_CHECK_NOT_NULL(merge_);
+  VELOX_CHECK_GT(outputBatchSize_, 0);
+
+  // merge_->next() produces the spilled rows sorted by the sorting keys. Each
+  // spill run holds at most 'count_' rows, so the first 'count_' merged rows
+  // are the result.
+  const auto numRowsToReturn = std::min<vector_size_t>(
+      outputBatchSize_, count_ - static_cast<int64_t>(numRowsReturned_));
+  auto output =
+      BaseVector::create<RowVector>(outputType_, numRowsToReturn, pool());
+
+  vector_size_t index = 0;
+  while (index < numRowsToReturn) {
+    auto next = merge_->next();
+    if (next == nullptr) {
+      break;
+    }
+
+    for (auto i = 0; i < inputChannels_.size(); ++i) {
+      output->childAt(inputChannels_[i])
+          ->copy(
+              next->current().childAt(i).get(),
+              index,
+              next->currentIndex(),
+              1);
+    }
+    ++index;
+    next->pop();
+  }
+
+  numRowsReturned_ += index;
+  finished_ = (index < numRowsToReturn) || (numRowsReturned_ == count_);
+  if (index == 0) {
+    return nullptr;
+  }
+  if (index < numRowsToReturn) {
+    output->resize(index);
+  }
+  return output;
+}
+
 void TopN::noMoreInput() {
   Operator::noMoreInput();
+
+  if (spiller_ != nullptr) {
+    // Spill remaining data to avoid running out of memory while sort-merging
+    // spilled data.
+    spill();
+
+    VELOX_CHECK_NULL(merge_);
+    auto spillPartition = spiller_->finishSpill();
+    merge_ = spillPartition.createOrderedReader(pool(), &spillConfig_.value());
+    recordSpillStats(spiller_->stats());
+
+    outputBatchSize_ = outputBatchRows(estimatedOutputRowSize_);
+    return;
+  }
+
   if (topRows_.empty()) {
     finished_ = true;
     return;
@@ -148,4 +436,133 @@ void TopN::noMoreInput() {
 bool TopN::isFinished() {
   return finished_;
 }
+
+void TopN::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& stats) {
+  VELOX_CHECK(canReclaim());
+  VELOX_CHECK(!nonReclaimableSection_);
+
+  if (data_->numRows() == 0) {
+    // Nothing to spill.
+    return;
+  }
+
+  // After noMoreInput(), the rows are either already spilled or are at most
+  // 'count_' rows that are being returned as output. These are not spilled
+  // again, so reclaim is a no-op.
+  if (noMoreInput_) {
+    ++stats.numNonReclaimableAttempts;
+    LOG(WARNING)
+        << "Can't reclaim from topN operator which has started producing output: "
+        << pool()->name()
+        << ", usage: " << succinctBytes(pool()->currentBytes())
+        << ", reservation: " << succinctBytes(pool()->reservedBytes());
+    return;
+  }
+
+  spill();
+}
+
+void TopN::ensureInputFits(const RowVectorPtr& input) {
+  if (!spillEnabled()) {
+    // Spilling is disabled.
+    return;
+  }
+
+  if (data_->numRows() == 0) {
+    // Nothing to spill.
+    return;
+  }
+
+  // Test-only spill path.
+  if (spillConfig_->testSpillPct > 0) {
+    spill();
+    return;
+  }
+
+  auto [freeRows, outOfLineFreeBytes] = data_->freeSpace();
+  const auto outOfLineBytes =
+      data_->stringAllocator().retainedSize() - outOfLineFreeBytes;
+  const auto outOfLineBytesPerRow = outOfLineBytes / data_->numRows();
+
+  // Once 'count_' rows are accumulated, the new rows reuse the memory of the
+  // rows they replace.
+  const auto numNewRows = std::min<int64_t>(
+      input->size(), count_ - static_cast<int64_t>(topRows_.size()));
+
+  const auto currentUsage = pool()->currentBytes();
+  const auto minReservationBytes =
+      currentUsage * spillConfig_->minSpillableReservationPct / 100;
+  const auto availableReservationBytes = pool()->availableReservation();
+  const auto incrementBytes = data_->sizeIncrement(
+      numNewRows, outOfLineBytesPerRow * input->size());
+
+  // First to check if we have sufficient minimal memory reservation.
+  if (availableReservationBytes >= minReservationBytes) {
+    if ((freeRows >= numNewRows) &&
+        (outOfLineBytes == 0 ||
+         outOfLineFreeBytes >= outOfLineBytesPerRow * input->size())) {
+      // Enough free rows for input rows and enough variable length free space.
+      return;
+    }
+  }
+
+  // Check if we can increase reservation. The increment is the largest of twice
+  // the maximum increment from this input and 'spillableReservationGrowthPct_'
+  // of the current memory usage.
+  const auto targetIncrementBytes = std::max<int64_t>(
+      incrementBytes * 2,
+      currentUsage * spillConfig_->spillableReservationGrowthPct / 100);
+  {
+    ReclaimableSectionGuard guard(this);
+    if (pool()->maybeReserve(targetIncrementBytes)) {
+      return;
+    }
+  }
+
+  LOG(WARNING) << "Failed to reserve " << succinctBytes(targetIncrementBytes)
+               << " for memory pool " << pool()->name()
+               << ", usage: " << succinctBytes(pool()->currentBytes())
+               << ", reservation: " << succinctBytes(pool()->reservedBytes());
+}
+
+void TopN::updateEstimatedOutputRowSize() {
+  const auto optionalRowSize = data_->estimateRowSize();
+  if (!optionalRowSize.has_value()) {
+    return;
+  }
+
+  const auto rowSize = optionalRowSize.value();
+  if (!estimatedOutputRowSize_.has_value() ||
+      rowSize > estimatedOutputRowSize_.value()) {
+    estimatedOutputRowSize_ = rowSize;
+  }
+}
+
+void TopN::spill() {
+  if (spiller_ == nullptr) {
+    setupSpiller();
+  }
+
+  updateEstimatedOutputRowSize();
+
+  spiller_->spill();
+  topRows_ = decltype(topRows_)(comparator_);
+  data_->clear();
+  pool()->release();
+}
+
+void TopN::setupSpiller() {
+  VELOX_CHECK_NULL(spiller_);
+  VELOX_CHECK(spillConfig_.has_value());
+
+  spiller_ = std::make_unique<Spiller>(
+      Spiller::Type::kOrderByInput,
+      data_.get(),
+      inputType_,
+      spillCompareFlags_.size(),
+      spillCompareFlags_,
+      &spillConfig_.value());
+}
 } // namespace facebook::velox::exec
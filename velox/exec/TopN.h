@@ -17,6 +17,8 @@
 
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
+#include "velox/exec/Spiller.h"
+#include "velox/exec/TreeOfLosers.h"
 
 namespace facebook::velox::exec {
 
@@ -43,15 +45,62 @@ class TopN : public Operator {
 
   bool isFinished() override;
 
+  // Spills the buffered rows. This is a no-op after noMoreInput().
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
  private:
+  // Sets 'candidateRows_' to the rows of the input whose first sorting key
+  // passes 'thresholdFilter_'. Returns false if all the input rows are
+  // candidates.
+  bool filterByThreshold(vector_size_t numInput);
+
+  // Updates 'thresholdFilter_' from the first sorting key of the top row once
+  // 'topRows_' holds 'count_' rows. Adds the filter to 'dynamicFilters_' for
+  // pushdown if it changed.
+  void updateThreshold();
+
+  // Returns true if the first sorting key is compared through
+  // 'thresholdFilter_'.
+  bool supportsThreshold() const;
+
+  // Returns true if 'thresholdFilter_' can be pushed down to the upstream
+  // operators as a dynamic filter.
+  bool canPushdownThreshold();
+
+  bool spillEnabled() const {
+    return spillConfig_.has_value();
+  }
+
+  void ensureInputFits(const RowVectorPtr& input);
+
+  // Sorts, spills and clears all of 'data_' and 'topRows_'.
+  void spill();
+
+  void setupSpiller();
+
+  void updateEstimatedOutputRowSize();
+
+  RowVectorPtr getOutputFromSpill();
+
   const int32_t count_;
 
+  const column_index_t numSortingKeys_;
+
+  // Input columns in the order of: sorting keys, the rest.
+  const std::vector<column_index_t> inputChannels_;
+
+  // Input column types in 'inputChannels_' order.
+  const RowTypePtr inputType_;
+
+  // Used to sort 'data_' while spilling.
+  const std::vector<CompareFlags> spillCompareFlags_;
+
+  const bool dynamicFilterEnabled_;
+
   bool finished_ = false;
   uint32_t numRowsReturned_ = 0;
 
-  std::vector<column_index_t> sortingKeyColumns_;
-  std::vector<column_index_t> nonKeyColumns_;
-
   // As the inputs are added to TopN operator, we use topRows_ (a priority
   // queue) to keep track of the pointers to rows stored in the
   // RowContainer (data_). We only update the RowContainer if a row is a
@@ -68,5 +117,32 @@ class TopN : public Operator {
 
   std::vector<DecodedVector> decodedVectors_;
   vector_size_t outputBatchSize_;
+
+  // Filter on the first sorting key which passes the values that are not
+  // worse than the first key of the current top row. The input rows which
+  // don't pass are discarded without comparing them to the top row. Set once
+  // 'topRows_' is full if the first sorting key is an integer, and kept after
+  // spilling as the rows worse than a spilled top row can't make the output.
+  std::shared_ptr<common::Filter> thresholdFilter_;
+
+  // The first sorting key of the top row 'thresholdFilter_' is made from.
+  std::optional<int64_t> threshold_;
+
+  // Unset until the first check whether 'thresholdFilter_' can be pushed
+  // down.
+  std::optional<bool> canPushdownThreshold_;
+
+  // The input rows which pass 'thresholdFilter_'.
+  std::vector<vector_size_t> candidateRows_;
+
+  // If spilling, this value is set to max 'data_->estimateRowSize()' across
+  // all accumulated data set.
+  std::optional<int64_t> estimatedOutputRowSize_;
+
+  // Spiller for contents of the 'data_'.
+  std::unique_ptr<Spiller> spiller_;
+
+  // Used to sort-merge spilled data.
+  std::unique_ptr<TreeOfLosers<SpillMergeStream>> merge_;
 };
 } // namespace facebook::velox::exec
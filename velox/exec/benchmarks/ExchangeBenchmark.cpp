@@ -64,17 +64,19 @@ struct Counters {
   int64_t exchangeNanos{0};
   int64_t exchangeRows{0};
   int64_t exchangeBatches{0};
+  int64_t producerBlockedNanos{0};
 
   std::string toString() {
     if (exchangeBatches == 0) {
       return "N/A";
     }
     return fmt::format(
-        "{}/s repartition={} exchange={} exchange batch={}",
+        "{}/s repartition={} exchange={} exchange batch={} producer blocked={}",
         succinctBytes(bytes / (usec / 1.0e6)),
         succinctNanos(repartitionNanos),
         succinctNanos(exchangeNanos),
-        exchangeRows / exchangeBatches);
+        exchangeRows / exchangeBatches,
+        succinctNanos(producerBlockedNanos));
   }
 };
 
@@ -105,14 +107,23 @@ class ExchangeBenchmark : public VectorTestBase {
     return vectors;
   }
 
+  /// Runs a shuffle of 'vectors' from 'width' tasks to 'width' consumer
+  /// tasks. If 'slowConsumer' is true, the first consumer runs a single
+  /// driver and computes checksums of all columns, so that its partition
+  /// backs up in the producers' output buffers. 'flowControl' enables per
+  /// destination flow control in the producers' output buffers.
   void run(
       std::vector<RowVectorPtr>& vectors,
       int32_t width,
       int32_t taskWidth,
-      Counters& counters) {
+      Counters& counters,
+      bool slowConsumer = false,
+      bool flowControl = false) {
     assert(!vectors.empty());
     configSettings_[core::QueryConfig::kMaxPartitionedOutputBufferSize] =
         fmt::format("{}", FLAGS_exchange_buffer_mb << 20);
+    configSettings_[core::QueryConfig::kPartitionedOutputFlowControlEnabled] =
+        flowControl ? "true" : "false";
     auto iteration = ++iteration_;
     std::vector<std::shared_ptr<Task>> tasks;
     std::vector<std::string> leafTaskIds;
@@ -138,14 +149,30 @@ class ExchangeBenchmark : public VectorTestBase {
                        .partitionedOutput({}, 1)
                        .planNode();
 
+    core::PlanNodePtr slowAggPlan;
+    if (slowConsumer) {
+      std::vector<std::string> aggregates = {"count(1)"};
+      const auto& rowType = leafPlan->outputType();
+      for (auto i = 0; i < rowType->size(); ++i) {
+        aggregates.push_back(fmt::format("checksum({})", rowType->nameOf(i)));
+      }
+      slowAggPlan = exec::test::PlanBuilder()
+                        .exchange(rowType)
+                        .singleAggregation({}, aggregates)
+                        .project({"a0"})
+                        .partitionedOutput({}, 1)
+                        .planNode();
+    }
+
     std::vector<exec::Split> finalAggSplits;
     for (int i = 0; i < width; i++) {
       auto taskId = makeTaskId(iteration, "final-agg", i);
       finalAggSplits.push_back(
           exec::Split(std::make_shared<exec::RemoteConnectorSplit>(taskId)));
-      auto task = makeTask(taskId, finalAggPlan, i);
+      const bool slow = slowConsumer && i == 0;
+      auto task = makeTask(taskId, slow ? slowAggPlan : finalAggPlan, i);
       tasks.push_back(task);
-      task->start(taskWidth);
+      task->start(slow ? 1 : taskWidth);
       addRemoteSplits(task, leafTaskIds);
     }
 
@@ -168,6 +195,7 @@ class ExchangeBenchmark : public VectorTestBase {
     int64_t exchangeNanos = 0;
     int64_t exchangeBatches = 0;
     int64_t exchangeRows = 0;
+    int64_t producerBlockedNanos = 0;
     for (auto& task : tasks) {
       auto stats = task->taskStats();
       for (auto& pipeline : stats.pipelineStats) {
@@ -175,6 +203,7 @@ class ExchangeBenchmark : public VectorTestBase {
           if (op.operatorType == "PartitionedOutput") {
             repartitionNanos +=
                 op.addInputTiming.cpuNanos + op.getOutputTiming.cpuNanos;
+            producerBlockedNanos += op.blockedWallNanos;
           } else if (op.operatorType == "Exchange") {
             bytes += op.rawInputBytes;
             exchangeRows += op.outputPositions;
@@ -193,12 +222,16 @@ class ExchangeBenchmark : public VectorTestBase {
     counters.exchangeNanos += exchangeNanos;
     counters.exchangeRows += exchangeRows;
     counters.exchangeBatches += exchangeBatches;
+    counters.producerBlockedNanos += producerBlockedNanos;
   }
 
+  /// Runs 'numTasks' concurrent local exchange queries. Repartitions on 'c0'
+  /// if 'roundRobin' is false.
   void runLocal(
       std::vector<RowVectorPtr>& vectors,
       int32_t taskWidth,
       int32_t numTasks,
+      bool roundRobin,
       Counters& counters) {
     assert(!vectors.empty());
     std::vector<std::shared_ptr<Task>> tasks;
@@ -210,10 +243,13 @@ class ExchangeBenchmark : public VectorTestBase {
       aggregates.push_back(fmt::format("checksum({})", rowType.nameOf(i)));
     }
     core::PlanNodeId exchangeId;
-    auto plan = exec::test::PlanBuilder()
-                    .values(vectors, true)
-                    .localPartition({"c0"})
-                    .capturePlanNodeId(exchangeId)
+    auto builder = exec::test::PlanBuilder().values(vectors, true);
+    if (roundRobin) {
+      builder.localPartitionRoundRobin();
+    } else {
+      builder.localPartition({"c0"});
+    }
+    auto plan = builder.capturePlanNodeId(exchangeId)
                     .singleAggregation({}, aggregates)
                     .localPartition(std::vector<std::string>{})
                     .singleAggregation({}, {"sum(a0)"})
@@ -354,7 +390,11 @@ Counters deep10kCounters;
 Counters flat50Counters;
 Counters deep50Counters;
 Counters localFlat10kCounters;
+Counters localRoundRobinFlat10kCounters;
+Counters localDeep10kCounters;
 Counters struct1kCounters;
+Counters slowConsumerCounters;
+Counters slowConsumerFlowControlCounters;
 
 BENCHMARK(exchangeFlat10k) {
   bm.run(flat10k, FLAGS_width, FLAGS_task_width, flat10kCounters);
@@ -376,9 +416,37 @@ BENCHMARK(exchangeStruct1K) {
   bm.run(struct1k, FLAGS_width, FLAGS_task_width, struct1kCounters);
 }
 
+BENCHMARK(exchangeSlowConsumerFlat10k) {
+  bm.run(flat10k, FLAGS_width, FLAGS_task_width, slowConsumerCounters, true);
+}
+
+BENCHMARK_RELATIVE(exchangeSlowConsumerFlowControlFlat10k) {
+  bm.run(
+      flat10k,
+      FLAGS_width,
+      FLAGS_task_width,
+      slowConsumerFlowControlCounters,
+      true,
+      true);
+}
+
 BENCHMARK(localFlat10k) {
   bm.runLocal(
-      flat10k, FLAGS_width, FLAGS_num_local_tasks, localFlat10kCounters);
+      flat10k, FLAGS_width, FLAGS_num_local_tasks, false, localFlat10kCounters);
+}
+
+BENCHMARK_RELATIVE(localRoundRobinFlat10k) {
+  bm.runLocal(
+      flat10k,
+      FLAGS_width,
+      FLAGS_num_local_tasks,
+      true,
+      localRoundRobinFlat10kCounters);
+}
+
+BENCHMARK(localDeep10k) {
+  bm.runLocal(
+      deep10k, FLAGS_width, FLAGS_num_local_tasks, false, localDeep10kCounters);
 }
 
 } // namespace
@@ -455,7 +523,10 @@ int main(int argc, char** argv) {
             << "flat50: " << flat50Counters.toString() << std::endl
             << "deep10k: " << deep10kCounters.toString() << std::endl
             << "deep50: " << deep50Counters.toString() << std::endl
-            << "struct1k: " << struct1kCounters.toString() << std::endl;
+            << "struct1k: " << struct1kCounters.toString() << std::endl
+            << "slow consumer: " << slowConsumerCounters.toString() << std::endl
+            << "slow consumer with flow control: "
+            << slowConsumerFlowControlCounters.toString() << std::endl;
   return 0;
   return 0;
 }
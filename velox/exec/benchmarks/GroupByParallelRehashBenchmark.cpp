@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/HashTable.h"
+#include "velox/exec/VectorHasher.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+#include <folly/Benchmark.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+#include <memory>
+
+DEFINE_int64(num_groups, 8'000'000, "Number of distinct grouping keys");
+DEFINE_int32(batch_size, 10'000, "Number of input rows per batch");
+DEFINE_int32(
+    min_partition_size,
+    10'000,
+    "Minimum number of table entries per partition for parallel rehash");
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::test;
+
+namespace {
+// Measures the time to fill a group-by hash table in kHash mode with
+// 'FLAGS_num_groups' distinct keys. The table is rehashed every time it
+// doubles in size. The rehash is split into as many partitions as there are
+// threads in the build executor. 1 thread corresponds to the serial build.
+class GroupByParallelRehashBenchmark : public VectorTestBase {
+ public:
+  GroupByParallelRehashBenchmark() {
+    // Random 64 bit keys don't fit in array or normalized key mode.
+    folly::Random::DefaultGenerator rng;
+    rng.seed(1);
+    for (auto i = 0; i < FLAGS_num_groups; i += FLAGS_batch_size) {
+      const auto size =
+          std::min<int64_t>(FLAGS_batch_size, FLAGS_num_groups - i);
+      batches_.push_back(makeRowVector({makeFlatVector<int64_t>(
+          size, [&](auto /*row*/) { return folly::Random::rand64(rng); })}));
+    }
+  }
+
+  void run(int32_t numThreads) {
+    std::unique_ptr<folly::CPUThreadPoolExecutor> executor;
+    std::unique_ptr<HashTable<false>> table;
+    std::unique_ptr<HashLookup> lookup;
+    {
+      folly::BenchmarkSuspender suspender;
+      executor = std::make_unique<folly::CPUThreadPoolExecutor>(numThreads);
+      std::vector<std::unique_ptr<VectorHasher>> hashers;
+      hashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 0));
+      table = HashTable<false>::createForAggregation(
+          std::move(hashers), std::vector<Accumulator>{}, pool());
+      if (numThreads > 1) {
+        table->setParallelGroupByRehash(
+            executor.get(), numThreads, FLAGS_min_partition_size);
+      }
+      lookup = std::make_unique<HashLookup>(table->hashers());
+    }
+
+    for (const auto& batch : batches_) {
+      insertGroups(*batch, *lookup, *table);
+    }
+
+    folly::BenchmarkSuspender suspender;
+    VELOX_CHECK_EQ(table->hashMode(), BaseHashTable::HashMode::kHash);
+    table.reset();
+    executor->join();
+  }
+
+ private:
+  void insertGroups(
+      const RowVector& input,
+      HashLookup& lookup,
+      HashTable<false>& table) {
+    const SelectivityVector rows(input.size());
+    lookup.reset(rows.end());
+    lookup.rows.resize(rows.end());
+    std::iota(lookup.rows.begin(), lookup.rows.end(), 0);
+
+    auto& hashers = table.hashers();
+    const auto mode = table.hashMode();
+    bool rehash = false;
+    for (int32_t i = 0; i < hashers.size(); ++i) {
+      auto key = input.childAt(hashers[i]->channel());
+      hashers[i]->decode(*key, rows);
+      if (mode != BaseHashTable::HashMode::kHash) {
+        if (!hashers[i]->computeValueIds(rows, lookup.hashes)) {
+          rehash = true;
+        }
+      } else {
+        hashers[i]->hash(rows, i > 0, lookup.hashes);
+      }
+    }
+
+    if (rehash) {
+      if (table.hashMode() != BaseHashTable::HashMode::kHash) {
+        table.decideHashMode(input.size());
+      }
+      insertGroups(input, lookup, table);
+      return;
+    }
+    table.groupProbe(lookup);
+  }
+
+  std::vector<RowVectorPtr> batches_;
+};
+
+std::unique_ptr<GroupByParallelRehashBenchmark> benchmark;
+} // namespace
+
+BENCHMARK(serial) {
+  benchmark->run(1);
+}
+
+BENCHMARK_RELATIVE(threads2) {
+  benchmark->run(2);
+}
+
+BENCHMARK_RELATIVE(threads4) {
+  benchmark->run(4);
+}
+
+BENCHMARK_RELATIVE(threads8) {
+  benchmark->run(8);
+}
+
+BENCHMARK_RELATIVE(threads16) {
+  benchmark->run(16);
+}
+
+BENCHMARK_RELATIVE(threads32) {
+  benchmark->run(32);
+}
+
+BENCHMARK_RELATIVE(threads64) {
+  benchmark->run(64);
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  memory::MemoryManager::initialize({});
+  benchmark = std::make_unique<GroupByParallelRehashBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
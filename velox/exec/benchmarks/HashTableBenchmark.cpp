@@ -26,19 +26,107 @@
 #include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
 #include <gtest/gtest.h>
+#include <chrono>
 #include <memory>
 
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 DEFINE_int64(custom_size, 0, "Custom number of entries");
 DEFINE_int32(custom_hit_rate, 0, "Percentage of hits in custom test");
 DEFINE_int32(custom_key_spacing, 1, "Spacing between key values");
 
 DEFINE_int32(custom_num_ways, 10, "Number of build threads");
 
+DEFINE_bool(prefetch_probe, true, "Use the staged prefetching hash probe");
+DEFINE_int64(
+    prefetch_probe_min_bytes,
+    0,
+    "Minimum table size in bytes for the staged prefetching hash probe");
+
+DEFINE_bool(
+    numa_aware_allocator,
+    false,
+    "Use the NUMA aware MmapAllocator. Tables are then backed by memory of the "
+    "node of the thread that allocates them");
+DEFINE_int32(
+    probe_numa_node,
+    -1,
+    "If not negative, probes from the CPUs of this NUMA node");
+
+// The AVX-512 tag probe can be compared with the SSE tag probe by running with
+// --avx512=true.
+//
+// Local and remote probes can be compared by running the process on the CPUs
+// of one node, e.g. with numactl --cpunodebind=0, so that the tables are built
+// there, and probing with --probe_numa_node=0 and then --probe_numa_node=1.
+
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
 using namespace facebook::velox::test;
 
 namespace {
+// Counts the cache misses of the calling thread with perf_event_open(). The
+// count is -1 if the counter is not available, e.g. if the kernel does not
+// allow access to performance counters.
+class CacheMissCounter {
+ public:
+  CacheMissCounter() {
+#ifdef __linux__
+    perf_event_attr attr{};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_ = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+  }
+
+  ~CacheMissCounter() {
+#ifdef __linux__
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+#endif
+  }
+
+  void start() {
+#ifdef __linux__
+    if (fd_ >= 0) {
+      ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  void stop() {
+#ifdef __linux__
+    if (fd_ >= 0) {
+      ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+    }
+#endif
+  }
+
+  int64_t count() const {
+#ifdef __linux__
+    int64_t value;
+    if (fd_ >= 0 && ::read(fd_, &value, sizeof(value)) == sizeof(value)) {
+      return value;
+    }
+#endif
+    return -1;
+  }
+
+ private:
+  int fd_{-1};
+};
+
 struct HashTableBenchmarkParams {
   HashTableBenchmarkParams() = default;
 
@@ -111,10 +199,23 @@ struct HashTableBenchmarkRun {
   // Clocks for same operation with F14FastSet if applicable.
   float f14ProbeClocks{-1};
 
+  // Size of the bucket array of the table in bytes.
+  uint64_t tableBytes{0};
+
+  // Probed rows per second of wall time spent in joinProbe().
+  double probesPerSecond{0};
+
+  // Cache misses per probed row in joinProbe(). -1 if not available.
+  double cacheMissesPerProbe{-1};
+
   std::string toString() const {
     std::stringstream out;
     out << params.toString();
     out << " hash/row=" << hashClocks << " probe clocks=" << probeClocks;
+    out << " table bytes=" << tableBytes << " probes/s=" << probesPerSecond;
+    if (cacheMissesPerProbe != -1) {
+      out << " cache misses/probe=" << cacheMissesPerProbe;
+    }
     if (f14ProbeClocks != -1) {
       out << " f14Probe=" << f14ProbeClocks << " ("
           << (100 * f14ProbeClocks / probeClocks) << "%)";
@@ -190,6 +291,8 @@ class HashTableBenchmark : public VectorTestBase {
       startOffset += params_.size;
     }
     topTable_->prepareJoinTable(std::move(otherTables), executor_.get());
+    topTable_->setPrefetchProbe(
+        FLAGS_prefetch_probe, FLAGS_prefetch_probe_min_bytes);
     LOG(INFO) << "Made table " << topTable_->toString();
 
     if (topTable_->hashMode() == BaseHashTable::HashMode::kNormalizedKey) {
@@ -217,11 +320,18 @@ class HashTableBenchmark : public VectorTestBase {
   HashTableBenchmarkRun run() {
     HashTableBenchmarkRun result;
     result.params = params_;
-    testProbe();
+    if (FLAGS_probe_numa_node >= 0) {
+      probeOnNumaNode(FLAGS_probe_numa_node);
+    } else {
+      testProbe();
+    }
     result.hashClocks = hashClocksPerRow_;
     result.probeClocks = clocksPerRow_;
+    result.probesPerSecond = probesPerSecond_;
+    result.cacheMissesPerProbe = cacheMissesPerProbe_;
     result.hashMode = topTable_->hashMode();
     result.numDistinct = topTable_->numDistinct();
+    result.tableBytes = topTable_->capacity() * sizeof(char*);
     if (topTable_->hashMode() == BaseHashTable::HashMode::kNormalizedKey) {
       testF14Probe();
       result.f14ProbeClocks = clocksPerRow_;
@@ -229,6 +339,23 @@ class HashTableBenchmark : public VectorTestBase {
     return result;
   }
 
+  // Runs testProbe() with the calling thread on the CPUs of 'node' and then
+  // restores the affinity of the thread.
+  void probeOnNumaNode(int32_t node) {
+#ifdef __linux__
+    cpu_set_t previous;
+    VELOX_CHECK_EQ(0, ::sched_getaffinity(0, sizeof(previous), &previous));
+    VELOX_CHECK(
+        memory::NumaTopology::system()->bindCurrentThread(node),
+        "Cannot run on NUMA node {}",
+        node);
+    testProbe();
+    VELOX_CHECK_EQ(0, ::sched_setaffinity(0, sizeof(previous), &previous));
+#else
+    testProbe();
+#endif
+  }
+
   void insertGroups(
       const RowVector& input,
       HashLookup& lookup,
@@ -417,6 +544,8 @@ class HashTableBenchmark : public VectorTestBase {
     int32_t numHashed = 0;
     int32_t numProbed = 0;
     int32_t numHit = 0;
+    std::chrono::nanoseconds probeWallTime{0};
+    CacheMissCounter cacheMisses;
     auto& hashers = topTable_->hashers();
     VectorHasher::ScratchMemory scratchMemory;
     for (auto batchIndex = 0; batchIndex < batches_.size(); ++batchIndex) {
@@ -459,7 +588,11 @@ class HashTableBenchmark : public VectorTestBase {
         {
           numProbed += lookup->rows.size();
           SelectivityTimer timer(probeTime, 0);
+          const auto start = std::chrono::steady_clock::now();
+          cacheMisses.start();
           topTable_->joinProbe(*lookup);
+          cacheMisses.stop();
+          probeWallTime += std::chrono::steady_clock::now() - start;
         }
         for (auto i = 0; i < lookup->rows.size(); ++i) {
           auto key = lookup->rows[i];
@@ -471,6 +604,12 @@ class HashTableBenchmark : public VectorTestBase {
     hashClocksPerRow_ = hashTime.timeToDropValue() / numHashed;
 
     clocksPerRow_ = probeTime.timeToDropValue() / numProbed;
+    probesPerSecond_ = probeWallTime.count() == 0
+        ? 0
+        : numProbed * 1'000'000'000.0 / probeWallTime.count();
+    const auto numCacheMisses = cacheMisses.count();
+    cacheMissesPerProbe_ =
+        numCacheMisses < 0 ? -1 : numCacheMisses / (1.0 * numProbed);
 
     std::cout
         << fmt::format(
@@ -579,6 +718,10 @@ class HashTableBenchmark : public VectorTestBase {
   float hashClocksPerRow_{0};
   float clocksPerRow_{0};
 
+  // Set by testProbe().
+  double probesPerSecond_{0};
+  double cacheMissesPerProbe_{-1};
+
   // hasher and comparer for F14 comparison test.
   struct F14TestHasher {
     // Same as mixNormalizedKey() in HashTable.cpp.
@@ -616,8 +759,10 @@ int main(int argc, char** argv) {
   memory::MemoryManagerOptions options;
   options.useMmapAllocator = true;
   options.allocatorCapacity = 10UL << 30;
-  options.useMmapArena = true;
+  // The arenas for large allocations are not NUMA aware.
+  options.useMmapArena = !FLAGS_numa_aware_allocator;
   options.mmapArenaCapacityRatio = 1;
+  options.numaAwareMmapAllocator = FLAGS_numa_aware_allocator;
   memory::MemoryManager::initialize(options);
 
   auto bm = std::make_unique<HashTableBenchmark>();
@@ -15,30 +15,137 @@
  */
 #pragma once
 
+#include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <functional>
+#include <limits>
 #include <memory>
+#include <optional>
 
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
+#include "velox/type/StringView.h"
+#include "velox/type/Timestamp.h"
 
 namespace facebook::velox::exec::prefixsort {
 
-/// Provides encode/decode methods for PrefixSort.
+/// Provides encode/decode methods for PrefixSort. The encoded keys compare
+/// with memcmp in the same order as the values compare with the sort order
+/// of the encoder.
+///
+/// A nullable key is encoded as one null byte followed by the encoded value.
+/// The null byte is 0 for a null sorted first, 1 for a non-null value and 2
+/// for a null sorted last. The value bytes of a null are all zero. The value
+/// bytes are inverted for a descending sort order.
 class PrefixSortEncoder {
  public:
-  /// 1. Only int64_t is supported now.
-  /// 2. Encoding is compatible with sorting ascending with no nulls.
+  PrefixSortEncoder(bool ascending, bool nullsFirst)
+      : ascending_(ascending), nullsFirst_(nullsFirst) {}
+
+  /// Encodes a nullable key of type int32_t (also used by DATE), int64_t,
+  /// float, double or Timestamp into 'encodedSize<T>()' bytes at 'dest'. The
+  /// encoding is exact: two keys compare equal iff the values do.
+  template <typename T>
+  FOLLY_ALWAYS_INLINE void encode(std::optional<T> value, char* dest) const {
+    if (!value.has_value()) {
+      encodeNull(dest, encodedSize<T>());
+      return;
+    }
+    dest[0] = kNotNull;
+    encodeNoNulls(value.value(), dest + 1);
+    if (!ascending_) {
+      invert(dest + 1, encodedSize<T>() - 1);
+    }
+  }
+
+  /// Encodes the first 'size' - 1 bytes of a nullable string key into 'size'
+  /// bytes at 'dest'. Shorter strings are padded with zeros. The encoding is
+  /// not exact: strings which share the encoded prefix and strings which
+  /// differ only by trailing zeros compare equal. The caller must compare
+  /// such keys by their full values.
+  FOLLY_ALWAYS_INLINE void
+  encode(std::optional<StringView> value, char* dest, uint32_t size) const {
+    if (!value.has_value()) {
+      encodeNull(dest, size);
+      return;
+    }
+    dest[0] = kNotNull;
+    const uint32_t valueSize = std::min<uint32_t>(value->size(), size - 1);
+    simd::memcpy(dest + 1, value->data(), valueSize);
+    std::memset(dest + 1 + valueSize, 0, size - 1 - valueSize);
+    if (!ascending_) {
+      invert(dest + 1, size - 1);
+    }
+  }
+
+  /// Returns the number of bytes to encode a nullable key of type 'T'.
   template <typename T>
-  static FOLLY_ALWAYS_INLINE void encode(T value, char* row);
+  static constexpr uint32_t encodedSize() {
+    if constexpr (std::is_same_v<T, Timestamp>) {
+      return 1 + sizeof(int64_t) + sizeof(uint64_t);
+    } else {
+      return 1 + sizeof(T);
+    }
+  }
+
+  /// Encodes a non-null 'value' sorted ascending into sizeof(T) bytes at
+  /// 'dest' (16 bytes for Timestamp).
+  template <typename T>
+  static FOLLY_ALWAYS_INLINE void encodeNoNulls(T value, char* dest);
+
+  /// Decodes in place a value of type int32_t or int64_t encoded by
+  /// encodeNoNulls().
   template <typename T>
-  static FOLLY_ALWAYS_INLINE void decode(char* row);
+  static FOLLY_ALWAYS_INLINE void decodeNoNulls(char* dest);
+
+  bool isAscending() const {
+    return ascending_;
+  }
+
+  bool isNullsFirst() const {
+    return nullsFirst_;
+  }
 
  private:
+  static constexpr char kNullFirst = 0;
+  static constexpr char kNotNull = 1;
+  static constexpr char kNullLast = 2;
+
   FOLLY_ALWAYS_INLINE static uint8_t flipSignBit(uint8_t byte) {
     return byte ^ 128;
   }
+
+  FOLLY_ALWAYS_INLINE static void invert(char* data, uint32_t size) {
+    for (uint32_t i = 0; i < size; ++i) {
+      data[i] = ~data[i];
+    }
+  }
+
+  FOLLY_ALWAYS_INLINE void encodeNull(char* dest, uint32_t size) const {
+    dest[0] = nullsFirst_ ? kNullFirst : kNullLast;
+    std::memset(dest + 1, 0, size - 1);
+  }
+
+  // Maps the bits of an IEEE floating point value to an unsigned integer
+  // which sorts in the same order. -0.0 is mapped to 0.0 and all NaNs to one
+  // value above infinity as RowContainer compares them.
+  template <typename T, typename U>
+  FOLLY_ALWAYS_INLINE static U floatingPointBits(T value) {
+    static constexpr U kSignBit = U(1) << (sizeof(U) * 8 - 1);
+    if (std::isnan(value)) {
+      value = std::numeric_limits<T>::quiet_NaN();
+    } else if (value == 0) {
+      value = 0;
+    }
+    U bits;
+    std::memcpy(&bits, &value, sizeof(U));
+    return (bits & kSignBit) ? ~bits : bits | kSignBit;
+  }
+
+  const bool ascending_;
+  const bool nullsFirst_;
 };
 
 /// Assuming that value is little-endian encoded, we encode it as follows to
@@ -47,17 +154,66 @@ class PrefixSortEncoder {
 /// 2 Flip the sign bit.
 /// The decode logic is exactly the opposite of the above approach.
 template <>
-FOLLY_ALWAYS_INLINE void PrefixSortEncoder::encode(int64_t value, char* row) {
+FOLLY_ALWAYS_INLINE void PrefixSortEncoder::encodeNoNulls(
+    int64_t value,
+    char* dest) {
   const auto v = __builtin_bswap64(static_cast<uint64_t>(value));
-  simd::memcpy(row, &v, sizeof(int64_t));
-  row[0] = flipSignBit(row[0]);
+  simd::memcpy(dest, &v, sizeof(int64_t));
+  dest[0] = flipSignBit(dest[0]);
+}
+
+template <>
+FOLLY_ALWAYS_INLINE void PrefixSortEncoder::decodeNoNulls<int64_t>(
+    char* dest) {
+  dest[0] = flipSignBit(dest[0]);
+  const auto v = __builtin_bswap64(*reinterpret_cast<uint64_t*>(dest));
+  simd::memcpy(dest, &v, sizeof(int64_t));
+}
+
+template <>
+FOLLY_ALWAYS_INLINE void PrefixSortEncoder::encodeNoNulls(
+    int32_t value,
+    char* dest) {
+  const auto v = __builtin_bswap32(static_cast<uint32_t>(value));
+  simd::memcpy(dest, &v, sizeof(int32_t));
+  dest[0] = flipSignBit(dest[0]);
+}
+
+template <>
+FOLLY_ALWAYS_INLINE void PrefixSortEncoder::decodeNoNulls<int32_t>(
+    char* dest) {
+  dest[0] = flipSignBit(dest[0]);
+  const auto v = __builtin_bswap32(*reinterpret_cast<uint32_t*>(dest));
+  simd::memcpy(dest, &v, sizeof(int32_t));
+}
+
+/// Flips all the bits of a negative value and only the sign bit of a
+/// positive one, then stores the result big-endian.
+template <>
+FOLLY_ALWAYS_INLINE void PrefixSortEncoder::encodeNoNulls(
+    double value,
+    char* dest) {
+  const auto v =
+      __builtin_bswap64(floatingPointBits<double, uint64_t>(value));
+  simd::memcpy(dest, &v, sizeof(double));
+}
+
+template <>
+FOLLY_ALWAYS_INLINE void PrefixSortEncoder::encodeNoNulls(
+    float value,
+    char* dest) {
+  const auto v = __builtin_bswap32(floatingPointBits<float, uint32_t>(value));
+  simd::memcpy(dest, &v, sizeof(float));
 }
 
+/// Encodes the seconds followed by the nanos, which is the order Timestamp
+/// compares in.
 template <>
-FOLLY_ALWAYS_INLINE void PrefixSortEncoder::decode<int64_t>(char* row) {
-  row[0] = flipSignBit(row[0]);
-  const auto v = __builtin_bswap64(*reinterpret_cast<uint64_t*>(row));
-  simd::memcpy(row, &v, sizeof(int64_t));
+FOLLY_ALWAYS_INLINE void PrefixSortEncoder::encodeNoNulls(
+    Timestamp value,
+    char* dest) {
+  encodeNoNulls<int64_t>(value.getSeconds(), dest);
+  encodeNoNulls<int64_t>(value.getNanos(), dest + sizeof(int64_t));
 }
 
 /// For testing only.
@@ -65,14 +221,15 @@ namespace {
 template <typename T>
 FOLLY_ALWAYS_INLINE void testingEncodeInPlace(const std::vector<T>& data) {
   for (auto i = 0; i < data.size(); i++) {
-    PrefixSortEncoder::encode(data[i], (char*)data.data() + i * sizeof(T));
+    PrefixSortEncoder::encodeNoNulls(
+        data[i], (char*)data.data() + i * sizeof(T));
   }
 }
 
 template <typename T>
 FOLLY_ALWAYS_INLINE void testingDecodeInPlace(const std::vector<T>& data) {
   for (auto i = 0; i < data.size(); i++) {
-    PrefixSortEncoder::decode<T>((char*)data.data() + i * sizeof(T));
+    PrefixSortEncoder::decodeNoNulls<T>((char*)data.data() + i * sizeof(T));
   }
 }
 } // namespace
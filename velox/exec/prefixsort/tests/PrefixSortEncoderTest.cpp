@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Random.h>
+#include <gtest/gtest.h>
+#include <array>
+
+#include "velox/exec/prefixsort/PrefixSortEncoder.h"
+#include "velox/vector/SimpleVector.h"
+
+namespace facebook::velox::exec::prefixsort::test {
+namespace {
+
+int32_t sign(int32_t value) {
+  return value < 0 ? -1 : (value > 0 ? 1 : 0);
+}
+
+// Returns the expected order of 'left' and 'right' with the sort order of
+// 'encoder'.
+template <typename T>
+int32_t compare(
+    const PrefixSortEncoder& encoder,
+    const std::optional<T>& left,
+    const std::optional<T>& right) {
+  if (!left.has_value() || !right.has_value()) {
+    if (left.has_value() == right.has_value()) {
+      return 0;
+    }
+    return !left.has_value() == encoder.isNullsFirst() ? -1 : 1;
+  }
+  int32_t result;
+  if constexpr (std::is_same_v<T, std::string>) {
+    result = sign(left.value().compare(right.value()));
+  } else {
+    result = SimpleVector<T>::comparePrimitiveAsc(left.value(), right.value());
+  }
+  return encoder.isAscending() ? result : -result;
+}
+
+// Returns the first 'size' bytes of 'value' without trailing zeros, which is
+// what a string encodes to.
+std::string encodedPrefix(const std::string& value, uint32_t size) {
+  auto prefix = value.substr(0, size);
+  while (!prefix.empty() && prefix.back() == '\0') {
+    prefix.pop_back();
+  }
+  return prefix;
+}
+
+class PrefixSortEncoderTest : public testing::Test {
+ protected:
+  // Verifies that the encoded values compare with memcmp the same way as the
+  // values for each sort order and null order.
+  template <typename T>
+  void testEncode(const std::vector<std::optional<T>>& values) {
+    constexpr auto kSize = PrefixSortEncoder::encodedSize<T>();
+    for (const auto ascending : {true, false}) {
+      for (const auto nullsFirst : {true, false}) {
+        SCOPED_TRACE(
+            fmt::format("ascending: {}, nullsFirst: {}", ascending, nullsFirst));
+        const PrefixSortEncoder encoder(ascending, nullsFirst);
+        std::vector<std::array<char, kSize>> encoded(values.size());
+        for (auto i = 0; i < values.size(); ++i) {
+          encoder.encode(values[i], encoded[i].data());
+        }
+        for (auto i = 0; i < values.size(); ++i) {
+          for (auto j = 0; j < values.size(); ++j) {
+            ASSERT_EQ(
+                sign(std::memcmp(encoded[i].data(), encoded[j].data(), kSize)),
+                compare(encoder, values[i], values[j]))
+                << i << " " << j;
+          }
+        }
+      }
+    }
+  }
+
+  // Returns 'values' plus 100 values from 'makeValue' and two nulls.
+  template <typename T>
+  std::vector<std::optional<T>> randomValues(
+      std::function<T()> makeValue,
+      std::vector<std::optional<T>> values) {
+    for (auto i = 0; i < 100; ++i) {
+      values.push_back(makeValue());
+    }
+    values.push_back(std::nullopt);
+    values.push_back(std::nullopt);
+    return values;
+  }
+};
+
+TEST_F(PrefixSortEncoderTest, integers) {
+  testEncode<int32_t>(randomValues<int32_t>(
+      [] { return static_cast<int32_t>(folly::Random::rand32()); },
+      {0,
+       1,
+       -1,
+       std::numeric_limits<int32_t>::min(),
+       std::numeric_limits<int32_t>::max()}));
+  testEncode<int64_t>(randomValues<int64_t>(
+      [] { return static_cast<int64_t>(folly::Random::rand64()); },
+      {0,
+       1,
+       -1,
+       std::numeric_limits<int64_t>::min(),
+       std::numeric_limits<int64_t>::max()}));
+}
+
+TEST_F(PrefixSortEncoderTest, floatingPoint) {
+  testEncode<double>(randomValues<double>(
+      [] { return folly::Random::randDouble(-1e10, 1e10); },
+      {0.0,
+       -0.0,
+       std::numeric_limits<double>::quiet_NaN(),
+       -std::numeric_limits<double>::quiet_NaN(),
+       std::numeric_limits<double>::infinity(),
+       -std::numeric_limits<double>::infinity(),
+       std::numeric_limits<double>::min(),
+       std::numeric_limits<double>::lowest(),
+       std::numeric_limits<double>::max()}));
+  testEncode<float>(randomValues<float>(
+      [] { return folly::Random::randDouble(-1e5, 1e5); },
+      {0.0f,
+       -0.0f,
+       std::numeric_limits<float>::quiet_NaN(),
+       std::numeric_limits<float>::infinity(),
+       -std::numeric_limits<float>::infinity(),
+       std::numeric_limits<float>::lowest(),
+       std::numeric_limits<float>::max()}));
+}
+
+TEST_F(PrefixSortEncoderTest, timestamp) {
+  testEncode<Timestamp>(randomValues<Timestamp>(
+      [] {
+        return Timestamp(
+            static_cast<int32_t>(folly::Random::rand32()),
+            folly::Random::rand32(Timestamp::kMaxNanos + 1));
+      },
+      {Timestamp(0, 0),
+       Timestamp(0, 1),
+       Timestamp(-1, Timestamp::kMaxNanos),
+       Timestamp(1, 0),
+       Timestamp::min(),
+       Timestamp::max()}));
+}
+
+TEST_F(PrefixSortEncoderTest, string) {
+  const std::vector<std::optional<std::string>> values = {
+      "",
+      "a",
+      std::string("a\0", 2),
+      "ab",
+      "abcdefgh",
+      "abcdefghi",
+      "abcdefghij",
+      "b",
+      std::string(1, '\xff'),
+      std::nullopt};
+  // One null byte and 8 bytes of the string.
+  constexpr uint32_t kSize = 9;
+  for (const auto ascending : {true, false}) {
+    for (const auto nullsFirst : {true, false}) {
+      SCOPED_TRACE(
+          fmt::format("ascending: {}, nullsFirst: {}", ascending, nullsFirst));
+      const PrefixSortEncoder encoder(ascending, nullsFirst);
+      std::vector<std::array<char, kSize>> encoded(values.size());
+      for (auto i = 0; i < values.size(); ++i) {
+        encoder.encode(
+            values[i].has_value()
+                ? std::optional<StringView>(StringView(values[i].value()))
+                : std::nullopt,
+            encoded[i].data(),
+            kSize);
+      }
+      for (auto i = 0; i < values.size(); ++i) {
+        for (auto j = 0; j < values.size(); ++j) {
+          const auto actual =
+              sign(std::memcmp(encoded[i].data(), encoded[j].data(), kSize));
+          const auto expected = compare(encoder, values[i], values[j]);
+          if (actual != 0) {
+            ASSERT_EQ(actual, expected) << i << " " << j;
+            continue;
+          }
+          // Different strings encode the same if they only differ after the
+          // encoded prefix or by trailing zeros.
+          if (expected != 0) {
+            ASSERT_EQ(
+                encodedPrefix(values[i].value(), kSize - 1),
+                encodedPrefix(values[j].value(), kSize - 1))
+                << i << " " << j;
+          }
+        }
+      }
+    }
+  }
+}
+} // namespace
+} // namespace facebook::velox::exec::prefixsort::test
@@ -907,6 +907,46 @@ TEST_F(AggregationTest, partialDistinctWithAbandon) {
              .assertResults("SELECT distinct c0, sum(c0) FROM tmp group by c0");
 }
 
+TEST_F(AggregationTest, partialAggregationSampling) {
+  // The first 4 batches have unique keys. The last 4 have only 10 keys.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 8; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000,
+            [&](auto row) { return i < 4 ? i * 1'000 + row : row % 10; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  // The sample of the first 2 batches abandons partial aggregation. The
+  // sample of the 4th and 5th batches resumes it.
+  core::PlanNodeId partialAggId;
+  auto task =
+      AssertQueryBuilder(duckDbQueryRunner_)
+          .config(QueryConfig::kPartialAggregationSampleBatches, "2")
+          .config(QueryConfig::kPartialAggregationReprobeBatches, "2")
+          .config(QueryConfig::kAbandonPartialAggregationMinPct, "80")
+          .config("max_drivers_per_task", "1")
+          .plan(PlanBuilder()
+                    .values(vectors)
+                    .partialAggregation({"c0"}, {"sum(c1)"})
+                    .capturePlanNodeId(partialAggId)
+                    .finalAggregation()
+                    .planNode())
+          .assertResults("SELECT c0, sum(c1) FROM tmp GROUP BY c0");
+
+  auto runtimeStats =
+      toPlanStats(task->taskStats()).at(partialAggId).customStats;
+  ASSERT_EQ(
+      1, runtimeStats.at("abandonedPartialAggregationBySampling").count);
+  ASSERT_EQ(1, runtimeStats.at("resumedPartialAggregation").count);
+  ASSERT_EQ(2, runtimeStats.at("partialAggregationEstimatedDistinct").count);
+  ASSERT_GE(runtimeStats.at("partialAggregationEstimatedPct").max, 80);
+  ASSERT_LT(runtimeStats.at("partialAggregationEstimatedPct").min, 80);
+}
+
 TEST_F(AggregationTest, largeValueRangeArray) {
   // We have keys that map to integer range. The keys are
   // a little under max array hash table size apart. This wastes 16MB of
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/DriverScaling.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::exec;
+
+namespace {
+DriverScalingInput makeInput(
+    uint32_t numActiveDrivers,
+    double cpuRatio,
+    double consumerBlockedRatio = 0) {
+  DriverScalingInput input;
+  input.numActiveDrivers = numActiveDrivers;
+  input.maxDrivers = 8;
+  input.wallNanos = 100'000'000;
+  const double capacityNanos =
+      static_cast<double>(input.wallNanos) * numActiveDrivers;
+  input.cpuNanos = cpuRatio * capacityNanos;
+  input.consumerBlockedNanos = consumerBlockedRatio * capacityNanos;
+  return input;
+}
+} // namespace
+
+TEST(DriverScalingTest, cpuBound) {
+  EXPECT_EQ(decideDriverScaling(makeInput(2, 0.95)), DriverScaling::kScaleUp);
+
+  // No room to grow.
+  auto input = makeInput(8, 0.95);
+  EXPECT_EQ(decideDriverScaling(input), DriverScaling::kKeep);
+  input = makeInput(2, 0.95);
+  input.atTaskLimit = true;
+  EXPECT_EQ(decideDriverScaling(input), DriverScaling::kKeep);
+
+  // Busy, but the consumers do not keep up.
+  EXPECT_EQ(
+      decideDriverScaling(makeInput(2, 0.95, 0.2)), DriverScaling::kKeep);
+}
+
+TEST(DriverScalingTest, idle) {
+  EXPECT_EQ(
+      decideDriverScaling(makeInput(4, 0.1)), DriverScaling::kScaleDown);
+  EXPECT_EQ(
+      decideDriverScaling(makeInput(4, 0.5, 0.6)), DriverScaling::kScaleDown);
+  // The last active driver is never parked.
+  EXPECT_EQ(decideDriverScaling(makeInput(1, 0.1)), DriverScaling::kKeep);
+}
+
+TEST(DriverScalingTest, keep) {
+  EXPECT_EQ(decideDriverScaling(makeInput(4, 0.5)), DriverScaling::kKeep);
+  EXPECT_EQ(decideDriverScaling(makeInput(0, 0)), DriverScaling::kKeep);
+
+  // Too soon after the previous review.
+  auto input = makeInput(2, 0.95);
+  input.wallNanos = kDriverScalingIntervalNanos / 2;
+  input.cpuNanos = input.wallNanos * 2;
+  EXPECT_EQ(decideDriverScaling(input), DriverScaling::kKeep);
+}
+
+TEST(DriverScalingTest, name) {
+  EXPECT_EQ(driverScalingName(DriverScaling::kKeep), "KEEP");
+  EXPECT_EQ(driverScalingName(DriverScaling::kScaleUp), "SCALE_UP");
+  EXPECT_EQ(driverScalingName(DriverScaling::kScaleDown), "SCALE_DOWN");
+}
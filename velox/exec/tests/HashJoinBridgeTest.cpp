@@ -335,6 +335,94 @@ TEST_P(HashJoinBridgeTest, withSpill) {
   }
 }
 
+TEST_P(HashJoinBridgeTest, skewedSpillPartition) {
+  auto buildFutures = createEmptyFutures(numBuilders_);
+  auto probeFutures = createEmptyFutures(numProbers_);
+
+  auto joinBridge = createJoinBridge();
+  for (int32_t i = 0; i < numBuilders_; ++i) {
+    joinBridge->addBuilder();
+  }
+  joinBridge->start();
+
+  const SpillPartitionId skewedId(startPartitionBitOffset_, 0);
+  const SpillPartitionId otherId(startPartitionBitOffset_, 1);
+  SpillPartitionSet spillPartitionSet;
+  for (const auto& id : {skewedId, otherId}) {
+    spillPartitionSet.emplace(
+        id,
+        std::make_unique<SpillPartition>(
+            id, makeFakeSpillFiles(numSpillFilesPerPartition_)));
+  }
+  ASSERT_TRUE(joinBridge->setHashTable(
+      createFakeHashTable(),
+      std::move(spillPartitionSet),
+      false,
+      {},
+      {skewedId}));
+
+  // Probes the table of the current round and checks which spill input the
+  // builders get for the next round.
+  auto finishRound = [&](bool hasMoreSpill,
+                         const std::optional<SpillPartitionId>& restoredId,
+                         bool hasMoreSkewChunks) {
+    for (int32_t i = 0; i < numProbers_; ++i) {
+      auto tableOr = joinBridge->tableOrFuture(&probeFutures[i]);
+      ASSERT_TRUE(tableOr.has_value());
+      ASSERT_EQ(tableOr->restoredPartitionId, restoredId);
+      ASSERT_EQ(tableOr->hasMoreSkewChunks, hasMoreSkewChunks);
+    }
+    for (int32_t i = 0; i < numBuilders_; ++i) {
+      auto inputOr = joinBridge->spillInputOrFuture(&buildFutures[i]);
+      if (hasMoreSpill) {
+        ASSERT_FALSE(inputOr.has_value());
+      } else {
+        ASSERT_TRUE(inputOr.has_value());
+        ASSERT_TRUE(inputOr->spillPartition == nullptr);
+        ASSERT_FALSE(inputOr->nextSkewChunk);
+      }
+    }
+    ASSERT_EQ(joinBridge->probeFinished(), hasMoreSpill);
+  };
+
+  // The skewed partition is restored first and flagged for the builders.
+  finishRound(true, std::nullopt, false);
+  for (int32_t i = 0; i < numBuilders_; ++i) {
+    auto inputOr = joinBridge->spillInputOrFuture(&buildFutures[i]);
+    ASSERT_TRUE(inputOr.has_value());
+    ASSERT_EQ(inputOr->spillPartition->id(), skewedId);
+    ASSERT_TRUE(inputOr->skewed);
+    ASSERT_FALSE(inputOr->nextSkewChunk);
+  }
+
+  // The first chunk of the skewed partition has more chunks to follow. The
+  // builders continue with the shards they are reading.
+  ASSERT_TRUE(joinBridge->setHashTable(
+      createFakeHashTable(), {}, false, {}, {}, true));
+  finishRound(true, skewedId, true);
+  for (int32_t i = 0; i < numBuilders_; ++i) {
+    auto inputOr = joinBridge->spillInputOrFuture(&buildFutures[i]);
+    ASSERT_TRUE(inputOr.has_value());
+    ASSERT_TRUE(inputOr->spillPartition == nullptr);
+    ASSERT_TRUE(inputOr->nextSkewChunk);
+  }
+  ASSERT_ANY_THROW(joinBridge->spillInputOrFuture(&buildFutures[0]));
+
+  // The last chunk of the skewed partition. The other partition is restored
+  // next without the skew fallback.
+  ASSERT_TRUE(joinBridge->setHashTable(createFakeHashTable(), {}, false));
+  finishRound(true, skewedId, false);
+  for (int32_t i = 0; i < numBuilders_; ++i) {
+    auto inputOr = joinBridge->spillInputOrFuture(&buildFutures[i]);
+    ASSERT_TRUE(inputOr.has_value());
+    ASSERT_EQ(inputOr->spillPartition->id(), otherId);
+    ASSERT_FALSE(inputOr->skewed);
+  }
+
+  ASSERT_FALSE(joinBridge->setHashTable(createFakeHashTable(), {}, false));
+  finishRound(false, otherId, false);
+}
+
 TEST_P(HashJoinBridgeTest, multiThreading) {
   for (int32_t iter = 0; iter < 10; ++iter) {
     std::vector<std::thread> builderThreads;
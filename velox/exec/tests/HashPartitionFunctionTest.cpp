@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/exec/HashPartitionFunction.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
 
@@ -170,3 +171,112 @@ TEST_F(HashPartitionFunctionTest, noKeyAndBitRange) {
   ASSERT_TRUE(singlePartition.has_value());
   EXPECT_EQ(singlePartition.value(), 0u);
 }
+
+TEST_F(HashPartitionFunctionTest, skewed) {
+  const int numRows = 10'000;
+  const int numPartitions = 8;
+  // Half of the rows have key 0, the others have distinct keys.
+  auto vector = makeRowVector({makeFlatVector<int64_t>(
+      numRows, [](auto row) { return row % 2 == 0 ? 0 : row; })});
+  auto rowType = asRowType(vector->type());
+
+  std::vector<uint32_t> expected(numRows);
+  HashPartitionFunction hashFunction(numPartitions, rowType, {0});
+  hashFunction.partition(*vector, expected);
+
+  std::vector<uint32_t> partitions(numRows);
+  SkewedHashPartitionFunction function(numPartitions, rowType, {0});
+  ASSERT_FALSE(function.partition(*vector, partitions).has_value());
+  EXPECT_EQ(1, function.numHotKeys());
+  EXPECT_GT(function.numHotKeyRows(), 0);
+
+  // Rows of the hot key are spread over consecutive partitions starting at
+  // their hash partition. Rows of other keys stay in their hash partition.
+  std::unordered_set<uint32_t> hotKeyPartitions;
+  for (auto i = 0; i < numRows; ++i) {
+    if (i % 2 == 0) {
+      hotKeyPartitions.insert(partitions[i]);
+    } else {
+      EXPECT_EQ(expected[i], partitions[i]);
+    }
+  }
+  EXPECT_EQ(5, hotKeyPartitions.size());
+  EXPECT_EQ(1, hotKeyPartitions.count(expected[0]));
+
+  // Too few rows to detect hot keys.
+  SkewedHashPartitionFunction smallFunction(numPartitions, rowType, {0});
+  auto small = makeRowVector({makeFlatVector<int64_t>(100, [](auto row) {
+    return row % 2 == 0 ? 0 : row;
+  })});
+  smallFunction.partition(*small, partitions);
+  EXPECT_EQ(0, smallFunction.numHotKeys());
+  for (auto i = 0; i < small->size(); ++i) {
+    EXPECT_EQ(expected[i], partitions[i]);
+  }
+}
+
+TEST_F(HashPartitionFunctionTest, skewedSpec) {
+  Type::registerSerDe();
+
+  RowTypePtr inputType(ROW({"c0", "c1"}, {BIGINT(), VARCHAR()}));
+  auto spec = std::make_unique<SkewedHashPartitionFunctionSpec>(
+      inputType, std::vector<column_index_t>{1, 0});
+  ASSERT_EQ("SKEWED HASH(c1, c0)", spec->toString());
+  ASSERT_FALSE(spec->colocatesKeys());
+  ASSERT_TRUE(HashPartitionFunctionSpec(inputType, {0}).colocatesKeys());
+
+  auto copy =
+      SkewedHashPartitionFunctionSpec::deserialize(spec->serialize(), pool());
+  ASSERT_EQ(spec->toString(), copy->toString());
+
+  auto function = copy->create(4);
+  ASSERT_NE(
+      dynamic_cast<SkewedHashPartitionFunction*>(function.get()), nullptr);
+
+  VELOX_ASSERT_THROW(
+      SkewedHashPartitionFunctionSpec(inputType, {}).create(4), "");
+}
+
+TEST_F(HashPartitionFunctionTest, skewedSpecRequiresNoColocation) {
+  auto data = makeRowVector({makeFlatVector<int64_t>({1, 2, 3})});
+  auto inputType = asRowType(data->type());
+  auto values = std::make_shared<core::ValuesNode>(
+      "0", std::vector<RowVectorPtr>{data});
+  std::vector<core::TypedExprPtr> keys{
+      std::make_shared<core::FieldAccessTypedExpr>(BIGINT(), "c0")};
+  auto spec = std::make_shared<SkewedHashPartitionFunctionSpec>(
+      inputType, std::vector<column_index_t>{0});
+
+  VELOX_ASSERT_THROW(
+      std::make_shared<core::PartitionedOutputNode>(
+          "1",
+          core::PartitionedOutputNode::Kind::kPartitioned,
+          keys,
+          4,
+          false,
+          spec,
+          inputType,
+          values),
+      "can't be used if the consumers require co-located keys");
+  VELOX_ASSERT_THROW(
+      std::make_shared<core::LocalPartitionNode>(
+          "1",
+          core::LocalPartitionNode::Type::kRepartition,
+          spec,
+          std::vector<core::PlanNodePtr>{values}),
+      "Local repartitioning requires a partition function that co-locates");
+
+  auto node = std::make_shared<core::PartitionedOutputNode>(
+      "1",
+      core::PartitionedOutputNode::Kind::kPartitioned,
+      keys,
+      4,
+      false,
+      spec,
+      inputType,
+      values,
+      false);
+  ASSERT_FALSE(node->requireColocatedKeys());
+  ASSERT_NE(
+      node->toString(true).find("keys not co-located"), std::string::npos);
+}
@@ -25,6 +25,7 @@
 #include "velox/vector/tests/utils/VectorTestBase.h"
 
 #include <folly/executors/CPUThreadPoolExecutor.h>
+#include <gflags/gflags.h>
 #include <gmock/gmock-matchers.h>
 #include <gtest/gtest.h>
 #include <memory>
@@ -33,6 +34,8 @@ using namespace facebook::velox;
 using namespace facebook::velox::exec;
 using namespace facebook::velox::test;
 
+DECLARE_bool(avx512);
+
 namespace facebook::velox::exec::test {
 
 template <bool ignoreNullKeys>
@@ -610,6 +613,18 @@ TEST_P(HashTableTest, mixed6Sparse) {
   testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
 }
 
+TEST_P(HashTableTest, mixed6SparseAvx512) {
+  // Runs the hash mode probes with the AVX-512 tag compare. This is the same as
+  // the SSE path if the machine does not have AVX-512.
+  gflags::FlagSaver flagSaver;
+  FLAGS_avx512 = true;
+  auto type =
+      ROW({"k1", "k2", "k3", "k4", "k5", "k6"},
+          {BIGINT(), BIGINT(), BIGINT(), BIGINT(), BIGINT(), VARCHAR()});
+  keySpacing_ = 1000;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
+}
+
 // It should be safe to call clear() before we insert any data into HashTable
 TEST_P(HashTableTest, clear) {
   std::vector<std::unique_ptr<VectorHasher>> keyHashers;
@@ -790,6 +805,114 @@ TEST_P(HashTableTest, groupBySpill) {
   testGroupBySpill(5'000'000, type, 1, 1000, 1000);
 }
 
+DEBUG_ONLY_TEST_P(HashTableTest, parallelGroupByRehash) {
+  // The executor is only created when the parallel build is enabled.
+  if (!GetParam()) {
+    return;
+  }
+  auto rowType = ROW({"k1"}, {BIGINT()});
+  auto table = createHashTableForAggregation(rowType, 1);
+  table->setParallelGroupByRehash(executor_.get(), 4, 1'000);
+  auto lookup = std::make_unique<HashLookup>(table->hashers());
+  auto testHelper = HashTableTestHelper<false>::create(table.get());
+  testHelper.setHashMode(BaseHashTable::HashMode::kHash, 1'000);
+
+  std::atomic_int numParallelBuilds{0};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::HashTable::parallelGroupByRehash",
+      std::function<void(void*)>([&](void*) { ++numParallelBuilds; }));
+
+  constexpr int32_t kBatchSize = 10'000;
+  constexpr int32_t kNumBatches = 20;
+  constexpr uint64_t kNumRows = kBatchSize * kNumBatches;
+  std::vector<RowVectorPtr> batches;
+  std::vector<char*> groups;
+  for (auto i = 0; i < kNumBatches; ++i) {
+    batches.push_back(makeRowVector({makeFlatVector<int64_t>(
+        kBatchSize, [&](auto row) { return (i * kBatchSize + row) * 7; })}));
+    insertGroups(*batches.back(), *lookup, *table);
+    groups.insert(groups.end(), lookup->hits.begin(), lookup->hits.end());
+  }
+  ASSERT_GT(numParallelBuilds, 0);
+  ASSERT_EQ(table->numDistinct(), kNumRows);
+
+  // All keys must be found in the same rows after the parallel rehashes.
+  for (auto i = 0; i < kNumBatches; ++i) {
+    insertGroups(*batches[i], *lookup, *table);
+    for (auto row = 0; row < kBatchSize; ++row) {
+      ASSERT_EQ(lookup->hits[row], groups[i * kBatchSize + row]);
+    }
+  }
+  ASSERT_EQ(table->numDistinct(), kNumRows);
+  table->checkConsistency();
+}
+
+TEST_P(HashTableTest, prefetchProbe) {
+  constexpr int32_t kBatchSize = 10'000;
+  constexpr int32_t kNumBatches = 10;
+  constexpr int64_t kBatchOffset = 1'000;
+  constexpr uint64_t kNumDistinct =
+      kBatchOffset * (kNumBatches - 1) + kBatchSize / 2;
+  // Consecutive rows have the same key, so that a row of a prefetch group
+  // finds the entry inserted by the previous row in the same group.
+  auto makeKeys = [&](int64_t offset, vector_size_t size) {
+    return makeRowVector({
+        makeFlatVector<int64_t>(
+            size, [&](auto row) { return offset + row / 2; }),
+        makeFlatVector<int64_t>(
+            size, [&](auto row) { return (offset + row / 2) * 1'000'003; }),
+    });
+  };
+
+  for (const auto mode :
+       {BaseHashTable::HashMode::kHash,
+        BaseHashTable::HashMode::kNormalizedKey}) {
+    SCOPED_TRACE(BaseHashTable::modeString(mode));
+    auto table = createHashTableForAggregation(
+        ROW({"k1", "k2"}, {BIGINT(), BIGINT()}), 2);
+    table->setPrefetchProbe(true, 0);
+    auto lookup = std::make_unique<HashLookup>(table->hashers());
+    auto testHelper = HashTableTestHelper<false>::create(table.get());
+    testHelper.setHashMode(mode, 1'000);
+
+    std::unordered_map<int64_t, char*> groups;
+    for (auto i = 0; i < kNumBatches; ++i) {
+      const auto offset = i * kBatchOffset;
+      insertGroups(*makeKeys(offset, kBatchSize), *lookup, *table);
+      for (auto row = 0; row < kBatchSize; ++row) {
+        auto* group = lookup->hits[row];
+        ASSERT_NE(group, nullptr);
+        auto it = groups.emplace(offset + row / 2, group).first;
+        ASSERT_EQ(it->second, group);
+      }
+    }
+    ASSERT_EQ(table->numDistinct(), kNumDistinct);
+    ASSERT_EQ(groups.size(), kNumDistinct);
+    table->checkConsistency();
+
+    if (mode != BaseHashTable::HashMode::kHash) {
+      continue;
+    }
+    // Probes for the inserted keys and as many keys that are not in the table.
+    const vector_size_t numProbes = kNumDistinct * 4;
+    auto probeKeys = makeKeys(0, numProbes);
+    const SelectivityVector rows(numProbes);
+    lookup->reset(numProbes);
+    lookup->rows.resize(numProbes);
+    std::iota(lookup->rows.begin(), lookup->rows.end(), 0);
+    auto& hashers = table->hashers();
+    for (auto i = 0; i < hashers.size(); ++i) {
+      hashers[i]->decode(*probeKeys->childAt(i), rows);
+      hashers[i]->hash(rows, i > 0, lookup->hashes);
+    }
+    table->joinProbe(*lookup);
+    for (auto row = 0; row < numProbes; ++row) {
+      auto it = groups.find(row / 2);
+      ASSERT_EQ(lookup->hits[row], it == groups.end() ? nullptr : it->second);
+    }
+  }
+}
+
 TEST_P(HashTableTest, checkSizeValidation) {
   auto rowType = ROW({"a"}, {BIGINT()});
   auto table = createHashTableForAggregation(rowType, 1);
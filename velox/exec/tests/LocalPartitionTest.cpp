@@ -332,6 +332,65 @@ TEST_F(LocalPartitionTest, indicesBufferCapacity) {
   ASSERT_LE(capacity, 1.5 * numRows * sizeof(vector_size_t));
 }
 
+TEST_F(LocalPartitionTest, zeroCopy) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 4; i++) {
+    vectors.emplace_back(makeRowVector({
+        makeFlatSequence<int32_t>(i * 100, 100),
+        makeFlatSequence<int64_t>(i, 100),
+    }));
+  }
+
+  auto runQuery = [&](bool roundRobin) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    std::vector<core::PlanNodePtr> sources = {
+        PlanBuilder(planNodeIdGenerator).values(vectors).planNode()};
+
+    CursorParameters params;
+    params.planNode = roundRobin
+        ? PlanBuilder(planNodeIdGenerator)
+              .localPartitionRoundRobin(sources)
+              .planNode()
+        : PlanBuilder(planNodeIdGenerator)
+              .localPartition({"c0"}, sources)
+              .planNode();
+    params.copyResult = false;
+    params.maxDrivers = 2;
+
+    std::vector<RowVectorPtr> results;
+    TaskCursor cursor(params);
+    while (cursor.moveNext()) {
+      results.push_back(cursor.current());
+    }
+    return results;
+  };
+
+  // Round-robin exchange hands over the input vectors.
+  auto results = runQuery(true);
+  ASSERT_EQ(results.size(), vectors.size());
+  for (const auto& result : results) {
+    ASSERT_NE(
+        std::find(vectors.begin(), vectors.end(), result), vectors.end());
+  }
+
+  // Hash exchange wraps the input columns in dictionaries.
+  results = runQuery(false);
+  vector_size_t numRows = 0;
+  for (const auto& result : results) {
+    ASSERT_EQ(result->childrenSize(), 2);
+    for (auto i = 0; i < result->childrenSize(); ++i) {
+      const auto& column = result->childAt(i);
+      ASSERT_EQ(column->encoding(), VectorEncoding::Simple::DICTIONARY);
+      ASSERT_TRUE(std::any_of(
+          vectors.begin(), vectors.end(), [&](const auto& vector) {
+            return column->valueVector() == vector->childAt(i);
+          }));
+    }
+    numRows += result->size();
+  }
+  ASSERT_EQ(numRows, 400);
+}
+
 TEST_F(LocalPartitionTest, blockingOnLocalExchangeQueue) {
   auto localExchangeBufferSize = "1024";
   auto baseVector = vectorMaker_.flatVector<int64_t>(
@@ -14,18 +14,55 @@
  * limitations under the License.
  */
 
+#include "folly/experimental/EventCount.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/testutil/TestValue.h"
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
 using namespace facebook::velox::exec::test;
+using namespace facebook::velox::common::testutil;
 
 class MergeJoinTest : public HiveConnectorTestBase {
  protected:
   using OperatorTestBase::assertQuery;
 
+  // Creates the left side input with keys 0 to 5 in 't' and the right side
+  // input with key 3 repeated over multiple batches followed by keys 4 and 5
+  // in 'u'.
+  void makeSkewedRightMatchInputs(
+      std::vector<RowVectorPtr>& left,
+      std::vector<RowVectorPtr>& right) {
+    for (int32_t i = 0; i < 3; ++i) {
+      left.push_back(makeRowVector(
+          {"t0", "t1"},
+          {makeFlatVector<int32_t>(
+               100, [i](auto row) { return i * 2 + row / 50; }),
+           makeFlatVector<int64_t>(
+               100, [i](auto row) { return i * 100 + row; })}));
+    }
+
+    for (int32_t i = 0; i < 5; ++i) {
+      right.push_back(makeRowVector(
+          {"u0", "u1"},
+          {makeFlatVector<int32_t>(64, [](auto /*row*/) { return 3; }),
+           makeFlatVector<int64_t>(
+               64, [i](auto row) { return i * 64 + row; })}));
+    }
+    right.push_back(makeRowVector(
+        {"u0", "u1"},
+        {makeFlatVector<int32_t>(64, [](auto row) { return 4 + row / 32; }),
+         makeFlatVector<int64_t>(64, [](auto row) { return row; })}));
+
+    createDuckDbTable("t", left);
+    createDuckDbTable("u", right);
+  }
+
   CursorParameters makeCursorParameters(
       const std::shared_ptr<const core::PlanNode>& planNode,
       uint32_t preferredOutputBatchSize) {
@@ -644,3 +681,183 @@ TEST_F(MergeJoinTest, complexTypedFilter) {
     }
   }
 };
+
+TEST_F(MergeJoinTest, spillSkewedRightMatch) {
+  std::vector<RowVectorPtr> left;
+  std::vector<RowVectorPtr> right;
+  makeSkewedRightMatchInputs(left, right);
+
+  struct {
+    core::JoinType joinType;
+    std::string filter;
+    std::string sql;
+    // Left joins with a filter don't spill.
+    bool expectSpill;
+
+    std::string debugString() const {
+      return fmt::format(
+          "joinType: {}, filter: {}", core::joinTypeName(joinType), filter);
+    }
+  } testSettings[] = {
+      {core::JoinType::kInner,
+       "",
+       "SELECT t0, t1, u1 FROM t, u WHERE t0 = u0",
+       true},
+      {core::JoinType::kInner,
+       "(t1 + u1) % 3 = 0",
+       "SELECT t0, t1, u1 FROM t, u WHERE t0 = u0 AND (t1 + u1) % 3 = 0",
+       true},
+      {core::JoinType::kLeft,
+       "",
+       "SELECT t0, t1, u1 FROM t LEFT JOIN u ON t0 = u0",
+       true},
+      {core::JoinType::kLeft,
+       "(t1 + u1) % 3 = 0",
+       "SELECT t0, t1, u1 FROM t LEFT JOIN u ON t0 = u0 AND (t1 + u1) % 3 = 0",
+       false},
+  };
+
+  auto spillDirectory = TempDirectoryPath::create();
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+
+    core::PlanNodeId mergeJoinId;
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan =
+        PlanBuilder(planNodeIdGenerator)
+            .values(left)
+            .mergeJoin(
+                {"t0"},
+                {"u0"},
+                PlanBuilder(planNodeIdGenerator).values(right).planNode(),
+                testData.filter,
+                {"t0", "t1", "u1"},
+                testData.joinType)
+            .capturePlanNodeId(mergeJoinId)
+            .planNode();
+
+    // Use a small output batch size to produce the output of a spilled match
+    // over multiple output batches.
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .spillDirectory(spillDirectory->path)
+                    .config(core::QueryConfig::kSpillEnabled, "true")
+                    .config(core::QueryConfig::kMergeJoinSpillEnabled, "true")
+                    .config(core::QueryConfig::kTestingSpillPct, "100")
+                    .config(core::QueryConfig::kPreferredOutputBatchRows, "16")
+                    .assertResults(testData.sql);
+
+    auto planStats = toPlanStats(task->taskStats());
+    const auto& stats = planStats.at(mergeJoinId);
+    if (!testData.expectSpill) {
+      ASSERT_EQ(stats.spilledBytes, 0);
+      continue;
+    }
+    ASSERT_GT(stats.spilledBytes, 0);
+    ASSERT_GT(stats.spilledRows, 0);
+    ASSERT_GT(stats.spilledFiles, 0);
+    ASSERT_EQ(stats.spilledPartitions, 1);
+  }
+
+  // No spilling if merge join spilling is disabled.
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId mergeJoinId;
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(left)
+                  .mergeJoin(
+                      {"t0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator).values(right).planNode(),
+                      "",
+                      {"t0", "t1", "u1"},
+                      core::JoinType::kInner)
+                  .capturePlanNodeId(mergeJoinId)
+                  .planNode();
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .spillDirectory(spillDirectory->path)
+                  .config(core::QueryConfig::kSpillEnabled, "true")
+                  .config(core::QueryConfig::kMergeJoinSpillEnabled, "false")
+                  .config(core::QueryConfig::kTestingSpillPct, "100")
+                  .assertResults("SELECT t0, t1, u1 FROM t, u WHERE t0 = u0");
+  ASSERT_EQ(toPlanStats(task->taskStats()).at(mergeJoinId).spilledBytes, 0);
+}
+
+DEBUG_ONLY_TEST_F(MergeJoinTest, reclaimSkewedRightMatch) {
+  std::vector<RowVectorPtr> left;
+  std::vector<RowVectorPtr> right;
+  makeSkewedRightMatchInputs(left, right);
+
+  core::PlanNodeId mergeJoinId;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(left)
+                  .mergeJoin(
+                      {"t0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator).values(right).planNode(),
+                      "",
+                      {"t0", "t1", "u1"},
+                      core::JoinType::kInner)
+                  .capturePlanNodeId(mergeJoinId)
+                  .planNode();
+
+  folly::EventCount driverWait;
+  auto driverWaitKey = driverWait.prepareWait();
+  folly::EventCount testWait;
+  auto testWaitKey = testWait.prepareWait();
+
+  // Blocks the driver once 'rightMatch_' has buffered more than one right
+  // side batch with key 3.
+  std::atomic_int numRightMatchBatches{0};
+  Operator* op{nullptr};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::MergeJoin::getOutput::rightMatch",
+      std::function<void(Operator*)>([&](Operator* testOp) {
+        if (++numRightMatchBatches != 2) {
+          return;
+        }
+        op = testOp;
+        testWait.notify();
+        driverWait.wait(driverWaitKey);
+      }));
+
+  auto spillDirectory = TempDirectoryPath::create();
+  std::shared_ptr<Task> task;
+  std::thread taskThread([&]() {
+    task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+               .spillDirectory(spillDirectory->path)
+               .config(core::QueryConfig::kSpillEnabled, "true")
+               .config(core::QueryConfig::kMergeJoinSpillEnabled, "true")
+               .config(core::QueryConfig::kPreferredOutputBatchRows, "16")
+               .assertResults("SELECT t0, t1, u1 FROM t, u WHERE t0 = u0");
+  });
+
+  testWait.wait(testWaitKey);
+  ASSERT_TRUE(op != nullptr);
+  auto pausedTask = op->testingOperatorCtx()->task();
+  auto taskPauseWait = pausedTask->requestPause();
+  driverWait.notify();
+  taskPauseWait.wait();
+
+  ASSERT_TRUE(op->canReclaim());
+  uint64_t reclaimableBytes{0};
+  ASSERT_TRUE(op->reclaimableBytes(reclaimableBytes));
+  ASSERT_GT(reclaimableBytes, 0);
+
+  memory::MemoryReclaimer::Stats reclaimerStats;
+  const auto oldCapacity = op->pool()->capacity();
+  op->pool()->reclaim(0, 0, reclaimerStats);
+  dynamic_cast<memory::MemoryPoolImpl*>(op->pool())
+      ->testingSetCapacity(oldCapacity);
+  ASSERT_GT(reclaimerStats.reclaimExecTimeUs, 0);
+
+  Task::resume(pausedTask);
+  pausedTask.reset();
+  taskThread.join();
+
+  const auto stats = toPlanStats(task->taskStats()).at(mergeJoinId);
+  ASSERT_GT(stats.spilledBytes, 0);
+  ASSERT_GT(stats.spilledRows, 0);
+  ASSERT_GT(stats.spilledFiles, 0);
+  ASSERT_EQ(stats.spilledPartitions, 1);
+  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+}
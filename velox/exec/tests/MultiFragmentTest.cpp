@@ -22,6 +22,7 @@
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Exchange.h"
 #include "velox/exec/OutputBufferManager.h"
+#include "velox/exec/PartitionedOutput.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/RoundRobinPartitionFunction.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
@@ -801,6 +802,79 @@ TEST_F(MultiFragmentTest, constantKeys) {
   }
 }
 
+TEST_F(MultiFragmentTest, partitionBytes) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 10; }),
+  });
+
+  const int32_t numPartitions = 3;
+  const int32_t numDrivers = 4;
+  core::PlanNodeId partitionedOutputId;
+  auto leafPlan = PlanBuilder()
+                      .values({data}, true)
+                      .partitionedOutput({"c0"}, numPartitions)
+                      .capturePlanNodeId(partitionedOutputId)
+                      .planNode();
+  const auto leafTaskId = makeTaskId("leaf", 0);
+  auto leafTask = makeTask(leafTaskId, leafPlan, 0);
+  leafTask->start(numDrivers);
+
+  vector_size_t numRows = 0;
+  for (auto i = 0; i < numPartitions; ++i) {
+    auto result = AssertQueryBuilder(
+                      PlanBuilder().exchange(leafPlan->outputType()).planNode())
+                      .split(remoteSplit(leafTaskId))
+                      .destination(i)
+                      .copyResults(pool());
+    numRows += result->size();
+  }
+  ASSERT_EQ(numDrivers * data->size(), numRows);
+  ASSERT_TRUE(waitForTaskCompletion(leafTask.get())) << leafTaskId;
+
+  // One sample per destination with the bytes of all the drivers.
+  const auto stats = toPlanStats(leafTask->taskStats()).at(partitionedOutputId);
+  const auto& partitionBytes =
+      stats.customStats.at(PartitionedOutput::kPartitionBytes);
+  ASSERT_EQ(numPartitions, partitionBytes.count);
+  ASSERT_EQ(stats.outputBytes, partitionBytes.sum);
+}
+
+TEST_F(MultiFragmentTest, partitionedOutputPreserveEncodings) {
+  const std::string value(100, 'x');
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+      makeConstant(variant(value), 1'000),
+  });
+  createDuckDbTable({data});
+
+  core::PlanNodeId partitionedOutputId;
+  auto leafPlan = PlanBuilder()
+                      .values({data})
+                      .partitionedOutput({}, 1)
+                      .capturePlanNodeId(partitionedOutputId)
+                      .planNode();
+
+  // Returns the number of bytes produced by the partitioned output.
+  auto runQuery = [&](bool preserveEncodings) {
+    configSettings_[core::QueryConfig::kPartitionedOutputPreserveEncodings] =
+        preserveEncodings ? "true" : "false";
+    const auto leafTaskId =
+        makeTaskId(preserveEncodings ? "leaf-encoded" : "leaf", 0);
+    auto leafTask = makeTask(leafTaskId, leafPlan, 0);
+    leafTask->start(1);
+
+    auto plan = PlanBuilder().exchange(leafPlan->outputType()).planNode();
+    assertQuery(plan, {leafTaskId}, "SELECT * FROM tmp");
+    EXPECT_TRUE(waitForTaskCompletion(leafTask.get())) << leafTaskId;
+    return toPlanStats(leafTask->taskStats())
+        .at(partitionedOutputId)
+        .outputBytes;
+  };
+
+  // The constant column is written once instead of once per row.
+  ASSERT_LT(runQuery(true) + 1'000 * value.size() / 2, runQuery(false));
+}
+
 TEST_F(MultiFragmentTest, replicateNullsAndAny) {
   auto data = makeRowVector({makeFlatVector<int32_t>(
       1'000, [](auto row) { return row; }, nullEvery(7))});
@@ -1987,5 +2061,63 @@ TEST_F(MultiFragmentTest, mergeSmallBatchesInExchange) {
   test(100'000, 1);
 }
 
+TEST_F(MultiFragmentTest, minExchangeOutputBatchBytes) {
+  auto data = makeRowVector({makeFlatVector<int32_t>({1, 2, 3})});
+
+  const int32_t numPartitions = 100;
+  auto producerPlan = test::PlanBuilder()
+                          .values({data})
+                          .partitionedOutput({"c0"}, numPartitions)
+                          .planNode();
+  const auto producerTaskId = "local://t1";
+  auto producerTask = makeTask(producerTaskId, producerPlan);
+  bufferManager_->initializeTask(
+      producerTask,
+      core::PartitionedOutputNode::Kind::kPartitioned,
+      numPartitions,
+      1);
+  auto cleanupGuard = folly::makeGuard([&]() {
+    producerTask->requestCancel();
+    bufferManager_->removeTask(producerTaskId);
+  });
+
+  auto plan = test::PlanBuilder().exchange(asRowType(data->type())).planNode();
+
+  auto expected = makeRowVector({
+      makeFlatVector<int32_t>(3'000, [](auto row) { return 1 + row % 3; }),
+  });
+
+  // Enqueue half of the small pages before the consumer starts and the other
+  // half while it runs.
+  const int32_t numPages = 1'000;
+  for (auto i = 0; i < numPages / 2; ++i) {
+    enqueue(producerTaskId, 17, data);
+  }
+  std::thread producer([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    for (auto i = 0; i < numPages / 2; ++i) {
+      enqueue(producerTaskId, 17, data);
+    }
+    bufferManager_->noMoreData(producerTaskId);
+  });
+
+  // The minimum batch size is larger than all pages combined, so the exchange
+  // produces a single batch after receiving all pages.
+  auto task = test::AssertQueryBuilder(plan)
+                  .split(remoteSplit(producerTaskId))
+                  .destination(17)
+                  .config(
+                      core::QueryConfig::kMinExchangeOutputBatchBytes,
+                      std::to_string(1'000'000))
+                  .assertResults(expected);
+  producer.join();
+
+  auto taskStats = exec::toPlanStats(task->taskStats());
+  const auto& stats = taskStats.at("0");
+  ASSERT_EQ(expected->size(), stats.outputRows);
+  ASSERT_EQ(1, stats.outputVectors);
+  ASSERT_EQ(numPages, stats.customStats.at("numReceivedPages").sum);
+}
+
 } // namespace
 } // namespace facebook::velox::exec
@@ -13,8 +13,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/VectorTestUtil.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 
@@ -334,6 +337,79 @@ TEST_F(NestedLoopJoinTest, lazyVectors) {
   assertQuery(op, "SELECT * FROM t FULL JOIN u ON t.c0 + u.c0 < 100");
 }
 
+TEST_F(NestedLoopJoinTest, spillBuild) {
+  auto probeVectors = makeBatches(10, 5, probeType_, pool_.get());
+  auto buildVectors = makeBatches(20, 5, buildType_, pool_.get());
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  struct {
+    core::JoinType joinType;
+    std::string joinCondition;
+    int32_t numDrivers;
+    bool expectSpill;
+
+    std::string debugString() const {
+      return fmt::format(
+          "joinType: {}, joinCondition: {}, numDrivers: {}, expectSpill: {}",
+          core::joinTypeName(joinType),
+          joinCondition,
+          numDrivers,
+          expectSpill);
+    }
+  } testSettings[] = {
+      {core::JoinType::kInner, "t0 < u0", 1, true},
+      {core::JoinType::kInner, "t0 < u0", 4, true},
+      {core::JoinType::kInner, "", 1, true},
+      {core::JoinType::kLeft, "t0 = u0", 1, true},
+      {core::JoinType::kLeft, "t0 <> u0", 4, true},
+      {core::JoinType::kRight, "t0 < u0", 1, false},
+      {core::JoinType::kFull, "t0 < u0", 4, false}};
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+
+    auto spillDirectory = TempDirectoryPath::create();
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId joinNodeId;
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors)
+                    .localPartition({probeKeyName_})
+                    .nestedLoopJoin(
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors)
+                            .localPartition({buildKeyName_})
+                            .planNode(),
+                        testData.joinCondition,
+                        outputLayout_,
+                        testData.joinType)
+                    .capturePlanNodeId(joinNodeId)
+                    .planNode();
+
+    const auto joinCondition =
+        testData.joinCondition.empty() ? "true" : testData.joinCondition;
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .maxDrivers(testData.numDrivers)
+            .spillDirectory(spillDirectory->path)
+            .config(core::QueryConfig::kSpillEnabled, "true")
+            .config(core::QueryConfig::kJoinSpillEnabled, "true")
+            .config(core::QueryConfig::kTestingSpillPct, "100")
+            .assertResults(fmt::format(
+                "SELECT t0, u0 FROM t {} JOIN u ON {}",
+                core::joinTypeName(testData.joinType),
+                joinCondition));
+
+    const auto stats = toPlanStats(task->taskStats()).at(joinNodeId);
+    if (testData.expectSpill) {
+      ASSERT_GT(stats.spilledBytes, 0);
+      ASSERT_GT(stats.spilledRows, 0);
+      ASSERT_GT(stats.spilledFiles, 0);
+    } else {
+      ASSERT_EQ(stats.spilledBytes, 0);
+    }
+  }
+}
+
 // Test cross join with a build side that has rows, but no columns.
 TEST_F(NestedLoopJoinTest, zeroColumnBuild) {
   auto probeVectors = {
@@ -17,9 +17,11 @@
 #include <gtest/gtest.h>
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/FileSystems.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/serializers/PrestoSerializer.h"
 
 using namespace facebook::velox;
@@ -59,7 +61,8 @@ class OutputBufferManagerTest : public testing::Test {
       PartitionedOutputNode::Kind kind,
       int numDestinations,
       int numDrivers,
-      int maxOutputBufferSize = 0) {
+      int maxOutputBufferSize = 0,
+      bool flowControlEnabled = false) {
     bufferManager_->removeTask(taskId);
 
     auto planFragment = exec::test::PlanBuilder()
@@ -71,6 +74,10 @@ class OutputBufferManagerTest : public testing::Test {
       configSettings[core::QueryConfig::kMaxPartitionedOutputBufferSize] =
           std::to_string(maxOutputBufferSize);
     }
+    if (flowControlEnabled) {
+      configSettings[core::QueryConfig::kPartitionedOutputFlowControlEnabled] =
+          "true";
+    }
     auto queryCtx = std::make_shared<core::QueryCtx>(
         executor_.get(), core::QueryConfig(std::move(configSettings)));
 
@@ -1058,6 +1065,62 @@ TEST_F(OutputBufferManagerTest, outOfOrderAcks) {
   bufferManager_->removeTask(taskId);
 }
 
+TEST_F(OutputBufferManagerTest, destinationFlowControl) {
+  const std::string taskId = "t0";
+  // Enqueue copies of the same page so that all pages have the same size.
+  auto vector = BatchMaker::createBatch(rowType_, 100, *pool_);
+  const int64_t pageSize = toSerializedPage(vector)->size();
+  // Each of the 3 destinations gets a credit of 2 pages.
+  auto task = initializeTask(
+      taskId,
+      rowType_,
+      PartitionedOutputNode::Kind::kPartitioned,
+      3,
+      1,
+      6 * pageSize,
+      true);
+
+  auto enqueuePage = [&](int destination, ContinueFuture* future) {
+    return bufferManager_->enqueue(
+        taskId, destination, toSerializedPage(vector), future);
+  };
+
+  ContinueFuture future;
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_FALSE(enqueuePage(1, &future));
+  }
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_FALSE(enqueuePage(0, &future));
+  }
+
+  // Over the limit. Destinations 0 and 1 are over their credit.
+  ContinueFuture future0;
+  ASSERT_TRUE(enqueuePage(0, &future0));
+  ContinueFuture future1;
+  ASSERT_TRUE(enqueuePage(1, &future1));
+
+  // Destination 2 is within its credit and does not block.
+  ASSERT_FALSE(enqueuePage(2, &future));
+
+  auto stats = getStats(taskId);
+  ASSERT_EQ(stats.buffersStats[0].blockedEnqueues, 1);
+  ASSERT_EQ(stats.buffersStats[1].blockedEnqueues, 1);
+  ASSERT_EQ(stats.buffersStats[2].blockedEnqueues, 0);
+  ASSERT_EQ(stats.unblockedEnqueues, 1);
+
+  // Draining destination 0 resumes its producer while the buffer is still
+  // over the limit.
+  acknowledge(taskId, 0, 2);
+  ASSERT_TRUE(future0.isReady());
+  ASSERT_FALSE(future1.isReady());
+
+  acknowledge(taskId, 1, 5);
+  ASSERT_TRUE(future1.isReady());
+
+  task->requestCancel();
+  bufferManager_->removeTask(taskId);
+}
+
 TEST_F(OutputBufferManagerTest, errorInQueue) {
   auto queue = std::make_shared<ExchangeQueue>();
   queue->setError("Forced failure");
@@ -1208,6 +1271,170 @@ TEST_P(AllOutputBufferManagerTest, multiFetchers) {
   }
 }
 
+TEST_P(AllOutputBufferManagerTest, spill) {
+  filesystems::registerLocalFileSystem();
+  const std::string taskId = "t0";
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  const std::string spillPath = spillDirectory->getPath();
+  const auto spillConfig = common::SpillConfig(
+      [&]() -> const std::string& { return spillPath; },
+      [&](uint64_t) {},
+      "0.0.0",
+      0,
+      0,
+      0,
+      executor_.get(),
+      5,
+      10,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      "none");
+
+  auto task = initializeTask(taskId, rowType_, kind_, 1, 1);
+  ASSERT_TRUE(bufferManager_->updateOutputBuffers(taskId, 1, true));
+  auto buffer = bufferManager_->getBufferIfExists(taskId);
+  ASSERT_NE(buffer, nullptr);
+
+  // All pages have the same content.
+  auto vector = BatchMaker::createBatch(rowType_, 100, *pool_);
+  const auto expectedPage =
+      toSerializedPage(vector)->getIOBuf()->to<std::string>();
+  auto enqueuePage = [&]() {
+    ContinueFuture future;
+    ASSERT_FALSE(
+        bufferManager_->enqueue(taskId, 0, toSerializedPage(vector), &future));
+  };
+  auto fetchPages = [&](int64_t sequence, uint64_t maxBytes) {
+    std::vector<std::unique_ptr<folly::IOBuf>> result;
+    bufferManager_->getData(
+        taskId,
+        0,
+        maxBytes,
+        sequence,
+        [&](std::vector<std::unique_ptr<folly::IOBuf>> pages,
+            int64_t /*sequence*/) { result = std::move(pages); });
+    return result;
+  };
+
+  for (int i = 0; i < 4; ++i) {
+    enqueuePage();
+  }
+  // The fetched page may be fetched again and stays in memory.
+  ASSERT_EQ(fetchPages(0, 1).size(), 1);
+  const auto utilization = bufferManager_->getUtilization(taskId);
+
+  auto spillStats = buffer->spill(spillConfig, pool_.get());
+  ASSERT_EQ(spillStats.spilledFiles, 1);
+  ASSERT_EQ(spillStats.spilledRows, 3 * vector->size());
+  ASSERT_EQ(spillStats.spilledBytes, 3 * expectedPage.size());
+  ASSERT_LT(bufferManager_->getUtilization(taskId), utilization / 3);
+  ASSERT_GT(bufferManager_->getUtilization(taskId), 0);
+
+  // Nothing left to spill.
+  spillStats = buffer->spill(spillConfig, pool_.get());
+  ASSERT_EQ(spillStats.spilledFiles, 0);
+  ASSERT_EQ(spillStats.spilledBytes, 0);
+
+  // A page added after the spill is returned after the spilled ones.
+  enqueuePage();
+  auto pages = fetchPages(1, std::numeric_limits<uint64_t>::max());
+  ASSERT_EQ(pages.size(), 4);
+  for (const auto& page : pages) {
+    ASSERT_NE(page, nullptr);
+    ASSERT_EQ(page->to<std::string>(), expectedPage);
+  }
+  ASSERT_EQ(getStats(taskId).buffersStats[0].pagesBuffered, 4);
+
+  noMoreData(taskId);
+  fetchEndMarker(taskId, 0, 5);
+  const auto stats = getStats(taskId);
+  ASSERT_EQ(stats.buffersStats[0].pagesSent, 5);
+  ASSERT_EQ(stats.buffersStats[0].rowsSent, 5 * vector->size());
+  bufferManager_->removeTask(taskId);
+}
+
+TEST_F(OutputBufferManagerTest, spillBroadcast) {
+  filesystems::registerLocalFileSystem();
+  const std::string taskId = "t0";
+  const int kNumDestinations = 3;
+  const int kNumPages = 4;
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  const std::string spillPath = spillDirectory->getPath();
+  const auto spillConfig = common::SpillConfig(
+      [&]() -> const std::string& { return spillPath; },
+      [&](uint64_t) {},
+      "0.0.0",
+      0,
+      0,
+      0,
+      executor_.get(),
+      5,
+      10,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      "none");
+  auto spillPool = memory::memoryManager()->addLeafPool("spillBroadcast");
+
+  auto task = initializeTask(
+      taskId, rowType_, PartitionedOutputNode::Kind::kBroadcast, 1, 1);
+  ASSERT_TRUE(
+      bufferManager_->updateOutputBuffers(taskId, kNumDestinations, true));
+  auto buffer = bufferManager_->getBufferIfExists(taskId);
+  ASSERT_NE(buffer, nullptr);
+
+  auto vector = BatchMaker::createBatch(rowType_, 100, *pool_);
+  const auto pageSize = toSerializedPage(vector)->size();
+  for (int i = 0; i < kNumPages; ++i) {
+    ContinueFuture future;
+    ASSERT_FALSE(
+        bufferManager_->enqueue(taskId, 0, toSerializedPage(vector), &future));
+  }
+  auto spillStats = buffer->spill(spillConfig, spillPool.get());
+  // Each broadcast page is written once.
+  ASSERT_EQ(spillStats.spilledBytes, kNumPages * pageSize);
+  const auto spilledUtilization = bufferManager_->getUtilization(taskId);
+
+  auto fetchPages = [&](int destination) {
+    std::vector<std::unique_ptr<folly::IOBuf>> result;
+    bufferManager_->getData(
+        taskId,
+        destination,
+        std::numeric_limits<uint64_t>::max(),
+        0,
+        [&](std::vector<std::unique_ptr<folly::IOBuf>> pages,
+            int64_t /*sequence*/) { result = std::move(pages); });
+    return result;
+  };
+
+  // The first destination reads the pages back. The others share them.
+  ASSERT_EQ(fetchPages(0).size(), kNumPages);
+  const auto readBytes = spillPool->usedBytes();
+  const auto readUtilization = bufferManager_->getUtilization(taskId);
+  ASSERT_GE(readBytes, kNumPages * pageSize);
+  ASSERT_GT(readUtilization, spilledUtilization);
+  for (int destination = 1; destination < kNumDestinations; ++destination) {
+    ASSERT_EQ(fetchPages(destination).size(), kNumPages);
+    ASSERT_EQ(spillPool->usedBytes(), readBytes);
+    ASSERT_EQ(bufferManager_->getUtilization(taskId), readUtilization);
+  }
+
+  // The pages are freed once all the destinations have acknowledged them.
+  for (int destination = 0; destination < kNumDestinations; ++destination) {
+    bufferManager_->acknowledge(taskId, destination, kNumPages);
+  }
+  ASSERT_EQ(spillPool->usedBytes(), 0);
+  ASSERT_EQ(bufferManager_->getUtilization(taskId), 0);
+  bufferManager_->removeTask(taskId);
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     AllOutputBufferManagerTestSuite,
     AllOutputBufferManagerTest,
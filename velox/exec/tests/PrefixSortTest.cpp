@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/PrefixSort.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::exec::test {
+namespace {
+
+class PrefixSortTest : public testing::Test,
+                       public velox::test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  // Stores 'data' in a RowContainer with all its columns as keys, sorts the
+  // rows with prefix sort using 'maxNormalizedKeyBytes' and with std::sort,
+  // and verifies both produce the same key values.
+  void testSort(
+      const RowVectorPtr& data,
+      const std::vector<CompareFlags>& compareFlags,
+      uint32_t maxNormalizedKeyBytes) {
+    SCOPED_TRACE(fmt::format(
+        "{}, maxNormalizedKeyBytes: {}",
+        data->type()->toString(),
+        maxNormalizedKeyBytes));
+    const auto& rowType = asRowType(data->type());
+    RowContainer container(rowType->children(), pool());
+    std::vector<char*> rows(data->size());
+    for (auto i = 0; i < data->size(); ++i) {
+      rows[i] = container.newRow();
+    }
+    for (auto column = 0; column < data->childrenSize(); ++column) {
+      DecodedVector decoded(*data->childAt(column));
+      for (auto i = 0; i < data->size(); ++i) {
+        container.store(decoded, i, rows[i], column);
+      }
+    }
+
+    auto expectedRows = rows;
+    PrefixSort::sort(
+        &container,
+        compareFlags,
+        common::PrefixSortConfig(0, 0),
+        pool(),
+        folly::Range<char**>(expectedRows.data(), expectedRows.size()));
+    auto actualRows = rows;
+    PrefixSort::sort(
+        &container,
+        compareFlags,
+        common::PrefixSortConfig(maxNormalizedKeyBytes, 0),
+        pool(),
+        folly::Range<char**>(actualRows.data(), actualRows.size()));
+
+    for (auto column = 0; column < data->childrenSize(); ++column) {
+      auto expected =
+          BaseVector::create(rowType->childAt(column), rows.size(), pool());
+      container.extractColumn(
+          expectedRows.data(), expectedRows.size(), column, expected);
+      auto actual =
+          BaseVector::create(rowType->childAt(column), rows.size(), pool());
+      container.extractColumn(
+          actualRows.data(), actualRows.size(), column, actual);
+      velox::test::assertEqualVectors(expected, actual);
+    }
+  }
+
+  // Sorts 'data' with each combination of the sort order and null order.
+  void testSortOrders(const RowVectorPtr& data) {
+    for (const auto ascending : {true, false}) {
+      for (const auto nullsFirst : {true, false}) {
+        SCOPED_TRACE(
+            fmt::format("ascending: {}, nullsFirst: {}", ascending, nullsFirst));
+        std::vector<CompareFlags> compareFlags;
+        for (auto i = 0; i < data->childrenSize(); ++i) {
+          // Alternate the sort orders of the keys.
+          compareFlags.push_back(
+              {i % 2 == 0 ? nullsFirst : !nullsFirst,
+               i % 2 == 0 ? ascending : !ascending,
+               false,
+               CompareFlags::NullHandlingMode::kNullAsValue});
+        }
+        for (const auto maxNormalizedKeyBytes : {1, 12, 40, 128}) {
+          testSort(data, compareFlags, maxNormalizedKeyBytes);
+        }
+      }
+    }
+  }
+
+  RowVectorPtr fuzzData(const RowTypePtr& rowType, vector_size_t size) {
+    VectorFuzzer::Options options;
+    options.vectorSize = size;
+    options.nullRatio = 0.1;
+    options.stringLength = 20;
+    VectorFuzzer fuzzer(options, pool());
+    // Use a few distinct values per column to get ties on the leading keys.
+    std::vector<VectorPtr> children;
+    for (const auto& type : rowType->children()) {
+      children.push_back(
+          fuzzer.fuzzDictionary(fuzzer.fuzzFlat(type, 10), size));
+    }
+    return makeRowVector(rowType->names(), children);
+  }
+};
+
+TEST_F(PrefixSortTest, fixedWidthKeys) {
+  testSortOrders(fuzzData(
+      ROW({"c0", "c1", "c2", "c3", "c4"},
+          {BIGINT(), INTEGER(), DATE(), TIMESTAMP(), REAL()}),
+      1'000));
+}
+
+TEST_F(PrefixSortTest, stringKeys) {
+  testSortOrders(fuzzData(
+      ROW({"c0", "c1", "c2"}, {VARCHAR(), BIGINT(), VARCHAR()}), 1'000));
+
+  // Strings which are longer than the encoded prefix and differ only in
+  // their suffixes or by trailing zeros.
+  const std::string prefix(40, 'a');
+  testSortOrders(makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {prefix + "c",
+           prefix + "b",
+           std::nullopt,
+           prefix,
+           "",
+           std::string("a\0", 2),
+           "a",
+           prefix + "b",
+           std::string(1, '\xff'),
+           std::nullopt}),
+      makeFlatVector<int64_t>({1, 2, 3, 4, 5, 6, 7, 8, 9, 10}),
+  }));
+}
+
+TEST_F(PrefixSortTest, floatingPointKeys) {
+  constexpr auto kNaN = std::numeric_limits<double>::quiet_NaN();
+  constexpr auto kInf = std::numeric_limits<double>::infinity();
+  testSortOrders(makeRowVector({
+      makeNullableFlatVector<double>(
+          {0.0, -0.0, kNaN, -kNaN, kInf, -kInf, std::nullopt, 1.5, -1.5, 0.0}),
+      makeFlatVector<int32_t>({10, 9, 8, 7, 6, 5, 4, 3, 2, 1}),
+  }));
+}
+
+TEST_F(PrefixSortTest, reservationFailure) {
+  const auto data = fuzzData(ROW({"c0", "c1"}, {BIGINT(), VARCHAR()}), 1'000);
+  const auto& rowType = asRowType(data->type());
+  RowContainer container(rowType->children(), pool());
+  std::vector<char*> rows(data->size());
+  for (auto i = 0; i < data->size(); ++i) {
+    rows[i] = container.newRow();
+  }
+  for (auto column = 0; column < data->childrenSize(); ++column) {
+    DecodedVector decoded(*data->childAt(column));
+    for (auto i = 0; i < data->size(); ++i) {
+      container.store(decoded, i, rows[i], column);
+    }
+  }
+
+  auto expectedRows = rows;
+  PrefixSort::sort(
+      &container,
+      {},
+      common::PrefixSortConfig(0, 0),
+      pool(),
+      folly::Range<char**>(expectedRows.data(), expectedRows.size()));
+
+  // The encoded keys don't fit in the capacity of 'sortPool' so prefix sort
+  // falls back to std::sort without allocating from it.
+  auto rootPool = memory::memoryManager()->addRootPool("", 1 << 20);
+  auto sortPool = rootPool->addLeafChild("sort");
+  auto actualRows = rows;
+  PrefixSort::sort(
+      &container,
+      {},
+      common::PrefixSortConfig(128, 0),
+      sortPool.get(),
+      folly::Range<char**>(actualRows.data(), actualRows.size()));
+  ASSERT_EQ(sortPool->peakBytes(), 0);
+  ASSERT_EQ(sortPool->reservedBytes(), 0);
+
+  for (auto column = 0; column < data->childrenSize(); ++column) {
+    auto expected =
+        BaseVector::create(rowType->childAt(column), rows.size(), pool());
+    container.extractColumn(
+        expectedRows.data(), expectedRows.size(), column, expected);
+    auto actual =
+        BaseVector::create(rowType->childAt(column), rows.size(), pool());
+    container.extractColumn(
+        actualRows.data(), actualRows.size(), column, actual);
+    velox::test::assertEqualVectors(expected, actual);
+  }
+}
+
+TEST_F(PrefixSortTest, unsupportedKeys) {
+  // The leading array key can't be encoded so prefix sort falls back to
+  // std::sort. The array key after the encoded bigint key is compared through
+  // the RowContainer.
+  testSortOrders(
+      fuzzData(ROW({"c0", "c1"}, {ARRAY(BIGINT()), BIGINT()}), 500));
+  testSortOrders(
+      fuzzData(ROW({"c0", "c1"}, {BIGINT(), ARRAY(INTEGER())}), 500));
+}
+
+TEST_F(PrefixSortTest, layout) {
+  RowContainer container({BIGINT(), TIMESTAMP(), VARCHAR(), INTEGER()}, pool());
+  auto layout = PrefixSortLayout::make(container, {}, 128);
+  ASSERT_EQ(layout.numKeys, 4);
+  ASSERT_EQ(layout.numEncodedKeys, 3);
+  ASSERT_EQ(layout.numExactKeys, 2);
+  ASSERT_EQ(layout.keySizes, (std::vector<uint32_t>{9, 17, 17}));
+  ASSERT_EQ(layout.encodeSize, 43);
+  ASSERT_EQ(layout.entrySize, 43 + sizeof(char*));
+
+  layout = PrefixSortLayout::make(container, {}, 20);
+  ASSERT_EQ(layout.numEncodedKeys, 1);
+  ASSERT_EQ(layout.numExactKeys, 1);
+  ASSERT_EQ(layout.encodeSize, 9);
+
+  layout = PrefixSortLayout::make(container, std::vector<CompareFlags>(2), 128);
+  ASSERT_EQ(layout.numKeys, 2);
+  ASSERT_EQ(layout.numEncodedKeys, 2);
+  ASSERT_EQ(layout.numExactKeys, 2);
+
+  layout = PrefixSortLayout::make(container, {}, 8);
+  ASSERT_EQ(layout.numEncodedKeys, 0);
+}
+} // namespace
+} // namespace facebook::velox::exec::test
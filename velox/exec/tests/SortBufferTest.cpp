@@ -42,7 +42,9 @@ class SortBufferTest : public OperatorTestBase {
     rng_.seed(123);
   }
 
-  common::SpillConfig getSpillConfig(const std::string& spillDir) const {
+  common::SpillConfig getSpillConfig(
+      const std::string& spillDir,
+      const std::string& format = "columnar") const {
     return common::SpillConfig(
         [&]() -> const std::string& { return spillDir; },
         [&](uint64_t) {},
@@ -59,7 +61,37 @@ class SortBufferTest : public OperatorTestBase {
         0,
         0,
         0,
-        "none");
+        "none",
+        "",
+        0,
+        format);
+  }
+
+  // Returns the output of 'sortBuffer' in batches of at most 'maxOutputRows'.
+  // Calls 'afterFirstOutput' after producing the first batch.
+  static std::vector<RowVectorPtr> readOutput(
+      SortBuffer& sortBuffer,
+      uint32_t maxOutputRows,
+      std::function<void()> afterFirstOutput = nullptr) {
+    std::vector<RowVectorPtr> outputs;
+    while (auto output = sortBuffer.getOutput(maxOutputRows)) {
+      // The output vector is reused across the calls.
+      outputs.push_back(
+          std::static_pointer_cast<RowVector>(BaseVector::copy(*output)));
+      if (outputs.size() == 1 && afterFirstOutput != nullptr) {
+        afterFirstOutput();
+      }
+    }
+    return outputs;
+  }
+
+  static void assertEqualOutputs(
+      const std::vector<RowVectorPtr>& expected,
+      const std::vector<RowVectorPtr>& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (auto i = 0; i < expected.size(); ++i) {
+      velox::test::assertEqualVectors(expected[i], actual[i]);
+    }
   }
 
   const RowTypePtr inputType_ = ROW(
@@ -451,6 +483,156 @@ TEST_F(SortBufferTest, spill) {
   }
 }
 
+TEST_F(SortBufferTest, spillFormat) {
+  const std::shared_ptr<memory::MemoryPool> fuzzerPool =
+      memory::memoryManager()->addLeafPool("spillFormat");
+  VectorFuzzer fuzzer(
+      {.vectorSize = 1024, .nullRatio = 0.1, .stringVariableLength = true},
+      fuzzerPool.get());
+  std::vector<RowVectorPtr> inputVectors;
+  for (int i = 0; i < 4; ++i) {
+    inputVectors.push_back(fuzzer.fuzzRow(inputType_));
+  }
+
+  // Returns the sorted output batches with every input batch spilled in
+  // 'format'.
+  auto sortWithSpill = [&](const std::string& format) {
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    const common::SpillConfig spillConfig(
+        [&]() -> const std::string& { return spillDirectory->path; },
+        [&](uint64_t) {},
+        "0.0.0",
+        0,
+        0,
+        0,
+        executor_.get(),
+        5,
+        10,
+        0,
+        0,
+        0,
+        0,
+        0,
+        100, //  testSpillPct
+        "none",
+        "",
+        0,
+        format);
+    auto sortBuffer = std::make_unique<SortBuffer>(
+        inputType_,
+        sortColumnIndices_,
+        sortCompareFlags_,
+        pool_.get(),
+        &nonReclaimableSection_,
+        &spillConfig,
+        0);
+    for (const auto& input : inputVectors) {
+      sortBuffer->addInput(input);
+    }
+    sortBuffer->noMoreInput();
+    const auto spillStats = sortBuffer->spilledStats();
+    EXPECT_TRUE(spillStats.has_value());
+    EXPECT_EQ(spillStats->spilledRows, 4 * 1024);
+    return readOutput(*sortBuffer, 1000);
+  };
+
+  assertEqualOutputs(sortWithSpill("columnar"), sortWithSpill("row_container"));
+  VELOX_ASSERT_THROW(
+      common::stringToSpillFormat("unknown"), "Unsupported spill format");
+}
+
+TEST_F(SortBufferTest, inputAfterSpill) {
+  const std::shared_ptr<memory::MemoryPool> fuzzerPool =
+      memory::memoryManager()->addLeafPool("inputAfterSpill");
+  VectorFuzzer fuzzer({.vectorSize = 1024}, fuzzerPool.get());
+  std::vector<RowVectorPtr> inputVectors;
+  for (int i = 0; i < 3; ++i) {
+    inputVectors.push_back(fuzzer.fuzzRow(inputType_));
+  }
+
+  auto sort = [&](const common::SpillConfig* spillConfig) {
+    auto sortBuffer = std::make_unique<SortBuffer>(
+        inputType_,
+        sortColumnIndices_,
+        sortCompareFlags_,
+        pool_.get(),
+        &nonReclaimableSection_,
+        spillConfig,
+        0);
+    sortBuffer->addInput(inputVectors[0]);
+    if (spillConfig != nullptr) {
+      sortBuffer->spill();
+    }
+    // The rows added after the spill are spilled by noMoreInput().
+    sortBuffer->addInput(inputVectors[1]);
+    sortBuffer->addInput(inputVectors[2]);
+    sortBuffer->noMoreInput();
+    if (spillConfig != nullptr) {
+      EXPECT_EQ(sortBuffer->spilledStats()->spilledRows, 3 * 1024);
+      EXPECT_EQ(sortBuffer->spilledStats()->spilledFiles, 2);
+    }
+    return readOutput(*sortBuffer, 1000);
+  };
+
+  const auto expectedOutputs = sort(nullptr);
+  for (const auto& format : {"columnar", "row_container"}) {
+    SCOPED_TRACE(format);
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    const auto spillConfig = getSpillConfig(spillDirectory->path, format);
+    assertEqualOutputs(expectedOutputs, sort(&spillConfig));
+  }
+}
+
+TEST_F(SortBufferTest, outputSpill) {
+  const std::shared_ptr<memory::MemoryPool> fuzzerPool =
+      memory::memoryManager()->addLeafPool("outputSpill");
+  VectorFuzzer fuzzer(
+      {.vectorSize = 1024, .nullRatio = 0.1, .stringVariableLength = true},
+      fuzzerPool.get());
+  std::vector<RowVectorPtr> inputVectors;
+  for (int i = 0; i < 3; ++i) {
+    inputVectors.push_back(fuzzer.fuzzRow(inputType_));
+  }
+
+  // Spills the rows that are not yet output after the first output batch if
+  // 'spillConfig' is set.
+  auto sort = [&](const common::SpillConfig* spillConfig) {
+    auto sortBuffer = std::make_unique<SortBuffer>(
+        inputType_,
+        sortColumnIndices_,
+        sortCompareFlags_,
+        pool_.get(),
+        &nonReclaimableSection_,
+        spillConfig,
+        0);
+    for (const auto& input : inputVectors) {
+      sortBuffer->addInput(input);
+    }
+    sortBuffer->noMoreInput();
+    EXPECT_FALSE(sortBuffer->spilledStats().has_value());
+    auto outputs = readOutput(*sortBuffer, 1000, [&]() {
+      if (spillConfig != nullptr) {
+        sortBuffer->spill();
+        EXPECT_EQ(sortBuffer->spilledStats()->spilledRows, 3 * 1024 - 1000);
+        // Spilling again while the spilled rows are output is a no-op.
+        sortBuffer->spill();
+      }
+    });
+    if (spillConfig != nullptr) {
+      EXPECT_EQ(sortBuffer->spilledStats()->spilledRows, 3 * 1024 - 1000);
+    }
+    return outputs;
+  };
+
+  const auto expectedOutputs = sort(nullptr);
+  for (const auto& format : {"columnar", "row_container"}) {
+    SCOPED_TRACE(format);
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    const auto spillConfig = getSpillConfig(spillDirectory->path, format);
+    assertEqualOutputs(expectedOutputs, sort(&spillConfig));
+  }
+}
+
 TEST_F(SortBufferTest, emptySpill) {
   const std::shared_ptr<memory::MemoryPool> fuzzerPool =
       memory::memoryManager()->addLeafPool("emptySpillSource");
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <memory>
@@ -493,6 +494,101 @@ TEST_P(SpillTest, spillTimestamp) {
   ASSERT_EQ(nullptr, merge->next());
 }
 
+TEST_P(SpillTest, spillReadAhead) {
+  // Spills each partition into one file which is several times larger than
+  // the read buffer.
+  const int numBatches = 8;
+  const int numRowsPerBatch = 200'000;
+  setupSpillState(kGB, 0, 2, numBatches, numRowsPerBatch);
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  std::vector<SpillFiles> spillFilesByPartition;
+  for (auto partition = 0; partition < state_->maxPartitions(); ++partition) {
+    spillFilesByPartition.push_back(state_->finish(partition));
+  }
+
+  for (const auto numReadAheadBuffers : {0, 1, 3}) {
+    SCOPED_TRACE(fmt::format("numReadAheadBuffers: {}", numReadAheadBuffers));
+    const common::SpillConfig spillConfig(
+        [&]() -> const std::string& { return tempDir_->path; },
+        updateSpilledBytesCb_,
+        "test",
+        0,
+        0,
+        0,
+        executor.get(),
+        0,
+        0,
+        0,
+        0,
+        0,
+        0,
+        0,
+        0,
+        "none",
+        "",
+        numReadAheadBuffers);
+    runtimeStats_.clear();
+    const auto prevGStats = common::globalSpillStats();
+    uint64_t totalFileBytes{0};
+    for (auto partition = 0; partition < spillFilesByPartition.size();
+         ++partition) {
+      SpillPartition spillPartition(
+          SpillPartitionId{0, partition}, spillFilesByPartition[partition]);
+      for (const auto& fileInfo : spillPartition.files()) {
+        totalFileBytes += fileInfo.size;
+      }
+      auto merge = spillPartition.createOrderedReader(pool(), &spillConfig);
+      for (auto i = 0; i < numBatches * numRowsPerBatch; ++i) {
+        auto* stream = merge->next();
+        ASSERT_NE(nullptr, stream);
+        if (values_[i].has_value()) {
+          ASSERT_EQ(
+              values_[i].value(),
+              stream->decoded(0).valueAt<int64_t>(stream->currentIndex()))
+              << i;
+        } else {
+          ASSERT_TRUE(stream->decoded(0).isNullAt(stream->currentIndex())) << i;
+        }
+        stream->pop();
+      }
+      ASSERT_EQ(nullptr, merge->next());
+    }
+    const auto newGStats = common::globalSpillStats();
+    ASSERT_EQ(
+        newGStats.spillReadBytes - prevGStats.spillReadBytes, totalFileBytes);
+    ASSERT_GE(newGStats.spillReadWaitTimeUs, prevGStats.spillReadWaitTimeUs);
+    ASSERT_GT(runtimeStats_["spillReadWaitTime"].count, 0);
+  }
+
+  // Destroys the readers with read-ahead in flight.
+  const common::SpillConfig spillConfig(
+      [&]() -> const std::string& { return tempDir_->path; },
+      updateSpilledBytesCb_,
+      "test",
+      0,
+      0,
+      0,
+      executor.get(),
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      "none",
+      "",
+      2);
+  SpillPartition spillPartition(
+      SpillPartitionId{0, 0}, spillFilesByPartition[0]);
+  auto reader = spillPartition.createUnorderedReader(pool(), &spillConfig);
+  RowVectorPtr batch;
+  ASSERT_TRUE(reader->nextBatch(batch));
+  reader.reset();
+  executor->join();
+}
+
 TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   // Set the target file size to a small value to open a new file on each batch
   // write.
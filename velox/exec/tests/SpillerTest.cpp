@@ -73,6 +73,12 @@ struct TestParamsBuilder {
     const auto numSpillerTypes = static_cast<int8_t>(Spiller::Type::kNumTypes);
     for (int i = 0; i < numSpillerTypes; ++i) {
       const auto type = static_cast<Spiller::Type>(i);
+      // The operator specific vector spillers are covered by the operator
+      // tests.
+      if (type == Spiller::Type::kNestedLoopJoinBuild ||
+          type == Spiller::Type::kMergeJoin) {
+        continue;
+      }
       if (typesToExclude.find(type) == typesToExclude.end()) {
         common::CompressionKind compressionKind =
             static_cast<common::CompressionKind>(numSpillerTypes % 6);
@@ -471,7 +477,9 @@ class SpillerTest : public exec::test::RowContainerTestBase {
       uint64_t targetFileSize,
       uint64_t writeBufferSize,
       bool makeError,
-      uint64_t maxSpillRunRows = 0) {
+      uint64_t maxSpillRunRows = 0,
+      std::optional<common::PrefixSortConfig> prefixSortConfig =
+          std::nullopt) {
     static const std::string kBadSpillDirPath = "/bad/path";
     common::GetSpillDirectoryPathCB badSpillDirCb =
         [&]() -> const std::string& { return kBadSpillDirPath; };
@@ -488,6 +496,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
     spillConfig.compressionKind = compressionKind_;
     spillConfig.maxSpillRunRows = maxSpillRunRows;
     spillConfig.fileCreateConfig = {};
+    spillConfig.prefixSortConfig = prefixSortConfig;
 
     if (type_ == Spiller::Type::kHashJoinProbe) {
       // kHashJoinProbe doesn't have associated row container.
@@ -1132,6 +1141,21 @@ TEST_P(NoHashJoin, error) {
   testSortedSpill(100, 1, false, true);
 }
 
+TEST_P(NoHashJoin, prefixSortReservation) {
+  setupSpillData(rowType_, numKeys_, 5'000, 1, [&](RowVectorPtr rows) {
+    setSequentialValue(rows, 5);
+  });
+  sortSpillData();
+  const auto prevReservedBytes = memory::spillMemoryPool()->reservedBytes();
+  setupSpiller(2'000'000, 0, false, 0, common::PrefixSortConfig(128, 0));
+  runSpill(false);
+  // The memory reserved for the prefix sort keys is released after each sort.
+  ASSERT_EQ(memory::spillMemoryPool()->reservedBytes(), prevReservedBytes);
+  auto spillPartition = spiller_->finishSpill();
+  verifySortedSpillData(&spillPartition);
+  ASSERT_EQ(memory::spillMemoryPool()->reservedBytes(), prevReservedBytes);
+}
+
 class HashJoinBuildOnly : public SpillerTest,
                           public testing::WithParamInterface<TestParam> {
  public:
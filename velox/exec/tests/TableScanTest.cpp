@@ -3102,6 +3102,31 @@ TEST_F(TableScanTest, parallelPrepare) {
       .copyResults(pool_.get());
 }
 
+TEST_F(TableScanTest, dynamicDrivers) {
+  constexpr int32_t kNumFiles = 20;
+  auto vectors = makeVectors(kNumFiles, 1'000);
+  auto filePaths = makeFilePaths(kNumFiles);
+  for (auto i = 0; i < kNumFiles; ++i) {
+    writeToFile(filePaths[i]->path, {vectors[i]});
+  }
+  createDuckDbTable(vectors);
+
+  // Parked drivers must resume and finish once the splits are exhausted.
+  for (const auto& maxActive : {"0", "1", "3"}) {
+    SCOPED_TRACE(fmt::format("maxActive: {}", maxActive));
+    auto task =
+        AssertQueryBuilder(tableScanNode(), duckDbQueryRunner_)
+            .config(core::QueryConfig::kDynamicDriversEnabled, "true")
+            .config(core::QueryConfig::kDynamicDriversMaxActive, maxActive)
+            .maxDrivers(4)
+            .splits(makeHiveConnectorSplits(filePaths))
+            .assertResults("SELECT * FROM tmp");
+    const auto taskStats = task->taskStats();
+    EXPECT_EQ(taskStats.numTotalDrivers, 4);
+    EXPECT_EQ(taskStats.numCompletedDrivers, 4);
+  }
+}
+
 TEST_F(TableScanTest, dictionaryMemo) {
   constexpr int kSize = 100;
   const char* baseStrings[] = {
@@ -14,13 +14,16 @@
  * limitations under the License.
  */
 #include "velox/common/base/tests/GTestUtils.h"
-#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec::test;
 
-class TopNTest : public OperatorTestBase {
+class TopNTest : public HiveConnectorTestBase {
  protected:
   static std::vector<std::string> getSortOrderSqls() {
     return {"NULLS LAST", "NULLS FIRST", "DESC NULLS FIRST", "DESC NULLS LAST"};
@@ -305,3 +308,151 @@ TEST_F(TopNTest, planNodeValidation) {
       plan({"a", "b", "a"}),
       "TopN must specify unique sorting keys. Found duplicate key: a");
 }
+
+TEST_F(TopNTest, thresholdFilter) {
+  vector_size_t batchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    auto c0 = makeFlatVector<int64_t>(
+        batchSize,
+        [&](auto row) { return batchSize * i + row; },
+        nullEvery(1'001));
+    auto c1 = makeFlatVector<int32_t>(
+        batchSize, [&](auto row) { return batchSize * i - row; });
+    auto c2 = makeFlatVector<int16_t>(batchSize, [](auto row) {
+      return row % 1'000;
+    });
+    auto c3 = makeFlatVector<StringView>(batchSize, [](auto row) {
+      return StringView::makeInline(std::to_string(row));
+    });
+    vectors.push_back(makeRowVector({c0, c1, c2, c3}));
+  }
+  createDuckDbTable(vectors);
+
+  testSingleKey(vectors, "c0", 10);
+  testSingleKey(vectors, "c1", 10);
+  testTwoKeys(vectors, "c2", "c0", 100);
+
+  // The rows of all but the first batch are discarded by the filter on the
+  // 10th smallest value of the first batch.
+  core::PlanNodeId topNId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .topN({"c0 NULLS LAST"}, 10, false)
+                  .capturePlanNodeId(topNId)
+                  .planNode();
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .assertResults(
+                      "SELECT * FROM tmp ORDER BY c0 NULLS LAST LIMIT 10");
+  auto stats = exec::toPlanStats(task->taskStats());
+  ASSERT_EQ(
+      stats.at(topNId).customStats.at("thresholdFilteredRows").sum,
+      4 * batchSize);
+
+  // The filter can't be pushed down to the Values operator.
+  ASSERT_EQ(stats.at(topNId).customStats.count("dynamicFiltersProduced"), 0);
+}
+
+TEST_F(TopNTest, dynamicFilter) {
+  vector_size_t batchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    auto c0 = makeFlatVector<int64_t>(
+        batchSize,
+        [&](auto row) { return batchSize * i + row; },
+        nullEvery(1'001));
+    auto c1 = makeFlatVector<double>(
+        batchSize, [](auto row) { return row * 0.1; });
+    vectors.push_back(makeRowVector({c0, c1}));
+  }
+  createDuckDbTable(vectors);
+
+  auto filePaths = makeFilePaths(vectors.size());
+  for (auto i = 0; i < vectors.size(); ++i) {
+    writeToFile(filePaths[i]->path, vectors[i]);
+  }
+
+  for (const auto& sortOrderSql : getSortOrderSqls()) {
+    SCOPED_TRACE(sortOrderSql);
+    const auto sql = fmt::format("c0 {}", sortOrderSql);
+    const bool nullsFirst = sortOrderSql.find("FIRST") != std::string::npos;
+
+    core::PlanNodeId scanId;
+    auto plan = PlanBuilder()
+                    .tableScan(asRowType(vectors[0]->type()))
+                    .capturePlanNodeId(scanId)
+                    .topN({sql}, 10, false)
+                    .planNode();
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .splits(makeHiveConnectorSplits(filePaths))
+            .assertResults(
+                fmt::format("SELECT * FROM tmp ORDER BY {} LIMIT 10", sql));
+
+    // The threshold is pushed down to the table scan only if nulls sort last.
+    auto stats = exec::toPlanStats(task->taskStats());
+    const auto& scanStats = stats.at(scanId).customStats;
+    if (nullsFirst) {
+      ASSERT_EQ(scanStats.count("dynamicFiltersAccepted"), 0);
+    } else {
+      ASSERT_GT(scanStats.at("dynamicFiltersAccepted").sum, 0);
+    }
+
+    // No pushdown if disabled.
+    task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+               .config(core::QueryConfig::kTopNDynamicFilterEnabled, "false")
+               .splits(makeHiveConnectorSplits(filePaths))
+               .assertResults(
+                   fmt::format("SELECT * FROM tmp ORDER BY {} LIMIT 10", sql));
+    stats = exec::toPlanStats(task->taskStats());
+    ASSERT_EQ(stats.at(scanId).customStats.count("dynamicFiltersAccepted"), 0);
+  }
+}
+
+TEST_F(TopNTest, spill) {
+  vector_size_t batchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    auto c0 = makeFlatVector<int64_t>(
+        batchSize,
+        [&](auto row) { return (batchSize * (4 - i) + row) * 7 % 5'000; });
+    auto c1 = makeFlatVector<double>(
+        batchSize, [](auto row) { return row * 0.1; });
+    auto c2 = makeFlatVector<StringView>(batchSize, [](auto row) {
+      return StringView::makeInline(std::to_string(row));
+    });
+    vectors.push_back(makeRowVector({c0, c1, c2}));
+  }
+  createDuckDbTable(vectors);
+
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  for (const auto limit : {1, 10, 1'500, 10'000}) {
+    for (const auto& sortOrderSql : getSortOrderSqls()) {
+      SCOPED_TRACE(fmt::format("limit {} {}", limit, sortOrderSql));
+      const auto sql = fmt::format("c0 {}", sortOrderSql);
+
+      core::PlanNodeId topNId;
+      auto plan = PlanBuilder()
+                      .values(vectors)
+                      .topN({sql}, limit, false)
+                      .capturePlanNodeId(topNId)
+                      .planNode();
+      auto task =
+          AssertQueryBuilder(plan, duckDbQueryRunner_)
+              .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+              .config(core::QueryConfig::kTestingSpillPct, "100")
+              .config(core::QueryConfig::kSpillEnabled, "true")
+              .config(core::QueryConfig::kTopNSpillEnabled, "true")
+              .spillDirectory(spillDirectory->path)
+              .assertResults(fmt::format(
+                  "SELECT * FROM tmp ORDER BY {} LIMIT {}", sql, limit));
+
+      auto taskStats = exec::toPlanStats(task->taskStats());
+      const auto& stats = taskStats.at(topNId);
+      ASSERT_GT(stats.spilledBytes, 0);
+      ASSERT_GT(stats.spilledRows, 0);
+      ASSERT_GT(stats.spilledFiles, 0);
+      ASSERT_GT(stats.spilledPartitions, 0);
+    }
+  }
+}
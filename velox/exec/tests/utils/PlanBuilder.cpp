@@ -1146,7 +1146,8 @@ PlanBuilder& PlanBuilder::partitionedOutput(
     int numPartitions,
     bool replicateNullsAndAny,
     core::PartitionFunctionSpecPtr partitionFunctionSpec,
-    const std::vector<std::string>& outputLayout) {
+    const std::vector<std::string>& outputLayout,
+    bool requireColocatedKeys) {
   VELOX_CHECK_NOT_NULL(
       planNode_, "PartitionedOutput cannot be the source node");
   auto outputType = outputLayout.empty()
@@ -1160,7 +1161,8 @@ PlanBuilder& PlanBuilder::partitionedOutput(
       replicateNullsAndAny,
       std::move(partitionFunctionSpec),
       outputType,
-      planNode_);
+      planNode_,
+      requireColocatedKeys);
   return *this;
 }
 
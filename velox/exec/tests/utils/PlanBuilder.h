@@ -747,12 +747,15 @@ class PlanBuilder {
       const std::vector<std::string>& outputLayout = {});
 
   /// Same as above, but allows to provide custom partition function.
+  /// 'requireColocatedKeys' must be false for a partition function that may
+  /// assign the rows of a key to different partitions.
   PlanBuilder& partitionedOutput(
       const std::vector<std::string>& keys,
       int numPartitions,
       bool replicateNullsAndAny,
       core::PartitionFunctionSpecPtr partitionFunctionSpec,
-      const std::vector<std::string>& outputLayout = {});
+      const std::vector<std::string>& outputLayout = {},
+      bool requireColocatedKeys = true);
 
   /// Adds a PartitionedOutputNode to broadcast the input data.
   ///
@@ -62,6 +62,8 @@ DEFINE_bool(avx2, true, "Enables use of AVX2 when available");
 
 DEFINE_bool(bmi2, true, "Enables use of BMI2 when available");
 
+DEFINE_bool(avx512, false, "Enables use of AVX-512 when available");
+
 // Used in exec/Expr.cpp
 
 DEFINE_string(
@@ -477,6 +477,199 @@ int32_t CompactRow::serializeVariableWidth(vector_size_t index, char* buffer) {
   };
 }
 
+void CompactRow::rowSizes(
+    vector_size_t offset,
+    vector_size_t size,
+    int32_t* sizes) {
+  int32_t fixedSize = rowNullBytes_;
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      fixedSize += children_[i].valueBytes_;
+    }
+  }
+  std::fill(sizes, sizes + size, fixedSize);
+
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      continue;
+    }
+
+    auto& child = children_[i];
+    const bool isString = child.typeKind_ == TypeKind::VARCHAR ||
+        child.typeKind_ == TypeKind::VARBINARY;
+    for (auto row = 0; row < size; ++row) {
+      const auto childIndex = decoded_.index(offset + row);
+      if (child.isNullAt(childIndex)) {
+        continue;
+      }
+      if (isString) {
+        sizes[row] += kSizeBytes +
+            child.decoded_.valueAt<StringView>(childIndex).size();
+      } else {
+        sizes[row] += child.variableWidthRowSize(childIndex);
+      }
+    }
+  }
+}
+
+void CompactRow::serialize(
+    vector_size_t offset,
+    vector_size_t size,
+    const size_t* bufferOffsets,
+    char* buffer) {
+  std::vector<vector_size_t> childIndices(size);
+  for (auto row = 0; row < size; ++row) {
+    childIndices[row] = decoded_.index(offset + row);
+  }
+
+  // The next value of row 'i' is written at 'rowOffsets[i] + columnOffset'.
+  // 'columnOffset' covers the fixed-width values written after the last
+  // variable-width value, which are at the same offset in all rows.
+  std::vector<size_t> rowOffsets(bufferOffsets, bufferOffsets + size);
+  int32_t columnOffset = rowNullBytes_;
+
+  for (auto i = 0; i < children_.size(); ++i) {
+    auto& child = children_[i];
+    if (child.decoded_.mayHaveNulls()) {
+      for (auto row = 0; row < size; ++row) {
+        if (child.isNullAt(childIndices[row])) {
+          bits::setBit(
+              reinterpret_cast<uint8_t*>(buffer + bufferOffsets[row]),
+              i,
+              true);
+        }
+      }
+    }
+
+    if (childIsFixedWidth_[i]) {
+      if (child.valueBytes_ > 0) {
+        child.serializeFixedWidth(
+            childIndices.data(), size, rowOffsets.data(), columnOffset, buffer);
+      }
+      columnOffset += child.valueBytes_;
+    } else {
+      child.serializeVariableWidth(
+          childIndices.data(), size, rowOffsets.data(), columnOffset, buffer);
+      columnOffset = 0;
+    }
+  }
+}
+
+namespace {
+
+// Copies 'kValueBytes'-wide values at 'indices' of 'decoded' into 'buffer' at
+// 'rowOffsets[i] + columnOffset'. Skips null values.
+template <int32_t kValueBytes>
+void scatterFixedWidth(
+    const DecodedVector& decoded,
+    const vector_size_t* indices,
+    vector_size_t size,
+    const size_t* rowOffsets,
+    int32_t columnOffset,
+    char* buffer) {
+  const auto* values = decoded.data<char>();
+  // 'values' can be null if all values are null.
+  if (values == nullptr) {
+    return;
+  }
+
+  if (!decoded.mayHaveNulls() && decoded.isIdentityMapping()) {
+    for (auto row = 0; row < size; ++row) {
+      memcpy(
+          buffer + rowOffsets[row] + columnOffset,
+          values + indices[row] * kValueBytes,
+          kValueBytes);
+    }
+    return;
+  }
+
+  for (auto row = 0; row < size; ++row) {
+    if (decoded.isNullAt(indices[row])) {
+      continue;
+    }
+    memcpy(
+        buffer + rowOffsets[row] + columnOffset,
+        values + decoded.index(indices[row]) * kValueBytes,
+        kValueBytes);
+  }
+}
+} // namespace
+
+void CompactRow::serializeFixedWidth(
+    const vector_size_t* indices,
+    vector_size_t size,
+    const size_t* rowOffsets,
+    int32_t columnOffset,
+    char* buffer) {
+  VELOX_DCHECK(fixedWidthTypeKind_);
+  switch (typeKind_) {
+    case TypeKind::BOOLEAN:
+      [[fallthrough]];
+    case TypeKind::TIMESTAMP:
+      for (auto row = 0; row < size; ++row) {
+        if (!isNullAt(indices[row])) {
+          serializeFixedWidth(
+              indices[row], buffer + rowOffsets[row] + columnOffset);
+        }
+      }
+      break;
+    default:
+      switch (valueBytes_) {
+        case 1:
+          scatterFixedWidth<1>(
+              decoded_, indices, size, rowOffsets, columnOffset, buffer);
+          break;
+        case 2:
+          scatterFixedWidth<2>(
+              decoded_, indices, size, rowOffsets, columnOffset, buffer);
+          break;
+        case 4:
+          scatterFixedWidth<4>(
+              decoded_, indices, size, rowOffsets, columnOffset, buffer);
+          break;
+        case 8:
+          scatterFixedWidth<8>(
+              decoded_, indices, size, rowOffsets, columnOffset, buffer);
+          break;
+        case 16:
+          scatterFixedWidth<16>(
+              decoded_, indices, size, rowOffsets, columnOffset, buffer);
+          break;
+        default:
+          VELOX_UNREACHABLE("Unexpected value size: {}", valueBytes_);
+      }
+  }
+}
+
+void CompactRow::serializeVariableWidth(
+    const vector_size_t* indices,
+    vector_size_t size,
+    size_t* rowOffsets,
+    int32_t columnOffset,
+    char* buffer) {
+  const bool isString =
+      typeKind_ == TypeKind::VARCHAR || typeKind_ == TypeKind::VARBINARY;
+  for (auto row = 0; row < size; ++row) {
+    rowOffsets[row] += columnOffset;
+    const auto index = indices[row];
+    if (isNullAt(index)) {
+      continue;
+    }
+
+    auto* rowBuffer = buffer + rowOffsets[row];
+    if (isString) {
+      auto value = decoded_.valueAt<StringView>(index);
+      writeInt32(rowBuffer, value.size());
+      if (!value.empty()) {
+        memcpy(rowBuffer + kSizeBytes, value.data(), value.size());
+      }
+      rowOffsets[row] += kSizeBytes + value.size();
+    } else {
+      rowOffsets[row] += serializeVariableWidth(index, rowBuffer);
+    }
+  }
+}
+
 namespace {
 
 // Reads single fixed-width value from buffer into flatVector[index].
@@ -36,6 +36,21 @@ class CompactRow {
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer);
 
+  /// Computes serialized sizes of 'size' rows starting at 'offset' and writes
+  /// them into 'sizes'. Processes one column at a time. Returns the same sizes
+  /// as calling 'rowSize' for each row.
+  void rowSizes(vector_size_t offset, vector_size_t size, int32_t* sizes);
+
+  /// Serializes 'size' rows starting at 'offset' one column at a time. Row
+  /// 'offset + i' is written at 'buffer + bufferOffsets[i]'. 'buffer' must
+  /// have sufficient capacity for the sizes returned by 'rowSizes' and set to
+  /// all zeros. Produces the same bytes as calling 'serialize' for each row.
+  void serialize(
+      vector_size_t offset,
+      vector_size_t size,
+      const size_t* bufferOffsets,
+      char* buffer);
+
   /// Deserializes multiple rows into a RowVector of specified type. The type
   /// must match the contents of the serialized rows.
   static RowVectorPtr deserialize(
@@ -64,6 +79,25 @@ class CompactRow {
   void
   serializeFixedWidth(vector_size_t offset, vector_size_t size, char* buffer);
 
+  /// Writes fixed-width values at 'indices' into 'buffer' at 'rowOffsets[i] +
+  /// columnOffset' for the i-th index. Skips null values.
+  void serializeFixedWidth(
+      const vector_size_t* indices,
+      vector_size_t size,
+      const size_t* rowOffsets,
+      int32_t columnOffset,
+      char* buffer);
+
+  /// Writes variable-width values at 'indices' into 'buffer' at 'rowOffsets[i]
+  /// + columnOffset' for the i-th index. Advances 'rowOffsets[i]' by
+  /// 'columnOffset' plus the size of the written value. Skips null values.
+  void serializeVariableWidth(
+      const vector_size_t* indices,
+      vector_size_t size,
+      size_t* rowOffsets,
+      int32_t columnOffset,
+      char* buffer);
+
   /// Returns serialized size of variable-width row.
   int32_t variableWidthRowSize(vector_size_t index);
 
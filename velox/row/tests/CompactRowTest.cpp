@@ -78,6 +78,40 @@ class CompactRowTest : public ::testing::Test, public VectorTestBase {
 
     auto copy = CompactRow::deserialize(serialized, rowType, pool());
     assertEqualVectors(data, copy);
+
+    testBatchSerialize(row, numRows, serialized);
+  }
+
+  // Verifies that serializing rows in batches produces the same sizes and
+  // bytes as serializing one row at a time.
+  void testBatchSerialize(
+      CompactRow& row,
+      vector_size_t numRows,
+      const std::vector<std::string_view>& expected) {
+    // Serialize the second half first to exercise a non-zero start offset.
+    const vector_size_t half = numRows / 2;
+    std::vector<int32_t> sizes(numRows);
+    row.rowSizes(half, numRows - half, sizes.data() + half);
+    row.rowSizes(0, half, sizes.data());
+
+    std::vector<size_t> offsets(numRows);
+    size_t totalSize = 0;
+    for (auto i = 0; i < numRows; ++i) {
+      ASSERT_EQ(sizes[i], expected[i].size()) << "Row " << i;
+      offsets[i] = totalSize;
+      totalSize += sizes[i];
+    }
+
+    BufferPtr buffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    auto* rawBuffer = buffer->asMutable<char>();
+    row.serialize(half, numRows - half, offsets.data() + half, rawBuffer);
+    row.serialize(0, half, offsets.data(), rawBuffer);
+
+    for (auto i = 0; i < numRows; ++i) {
+      ASSERT_EQ(
+          std::string_view(rawBuffer + offsets[i], sizes[i]), expected[i])
+          << "Row " << i;
+    }
   }
 };
 
@@ -3021,9 +3021,14 @@ class PrestoVectorSerializer : public VectorSerializer {
       int32_t numRows,
       StreamArena* streamArena,
       bool useLosslessTimestamp,
-      common::CompressionKind compressionKind)
+      common::CompressionKind compressionKind,
+      float minCompressionRatio,
+      bool preserveEncodings)
       : streamArena_(streamArena),
-        codec_(common::compressionKindToCodec(compressionKind)) {
+        codec_(common::compressionKindToCodec(compressionKind)),
+        useLosslessTimestamp_(useLosslessTimestamp),
+        minCompressionRatio_(minCompressionRatio),
+        preserveEncodings_(preserveEncodings && encodings.empty()) {
     auto types = rowType->children();
     auto numTypes = types.size();
     streams_.resize(numTypes);
@@ -3043,6 +3048,12 @@ class PrestoVectorSerializer : public VectorSerializer {
       Scratch& scratch) override {
     auto newRows = rangesTotalSize(ranges);
     if (newRows > 0) {
+      if (numRows_ == 0 && preserveEncodings_ &&
+          appendFirstEncoded(vector, ranges, newRows)) {
+        numRows_ += newRows;
+        return;
+      }
+      flattenFirstEncoded();
       numRows_ += newRows;
       for (int32_t i = 0; i < vector->childrenSize(); ++i) {
         serializeColumn(vector->childAt(i).get(), ranges, streams_[i].get());
@@ -3056,6 +3067,18 @@ class PrestoVectorSerializer : public VectorSerializer {
       Scratch& scratch) override {
     auto newRows = rows.size();
     if (newRows > 0) {
+      if (numRows_ == 0 && preserveEncodings_) {
+        std::vector<IndexRange> ranges;
+        ranges.reserve(newRows);
+        for (auto row : rows) {
+          ranges.push_back({row, 1});
+        }
+        if (appendFirstEncoded(vector, ranges, newRows)) {
+          numRows_ += newRows;
+          return;
+        }
+      }
+      flattenFirstEncoded();
       numRows_ += newRows;
       for (int32_t i = 0; i < vector->childrenSize(); ++i) {
         serializeColumn(
@@ -3079,7 +3102,7 @@ class PrestoVectorSerializer : public VectorSerializer {
 
   size_t maxSerializedSize() const override {
     size_t dataSize = 4; // streams_.size()
-    for (auto& stream : streams_) {
+    for (auto& stream : outputStreams()) {
       dataSize += stream->serializedSize();
     }
 
@@ -3106,6 +3129,91 @@ class PrestoVectorSerializer : public VectorSerializer {
   }
 
  private:
+  // Returns the encoding to keep for 'vector' appended as the first data of
+  // the serializer with 'numRows' rows, or std::nullopt to flatten it.
+  static std::optional<VectorEncoding::Simple> encodingToPreserve(
+      const BaseVector& vector,
+      vector_size_t numRows) {
+    if (!vector.type()->isPrimitiveType()) {
+      return std::nullopt;
+    }
+    switch (vector.encoding()) {
+      case VectorEncoding::Simple::CONSTANT:
+        return VectorEncoding::Simple::CONSTANT;
+      case VectorEncoding::Simple::DICTIONARY:
+        // The whole base vector is serialized with the indices.
+        if (vector.nulls() == nullptr &&
+            vector.valueVector()->size() <= numRows) {
+          return VectorEncoding::Simple::DICTIONARY;
+        }
+        return std::nullopt;
+      default:
+        return std::nullopt;
+    }
+  }
+
+  // Serializes the first appended data into 'encodedStreams_' while keeping
+  // the constant and dictionary encodings of the columns. Keeps a reference
+  // to 'vector' to flatten the data if more is appended. Returns false if no
+  // column keeps its encoding.
+  bool appendFirstEncoded(
+      const RowVectorPtr& vector,
+      const folly::Range<const IndexRange*>& ranges,
+      vector_size_t numRows) {
+    VELOX_CHECK(encodedStreams_.empty());
+    std::vector<std::optional<VectorEncoding::Simple>> encodings;
+    encodings.reserve(vector->childrenSize());
+    bool anyEncoded = false;
+    for (const auto& child : vector->children()) {
+      encodings.push_back(encodingToPreserve(*child, numRows));
+      anyEncoded |= encodings.back().has_value();
+    }
+    if (!anyEncoded) {
+      return false;
+    }
+
+    encodedStreams_.resize(encodings.size());
+    for (auto i = 0; i < encodings.size(); ++i) {
+      const auto* child = vector->childAt(i).get();
+      encodedStreams_[i] = std::make_unique<VectorStream>(
+          child->type(),
+          encodings[i],
+          streamArena_,
+          numRows,
+          useLosslessTimestamp_);
+      if (encodings[i].has_value()) {
+        serializeEncodedColumn(child, ranges, encodedStreams_[i].get());
+      } else {
+        serializeColumn(child, ranges, encodedStreams_[i].get());
+      }
+    }
+    firstVector_ = vector;
+    firstRanges_.assign(ranges.begin(), ranges.end());
+    return true;
+  }
+
+  // Serializes the data kept by appendFirstEncoded() into 'streams_' without
+  // encodings. No-op if there is no such data.
+  void flattenFirstEncoded() {
+    if (encodedStreams_.empty()) {
+      return;
+    }
+    const folly::Range<const IndexRange*> ranges(
+        firstRanges_.data(), firstRanges_.size());
+    for (int32_t i = 0; i < firstVector_->childrenSize(); ++i) {
+      serializeColumn(
+          firstVector_->childAt(i).get(), ranges, streams_[i].get());
+    }
+    encodedStreams_.clear();
+    firstVector_.reset();
+    firstRanges_.clear();
+  }
+
+  // Returns the streams holding the data to flush.
+  const std::vector<std::unique_ptr<VectorStream>>& outputStreams() const {
+    return encodedStreams_.empty() ? streams_ : encodedStreams_;
+  }
+
   void flushUncompressed(
       int32_t numRows,
       OutputStream* out,
@@ -3134,9 +3242,10 @@ class PrestoVectorSerializer : public VectorSerializer {
     if (listener) {
       listener->resume();
     }
-    writeInt32(out, streams_.size());
+    const auto& streams = outputStreams();
+    writeInt32(out, streams.size());
 
-    for (auto& stream : streams_) {
+    for (auto& stream : streams) {
       stream->flush(out);
     }
 
@@ -3164,25 +3273,12 @@ class PrestoVectorSerializer : public VectorSerializer {
       int32_t numRows,
       OutputStream* output,
       PrestoOutputStreamListener* listener) {
-    const int32_t offset = output->tellp();
-    char codec = kCompressedBitMask;
-    if (listener) {
-      codec |= kCheckSumBitMask;
-    }
-
-    // Pause CRC computation
-    if (listener) {
-      listener->pause();
-    }
-
-    writeInt32(output, numRows);
-    output->write(&codec, 1);
-
     IOBufOutputStream out(
         *(streamArena_->pool()), nullptr, streamArena_->size());
-    writeInt32(&out, streams_.size());
+    const auto& streams = outputStreams();
+    writeInt32(&out, streams.size());
 
-    for (auto& stream : streams_) {
+    for (auto& stream : streams) {
       stream->flush(&out);
     }
 
@@ -3193,6 +3289,26 @@ class PrestoVectorSerializer : public VectorSerializer {
         "UncompressedSize exceeds limit");
     auto compressed = codec_->compress(out.getIOBuf().get());
     const int32_t compressedSize = compressed->length();
+    if (minCompressionRatio_ > 0 &&
+        compressedSize > uncompressedSize * minCompressionRatio_) {
+      // Not worth decompressing on the reader side.
+      flushUncompressed(numRows, output, listener);
+      return;
+    }
+
+    const int32_t offset = output->tellp();
+    char codec = kCompressedBitMask;
+    if (listener) {
+      codec |= kCheckSumBitMask;
+    }
+
+    // Pause CRC computation
+    if (listener) {
+      listener->pause();
+    }
+
+    writeInt32(output, numRows);
+    output->write(&codec, 1);
     writeInt32(output, uncompressedSize);
     writeInt32(output, compressedSize);
     const int32_t crcOffset = output->tellp();
@@ -3239,8 +3355,20 @@ class PrestoVectorSerializer : public VectorSerializer {
 
   StreamArena* const streamArena_;
   const std::unique_ptr<folly::io::Codec> codec_;
+  const bool useLosslessTimestamp_;
+  const float minCompressionRatio_;
+  const bool preserveEncodings_;
   int32_t numRows_{0};
   std::vector<std::unique_ptr<VectorStream>> streams_;
+
+  // Streams with the encodings of the columns of the first appended data. Set
+  // only while 'numRows_' comes from a single append and 'preserveEncodings_'
+  // is true.
+  std::vector<std::unique_ptr<VectorStream>> encodedStreams_;
+
+  // The vector and ranges of the data in 'encodedStreams_'.
+  RowVectorPtr firstVector_;
+  std::vector<IndexRange> firstRanges_;
 };
 } // namespace
 
@@ -3272,7 +3400,9 @@ std::unique_ptr<VectorSerializer> PrestoVectorSerde::createSerializer(
       numRows,
       streamArena,
       prestoOptions.useLosslessTimestamp,
-      prestoOptions.compressionKind);
+      prestoOptions.compressionKind,
+      prestoOptions.minCompressionRatio,
+      prestoOptions.preserveEncodings);
 }
 
 void PrestoVectorSerde::serializeEncoded(
@@ -3330,16 +3460,16 @@ void PrestoVectorSerde::deserialize(
   VELOX_CHECK_EQ(
       checksum, actualCheckSum, "Received corrupted serialized page.");
 
-  VELOX_CHECK_EQ(
-      needCompression(*codec),
-      isCompressedBitSet(pageCodecMarker),
+  // A page may be written uncompressed if compression does not pay off.
+  VELOX_CHECK(
+      needCompression(*codec) || !isCompressedBitSet(pageCodecMarker),
       "Compression kind {} should align with codec marker.",
       common::compressionKindToString(
           common::codecTypeToCompressionKind(codec->type())));
 
   auto& children = (*result)->children();
   const auto& childTypes = type->asRow().children();
-  if (!needCompression(*codec)) {
+  if (!isCompressedBitSet(pageCodecMarker)) {
     const auto numColumns = source->read<int32_t>();
     // TODO Fix call sites and tighten the check to _EQ.
     VELOX_USER_CHECK_GE(
@@ -29,9 +29,13 @@ class PrestoVectorSerde : public VectorSerde {
 
     PrestoOptions(
         bool _useLosslessTimestamp,
-        common::CompressionKind _compressionKind)
+        common::CompressionKind _compressionKind,
+        float _minCompressionRatio = 0,
+        bool _preserveEncodings = false)
         : useLosslessTimestamp(_useLosslessTimestamp),
-          compressionKind(_compressionKind) {}
+          compressionKind(_compressionKind),
+          minCompressionRatio(_minCompressionRatio),
+          preserveEncodings(_preserveEncodings) {}
 
     // Currently presto only supports millisecond precision and the serializer
     // converts velox native timestamp to that resulting in loss of precision.
@@ -40,6 +44,23 @@ class PrestoVectorSerde : public VectorSerde {
     bool useLosslessTimestamp{false};
     common::CompressionKind compressionKind{
         common::CompressionKind::CompressionKind_NONE};
+
+    // If greater than zero, a page is written compressed only if its
+    // compressed size is below this fraction of its uncompressed size.
+    // Otherwise, the page is written uncompressed, which saves the
+    // decompression on the reader side. The deserializer reads both kinds of
+    // pages. Zero by default, i.e. all pages are compressed with
+    // 'compressionKind'.
+    float minCompressionRatio{0};
+
+    // If true and 'encodings' is empty, the top level constant and dictionary
+    // columns of the data added in the first append to a serializer are
+    // written as RLE and DICTIONARY columns instead of being flattened. A
+    // dictionary is kept only if its base vector has no more rows than the
+    // appended rows. The columns are flattened if more data is appended to
+    // the same serializer.
+    bool preserveEncodings{false};
+
     std::vector<VectorEncoding::Simple> encodings;
   };
 
@@ -305,6 +305,29 @@ class PrestoSerializerTest
     assertEqualVectors(expected, result);
   }
 
+  // Serializes the 'ranges' of each of 'vectors' into one page.
+  std::string serializeRanges(
+      const std::vector<RowVectorPtr>& vectors,
+      const std::vector<IndexRange>& ranges,
+      const serializer::presto::PrestoVectorSerde::PrestoOptions& options) {
+    StreamArena arena{pool_.get()};
+    auto serializer = serde_->createSerializer(
+        asRowType(vectors[0]->type()), vectors[0]->size(), &arena, &options);
+    Scratch scratch;
+    for (const auto& vector : vectors) {
+      serializer->append(
+          vector, folly::Range(ranges.data(), ranges.size()), scratch);
+    }
+
+    const auto maxSize = serializer->maxSerializedSize();
+    std::ostringstream output;
+    facebook::velox::serializer::presto::PrestoOutputStreamListener listener;
+    OStreamOutputStream out(&output, &listener);
+    serializer->flush(&out);
+    EXPECT_GE(maxSize, static_cast<size_t>(out.tellp()));
+    return output.str();
+  }
+
   std::unique_ptr<serializer::presto::PrestoVectorSerde> serde_;
 };
 
@@ -653,6 +676,101 @@ TEST_P(PrestoSerializerTest, typeMismatch) {
       "Expected LONG_ARRAY. Got VARIABLE_WIDTH.");
 }
 
+TEST_P(PrestoSerializerTest, preserveEncodings) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector({
+      makeConstant<int64_t>(11, size),
+      wrapInDictionary(
+          makeIndices(size, [](auto row) { return row % 10; }),
+          makeFlatVector<StringView>(
+              10,
+              [](auto row) {
+                return StringView(fmt::format("string value {}", row));
+              })),
+      // The base vector is larger than the serialized rows.
+      wrapInDictionary(
+          makeIndices(size, [](auto row) { return row; }),
+          makeFlatVector<int32_t>(2 * size, [](auto row) { return row; })),
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+  });
+  auto rowType = asRowType(data->type());
+
+  auto options = getParamSerdeOptions(nullptr);
+  options.preserveEncodings = true;
+
+  // A single append keeps the constant and the small dictionary.
+  std::vector<IndexRange> ranges{{0, size}};
+  auto serialized = serializeRanges({data}, ranges, options);
+  auto byteStream = toByteStream(serialized);
+  RowVectorPtr result;
+  serde_->deserialize(&byteStream, pool_.get(), rowType, &result, &options);
+  assertEqualVectors(data, result);
+  ASSERT_EQ(
+      result->childAt(0)->encoding(), VectorEncoding::Simple::CONSTANT);
+  ASSERT_EQ(
+      result->childAt(1)->encoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(result->childAt(2)->encoding(), VectorEncoding::Simple::FLAT);
+  ASSERT_EQ(result->childAt(3)->encoding(), VectorEncoding::Simple::FLAT);
+
+  if (options.compressionKind == common::CompressionKind_NONE) {
+    // The encoded page is smaller than the flat one.
+    options.preserveEncodings = false;
+    ASSERT_LT(
+        serialized.size(), serializeRanges({data}, ranges, options).size());
+  }
+
+  // More appends flatten the columns.
+  options.preserveEncodings = true;
+  ranges = {{0, 10}, {500, 100}};
+  serialized = serializeRanges({data, data}, ranges, options);
+  byteStream = toByteStream(serialized);
+  result = nullptr;
+  serde_->deserialize(&byteStream, pool_.get(), rowType, &result, &options);
+  ASSERT_EQ(result->size(), 220);
+  for (auto i = 0; i < result->childrenSize(); ++i) {
+    ASSERT_EQ(result->childAt(i)->encoding(), VectorEncoding::Simple::FLAT);
+  }
+  auto expected = BaseVector::create<RowVector>(rowType, 220, pool());
+  vector_size_t offset = 0;
+  for (auto i = 0; i < 2; ++i) {
+    for (const auto& range : ranges) {
+      expected->copy(data.get(), offset, range.begin, range.size);
+      offset += range.size;
+    }
+  }
+  assertEqualVectors(expected, result);
+}
+
+TEST_P(PrestoSerializerTest, minCompressionRatio) {
+  const vector_size_t size = 10'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(size, [](auto row) { return row % 7; }),
+      makeFlatVector<int64_t>(
+          size, [](auto /*row*/) { return folly::Random::rand64(); }),
+  });
+  auto rowType = asRowType(data->type());
+  std::vector<IndexRange> ranges{{0, size}};
+
+  auto options = getParamSerdeOptions(nullptr);
+  const bool compressed =
+      options.compressionKind != common::CompressionKind_NONE;
+  // Zero disables the check. A tiny ratio is never met.
+  for (const float ratio : {0.0, 0.01, 1.0}) {
+    SCOPED_TRACE(fmt::format("minCompressionRatio {}", ratio));
+    options.minCompressionRatio = ratio;
+    auto serialized = serializeRanges({data}, ranges, options);
+
+    // The codec marker follows the number of rows.
+    const auto codecMarker = serialized[sizeof(int32_t)];
+    ASSERT_EQ((codecMarker & 1) != 0, compressed && ratio != 0.01f);
+
+    auto byteStream = toByteStream(serialized);
+    RowVectorPtr result;
+    serde_->deserialize(&byteStream, pool_.get(), rowType, &result, &options);
+    assertEqualVectors(data, result);
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     PrestoSerializerTest,
     PrestoSerializerTest,
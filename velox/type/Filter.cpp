@@ -20,6 +20,8 @@
 #include <set>
 #include <string>
 
+#include <folly/String.h>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/type/Filter.h"
 
@@ -94,6 +96,9 @@ std::string Filter::toString() const {
     case FilterKind::kHugeintValuesUsingHashTable:
       strKind = "HugeintValuesUsingHashTable";
       break;
+    case FilterKind::kBloomFilterValues:
+      strKind = "BloomFilterValues";
+      break;
   };
 
   return fmt::format(
@@ -131,6 +136,7 @@ std::unordered_map<FilterKind, std::string> filterKindNames() {
       {FilterKind::kTimestampRange, "kTimestampRange"},
       {FilterKind::kHugeintValuesUsingHashTable,
        "kHugeintValuesUsingHashTable"},
+      {FilterKind::kBloomFilterValues, "kBloomFilterValues"},
   };
 }
 
@@ -199,6 +205,7 @@ void Filter::registerSerDe() {
   registry.Register("NegatedBytesValues", NegatedBytesValues::create);
   registry.Register("MultiRange", MultiRange::create);
   registry.Register("TimestampRange", TimestampRange::create);
+  registry.Register("BloomFilterValues", BloomFilterValues::create);
 }
 
 folly::dynamic Filter::serializeBase(std::string_view name) const {
@@ -757,6 +764,50 @@ bool MultiRange::testingEquals(const Filter& other) const {
   return true;
 }
 
+namespace {
+std::string serializeBloomFilter(
+    const BloomFilterValues::BloomFilterType& bloomFilter) {
+  std::string serialized(bloomFilter.serializedSize(), '\0');
+  bloomFilter.serialize(serialized.data());
+  return serialized;
+}
+} // namespace
+
+folly::dynamic BloomFilterValues::serialize() const {
+  auto obj = Filter::serializeBase("BloomFilterValues");
+  obj["bloomFilter"] = folly::hexlify(serializeBloomFilter(*bloomFilter_));
+  if (filter_ != nullptr) {
+    obj["filter"] = filter_->serialize();
+  }
+  return obj;
+}
+
+FilterPtr BloomFilterValues::create(const folly::dynamic& obj) {
+  auto nullAllowed = deserializeNullAllowed(obj);
+  const auto serialized = folly::unhexlify(obj["bloomFilter"].asString());
+  auto bloomFilter = std::make_shared<BloomFilterType>();
+  bloomFilter->merge(serialized.data());
+  std::unique_ptr<Filter> filter;
+  if (obj.count("filter")) {
+    filter = ISerializable::deserialize<Filter>(obj["filter"])->clone();
+  }
+  return std::make_unique<BloomFilterValues>(
+      std::move(bloomFilter), nullAllowed, std::move(filter));
+}
+
+bool BloomFilterValues::testingEquals(const Filter& other) const {
+  auto otherBloomFilter = dynamic_cast<const BloomFilterValues*>(&other);
+  if (otherBloomFilter == nullptr || !Filter::testingBaseEquals(other) ||
+      serializeBloomFilter(*bloomFilter_) !=
+          serializeBloomFilter(*otherBloomFilter->bloomFilter_)) {
+    return false;
+  }
+  if (filter_ == nullptr || otherBloomFilter->filter_ == nullptr) {
+    return filter_ == nullptr && otherBloomFilter->filter_ == nullptr;
+  }
+  return filter_->testingEquals(*otherBloomFilter->filter_);
+}
+
 BigintValuesUsingBitmask::BigintValuesUsingBitmask(
     int64_t min,
     int64_t max,
@@ -2644,4 +2695,61 @@ std::unique_ptr<Filter> NegatedBytesValues::mergeWith(
       VELOX_UNREACHABLE();
   }
 }
+
+bool BloomFilterValues::testInt64Range(int64_t min, int64_t max, bool hasNull)
+    const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+
+  if (min == max) {
+    return testInt64(min);
+  }
+
+  return filter_ == nullptr || filter_->testInt64Range(min, max, false);
+}
+
+bool BloomFilterValues::testBytesRange(
+    std::optional<std::string_view> min,
+    std::optional<std::string_view> max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+
+  if (min.has_value() && max.has_value() && min.value() == max.value()) {
+    return testBytes(min->data(), min->size());
+  }
+
+  return filter_ == nullptr || filter_->testBytesRange(min, max, false);
+}
+
+std::unique_ptr<Filter> BloomFilterValues::mergeWith(
+    const Filter* other) const {
+  const bool bothNullAllowed = nullAllowed_ && other->testNull();
+  std::unique_ptr<Filter> filter;
+  if (filter_ == nullptr) {
+    filter = other->clone();
+  } else if (other->kind() == FilterKind::kBloomFilterValues) {
+    // Merge into 'other' as the other filter kinds don't know how to merge
+    // with a Bloom filter.
+    filter = other->mergeWith(filter_.get());
+  } else {
+    filter = filter_->mergeWith(other);
+  }
+
+  switch (filter->kind()) {
+    case FilterKind::kAlwaysFalse:
+      return filter;
+    case FilterKind::kIsNull:
+      return nullOrFalse(bothNullAllowed);
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kIsNotNull:
+      return std::make_unique<BloomFilterValues>(
+          bloomFilter_, bothNullAllowed);
+    default:
+      return std::make_unique<BloomFilterValues>(
+          bloomFilter_, bothNullAllowed, std::move(filter));
+  }
+}
 } // namespace facebook::velox::common
@@ -24,7 +24,9 @@
 
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
+#include <folly/hash/Hash.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -56,6 +58,7 @@ enum class FilterKind {
   kHugeintRange,
   kTimestampRange,
   kHugeintValuesUsingHashTable,
+  kBloomFilterValues,
 };
 
 class Filter;
@@ -2069,6 +2072,159 @@ class MultiRange final : public Filter {
   const bool nanAllowed_;
 };
 
+/// Provides the memory for the Bloom filter of BloomFilterValues. The type
+/// library does not depend on memory pools, so a caller that accounts for its
+/// memory, e.g. a hash join build, implements this over its memory pool.
+class BloomFilterMemory {
+ public:
+  virtual ~BloomFilterMemory() = default;
+
+  virtual void* allocate(size_t bytes) = 0;
+
+  virtual void free(void* p, size_t bytes) = 0;
+};
+
+/// STL allocator over a BloomFilterMemory. Allocates with std::allocator if
+/// there is no BloomFilterMemory.
+template <typename T>
+class BloomFilterAllocator {
+ public:
+  typedef T value_type;
+
+  BloomFilterAllocator() = default;
+
+  explicit BloomFilterAllocator(std::shared_ptr<BloomFilterMemory> memory)
+      : memory_(std::move(memory)) {}
+
+  template <typename U>
+  /* implicit */ BloomFilterAllocator(const BloomFilterAllocator<U>& other)
+      : memory_(other.memory()) {}
+
+  T* allocate(size_t n) {
+    if (memory_ == nullptr) {
+      return std::allocator<T>().allocate(n);
+    }
+    return static_cast<T*>(memory_->allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T* p, size_t n) {
+    if (memory_ == nullptr) {
+      std::allocator<T>().deallocate(p, n);
+      return;
+    }
+    memory_->free(p, n * sizeof(T));
+  }
+
+  const std::shared_ptr<BloomFilterMemory>& memory() const {
+    return memory_;
+  }
+
+  template <typename U>
+  bool operator==(const BloomFilterAllocator<U>& other) const {
+    return memory_ == other.memory();
+  }
+
+  template <typename U>
+  bool operator!=(const BloomFilterAllocator<U>& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  std::shared_ptr<BloomFilterMemory> memory_;
+};
+
+/// IN-list filter for integral and string types implemented as a Bloom
+/// filter over the hashes of the values. All the values in the list pass the
+/// filter and a small fraction (~2% with 8 bits per value) of the values not
+/// in the list pass as well. Used for dynamic filters pushed down from hash
+/// joins whose keys have too many distinct values for an exact IN-list.
+///
+/// The filter can be combined with another filter on the same column, e.g. a
+/// range filter from the query. The values then must pass both. The other
+/// filter is also used to decide the range tests for row group skipping.
+class BloomFilterValues final : public Filter {
+ public:
+  using BloomFilterType = BloomFilter<BloomFilterAllocator<uint64_t>>;
+
+  /// @param bloomFilter Bloom filter built from the hashes of the values
+  /// computed with hashInt64() or hashBytes(). It is shared between the
+  /// copies of the filter and must not be modified after this.
+  /// @param nullAllowed Null values are passing the filter if true.
+  /// @param filter Optional filter that the values must pass in addition to
+  /// the Bloom filter.
+  BloomFilterValues(
+      std::shared_ptr<const BloomFilterType> bloomFilter,
+      bool nullAllowed,
+      std::unique_ptr<Filter> filter = nullptr)
+      : Filter(true, nullAllowed, FilterKind::kBloomFilterValues),
+        bloomFilter_(std::move(bloomFilter)),
+        filter_(std::move(filter)) {
+    VELOX_CHECK_NOT_NULL(bloomFilter_);
+    VELOX_CHECK(bloomFilter_->isSet());
+  }
+
+  BloomFilterValues(const BloomFilterValues& other, bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBloomFilterValues),
+        bloomFilter_(other.bloomFilter_),
+        filter_(other.filter_ ? other.filter_->clone() : nullptr) {}
+
+  /// Returns the hash of an integral value to add to or test against the
+  /// Bloom filter.
+  static uint64_t hashInt64(int64_t value) {
+    return folly::hasher<int64_t>()(value);
+  }
+
+  /// Returns the hash of a string value to add to or test against the Bloom
+  /// filter.
+  static uint64_t hashBytes(std::string_view value) {
+    return folly::hasher<std::string_view>()(value);
+  }
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    return std::make_unique<BloomFilterValues>(
+        *this, nullAllowed.value_or(nullAllowed_));
+  }
+
+  bool testInt64(int64_t value) const final {
+    return (filter_ == nullptr || filter_->testInt64(value)) &&
+        bloomFilter_->mayContain(hashInt64(value));
+  }
+
+  bool testBytes(const char* value, int32_t length) const final {
+    return (filter_ == nullptr || filter_->testBytes(value, length)) &&
+        bloomFilter_->mayContain(hashBytes(std::string_view(value, length)));
+  }
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  bool testBytesRange(
+      std::optional<std::string_view> min,
+      std::optional<std::string_view> max,
+      bool hasNull) const final;
+
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  const BloomFilterType& bloomFilter() const {
+    return *bloomFilter_;
+  }
+
+  /// Returns the filter combined with the Bloom filter, null if none.
+  const Filter* filter() const {
+    return filter_.get();
+  }
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  const std::shared_ptr<const BloomFilterType> bloomFilter_;
+  const std::unique_ptr<Filter> filter_;
+};
+
 // Helper for applying filters to different types
 template <typename TFilter, typename T>
 static inline bool applyFilter(TFilter& filter, T value) {
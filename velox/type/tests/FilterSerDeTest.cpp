@@ -110,6 +110,21 @@ TEST_F(FilterSerDeTest, valuesFilters) {
   }
 }
 
+TEST_F(FilterSerDeTest, bloomFilterValues) {
+  auto bloomFilter = std::make_shared<BloomFilterValues::BloomFilterType>();
+  bloomFilter->reset(100);
+  for (int64_t i = 0; i < 100; ++i) {
+    bloomFilter->insert(BloomFilterValues::hashInt64(i * 17));
+  }
+  for (auto nullAllowed : {false, true}) {
+    testSerde(BloomFilterValues(bloomFilter, nullAllowed));
+    testSerde(BloomFilterValues(
+        bloomFilter,
+        nullAllowed,
+        std::make_unique<BigintRange>(10, 1'000, false)));
+  }
+}
+
 TEST_F(FilterSerDeTest, rangeFilters) {
   FloatRange floatRange(1.0, true, true, 124.5, false, true, false);
   testSerde(floatRange);
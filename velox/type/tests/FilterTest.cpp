@@ -1817,6 +1817,124 @@ TEST(FilterTest, hugeIntRange) {
   EXPECT_FALSE(filter->testInt128Range(min, max, false));
 }
 
+namespace {
+std::shared_ptr<BloomFilterValues::BloomFilterType> makeBloomFilter(
+    const std::vector<int64_t>& values,
+    const std::vector<std::string>& strValues) {
+  auto bloomFilter = std::make_shared<BloomFilterValues::BloomFilterType>();
+  bloomFilter->reset(values.size() + strValues.size());
+  for (auto value : values) {
+    bloomFilter->insert(BloomFilterValues::hashInt64(value));
+  }
+  for (const auto& value : strValues) {
+    bloomFilter->insert(BloomFilterValues::hashBytes(value));
+  }
+  return bloomFilter;
+}
+} // namespace
+
+TEST(FilterTest, bloomFilterValues) {
+  std::vector<int64_t> values;
+  std::vector<std::string> strValues;
+  for (int64_t i = 0; i < 10'000; ++i) {
+    values.push_back(i * 1'000'003);
+    strValues.push_back(fmt::format("value-{}", i * 7));
+  }
+  BloomFilterValues filter(makeBloomFilter(values, strValues), false);
+  EXPECT_EQ(filter.kind(), FilterKind::kBloomFilterValues);
+  EXPECT_FALSE(filter.testNull());
+  EXPECT_TRUE(filter.clone(true)->testNull());
+
+  // No false negatives.
+  for (auto value : values) {
+    EXPECT_TRUE(filter.testInt64(value));
+    EXPECT_TRUE(applyFilter(filter, value));
+  }
+  for (const auto& value : strValues) {
+    EXPECT_TRUE(applyFilter(filter, value));
+  }
+
+  // A few false positives.
+  int32_t numPassed = 0;
+  int32_t numStrPassed = 0;
+  for (int64_t i = 0; i < 10'000; ++i) {
+    numPassed += filter.testInt64(i * 1'000'003 + 1);
+    numStrPassed += applyFilter(filter, fmt::format("value-{}", i * 7 + 1));
+  }
+  EXPECT_LT(numPassed, 500);
+  EXPECT_LT(numStrPassed, 500);
+
+  // The range tests can only use the exact values.
+  EXPECT_TRUE(filter.testInt64Range(0, 10, false));
+  EXPECT_TRUE(filter.testInt64Range(values[10], values[10], false));
+  EXPECT_TRUE(filter.testBytesRange("a", "b", false));
+  EXPECT_TRUE(filter.testBytesRange(strValues[10], strValues[10], false));
+
+  // Merge with a range filter.
+  BigintRange range(0, values[99], false);
+  auto merged = filter.mergeWith(&range);
+  ASSERT_EQ(merged->kind(), FilterKind::kBloomFilterValues);
+  EXPECT_TRUE(merged->testInt64(values[0]));
+  EXPECT_TRUE(merged->testInt64(values[99]));
+  EXPECT_FALSE(merged->testInt64(values[100]));
+  EXPECT_FALSE(merged->testInt64Range(values[100], values[200], false));
+  EXPECT_TRUE(merged->testInt64Range(values[10], values[200], false));
+
+  // Merge two Bloom filters and a range.
+  BloomFilterValues otherFilter(
+      makeBloomFilter({values.begin(), values.begin() + 50}, {}), false);
+  auto mergedTwice = otherFilter.mergeWith(merged.get());
+  ASSERT_EQ(mergedTwice->kind(), FilterKind::kBloomFilterValues);
+  EXPECT_TRUE(mergedTwice->testInt64(values[0]));
+  EXPECT_FALSE(mergedTwice->testInt64(values[100]));
+
+  // Merge with IS NULL and IS NOT NULL.
+  EXPECT_EQ(
+      filter.mergeWith(std::make_unique<IsNull>().get())->kind(),
+      FilterKind::kAlwaysFalse);
+  auto notNull = filter.clone(true)->mergeWith(
+      std::make_unique<IsNotNull>().get());
+  ASSERT_EQ(notNull->kind(), FilterKind::kBloomFilterValues);
+  EXPECT_FALSE(notNull->testNull());
+}
+
+TEST(FilterTest, bloomFilterValuesMemory) {
+  class CountingMemory : public BloomFilterMemory {
+   public:
+    void* allocate(size_t bytes) override {
+      allocatedBytes += bytes;
+      return ::malloc(bytes);
+    }
+
+    void free(void* p, size_t bytes) override {
+      allocatedBytes -= bytes;
+      ::free(p);
+    }
+
+    int64_t allocatedBytes{0};
+  };
+
+  auto memory = std::make_shared<CountingMemory>();
+  auto bloomFilter = std::make_shared<BloomFilterValues::BloomFilterType>(
+      BloomFilterAllocator<uint64_t>(memory));
+  bloomFilter->reset(1'000);
+  for (int64_t i = 0; i < 1'000; ++i) {
+    bloomFilter->insert(BloomFilterValues::hashInt64(i));
+  }
+  EXPECT_EQ(memory->allocatedBytes, bloomFilter->serializedSize() - 5);
+
+  auto filter = std::make_unique<BloomFilterValues>(bloomFilter, false);
+  auto copy = filter->clone(true);
+  bloomFilter.reset();
+  filter.reset();
+  EXPECT_GT(memory->allocatedBytes, 0);
+  EXPECT_TRUE(copy->testInt64(10));
+
+  // The memory is freed with the last copy of the filter.
+  copy.reset();
+  EXPECT_EQ(memory->allocatedBytes, 0);
+}
+
 TEST(FilterTest, dateRange) {
   auto filter =
       between(DATE()->toDays("1970-01-01"), DATE()->toDays("1980-01-01"));